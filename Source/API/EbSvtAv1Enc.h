@@ -18,6 +18,7 @@ extern "C" {
 
 #include <stdint.h>
 #include "EbSvtAv1.h"
+#include "EbSvtAv1ExtFrameBuf.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -67,8 +68,9 @@ typedef enum ATTRIBUTE_PACKED {
 #define EB_BUFFERFLAG_SHOW_EXT 0x00000002 // signals that the packet contains a show existing frame at the end
 #define EB_BUFFERFLAG_HAS_TD 0x00000004 // signals that the packet contains a TD
 #define EB_BUFFERFLAG_IS_ALT_REF 0x00000008 // signals that the packet contains an ALT_REF frame
+#define EB_BUFFERFLAG_SUB_FRAME 0x00000010 // signals that the packet holds part of a frame, the rest follows
 #define EB_BUFFERFLAG_ERROR_MASK \
-    0xFFFFFFF0 // mask for signalling error assuming top flags fit in 4 bits. To be changed, if more flags are added.
+    0xFFFFFFE0 // mask for signalling error assuming top flags fit in 5 bits. To be changed, if more flags are added.
 
 /*
  * Struct for storing content light level information
@@ -151,10 +153,33 @@ typedef enum SvtAv1IntraRefreshType {
 typedef enum {
     SVT_AV1_STREAM_INFO_START                = 1,
     SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT = SVT_AV1_STREAM_INFO_START,
+    SVT_AV1_STREAM_INFO_INPUT_FRAME_LAYOUT,
+    SVT_AV1_STREAM_INFO_MEMORY_USAGE,
+    SVT_AV1_STREAM_INFO_PIPELINE_TELEMETRY,
+    SVT_AV1_STREAM_INFO_HME_CACHE_STATS,
+    SVT_AV1_STREAM_INFO_TF_STATS,
 
     SVT_AV1_STREAM_INFO_END,
 } SVT_AV1_STREAM_INFO_ID;
 
+/*!\brief Plane layout of the frames the encoder can reference without copying
+ *
+ * Returned for SVT_AV1_STREAM_INFO_INPUT_FRAME_LAYOUT. A picture sent with
+ * SvtAv1EncCallbacks.release_input_frame set is referenced in place when its
+ * planes follow this layout: the EbSvtIOFormat luma / cb / cr pointers are
+ * luma_offset / chroma_offset bytes into planes of luma_size / chroma_size
+ * bytes, with y_stride == luma_stride and cb_stride == cr_stride == chroma_stride.
+ * Only 8-bit 4:2:0 input qualifies, other pictures are copied as usual.
+ */
+typedef struct SvtAv1InputFrameLayout {
+    uint32_t luma_stride;
+    uint32_t chroma_stride;
+    uint32_t luma_offset;
+    uint32_t chroma_offset;
+    uint32_t luma_size;
+    uint32_t chroma_size;
+} SvtAv1InputFrameLayout;
+
 /*!\brief Generic fixed size buffer structure
  *
  * This structure is able to hold a reference to any fixed size buffer.
@@ -212,6 +237,177 @@ typedef struct SvtAv1FrameScaleEvts {
     uint32_t *resize_denoms;
 } SvtAv1FrameScaleEvts;
 
+// Event callbacks for integrations that do not want to poll the encoder,
+// registered with svt_av1_enc_set_callbacks() before svt_av1_enc_init()
+typedef struct SvtAv1EncCallbacks {
+    // Passed back untouched to every callback
+    void *user_data;
+    /* Called from the encoder thread as soon as a temporal unit is ready, in output
+     * order, the last one carrying EB_BUFFERFLAG_EOS. The callee owns the packet and
+     * returns it with svt_av1_enc_release_out_buffer(), possibly later and from
+     * another thread; packets with flags above 0xf signal an encode error.
+     * When set, svt_av1_enc_get_packet() never returns packets. */
+    void (*packet_ready)(void *user_data, EbBufferHeaderType *packet);
+    /* Called from an encoder thread whenever the encoder releases the input buffers
+     * of a picture, i.e. when an svt_av1_enc_send_picture() call that would have had to
+     * wait for a free input slot can go ahead. */
+    void (*input_slot_available)(void *user_data);
+    /* Enables zero-copy input (see SvtAv1InputFrameLayout). Called exactly once for
+     * every picture sent with a buffer, as soon as the encoder no longer reads its
+     * planes: right after svt_av1_enc_send_picture() for copied pictures, once
+     * analysis, temporal filtering and motion estimation are done for referenced
+     * ones. frame_buf->buffer is the luma pointer that was sent, buffer_size its
+     * n_filled_len and private_data the EbSvtIOFormat pointer, the second argument
+     * is user_data. Referenced planes may be modified by the encoder (border padding,
+     * temporal filtering) until they are released. */
+    EbReleaseFrameBuffer release_input_frame;
+} SvtAv1EncCallbacks;
+
+// What an allocation made through an SvtAv1Allocator is used for
+typedef enum SvtAv1AllocTag {
+    SVT_AV1_ALLOC_TAG_OTHER, // Anything not listed below
+    SVT_AV1_ALLOC_TAG_SEQUENCE_CONTROL_SET,
+    SVT_AV1_ALLOC_TAG_PCS, // Picture control sets (parent and child)
+    SVT_AV1_ALLOC_TAG_ME_RESULTS, // Motion estimation data attached to parent PCS
+    SVT_AV1_ALLOC_TAG_ENC_DEC, // Per-picture mode decision / encode pass data
+    SVT_AV1_ALLOC_TAG_REFERENCE_PICTURE, // Reconstructed reference pictures used for motion compensation
+    SVT_AV1_ALLOC_TAG_PA_REFERENCE, // Source and downscaled pictures used by motion estimation
+    SVT_AV1_ALLOC_TAG_INPUT_PICTURE, // Copies of the input pictures
+    SVT_AV1_ALLOC_TAG_OUTPUT_BUFFER, // Bitstream and reconstruction output buffers
+    SVT_AV1_ALLOC_TAG_RESULTS, // Inter-kernel task and result messages
+    SVT_AV1_ALLOC_TAG_CONTEXT, // Per-thread kernel contexts
+    SVT_AV1_ALLOC_TAG_TPL, // TPL statistics and reference pictures
+    SVT_AV1_ALLOC_TAG_NEIGHBOR_ARRAY, // Neighbor arrays of pictures and contexts
+    SVT_AV1_ALLOC_TAG_COUNT
+} SvtAv1AllocTag;
+
+// Size class hint of an allocation made through an SvtAv1Allocator
+typedef enum SvtAv1AllocSizeClass {
+    SVT_AV1_ALLOC_SIZE_SMALL, // below 4 KiB
+    SVT_AV1_ALLOC_SIZE_MEDIUM, // below 2 MiB
+    SVT_AV1_ALLOC_SIZE_LARGE, // 2 MiB and above, candidates for huge pages
+} SvtAv1AllocSizeClass;
+
+// Host memory allocator, registered with svt_av1_enc_set_allocator() before svt_av1_enc_init().
+// It backs every pool and context built by svt_av1_enc_init(); buffers the encoder allocates
+// while running are not routed through it. All functions may be called from any encoder
+// thread and must be thread safe; every block is released with free() using the same tag.
+typedef struct SvtAv1Allocator {
+    // Passed back untouched to every function
+    void *opaque;
+    // Returns a block of at least size bytes, NULL on failure
+    void *(*alloc)(void *opaque, size_t size, SvtAv1AllocSizeClass size_class, SvtAv1AllocTag tag);
+    // Same as alloc with the block aligned to alignment bytes (a power of two)
+    void *(*aligned_alloc)(void *opaque, size_t size, size_t alignment, SvtAv1AllocSizeClass size_class,
+                           SvtAv1AllocTag tag);
+    // Releases a block returned by alloc or aligned_alloc
+    void (*free)(void *opaque, void *ptr, SvtAv1AllocTag tag);
+} SvtAv1Allocator;
+
+/*!\brief Memory held by an encoder instance
+ *
+ * Returned for SVT_AV1_STREAM_INFO_MEMORY_USAGE. Covers what svt_av1_enc_init_handle()
+ * and svt_av1_enc_init() allocate and the encoder keeps until svt_av1_enc_deinit(): the
+ * picture, reference and result pools, the kernel contexts and everything they own.
+ * Scratch buffers the kernels allocate while encoding are not included.
+ */
+typedef struct SvtAv1MemoryUsage {
+    // Heap bytes, malloc_bytes + calloc_bytes + aligned_bytes
+    uint64_t total_bytes;
+    uint64_t malloc_bytes;
+    uint64_t calloc_bytes;
+    uint64_t aligned_bytes;
+    uint32_t mutex_count;
+    uint32_t semaphore_count;
+    uint32_t thread_count;
+    // Heap bytes by owning pool or object, sums up to total_bytes
+    uint64_t bytes_by_tag[SVT_AV1_ALLOC_TAG_COUNT];
+} SvtAv1MemoryUsage;
+
+// Encoder pipeline stages, in pipeline order
+typedef enum SvtAv1PipelineStage {
+    SVT_AV1_STAGE_RESOURCE_COORDINATION,
+    SVT_AV1_STAGE_PICTURE_ANALYSIS,
+    SVT_AV1_STAGE_PICTURE_DECISION,
+    SVT_AV1_STAGE_MOTION_ESTIMATION,
+    SVT_AV1_STAGE_INITIAL_RATE_CONTROL,
+    SVT_AV1_STAGE_SOURCE_BASED_OPERATIONS,
+    SVT_AV1_STAGE_TPL_DISPENSER,
+    SVT_AV1_STAGE_PICTURE_MANAGER,
+    SVT_AV1_STAGE_RATE_CONTROL,
+    SVT_AV1_STAGE_MODE_DECISION_CONFIGURATION,
+    SVT_AV1_STAGE_ENC_DEC,
+    SVT_AV1_STAGE_DLF,
+    SVT_AV1_STAGE_CDEF,
+    SVT_AV1_STAGE_RESTORATION,
+    SVT_AV1_STAGE_ENTROPY_CODING,
+    SVT_AV1_STAGE_PACKETIZATION,
+    SVT_AV1_STAGE_COUNT
+} SvtAv1PipelineStage;
+
+// Bin i of a latency histogram counts durations of [2^i, 2^(i+1)) microseconds,
+// the first bin also counts shorter ones and the last one longer ones
+#define SVT_AV1_LATENCY_HISTOGRAM_BINS 24
+
+typedef struct SvtAv1StageTelemetry {
+    // Tasks the stage took from its input queue
+    uint64_t task_count;
+    // Time tasks spent queued before a thread of the stage took them, and its distribution
+    uint64_t total_wait_us;
+    uint64_t wait_histogram[SVT_AV1_LATENCY_HISTOGRAM_BINS];
+    // Time the threads of the stage spent on a task, including waits for downstream
+    // buffers, and its distribution
+    uint64_t total_busy_us;
+    uint64_t busy_histogram[SVT_AV1_LATENCY_HISTOGRAM_BINS];
+    // Tasks waiting in the input queue when queried, and the most ever seen
+    uint32_t queue_depth;
+    uint32_t max_queue_depth;
+} SvtAv1StageTelemetry;
+
+/*!\brief Where the pictures spend their time inside the encoder
+ *
+ * Returned for SVT_AV1_STREAM_INFO_PIPELINE_TELEMETRY. Every stage reads its tasks
+ * from one queue: a task is a picture or a part of it (a segment for ENC_DEC, a
+ * tile group for DLF...), so task counts differ between stages. The counters keep
+ * running and can be queried from any thread at any time after svt_av1_enc_init(),
+ * the values of one query are not a consistent snapshot.
+ */
+typedef struct SvtAv1PipelineTelemetry {
+    SvtAv1StageTelemetry stage[SVT_AV1_STAGE_COUNT];
+    // Pictures output, and the distribution of the time between picture intake
+    // by resource coordination and packetization
+    uint64_t picture_count;
+    uint64_t picture_latency_histogram[SVT_AV1_LATENCY_HISTOGRAM_BINS];
+} SvtAv1PipelineTelemetry;
+
+/*!\brief Reuse of hierarchical ME results
+ *
+ * Returned for SVT_AV1_STREAM_INFO_HME_CACHE_STATS. Motion estimation keeps the HME
+ * results of the last searched picture pairs, a 64x64 block searched again against
+ * the same references with the same settings (e.g. when a picture is re-encoded)
+ * takes them from there. Counts are in 64x64 blocks and keep running.
+ */
+typedef struct SvtAv1HmeCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+} SvtAv1HmeCacheStats;
+
+/*!\brief Temporal filtering work avoided by the block early exit
+ *
+ * Returned for SVT_AV1_STREAM_INFO_TF_STATS. Counts are in 64x64 block / reference
+ * frame pairs and keep running: skipped pairs are filtered with the (0, 0) prediction
+ * without motion search, seeded pairs start their motion search from the vector of the
+ * previous reference frame on the same side. All stay 0 unless tf_early_exit is set.
+ */
+typedef struct SvtAv1TfStats {
+    uint64_t blocks;
+    uint64_t skipped;
+    uint64_t seeded;
+} SvtAv1TfStats;
+
+// Opaque pool of execution slots that several encoder instances can share
+typedef struct EbWorkerPool EbSvtAv1WorkerPool;
+
 // Will contain the EbEncApi which will live in the EncHandle class
 // Only modifiable during config-time.
 typedef struct EbSvtAv1EncConfiguration {
@@ -980,6 +1176,64 @@ typedef struct EbSvtAv1EncConfiguration {
      *  Default is 6 */
     uint8_t variance_octile;
 
+    /* Worker pool size
+     * 0 = each encoder stage runs its own threads unrestricted
+     * N = all encoder threads share N execution slots: a thread only runs while it
+     *     holds a slot and gives it back whenever it waits for work, and each parallel
+     *     stage gets up to N threads so that any stage can use the whole pool.
+     * Default is 0. */
+    uint32_t worker_pool_size;
+
+    /* Worker pool shared with other encoder instances, created with
+     * svt_av1_enc_create_worker_pool(). When set, all the threads of this encoder
+     * run on the slots of that pool (worker_pool_size is then ignored), and free
+     * slots are handed out fairly between the encoders using the pool.
+     * Default is NULL. */
+    EbSvtAv1WorkerPool *shared_worker_pool;
+
+    /* Path of a Chrome trace JSON file (chrome://tracing, ui.perfetto.dev) written by
+     * svt_av1_enc_deinit(), with one event per task run by the encoder threads: the
+     * stage, the picture number and segment, and the thread. The path is copied by
+     * svt_av1_enc_init().
+     * Default is NULL (no tracing). */
+    const char *trace_file;
+
+    /* Sub-frame output, for low-delay real-time encoding. The tile rows of a frame are
+     * entropy coded as soon as EncDec is done with their superblocks, and are sent right
+     * away in packets flagged EB_BUFFERFLAG_SUB_FRAME: the first one holds the temporal
+     * delimiter and the frame header, then each holds one tile group OBU per tile row.
+     * The last packet of the frame is not flagged, carries the frame properties (pts,
+     * pic_type, ...) and may be empty. Requires a low-delay prediction structure, a single
+     * pass and no resizing. CDEF, restoration and re-encoding are turned off and the
+     * deblocking filter runs per superblock within EncDec. Frames are split at tile rows:
+     * tile_rows is set to 2 when left to 0.
+     * Default is false. */
+    Bool sub_frame_output;
+
+    /* Incremental TPL. Consecutive TPL groups overlap by one mini-GOP: instead of running the
+     * TPL dispenser again on the pictures already processed for the previous group, their
+     * dispenser stats and TPL reconstructions are kept and only the pictures that entered the
+     * lookahead are dispensed, then the synthesizer is run on the whole group. Reused pictures
+     * keep the stats computed with the previous group's references, so the output differs
+     * from the default mode. Not available with super-resolution or resizing.
+     * Default is false. */
+    Bool incremental_tpl;
+
+    /* Downscaled TPL. The TPL dispenser runs on the downsampled pictures built in picture
+     * analysis instead of the full-resolution source, and its stats are stored back on the
+     * full-resolution synthesizer grid used for r0, beta and the lambda factors.
+     * 0 = full resolution, 1 = 1/4 (half width and height), 2 = 1/16 (quarter width and height).
+     * Not available with super-resolution or resizing.
+     * Default is 0. */
+    uint8_t tpl_downscale;
+
+    /* Temporal filtering block early exit. A 64x64 block whose zero-motion error to a
+     * reference frame is within the source noise level is filtered with the (0, 0)
+     * prediction without motion search, and the motion search of the other blocks starts
+     * from the vector found for the previous reference frame on the same side.
+     * Default is false. */
+    Bool tf_early_exit;
+
 #if FTR_LOSSLESS_SUPPORT
     /* @brief Signal to the library to enable losless coding
      *
@@ -996,23 +1250,23 @@ typedef struct EbSvtAv1EncConfiguration {
     /*Add 128 Byte Padding to Struct to avoid changing the size of the public configuration struct*/
 #if CLN_LP_LVLS
 #if FTR_STILL_PICTURE
-    uint8_t padding[128 - 3 * sizeof(Bool) - 2 * sizeof(uint8_t) - sizeof(uint32_t)];
+    uint8_t padding[128 - 6 * sizeof(Bool) - 3 * sizeof(uint8_t) - 2 * sizeof(uint32_t) - 2 * sizeof(void *)];
 #else
-    uint8_t padding[128 - 2 * sizeof(Bool) - 2 * sizeof(uint8_t) - sizeof(uint32_t)];
+    uint8_t padding[128 - 5 * sizeof(Bool) - 3 * sizeof(uint8_t) - 2 * sizeof(uint32_t) - 2 * sizeof(void *)];
 #endif
 #else
 #if FTR_STILL_PICTURE
-    uint8_t padding[128 - 3 * sizeof(Bool) - 2 * sizeof(uint8_t)];
+    uint8_t padding[128 - 6 * sizeof(Bool) - 3 * sizeof(uint8_t) - sizeof(uint32_t) - 2 * sizeof(void *)];
 #else
-    uint8_t padding[128 - 2 * sizeof(Bool) - 2 * sizeof(uint8_t)];
+    uint8_t padding[128 - 5 * sizeof(Bool) - 3 * sizeof(uint8_t) - sizeof(uint32_t) - 2 * sizeof(void *)];
 #endif
 #endif
 #else
     /*Add 128 Byte Padding to Struct to avoid changing the size of the public configuration struct*/
 #if CLN_LP_LVLS
-    uint8_t padding[128 - sizeof(Bool) - 2 * sizeof(uint8_t) - sizeof(uint32_t)];
+    uint8_t padding[128 - 4 * sizeof(Bool) - 3 * sizeof(uint8_t) - 2 * sizeof(uint32_t) - 2 * sizeof(void *)];
 #else
-    uint8_t padding[128 - sizeof(Bool) - 2 * sizeof(uint8_t)];
+    uint8_t padding[128 - 4 * sizeof(Bool) - 3 * sizeof(uint8_t) - sizeof(uint32_t) - 2 * sizeof(void *)];
 #endif
 #endif
 } EbSvtAv1EncConfiguration;
@@ -1060,6 +1314,23 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
 EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *pComponentParameterStructure, const char *name,
                                                const char *value);
 
+/* OPTIONAL: Register event callbacks instead of polling, before svt_av1_enc_init.
+     * Callbacks run on encoder threads: they should return quickly and must not
+     * call svt_av1_enc_send_picture() or svt_av1_enc_deinit() themselves.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *callbacks          Callbacks to copy, NULL to unregister. */
+EB_API EbErrorType svt_av1_enc_set_callbacks(EbComponentType *svt_enc_component, const SvtAv1EncCallbacks *callbacks);
+
+/* OPTIONAL: Back the encoder buffers with a host allocator, before svt_av1_enc_init.
+     * The allocator must stay usable until svt_av1_enc_deinit() returns.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *allocator          Allocator to copy, NULL to go back to the C runtime. */
+EB_API EbErrorType svt_av1_enc_set_allocator(EbComponentType *svt_enc_component, const SvtAv1Allocator *allocator);
+
 /* STEP 3: Initialize encoder and allocates memory to necessary buffers.
      *
      * Parameter:
@@ -1133,6 +1404,22 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component);
      * @ *svt_enc_component  Encoder handler. */
 EB_API EbErrorType svt_av1_enc_deinit_handle(EbComponentType *svt_enc_component);
 
+/* Create a worker pool that several encoder handles can share through
+     * EbSvtAv1EncConfiguration.shared_worker_pool, so that all their threads run on
+     * at most slot_count cores.
+     *
+     * Parameter:
+     * @ **p_pool      Receives the pool.
+     * @ slot_count    Number of encoder threads allowed to run at the same time. */
+EB_API EbErrorType svt_av1_enc_create_worker_pool(EbSvtAv1WorkerPool **p_pool, uint32_t slot_count);
+
+/* Destroy a worker pool. Every encoder handle using it must have been
+     * deinitialized first.
+     *
+     * Parameter:
+     * @ *pool         Pool created by svt_av1_enc_create_worker_pool. */
+EB_API EbErrorType svt_av1_enc_destroy_worker_pool(EbSvtAv1WorkerPool *pool);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -94,6 +94,7 @@
 #define SCREEN_CONTENT_TOKEN "--scm"
 // --- start: ALTREF_FILTERING_SUPPORT
 #define ENABLE_TF_TOKEN "--enable-tf"
+#define TF_EARLY_EXIT_TOKEN "--tf-early-exit"
 #define ENABLE_OVERLAYS "--enable-overlays"
 #define TUNE_TOKEN "--tune"
 // --- end: ALTREF_FILTERING_SUPPORT
@@ -132,6 +133,8 @@
 #define BUFFER_OPTIMAL_SIZE_TOKEN "--buf-optimal-sz"
 #define RECODE_LOOP_TOKEN "--recode-loop"
 #define ENABLE_TPL_LA_TOKEN "--enable-tpl-la"
+#define INCREMENTAL_TPL_TOKEN "--incremental-tpl"
+#define TPL_DOWNSCALE_TOKEN "--tpl-downscale"
 #define TILE_ROW_TOKEN "--tile-rows"
 #define TILE_COL_TOKEN "--tile-columns"
 
@@ -142,6 +145,9 @@
 #define THREAD_MGMNT "--lp"
 #define PIN_TOKEN "--pin"
 #define TARGET_SOCKET "--ss"
+#define WORKER_POOL_TOKEN "--worker-pool"
+#define TRACE_FILE_TOKEN "--trace-file"
+#define SUB_FRAME_OUTPUT_TOKEN "--sub-frame-output"
 #define RESTRICTED_MOTION_VECTOR "--rmv"
 
 //double dash
@@ -405,6 +411,13 @@ static EbErrorType set_cfg_fgs_table_path(EbConfig *cfg, const char *token, cons
 
     return EB_ErrorNone;
 }
+static EbErrorType set_cfg_trace_file_path(EbConfig *cfg, const char *token, const char *value) {
+    (void)token;
+    free(cfg->trace_file_path);
+    cfg->trace_file_path   = strdup(value);
+    cfg->config.trace_file = cfg->trace_file_path;
+    return EB_ErrorNone;
+}
 
 static EbErrorType set_two_pass_stats(EbConfig *cfg, const char *token, const char *value) {
     return str_to_str(value, (char **)&cfg->stats, token);
@@ -794,6 +807,21 @@ ConfigEntry config_entry_global_options[] = {
      "Specifies which socket to run on, assumes a max of two sockets. Refer to Appendix A.1 of the "
      "user guide, default is -1 [-1, 0, -1]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     WORKER_POOL_TOKEN,
+     "Number of execution slots shared by all encoder threads, 0 lets every thread run "
+     "unrestricted, default is 0 [0, core count of the machine]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     TRACE_FILE_TOKEN,
+     "Write a Chrome trace JSON file of the tasks run by every encoder thread, for "
+     "chrome://tracing or ui.perfetto.dev",
+     set_cfg_trace_file_path},
+    {SINGLE_INPUT,
+     SUB_FRAME_OUTPUT_TOKEN,
+     "Output the tile rows of a frame as soon as they are coded, low-delay single pass only, "
+     "turns off CDEF and restoration, default is 0 [0-1]",
+     set_cfg_generic_token},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -1031,6 +1059,16 @@ ConfigEntry config_entry_specific[] = {
      "Temporal Dependency model control, currently forced on library side, only applicable for "
      "CRF/CQP, default is 1 [0-1]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     INCREMENTAL_TPL_TOKEN,
+     "Only run the Temporal Dependency model on the pictures that entered the lookahead, reusing "
+     "the results of the previous TPL group, default is 0 [0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     TPL_DOWNSCALE_TOKEN,
+     "Run the Temporal Dependency model on downsampled pictures, default is 0 [0: full resolution, 1: 1/4, "
+     "2: 1/16]",
+     set_cfg_generic_token},
     {SINGLE_INPUT,
      MFMV_ENABLE_NEW_TOKEN,
      "Motion Field Motion Vector control, default is -1 [-1: auto, 0-1]",
@@ -1042,6 +1080,11 @@ ConfigEntry config_entry_specific[] = {
      ENABLE_TF_TOKEN,
      "Enable ALT-REF (temporally filtered) frames, default is 1 [0-1]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     TF_EARLY_EXIT_TOKEN,
+     "Filter the ALT-REF blocks matching a reference within the noise level without motion search, "
+     "and seed the other searches from the previous reference, default is 0 [0-1]",
+     set_cfg_generic_token},
 
     {SINGLE_INPUT,
      ENABLE_OVERLAYS,
@@ -1254,6 +1297,9 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_cfg_generic_token},
     {SINGLE_INPUT, PIN_TOKEN, "PinnedExecution", set_cfg_generic_token},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_cfg_generic_token},
+    {SINGLE_INPUT, WORKER_POOL_TOKEN, "WorkerPoolSize", set_cfg_generic_token},
+    {SINGLE_INPUT, TRACE_FILE_TOKEN, "TraceFile", set_cfg_trace_file_path},
+    {SINGLE_INPUT, SUB_FRAME_OUTPUT_TOKEN, "SubFrameOutput", set_cfg_generic_token},
 
     // Rate Control Options
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_cfg_generic_token},
@@ -1322,12 +1368,15 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, CDEF_ENABLE_TOKEN, "CDEFLevel", set_cdef_enable},
     {SINGLE_INPUT, ENABLE_RESTORATION_TOKEN, "EnableRestoration", set_cfg_generic_token},
     {SINGLE_INPUT, ENABLE_TPL_LA_TOKEN, "EnableTPLModel", set_cfg_generic_token},
+    {SINGLE_INPUT, INCREMENTAL_TPL_TOKEN, "IncrementalTPL", set_cfg_generic_token},
+    {SINGLE_INPUT, TPL_DOWNSCALE_TOKEN, "TPLDownscale", set_cfg_generic_token},
     {SINGLE_INPUT, MFMV_ENABLE_NEW_TOKEN, "Mfmv", set_cfg_generic_token},
     {SINGLE_INPUT, DG_ENABLE_NEW_TOKEN, "EnableDg", set_cfg_generic_token},
     {SINGLE_INPUT, FAST_DECODE_TOKEN, "FastDecode", set_cfg_generic_token},
     {SINGLE_INPUT, TUNE_TOKEN, "Tune", set_cfg_generic_token},
     //   ALT-REF filtering support
     {SINGLE_INPUT, ENABLE_TF_TOKEN, "EnableTf", set_cfg_generic_token},
+    {SINGLE_INPUT, TF_EARLY_EXIT_TOKEN, "TfEarlyExit", set_cfg_generic_token},
     {SINGLE_INPUT, ENABLE_OVERLAYS, "EnableOverlays", set_cfg_generic_token},
     {SINGLE_INPUT, SCREEN_CONTENT_TOKEN, "ScreenContentMode", set_cfg_generic_token},
     {SINGLE_INPUT, RESTRICTED_MOTION_VECTOR, "RestrictedMotionVector", set_cfg_generic_token},
@@ -1398,6 +1447,7 @@ EbConfig *svt_config_ctor() {
     app_cfg->injector_frame_rate = 60;
     app_cfg->roi_map_file        = NULL;
     app_cfg->fgs_table_path      = NULL;
+    app_cfg->trace_file_path     = NULL;
 
     return app_cfg;
 }
@@ -1457,6 +1507,14 @@ void svt_config_dtor(EbConfig *app_cfg) {
         app_cfg->fgs_table_path = NULL;
     }
 
+    if (app_cfg->trace_file_path) {
+        free(app_cfg->trace_file_path);
+        app_cfg->trace_file_path = NULL;
+    }
+
+    free(app_cfg->sub_frame_buffer);
+    app_cfg->sub_frame_buffer = NULL;
+
     for (size_t i = 0; i < app_cfg->forced_keyframes.count; ++i) free(app_cfg->forced_keyframes.specifiers[i]);
     free(app_cfg->forced_keyframes.specifiers);
     free(app_cfg->forced_keyframes.frames);
@@ -187,6 +187,12 @@ typedef struct EbConfig {
     uint8_t instance_idx;
 
     char *fgs_table_path;
+    char *trace_file_path;
+
+    // Parts of the frame being output with --sub-frame-output, written once the frame is complete
+    uint8_t *sub_frame_buffer;
+    uint32_t sub_frame_size;
+    uint32_t sub_frame_alloc;
 } EbConfig;
 
 typedef struct EncChannel {
@@ -96,6 +96,8 @@ typedef struct EncContext {
     EncPass    enc_pass;
     int32_t    passes;
     int32_t    total_frames;
+    // Worker pool shared by all the channels when --worker-pool is used with several channels
+    EbSvtAv1WorkerPool* worker_pool;
 } EncContext;
 
 //initilize memory mapped file handler
@@ -192,6 +194,14 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
     if (enc_context->channels[0].app_cfg->config.target_socket != -1)
         assign_app_thread_group(enc_context->channels[0].app_cfg->config.target_socket);
 
+    // Let the channels share one pool of worker slots instead of one pool each
+    const uint32_t pool_size = enc_context->channels[0].app_cfg->config.worker_pool_size;
+    if (num_channels > 1 && pool_size) {
+        return_error = svt_av1_enc_create_worker_pool(&enc_context->worker_pool, pool_size);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+
     // Init the Encoder
     for (uint32_t inst_cnt = 0; inst_cnt < num_channels; ++inst_cnt) {
         EncChannel* c = enc_context->channels + inst_cnt;
@@ -199,6 +209,7 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
             EbConfig* app_cfg                    = c->app_cfg;
             app_cfg->config.active_channel_count = num_channels;
             app_cfg->config.channel_id           = inst_cnt;
+            app_cfg->config.shared_worker_pool   = enc_context->worker_pool;
             app_cfg->config.recon_enabled        = app_cfg->recon_file ? TRUE : FALSE;
 
             // set force_key_frames frames
@@ -251,6 +262,8 @@ static void enc_context_dctor(EncContext* enc_context) {
         deinit_memory_file_map(c->app_cfg);
         enc_channel_dctor(c, inst_cnt);
     }
+    if (enc_context->worker_pool)
+        svt_av1_enc_destroy_worker_pool(enc_context->worker_pool);
 
     for (uint32_t warning_id = 0; warning_id < MAX_NUM_TOKENS; warning_id++) free(enc_context->warning[warning_id]);
 }
@@ -786,6 +786,23 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
     return;
 }
 
+// Keeps a part of the frame being output with --sub-frame-output
+static bool append_sub_frame(EbConfig *app_cfg, const EbBufferHeaderType *header_ptr) {
+    const uint32_t size = app_cfg->sub_frame_size + header_ptr->n_filled_len;
+    if (size > app_cfg->sub_frame_alloc) {
+        uint8_t *buf = (uint8_t *)realloc(app_cfg->sub_frame_buffer, size);
+        if (!buf) {
+            fprintf(stderr, "Could not allocate the sub-frame buffer\n");
+            return false;
+        }
+        app_cfg->sub_frame_buffer = buf;
+        app_cfg->sub_frame_alloc  = size;
+    }
+    memcpy(app_cfg->sub_frame_buffer + app_cfg->sub_frame_size, header_ptr->p_buffer, header_ptr->n_filled_len);
+    app_cfg->sub_frame_size = size;
+    return true;
+}
+
 void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t *frame_count) {
     EbConfig            *app_cfg    = channel->app_cfg;
     AppPortActiveType   *port_state = &app_cfg->output_stream_port_active;
@@ -802,14 +819,16 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
     uint64_t finish_s_time = 0;
     uint64_t finish_u_time = 0;
     uint8_t  is_alt_ref    = 1;
+    uint8_t  is_sub_frame  = 0;
     if (channel->exit_cond_output != APP_ExitConditionNone)
         return;
     uint8_t pic_send_done = (channel->exit_cond_input == APP_ExitConditionNone) ||
             (channel->exit_cond_recon == APP_ExitConditionNone)
         ? 0
         : 1;
-    while (is_alt_ref) {
-        is_alt_ref = 0;
+    while (is_alt_ref || is_sub_frame) {
+        is_alt_ref   = 0;
+        is_sub_frame = 0;
         // If we are not in low-delay mode, this is a non-blocking call until all input frames are sent
         EbErrorType stream_status = svt_av1_enc_get_packet(component_handle, &header_ptr, pic_send_done);
 
@@ -843,6 +862,17 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         }
                     }
                 }
+            } else if (flags & EB_BUFFERFLAG_SUB_FRAME) {
+                // Part of a frame, held until the frame is complete for the ivf frame header
+                is_sub_frame = 1;
+                if (stream_file && !append_sub_frame(app_cfg, header_ptr)) {
+                    channel->exit_cond_output = APP_ExitConditionError;
+                    svt_av1_enc_release_out_buffer(&header_ptr);
+                    return;
+                }
+                app_cfg->performance_context.byte_count += header_ptr->n_filled_len;
+                svt_av1_enc_release_out_buffer(&header_ptr);
+                continue;
             } else {
                 is_alt_ref = (flags & EB_BUFFERFLAG_IS_ALT_REF);
                 if (!(flags & EB_BUFFERFLAG_IS_ALT_REF))
@@ -871,9 +901,12 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         write_ivf_stream_header(
                             app_cfg, app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded);
                     }
-                    write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
+                    write_ivf_frame_header(app_cfg, app_cfg->sub_frame_size + header_ptr->n_filled_len);
+                    if (app_cfg->sub_frame_size)
+                        fwrite(app_cfg->sub_frame_buffer, 1, app_cfg->sub_frame_size, stream_file);
                     fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, stream_file);
                 }
+                app_cfg->sub_frame_size = 0;
 
                 app_cfg->performance_context.byte_count += header_ptr->n_filled_len;
 
@@ -4203,6 +4203,57 @@ void svt_aom_sad128x128x4d_avx2(const uint8_t *src, int src_stride, const uint8_
     res[3] = sum0[3] + sum1[3];
 }
 
+/* Keep the best 8x8 and 16x16 SAD + MV of eight search positions of one 16x16 block,
+   sad02 / sad13 hold the eight SADs of the 8x8 blocks 0, 2 / 1, 3 in their 128-bit lanes */
+static INLINE void eight_sad_update_8x8_16x16_avx2(const __m256i sad02, const __m256i sad13, const uint32_t mv,
+                                                   const uint32_t start_16x16_pos, uint32_t *p_best_sad_8x8,
+                                                   uint32_t *p_best_sad_16x16, uint32_t *p_best_mv8x8,
+                                                   uint32_t *p_best_mv16x16, uint32_t p_eight_sad16x16[16][8]) {
+    const uint32_t start_8x8_pos = 4 * start_16x16_pos;
+    const __m128i sad0 = _mm256_castsi256_si128(sad02);
+    const __m128i sad1 = _mm256_castsi256_si128(sad13);
+    const __m128i sad2 = _mm256_extracti128_si256(sad02, 1);
+    const __m128i sad3 = _mm256_extracti128_si256(sad13, 1);
+
+    const __m128i minpos0 = _mm_minpos_epu16(sad0);
+    const __m128i minpos1 = _mm_minpos_epu16(sad1);
+    const __m128i minpos2 = _mm_minpos_epu16(sad2);
+    const __m128i minpos3 = _mm_minpos_epu16(sad3);
+
+    const __m128i minpos01   = _mm_unpacklo_epi16(minpos0, minpos1);
+    const __m128i minpos23   = _mm_unpacklo_epi16(minpos2, minpos3);
+    const __m128i minpos0123 = _mm_unpacklo_epi32(minpos01, minpos23);
+    const __m128i sad8x8     = _mm_unpacklo_epi16(minpos0123, _mm_setzero_si128());
+    const __m128i pos8x8     = _mm_unpackhi_epi16(minpos0123, _mm_setzero_si128());
+
+    __m128i       best_sad8x8 = _mm_loadu_si128((__m128i *)(p_best_sad_8x8 + start_8x8_pos));
+    const __m128i mask        = _mm_cmplt_epi32(sad8x8, best_sad8x8);
+    best_sad8x8               = _mm_min_epi32(best_sad8x8, sad8x8);
+    _mm_storeu_si128((__m128i *)(p_best_sad_8x8 + start_8x8_pos), best_sad8x8);
+
+    const __m128i mvs        = _mm_set1_epi32(mv);
+    __m128i       best_mv8x8 = _mm_loadu_si128((__m128i *)(p_best_mv8x8 + start_8x8_pos));
+    const __m128i mv8x8      = _mm_add_epi16(mvs, pos8x8);
+    best_mv8x8               = _mm_blendv_epi8(best_mv8x8, mv8x8, mask);
+    _mm_storeu_si128((__m128i *)(p_best_mv8x8 + start_8x8_pos), best_mv8x8);
+    const __m128i sum01       = _mm_add_epi16(sad0, sad1);
+    const __m128i sum23       = _mm_add_epi16(sad2, sad3);
+    const __m128i sad16x16_16 = _mm_add_epi16(sum01, sum23);
+    const __m256i sad16x16_32 = _mm256_cvtepu16_epi32(sad16x16_16);
+    _mm256_storeu_si256((__m256i *)(p_eight_sad16x16[start_16x16_pos]), sad16x16_32);
+
+    const __m128i  minpos16x16 = _mm_minpos_epu16(sad16x16_16);
+    const uint32_t min16x16    = _mm_extract_epi16(minpos16x16, 0);
+
+    if (min16x16 < p_best_sad_16x16[start_16x16_pos]) {
+        p_best_sad_16x16[start_16x16_pos] = min16x16;
+
+        const __m128i pos16x16          = _mm_srli_si128(minpos16x16, 2);
+        const __m128i mv16x16           = _mm_add_epi16(mvs, pos16x16);
+        p_best_mv16x16[start_16x16_pos] = _mm_extract_epi32(mv16x16, 0);
+    }
+}
+
 void svt_ext_all_sad_calculation_8x8_16x16_avx2(uint8_t *src, uint32_t src_stride, uint8_t *ref, uint32_t ref_stride,
                                                 uint32_t mv, uint32_t *p_best_sad_8x8, uint32_t *p_best_sad_16x16,
                                                 uint32_t *p_best_mv8x8, uint32_t *p_best_mv16x16,
@@ -4214,7 +4265,6 @@ void svt_ext_all_sad_calculation_8x8_16x16_avx2(uint8_t *src, uint32_t src_strid
     for (int y = 0; y < 4; y++) {
         for (int x = 0; x < 4; x++) {
             const uint32_t start_16x16_pos = offsets[4 * y + x];
-            const uint32_t start_8x8_pos   = 4 * start_16x16_pos;
             const uint8_t *s               = src + 16 * y * src_stride + 16 * x;
             const uint8_t *r               = ref + 16 * y * ref_stride + 16 * x;
             __m256i        sad02           = _mm256_setzero_si256();
@@ -4262,47 +4312,83 @@ void svt_ext_all_sad_calculation_8x8_16x16_avx2(uint8_t *src, uint32_t src_strid
             }
 
             (void)p_eight_sad8x8;
-            const __m128i sad0 = _mm256_castsi256_si128(sad02);
-            const __m128i sad1 = _mm256_castsi256_si128(sad13);
-            const __m128i sad2 = _mm256_extracti128_si256(sad02, 1);
-            const __m128i sad3 = _mm256_extracti128_si256(sad13, 1);
-
-            const __m128i minpos0 = _mm_minpos_epu16(sad0);
-            const __m128i minpos1 = _mm_minpos_epu16(sad1);
-            const __m128i minpos2 = _mm_minpos_epu16(sad2);
-            const __m128i minpos3 = _mm_minpos_epu16(sad3);
-
-            const __m128i minpos01   = _mm_unpacklo_epi16(minpos0, minpos1);
-            const __m128i minpos23   = _mm_unpacklo_epi16(minpos2, minpos3);
-            const __m128i minpos0123 = _mm_unpacklo_epi32(minpos01, minpos23);
-            const __m128i sad8x8     = _mm_unpacklo_epi16(minpos0123, _mm_setzero_si128());
-            const __m128i pos8x8     = _mm_unpackhi_epi16(minpos0123, _mm_setzero_si128());
-
-            __m128i       best_sad8x8 = _mm_loadu_si128((__m128i *)(p_best_sad_8x8 + start_8x8_pos));
-            const __m128i mask        = _mm_cmplt_epi32(sad8x8, best_sad8x8);
-            best_sad8x8               = _mm_min_epi32(best_sad8x8, sad8x8);
-            _mm_storeu_si128((__m128i *)(p_best_sad_8x8 + start_8x8_pos), best_sad8x8);
-
-            const __m128i mvs        = _mm_set1_epi32(mv);
-            __m128i       best_mv8x8 = _mm_loadu_si128((__m128i *)(p_best_mv8x8 + start_8x8_pos));
-            const __m128i mv8x8      = _mm_add_epi16(mvs, pos8x8);
-            best_mv8x8               = _mm_blendv_epi8(best_mv8x8, mv8x8, mask);
-            _mm_storeu_si128((__m128i *)(p_best_mv8x8 + start_8x8_pos), best_mv8x8);
-            const __m128i sum01       = _mm_add_epi16(sad0, sad1);
-            const __m128i sum23       = _mm_add_epi16(sad2, sad3);
-            const __m128i sad16x16_16 = _mm_add_epi16(sum01, sum23);
-            const __m256i sad16x16_32 = _mm256_cvtepu16_epi32(sad16x16_16);
-            _mm256_storeu_si256((__m256i *)(p_eight_sad16x16[start_16x16_pos]), sad16x16_32);
-
-            const __m128i  minpos16x16 = _mm_minpos_epu16(sad16x16_16);
-            const uint32_t min16x16    = _mm_extract_epi16(minpos16x16, 0);
-
-            if (min16x16 < p_best_sad_16x16[start_16x16_pos]) {
-                p_best_sad_16x16[start_16x16_pos] = min16x16;
-
-                const __m128i pos16x16          = _mm_srli_si128(minpos16x16, 2);
-                const __m128i mv16x16           = _mm_add_epi16(mvs, pos16x16);
-                p_best_mv16x16[start_16x16_pos] = _mm_extract_epi32(mv16x16, 0);
+            eight_sad_update_8x8_16x16_avx2(sad02,
+                                            sad13,
+                                            mv,
+                                            start_16x16_pos,
+                                            p_best_sad_8x8,
+                                            p_best_sad_16x16,
+                                            p_best_mv8x8,
+                                            p_best_mv16x16,
+                                            p_eight_sad16x16);
+        }
+    }
+}
+
+
+/* SADs of the eight search positions of one 16x16 block against the source rows in src0123,
+   row i of the top 8x8 blocks in the low lane and row i of the bottom ones in the high lane */
+static INLINE void eight_sad_16x16_avx2(const __m256i *const src0123, const int rows, const uint8_t *r,
+                                        const uint32_t ref_stride, __m256i *const sad02, __m256i *const sad13) {
+    *sad02 = _mm256_setzero_si256();
+    *sad13 = _mm256_setzero_si256();
+    for (int i = 0; i < rows; i++) {
+        const __m128i ref0  = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 0));
+        const __m128i ref1  = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 8));
+        const __m128i ref2  = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 0));
+        const __m128i ref3  = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 8));
+        const __m256i ref02 = _mm256_insertf128_si256(_mm256_castsi128_si256(ref0), ref2, 1);
+        const __m256i ref13 = _mm256_insertf128_si256(_mm256_castsi128_si256(ref1), ref3, 1);
+        *sad02 = _mm256_adds_epu16(*sad02, _mm256_mpsadbw_epu8(ref02, src0123[i], 0)); // 000 000
+        *sad02 = _mm256_adds_epu16(*sad02, _mm256_mpsadbw_epu8(ref02, src0123[i], 45)); // 101 101
+        *sad13 = _mm256_adds_epu16(*sad13, _mm256_mpsadbw_epu8(ref13, src0123[i], 18)); // 010 010
+        *sad13 = _mm256_adds_epu16(*sad13, _mm256_mpsadbw_epu8(ref13, src0123[i], 63)); // 111 111
+        r += (rows == 4 ? 2 : 1) * ref_stride;
+    }
+}
+
+void svt_ext_all_sad_calculation_8x8_16x16_multi_avx2(uint8_t *src, uint32_t src_stride, MeSadRef *refs,
+                                                      uint32_t ref_count, Bool sub_sad) {
+    static const char offsets[16] = {0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15};
+    const int         rows        = sub_sad ? 4 : 8;
+    const uint32_t    src_step    = sub_sad ? 2 * src_stride : src_stride;
+
+    //---- 16x16 : 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            const uint32_t start_16x16_pos = offsets[4 * y + x];
+            const uint8_t *s               = src + 16 * y * src_stride + 16 * x;
+            __m256i        src0123[8];
+
+            // The source rows are loaded once and kept for all the references
+            for (int i = 0; i < rows; i++) {
+                const __m128i src01 = _mm_loadu_si128((__m128i *)(s + 0 * src_stride));
+                const __m128i src23 = _mm_loadu_si128((__m128i *)(s + 8 * src_stride));
+                src0123[i]          = _mm256_insertf128_si256(_mm256_castsi128_si256(src01), src23, 1);
+                s += src_step;
+            }
+
+            for (uint32_t ref_idx = 0; ref_idx < ref_count; ref_idx++) {
+                const MeSadRef *sad_ref = &refs[ref_idx];
+                const uint8_t  *r       = sad_ref->ref + 16 * y * sad_ref->ref_stride + 16 * x;
+                __m256i         sad02, sad13;
+
+                if (sub_sad) {
+                    eight_sad_16x16_avx2(src0123, 4, r, sad_ref->ref_stride, &sad02, &sad13);
+                    sad02 = _mm256_slli_epi16(sad02, 1);
+                    sad13 = _mm256_slli_epi16(sad13, 1);
+                } else
+                    eight_sad_16x16_avx2(src0123, 8, r, sad_ref->ref_stride, &sad02, &sad13);
+
+                eight_sad_update_8x8_16x16_avx2(sad02,
+                                                sad13,
+                                                sad_ref->mv,
+                                                start_16x16_pos,
+                                                sad_ref->p_best_sad_8x8,
+                                                sad_ref->p_best_sad_16x16,
+                                                sad_ref->p_best_mv8x8,
+                                                sad_ref->p_best_mv16x16,
+                                                sad_ref->p_eight_sad16x16);
             }
         }
     }
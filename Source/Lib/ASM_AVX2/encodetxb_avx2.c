@@ -17,6 +17,7 @@
 
 #include "cabac_context_model.h"
 #include "full_loop.h"
+#include "encode_txb_ref_c.h"
 
 static INLINE __m256i txb_init_levels_avx2(const TranLow *const coeff) {
     const __m256i idx   = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
@@ -796,6 +797,74 @@ void svt_av1_get_nz_map_contexts_avx2(const uint8_t *const levels, const int16_t
         coeff_contexts[pos] = 3;
 }
 
+int32_t svt_av1_cost_coeffs_txb_loop_avx2(const TranLow *const qcoeff, const int16_t *const scan,
+                                          const int8_t *const coeff_contexts, const uint8_t *const levels,
+                                          const struct LvMapCoeffCost *const coeff_costs, const int32_t c_start,
+                                          const int32_t bwl, const TxClass tx_class) {
+    const int32_t *const base_cost  = &coeff_costs->base_cost[0][0];
+    const __m256i        zero       = _mm256_setzero_si256();
+    const __m256i        num_base   = _mm256_set1_epi32(NUM_BASE_LEVELS);
+    const __m256i        max_base   = _mm256_set1_epi32(NUM_BASE_LEVELS + 1);
+    const __m256i        byte_mask  = _mm256_set1_epi32(0xff);
+    __m256i              cost_acc   = zero;
+    __m256i              zero_count = zero;
+    int32_t              cost       = 0;
+    int32_t              c          = 1;
+    DECLARE_ALIGNED(32, int32_t, pos_arr[8]);
+    DECLARE_ALIGNED(32, int32_t, level_arr[8]);
+
+    // Short runs are cheaper in scalar.
+    if (c_start < 16)
+        return svt_av1_cost_coeffs_txb_loop_c(qcoeff, scan, coeff_contexts, levels, coeff_costs, c_start, bwl, tx_class);
+
+    // Gather 8 coefficients at a time in scan order. The base level cost of each is looked up with
+    // a gather on base_cost[coeff_ctx][min(level, 3)]; the (rare) coefficients above
+    // NUM_BASE_LEVELS get their base-range and Golomb cost added in scalar.
+    for (; c + 8 <= c_start + 1; c += 8) {
+        const __m256i pos   = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(scan + c)));
+        const __m256i q     = _mm256_i32gather_epi32((const int *)qcoeff, pos, 4);
+        const __m256i level = _mm256_abs_epi32(q);
+        // coeff_contexts is int8; gather 32 bits at each position and keep the low byte.
+        const __m256i ctx = _mm256_and_si256(_mm256_i32gather_epi32((const int *)coeff_contexts, pos, 1),
+                                             byte_mask);
+        const __m256i idx = _mm256_add_epi32(_mm256_slli_epi32(ctx, 3), _mm256_min_epi32(level, max_base));
+        cost_acc          = _mm256_add_epi32(cost_acc, _mm256_i32gather_epi32(base_cost, idx, 4));
+        zero_count        = _mm256_sub_epi32(zero_count, _mm256_cmpeq_epi32(q, zero));
+        const int32_t br_mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(level, num_base)));
+        if (br_mask) {
+            _mm256_store_si256((__m256i *)pos_arr, pos);
+            _mm256_store_si256((__m256i *)level_arr, level);
+            for (int32_t i = 0; i < 8; i++) {
+                if (br_mask & (1 << i)) {
+                    const int32_t br_ctx = get_br_ctx(levels, pos_arr[i], bwl, tx_class);
+                    cost += get_br_golomb_cost(coeff_costs->lps_cost[br_ctx], level_arr[i]);
+                }
+            }
+        }
+    }
+
+    const __m128i sum4 = _mm_add_epi32(_mm256_castsi256_si128(cost_acc), _mm256_extracti128_si256(cost_acc, 1));
+    const __m128i cnt4 = _mm_add_epi32(_mm256_castsi256_si128(zero_count), _mm256_extracti128_si256(zero_count, 1));
+    const __m128i sum2 = _mm_hadd_epi32(sum4, cnt4);
+    const __m128i sum1 = _mm_hadd_epi32(sum2, sum2);
+    cost += _mm_cvtsi128_si32(sum1);
+    uint32_t cost_literal_cnt = (uint32_t)(c - 1 - _mm_extract_epi32(sum1, 1));
+
+    for (; c <= c_start; ++c) {
+        const int32_t pos   = scan[c];
+        const int32_t level = abs(qcoeff[pos]);
+        cost_literal_cnt += !!level;
+        if (level > NUM_BASE_LEVELS) {
+            const int32_t br_ctx = get_br_ctx(levels, pos, bwl, tx_class);
+            cost += coeff_costs->base_cost[coeff_contexts[pos]][3] +
+                get_br_golomb_cost(coeff_costs->lps_cost[br_ctx], level);
+        } else {
+            cost += coeff_costs->base_cost[coeff_contexts[pos]][level];
+        }
+    }
+    return cost + cost_literal_cnt * av1_cost_literal(1);
+}
+
 void svt_copy_mi_map_grid_avx2(ModeInfo **mi_grid_ptr, uint32_t mi_stride, uint8_t num_rows, uint8_t num_cols) {
     ModeInfo *target = mi_grid_ptr[0];
     if (num_cols == 1) {
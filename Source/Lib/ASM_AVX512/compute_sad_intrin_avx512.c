@@ -4733,4 +4733,104 @@ uint32_t svt_nxm_sad_kernel_helper_avx512(const uint8_t *src, uint32_t src_strid
     return nxm_sad;
 }
 
+/* SADs of the eight search positions of the top (rows 0 to 7) or bottom (rows 8 to 15) 8x8 blocks
+   of one 16x16 block. Lane k of a row broadcasts source bytes 4k to 4k+3, compared by vdbpsadbw to
+   the reference bytes 4k to 4k+11, so lane k gets the eight SADs of those four columns. */
+static INLINE __m512i eight_sad_16x8_avx512(const __m512i *const src, const int rows, const uint8_t *r,
+                                            const uint32_t ref_step) {
+    const __m512i ref_idx = _mm512_setr_epi32(0, 1, 2, 3, 1, 2, 3, 4, 2, 3, 4, 5, 3, 4, 5, 6);
+    __m512i       sum     = _mm512_setzero_si512();
+
+    for (int i = 0; i < rows; i++) {
+        // Only bytes 0 to 23 are used by the eight positions
+        const __m256i rr = _mm256_maskz_loadu_epi8(0x00FFFFFF, r);
+        const __m512i rk = _mm512_permutexvar_epi32(ref_idx, _mm512_castsi256_si512(rr));
+        sum              = _mm512_adds_epu16(sum, _mm512_dbsad_epu8(src[i], rk, 0x94));
+        r += ref_step;
+    }
+    // Lanes 0 and 2 get the SADs of the left and right 8x8 block
+    return _mm512_adds_epu16(sum, _mm512_shuffle_i64x2(sum, sum, 0xB1));
+}
+
+void svt_ext_all_sad_calculation_8x8_16x16_multi_avx512(uint8_t *src, uint32_t src_stride, MeSadRef *refs,
+                                                        uint32_t ref_count, Bool sub_sad) {
+    static const char offsets[16] = {0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15};
+    const __m512i     src_idx     = _mm512_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+    const int         rows        = sub_sad ? 4 : 8;
+    const uint32_t    src_step    = sub_sad ? 2 * src_stride : src_stride;
+
+    //---- 16x16 : 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            const uint32_t start_16x16_pos = offsets[4 * y + x];
+            const uint32_t start_8x8_pos   = 4 * start_16x16_pos;
+            const uint8_t *s               = src + 16 * y * src_stride + 16 * x;
+            __m512i        src_top[8], src_bottom[8];
+
+            // The source rows are loaded once and kept for all the references
+            for (int i = 0; i < rows; i++) {
+                const __m128i s_top    = _mm_loadu_si128((__m128i *)s);
+                const __m128i s_bottom = _mm_loadu_si128((__m128i *)(s + 8 * src_stride));
+                src_top[i]             = _mm512_permutexvar_epi32(src_idx, _mm512_castsi128_si512(s_top));
+                src_bottom[i]          = _mm512_permutexvar_epi32(src_idx, _mm512_castsi128_si512(s_bottom));
+                s += src_step;
+            }
+
+            for (uint32_t ref_idx = 0; ref_idx < ref_count; ref_idx++) {
+                const MeSadRef *sad_ref    = &refs[ref_idx];
+                const uint32_t  ref_stride = sad_ref->ref_stride;
+                const uint32_t  ref_step   = sub_sad ? 2 * ref_stride : ref_stride;
+                const uint8_t  *r          = sad_ref->ref + 16 * y * ref_stride + 16 * x;
+                const __m512i   sad_top    = eight_sad_16x8_avx512(src_top, rows, r, ref_step);
+                const __m512i   sad_bottom = eight_sad_16x8_avx512(src_bottom, rows, r + 8 * ref_stride, ref_step);
+                __m128i         sad0       = _mm512_castsi512_si128(sad_top);
+                __m128i         sad1       = _mm512_extracti32x4_epi32(sad_top, 2);
+                __m128i         sad2       = _mm512_castsi512_si128(sad_bottom);
+                __m128i         sad3       = _mm512_extracti32x4_epi32(sad_bottom, 2);
+                if (sub_sad) {
+                    sad0 = _mm_slli_epi16(sad0, 1);
+                    sad1 = _mm_slli_epi16(sad1, 1);
+                    sad2 = _mm_slli_epi16(sad2, 1);
+                    sad3 = _mm_slli_epi16(sad3, 1);
+                }
+
+                const __m128i minpos0 = _mm_minpos_epu16(sad0);
+                const __m128i minpos1 = _mm_minpos_epu16(sad1);
+                const __m128i minpos2 = _mm_minpos_epu16(sad2);
+                const __m128i minpos3 = _mm_minpos_epu16(sad3);
+
+                const __m128i minpos01   = _mm_unpacklo_epi16(minpos0, minpos1);
+                const __m128i minpos23   = _mm_unpacklo_epi16(minpos2, minpos3);
+                const __m128i minpos0123 = _mm_unpacklo_epi32(minpos01, minpos23);
+                const __m128i sad8x8     = _mm_unpacklo_epi16(minpos0123, _mm_setzero_si128());
+                const __m128i pos8x8     = _mm_unpackhi_epi16(minpos0123, _mm_setzero_si128());
+
+                __m128i best_sad8x8 = _mm_loadu_si128((__m128i *)(sad_ref->p_best_sad_8x8 + start_8x8_pos));
+                const __mmask8 mask = _mm_cmplt_epu32_mask(sad8x8, best_sad8x8);
+                best_sad8x8         = _mm_min_epu32(best_sad8x8, sad8x8);
+                _mm_storeu_si128((__m128i *)(sad_ref->p_best_sad_8x8 + start_8x8_pos), best_sad8x8);
+
+                const __m128i mvs = _mm_set1_epi32(sad_ref->mv);
+                _mm_mask_storeu_epi32(sad_ref->p_best_mv8x8 + start_8x8_pos, mask, _mm_add_epi16(mvs, pos8x8));
+
+                const __m128i sum01       = _mm_add_epi16(sad0, sad1);
+                const __m128i sum23       = _mm_add_epi16(sad2, sad3);
+                const __m128i sad16x16_16 = _mm_add_epi16(sum01, sum23);
+                _mm256_storeu_si256((__m256i *)(sad_ref->p_eight_sad16x16[start_16x16_pos]),
+                                    _mm256_cvtepu16_epi32(sad16x16_16));
+
+                const __m128i  minpos16x16 = _mm_minpos_epu16(sad16x16_16);
+                const uint32_t min16x16    = _mm_extract_epi16(minpos16x16, 0);
+
+                if (min16x16 < sad_ref->p_best_sad_16x16[start_16x16_pos]) {
+                    sad_ref->p_best_sad_16x16[start_16x16_pos] = min16x16;
+
+                    const __m128i mv16x16 = _mm_add_epi16(mvs, _mm_srli_si128(minpos16x16, 2));
+                    sad_ref->p_best_mv16x16[start_16x16_pos] = _mm_extract_epi32(mv16x16, 0);
+                }
+            }
+        }
+    }
+}
+
 #endif // EN_AVX512_SUPPORT
@@ -16,6 +16,9 @@
 #include <immintrin.h> /* AVX2 */
 #include "synonyms.h"
 #include "synonyms_avx2.h"
+#include "common_utils.h"
+#include "md_rate_estimation.h"
+#include "encode_txb_ref_c.h"
 
 static INLINE __m256i txb_init_levels_32_avx512(const TranLow *const coeff) {
     const __m512i idx   = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 0, 0, 0, 0, 0, 0, 0, 0);
@@ -147,4 +150,52 @@ void svt_av1_txb_init_levels_avx512(const TranLow *const coeff, const int32_t wi
         xx_storeu_128(ls + 2 * 64, x_zeros);
     }
 }
+int32_t svt_av1_cost_coeffs_txb_loop_avx512(const TranLow *const qcoeff, const int16_t *const scan,
+                                            const int8_t *const coeff_contexts, const uint8_t *const levels,
+                                            const struct LvMapCoeffCost *const coeff_costs, const int32_t c_start,
+                                            const int32_t bwl, const TxClass tx_class) {
+    const int32_t *const base_cost = &coeff_costs->base_cost[0][0];
+    const __m512i        zero      = _mm512_setzero_si512();
+    const __m512i        num_base  = _mm512_set1_epi32(NUM_BASE_LEVELS);
+    const __m512i        max_base  = _mm512_set1_epi32(NUM_BASE_LEVELS + 1);
+    const __m512i        byte_mask = _mm512_set1_epi32(0xff);
+    const __m512i        one       = _mm512_set1_epi32(1);
+    __m512i              cost_acc  = zero;
+    __m512i              nz_acc    = zero;
+    int32_t              cost      = 0;
+    DECLARE_ALIGNED(64, int32_t, pos_arr[16]);
+    DECLARE_ALIGNED(64, int32_t, level_arr[16]);
+
+    // Same as the AVX2 version with 16 coefficients per iteration; the tail is handled with masked
+    // loads and gathers. Short runs are cheaper in scalar.
+    if (c_start < 16)
+        return svt_av1_cost_coeffs_txb_loop_c(qcoeff, scan, coeff_contexts, levels, coeff_costs, c_start, bwl, tx_class);
+    for (int32_t c = 1; c <= c_start; c += 16) {
+        const int32_t   n     = AOMMIN(16, c_start + 1 - c);
+        const __mmask16 valid = (__mmask16)((1u << n) - 1);
+        const __m512i   pos   = _mm512_cvtepi16_epi32(_mm256_maskz_loadu_epi16(valid, scan + c));
+        const __m512i   q     = _mm512_mask_i32gather_epi32(zero, valid, pos, qcoeff, 4);
+        const __m512i   level = _mm512_abs_epi32(q);
+        // coeff_contexts is int8; gather 32 bits at each position and keep the low byte.
+        const __m512i ctx = _mm512_and_si512(_mm512_mask_i32gather_epi32(zero, valid, pos, coeff_contexts, 1),
+                                             byte_mask);
+        const __m512i idx = _mm512_add_epi32(_mm512_slli_epi32(ctx, 3), _mm512_min_epi32(level, max_base));
+        cost_acc          = _mm512_add_epi32(cost_acc, _mm512_mask_i32gather_epi32(zero, valid, idx, base_cost, 4));
+        nz_acc            = _mm512_mask_add_epi32(nz_acc, _mm512_mask_cmpneq_epi32_mask(valid, q, zero), nz_acc, one);
+        const __mmask16 br_mask = _mm512_cmpgt_epi32_mask(level, num_base);
+        if (br_mask) {
+            _mm512_store_si512((__m512i *)pos_arr, pos);
+            _mm512_store_si512((__m512i *)level_arr, level);
+            for (int32_t i = 0; i < 16; i++) {
+                if (br_mask & (1 << i)) {
+                    const int32_t br_ctx = get_br_ctx(levels, pos_arr[i], bwl, tx_class);
+                    cost += get_br_golomb_cost(coeff_costs->lps_cost[br_ctx], level_arr[i]);
+                }
+            }
+        }
+    }
+    cost += _mm512_reduce_add_epi32(cost_acc);
+    return cost + (uint32_t)_mm512_reduce_add_epi32(nz_acc) * av1_cost_literal(1);
+}
+
 #endif // EN_AVX512_SUPPORT
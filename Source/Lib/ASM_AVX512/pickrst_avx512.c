@@ -3383,4 +3383,127 @@ int64_t svt_av1_lowbd_pixel_proj_error_avx512(const uint8_t *src8, int32_t width
     return err + _mm_cvtsi128_si64(hadd_64_avx2(sum_256));
 }
 
+static INLINE __mmask32 proj_error_mask(const int32_t remaining) {
+    return remaining >= 32 ? (__mmask32)0xffffffff : (__mmask32)((1u << remaining) - 1);
+}
+
+// The last columns of each row are loaded with a mask instead of being handled
+// in C: masked out lanes read as zero, so their error is zero as well.
+int64_t svt_av1_highbd_pixel_proj_error_avx512(const uint8_t *src8, int32_t width, int32_t height, int32_t src_stride,
+                                               const uint8_t *dat8, int32_t dat_stride, int32_t *flt0,
+                                               int32_t flt0_stride, int32_t *flt1, int32_t flt1_stride, int32_t xq[2],
+                                               const SgrParamsType *params) {
+    const int32_t   shift     = SGRPROJ_RST_BITS + SGRPROJ_PRJ_BITS;
+    const uint16_t *src       = CONVERT_TO_SHORTPTR(src8);
+    const uint16_t *dat       = CONVERT_TO_SHORTPTR(dat8);
+    int32_t         y         = height;
+    int32_t         j;
+    const __m512i   rounding  = _mm512_set1_epi32(1 << (shift - 1));
+    const __m512i   idx       = _mm512_setr_epi32(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+    __m512i         sum64_512 = _mm512_setzero_si512();
+
+    if (params->r[0] > 0 && params->r[1] > 0) {
+        const __m512i xq0 = _mm512_set1_epi32(xq[0]);
+        const __m512i xq1 = _mm512_set1_epi32(xq[1]);
+
+        do {
+            __m512i sum_512 = _mm512_setzero_si512();
+
+            for (j = 0; j < width; j += 32) {
+                const __mmask32 mask  = proj_error_mask(width - j);
+                const __mmask16 mask0 = (__mmask16)mask;
+                const __mmask16 mask1 = (__mmask16)(mask >> 16);
+                const __m512i   s_512 = _mm512_maskz_loadu_epi16(mask, src + j);
+                const __m512i   d_512 = _mm512_maskz_loadu_epi16(mask, dat + j);
+                // The filtered values do not fit in 16 bits at 12-bit, so the
+                // projection is done on 32-bit lanes before packing the result.
+                const __m512i u_512 = _mm512_slli_epi16(d_512, SGRPROJ_RST_BITS);
+                const __m512i u0    = _mm512_cvtepu16_epi32(_mm512_castsi512_si256(u_512));
+                const __m512i u1    = _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(u_512, 1));
+                const __m512i v0    = _mm512_add_epi32(
+                    _mm512_mullo_epi32(xq0, _mm512_sub_epi32(_mm512_maskz_loadu_epi32(mask0, flt0 + j), u0)),
+                    _mm512_mullo_epi32(xq1, _mm512_sub_epi32(_mm512_maskz_loadu_epi32(mask0, flt1 + j), u0)));
+                const __m512i v1 = _mm512_add_epi32(
+                    _mm512_mullo_epi32(xq0, _mm512_sub_epi32(_mm512_maskz_loadu_epi32(mask1, flt0 + j + 16), u1)),
+                    _mm512_mullo_epi32(xq1, _mm512_sub_epi32(_mm512_maskz_loadu_epi32(mask1, flt1 + j + 16), u1)));
+                const __m512i vr0  = _mm512_srai_epi32(_mm512_add_epi32(v0, rounding), shift);
+                const __m512i vr1  = _mm512_srai_epi32(_mm512_add_epi32(v1, rounding), shift);
+                const __m512i vr   = _mm512_permutexvar_epi32(idx, _mm512_packs_epi32(vr0, vr1));
+                const __m512i e0   = _mm512_sub_epi16(_mm512_add_epi16(vr, d_512), s_512);
+                const __m512i err0 = _mm512_madd_epi16(e0, e0);
+                sum_512            = _mm512_add_epi32(sum_512, err0);
+            }
+
+            dat += dat_stride;
+            src += src_stride;
+            flt0 += flt0_stride;
+            flt1 += flt1_stride;
+            const __m512i sum0_512 = _mm512_cvtepu32_epi64(_mm512_castsi512_si256(sum_512));
+            const __m512i sum1_512 = _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(sum_512, 1));
+            sum64_512              = _mm512_add_epi64(sum64_512, sum0_512);
+            sum64_512              = _mm512_add_epi64(sum64_512, sum1_512);
+        } while (--y);
+    } else if (params->r[0] > 0 || params->r[1] > 0) {
+        const int32_t  xq_on       = (params->r[0] > 0) ? xq[0] : xq[1];
+        const __m512i  xq_active   = _mm512_set1_epi32(xq_on);
+        const __m512i  xq_inactive = _mm512_set1_epi32(-xq_on * (1 << SGRPROJ_RST_BITS));
+        const int32_t *flt         = (params->r[0] > 0) ? flt0 : flt1;
+        const int32_t  flt_stride  = (params->r[0] > 0) ? flt0_stride : flt1_stride;
+
+        do {
+            __m512i sum_512 = _mm512_setzero_si512();
+
+            for (j = 0; j < width; j += 32) {
+                const __mmask32 mask  = proj_error_mask(width - j);
+                const __m512i   s_512 = _mm512_maskz_loadu_epi16(mask, src + j);
+                const __m512i   d_512 = _mm512_maskz_loadu_epi16(mask, dat + j);
+                const __m512i   d0    = _mm512_cvtepu16_epi32(_mm512_castsi512_si256(d_512));
+                const __m512i   d1    = _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(d_512, 1));
+                const __m512i   flt_0 = _mm512_maskz_loadu_epi32((__mmask16)mask, flt + j);
+                const __m512i   flt_1 = _mm512_maskz_loadu_epi32((__mmask16)(mask >> 16), flt + j + 16);
+                const __m512i   v0    = _mm512_add_epi32(_mm512_mullo_epi32(flt_0, xq_active),
+                                                         _mm512_mullo_epi32(d0, xq_inactive));
+                const __m512i   v1    = _mm512_add_epi32(_mm512_mullo_epi32(flt_1, xq_active),
+                                                         _mm512_mullo_epi32(d1, xq_inactive));
+                const __m512i   vr0   = _mm512_srai_epi32(_mm512_add_epi32(v0, rounding), shift);
+                const __m512i   vr1   = _mm512_srai_epi32(_mm512_add_epi32(v1, rounding), shift);
+                const __m512i   vr    = _mm512_permutexvar_epi32(idx, _mm512_packs_epi32(vr0, vr1));
+                const __m512i   e0    = _mm512_sub_epi16(_mm512_add_epi16(vr, d_512), s_512);
+                const __m512i   err0  = _mm512_madd_epi16(e0, e0);
+                sum_512               = _mm512_add_epi32(sum_512, err0);
+            }
+
+            dat += dat_stride;
+            src += src_stride;
+            flt += flt_stride;
+            const __m512i sum0_512 = _mm512_cvtepu32_epi64(_mm512_castsi512_si256(sum_512));
+            const __m512i sum1_512 = _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(sum_512, 1));
+            sum64_512              = _mm512_add_epi64(sum64_512, sum0_512);
+            sum64_512              = _mm512_add_epi64(sum64_512, sum1_512);
+        } while (--y);
+    } else {
+        do {
+            __m512i sum_512 = _mm512_setzero_si512();
+
+            for (j = 0; j < width; j += 32) {
+                const __mmask32 mask = proj_error_mask(width - j);
+                const __m512i   diff = _mm512_sub_epi16(_mm512_maskz_loadu_epi16(mask, dat + j),
+                                                        _mm512_maskz_loadu_epi16(mask, src + j));
+                sum_512              = _mm512_add_epi32(sum_512, _mm512_madd_epi16(diff, diff));
+            }
+
+            dat += dat_stride;
+            src += src_stride;
+            const __m512i sum0_512 = _mm512_cvtepu32_epi64(_mm512_castsi512_si256(sum_512));
+            const __m512i sum1_512 = _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(sum_512, 1));
+            sum64_512              = _mm512_add_epi64(sum64_512, sum0_512);
+            sum64_512              = _mm512_add_epi64(sum64_512, sum1_512);
+        } while (--y);
+    }
+
+    const __m256i sum_256 = _mm256_add_epi64(_mm512_castsi512_si256(sum64_512),
+                                             _mm512_extracti64x4_epi64(sum64_512, 1));
+    return _mm_cvtsi128_si64(hadd_64_avx2(sum_256));
+}
+
 #endif // EN_AVX512_SUPPORT
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2024, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include "definitions.h"
+
+#if EN_AVX512_SUPPORT
+
+#include <immintrin.h>
+#include <math.h>
+#include "aom_dsp_rtcd.h"
+#include "restoration.h"
+#include "synonyms.h"
+#include "synonyms_avx2.h"
+#include "synonyms_avx512.h"
+#include "pickrst_avx2.h"
+
+static INLINE int64_t hadd64_avx512(const __m512i src) {
+    const __m256i sum = _mm256_add_epi64(_mm512_castsi512_si256(src), _mm512_extracti64x4_epi64(src, 1));
+    return _mm_cvtsi128_si64(hadd_64_avx2(sum));
+}
+
+// Widen the 32-bit sums of one row and add them to the 64-bit accumulator.
+static INLINE __m512i add_row_sum_avx512(const __m512i sum64, const __m512i sum32) {
+    const __m512i sum0 = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(sum32));
+    const __m512i sum1 = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(sum32, 1));
+    return _mm512_add_epi64(sum64, _mm512_add_epi64(sum0, sum1));
+}
+
+// Multiply the signed 32-bit lanes of a and b and add the 64-bit products to sum.
+static INLINE __m512i madd_epi32_epi64_avx512(const __m512i sum, const __m512i a, const __m512i b) {
+    const __m512i even = _mm512_mul_epi32(a, b);
+    const __m512i odd  = _mm512_mul_epi32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+    return _mm512_add_epi64(sum, _mm512_add_epi64(even, odd));
+}
+
+static INLINE __m512i load_flt_16b_avx512(const int32_t *const flt, const __m512i idx) {
+    const __m512i flt_0 = zz_loadu_512(flt);
+    const __m512i flt_1 = zz_loadu_512(flt + 16);
+    return _mm512_permutexvar_epi32(idx, _mm512_packs_epi32(flt_0, flt_1));
+}
+
+/* All the sums are accumulated as exact integers, so H and C end up identical
+ * to the double accumulation of the C version. */
+void svt_get_proj_subspace_avx512(const uint8_t *src8, int width, int height, int src_stride, const uint8_t *dat8,
+                                  int dat_stride, int use_highbitdepth, int32_t *flt0, int flt0_stride, int32_t *flt1,
+                                  int flt1_stride, int *xq, const SgrParamsType *params) {
+    double    H[2][2] = {{0, 0}, {0, 0}};
+    double    C[2]    = {0, 0};
+    double    det;
+    double    x[2];
+    const int size = width * height;
+
+    aom_clear_system_state();
+    RunEmms();
+
+    // Default
+    xq[0] = 0;
+    xq[1] = 0;
+
+    __m512i h_00 = _mm512_setzero_si512();
+    __m512i h_01 = _mm512_setzero_si512();
+    __m512i h_11 = _mm512_setzero_si512();
+    __m512i c_0  = _mm512_setzero_si512();
+    __m512i c_1  = _mm512_setzero_si512();
+
+    if (!use_highbitdepth) {
+        // At 8-bit f1, f2 and s fit in 16 bits: use madd and widen the sums once per row.
+        const __m512i  idx  = _mm512_setr_epi32(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+        const __m512i  zero = _mm512_setzero_si512();
+        const uint8_t *src  = src8;
+        const uint8_t *dat  = dat8;
+        for (int i = 0; i < height; ++i) {
+            __m512i h_00_32 = _mm512_setzero_si512();
+            __m512i h_01_32 = _mm512_setzero_si512();
+            __m512i h_11_32 = _mm512_setzero_si512();
+            __m512i c_0_32  = _mm512_setzero_si512();
+            __m512i c_1_32  = _mm512_setzero_si512();
+            int     j       = 0;
+            for (; j <= width - 32; j += 32) {
+                __m512i f1, f2;
+                __m512i u = _mm512_cvtepu8_epi16(yy_loadu_256(dat + i * dat_stride + j));
+                __m512i s = _mm512_cvtepu8_epi16(yy_loadu_256(src + i * src_stride + j));
+                u         = _mm512_slli_epi16(u, SGRPROJ_RST_BITS);
+                s         = _mm512_sub_epi16(_mm512_slli_epi16(s, SGRPROJ_RST_BITS), u);
+
+                if (params->r[0] > 0)
+                    f1 = _mm512_sub_epi16(load_flt_16b_avx512(flt0 + i * flt0_stride + j, idx), u);
+                else
+                    f1 = zero;
+                if (params->r[1] > 0)
+                    f2 = _mm512_sub_epi16(load_flt_16b_avx512(flt1 + i * flt1_stride + j, idx), u);
+                else
+                    f2 = zero;
+                h_00_32 = _mm512_add_epi32(h_00_32, _mm512_madd_epi16(f1, f1));
+                h_11_32 = _mm512_add_epi32(h_11_32, _mm512_madd_epi16(f2, f2));
+                h_01_32 = _mm512_add_epi32(h_01_32, _mm512_madd_epi16(f1, f2));
+                c_0_32  = _mm512_add_epi32(c_0_32, _mm512_madd_epi16(f1, s));
+                c_1_32  = _mm512_add_epi32(c_1_32, _mm512_madd_epi16(f2, s));
+            }
+
+            //Complement when width not divided by 32
+            for (; j < width; ++j) {
+                const double u  = (double)(dat[i * dat_stride + j] << SGRPROJ_RST_BITS);
+                const double s  = (double)(src[i * src_stride + j] << SGRPROJ_RST_BITS) - u;
+                const double f1 = (params->r[0] > 0) ? (double)flt0[i * flt0_stride + j] - u : 0;
+                const double f2 = (params->r[1] > 0) ? (double)flt1[i * flt1_stride + j] - u : 0;
+                H[0][0] += f1 * f1;
+                H[1][1] += f2 * f2;
+                H[0][1] += f1 * f2;
+                C[0] += f1 * s;
+                C[1] += f2 * s;
+            }
+
+            h_00 = add_row_sum_avx512(h_00, h_00_32);
+            h_01 = add_row_sum_avx512(h_01, h_01_32);
+            h_11 = add_row_sum_avx512(h_11, h_11_32);
+            c_0  = add_row_sum_avx512(c_0, c_0_32);
+            c_1  = add_row_sum_avx512(c_1, c_1_32);
+        }
+    } else {
+        // At 12-bit the products do not fit in 32 bits: multiply into 64-bit lanes.
+        const __m512i   zero = _mm512_setzero_si512();
+        const uint16_t *src  = CONVERT_TO_SHORTPTR(src8);
+        const uint16_t *dat  = CONVERT_TO_SHORTPTR(dat8);
+        for (int i = 0; i < height; ++i) {
+            int j = 0;
+            for (; j <= width - 16; j += 16) {
+                __m512i f1, f2;
+                __m512i u = _mm512_cvtepu16_epi32(yy_loadu_256(dat + i * dat_stride + j));
+                __m512i s = _mm512_cvtepu16_epi32(yy_loadu_256(src + i * src_stride + j));
+                u         = _mm512_slli_epi32(u, SGRPROJ_RST_BITS);
+                s         = _mm512_sub_epi32(_mm512_slli_epi32(s, SGRPROJ_RST_BITS), u);
+
+                if (params->r[0] > 0)
+                    f1 = _mm512_sub_epi32(zz_loadu_512(flt0 + i * flt0_stride + j), u);
+                else
+                    f1 = zero;
+                if (params->r[1] > 0)
+                    f2 = _mm512_sub_epi32(zz_loadu_512(flt1 + i * flt1_stride + j), u);
+                else
+                    f2 = zero;
+                h_00 = madd_epi32_epi64_avx512(h_00, f1, f1);
+                h_11 = madd_epi32_epi64_avx512(h_11, f2, f2);
+                h_01 = madd_epi32_epi64_avx512(h_01, f1, f2);
+                c_0  = madd_epi32_epi64_avx512(c_0, f1, s);
+                c_1  = madd_epi32_epi64_avx512(c_1, f2, s);
+            }
+
+            //Complement when width not divided by 16
+            for (; j < width; ++j) {
+                const double u  = (double)(dat[i * dat_stride + j] << SGRPROJ_RST_BITS);
+                const double s  = (double)(src[i * src_stride + j] << SGRPROJ_RST_BITS) - u;
+                const double f1 = (params->r[0] > 0) ? (double)flt0[i * flt0_stride + j] - u : 0;
+                const double f2 = (params->r[1] > 0) ? (double)flt1[i * flt1_stride + j] - u : 0;
+                H[0][0] += f1 * f1;
+                H[1][1] += f2 * f2;
+                H[0][1] += f1 * f2;
+                C[0] += f1 * s;
+                C[1] += f2 * s;
+            }
+        }
+    }
+
+    H[0][0] += (double)hadd64_avx512(h_00);
+    H[0][1] += (double)hadd64_avx512(h_01);
+    H[1][1] += (double)hadd64_avx512(h_11);
+    C[0] += (double)hadd64_avx512(c_0);
+    C[1] += (double)hadd64_avx512(c_1);
+
+    H[0][0] /= size;
+    H[0][1] /= size;
+    H[1][1] /= size;
+    H[1][0] = H[0][1];
+    C[0] /= size;
+    C[1] /= size;
+    if (params->r[0] == 0) {
+        // H matrix is now only the scalar H[1][1]
+        // C vector is now only the scalar C[1]
+        det = H[1][1];
+        if (det < 1e-8)
+            return; // ill-posed, return default values
+        x[0] = 0;
+        x[1] = C[1] / det;
+
+        xq[0] = 0;
+        xq[1] = (int)rint(x[1] * (1 << SGRPROJ_PRJ_BITS));
+    } else if (params->r[1] == 0) {
+        // H matrix is now only the scalar H[0][0]
+        // C vector is now only the scalar C[0]
+        det = H[0][0];
+        if (det < 1e-8)
+            return; // ill-posed, return default values
+        x[0] = C[0] / det;
+        x[1] = 0;
+
+        xq[0] = (int)rint(x[0] * (1 << SGRPROJ_PRJ_BITS));
+        xq[1] = 0;
+    } else {
+        det = (H[0][0] * H[1][1] - H[0][1] * H[1][0]);
+        if (det < 1e-8)
+            return; // ill-posed, return default values
+        x[0] = (H[1][1] * C[0] - H[0][1] * C[1]) / det;
+        x[1] = (H[0][0] * C[1] - H[1][0] * C[0]) / det;
+
+        xq[0] = (int)rint(x[0] * (1 << SGRPROJ_PRJ_BITS));
+        xq[1] = (int)rint(x[1] * (1 << SGRPROJ_PRJ_BITS));
+    }
+}
+
+#endif // EN_AVX512_SUPPORT
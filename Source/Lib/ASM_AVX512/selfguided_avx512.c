@@ -0,0 +1,460 @@
+/*
+ * Copyright (c) 2024, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include "definitions.h"
+
+#if EN_AVX512_SUPPORT
+
+#include <immintrin.h>
+#include "common_dsp_rtcd.h"
+#include "restoration.h"
+
+// The AVX2 version works on 8x8 transposed blocks and rounds every row up to a
+// multiple of 8. Here every row is processed 16 pixels at a time and the last
+// columns are handled with masked loads and stores, so nothing is read or
+// written outside of the processing unit.
+static INLINE __mmask16 tail_mask(const int32_t remaining) {
+    return remaining >= 16 ? (__mmask16)0xffff : (__mmask16)((1u << remaining) - 1);
+}
+
+// Inclusive prefix sum of the 16 lanes of x.
+static INLINE __m512i prefix_sum_epi32(__m512i x) {
+    const __m512i zero = _mm512_setzero_si512();
+    x                  = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 15));
+    x                  = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 14));
+    x                  = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 12));
+    x                  = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 8));
+    return x;
+}
+
+static INLINE void integral_images_row(const __m512i src, const __mmask16 mask, __m512i *const c_left,
+                                       __m512i *const d_left, int32_t *const ct, int32_t *const dt,
+                                       const int32_t buf_stride) {
+    const __m512i last = _mm512_set1_epi32(15);
+    const __m512i d    = _mm512_add_epi32(prefix_sum_epi32(src), *d_left);
+    // src is below 2^12, so madd squares it exactly.
+    const __m512i c = _mm512_add_epi32(prefix_sum_epi32(_mm512_madd_epi16(src, src)), *c_left);
+
+    *d_left = _mm512_permutexvar_epi32(last, d);
+    *c_left = _mm512_permutexvar_epi32(last, c);
+    _mm512_mask_storeu_epi32(dt, mask, _mm512_add_epi32(d, _mm512_maskz_loadu_epi32(mask, dt - buf_stride)));
+    _mm512_mask_storeu_epi32(ct, mask, _mm512_add_epi32(c, _mm512_maskz_loadu_epi32(mask, ct - buf_stride)));
+}
+
+// Compute the integral images C (sums of squares) and D (sums) of the
+// width x height block at src. The first row and the first column of C and D
+// are zero.
+static AOM_FORCE_INLINE void integral_images(const uint8_t *src, int32_t src_stride, int32_t width, int32_t height,
+                                             int32_t *C, int32_t *D, int32_t buf_stride, int32_t highbd) {
+    int32_t *ct = C + buf_stride + 1;
+    int32_t *dt = D + buf_stride + 1;
+
+    memset(C, 0, sizeof(*C) * (width + 1));
+    memset(D, 0, sizeof(*D) * (width + 1));
+
+    for (int32_t y = 0; y < height; ++y) {
+        __m512i c_left = _mm512_setzero_si512();
+        __m512i d_left = _mm512_setzero_si512();
+
+        // zero the left column.
+        ct[-1] = dt[-1] = 0;
+
+        if (highbd) {
+            const uint16_t *src16 = CONVERT_TO_SHORTPTR(src);
+            for (int32_t x = 0; x < width; x += 16) {
+                const __mmask16 mask = tail_mask(width - x);
+                const __m512i   s    = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(mask, src16 + x));
+                integral_images_row(s, mask, &c_left, &d_left, ct + x, dt + x, buf_stride);
+            }
+        } else {
+            for (int32_t x = 0; x < width; x += 16) {
+                const __mmask16 mask = tail_mask(width - x);
+                const __m512i   s    = _mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(mask, src + x));
+                integral_images_row(s, mask, &c_left, &d_left, ct + x, dt + x, buf_stride);
+            }
+        }
+
+        src += src_stride;
+        ct += buf_stride;
+        dt += buf_stride;
+    }
+}
+
+// Compute 16 values of boxsum from the given integral image. ii should point
+// at the middle of the box (for the first value). r is the box radius.
+static INLINE __m512i boxsum_from_ii(const int32_t *ii, int32_t stride, int32_t r, __mmask16 mask) {
+    const __m512i tl = _mm512_maskz_loadu_epi32(mask, ii - (r + 1) - (r + 1) * stride);
+    const __m512i tr = _mm512_maskz_loadu_epi32(mask, ii + (r + 0) - (r + 1) * stride);
+    const __m512i bl = _mm512_maskz_loadu_epi32(mask, ii - (r + 1) + r * stride);
+    const __m512i br = _mm512_maskz_loadu_epi32(mask, ii + (r + 0) + r * stride);
+    const __m512i u  = _mm512_sub_epi32(tr, tl);
+    const __m512i v  = _mm512_sub_epi32(br, bl);
+    return _mm512_sub_epi32(v, u);
+}
+
+static INLINE __m512i round_for_shift(unsigned shift) { return _mm512_set1_epi32((1 << shift) >> 1); }
+
+static INLINE __m512i compute_p(__m512i sum1, __m512i sum2, int32_t bit_depth, int32_t n) {
+    if (bit_depth == 8) {
+        const __m512i bb = _mm512_madd_epi16(sum1, sum1);
+        const __m512i an = _mm512_mullo_epi32(sum2, _mm512_set1_epi32(n));
+        return _mm512_sub_epi32(an, bb);
+    }
+    const __m512i rounding_a = round_for_shift(2 * (bit_depth - 8));
+    const __m512i rounding_b = round_for_shift(bit_depth - 8);
+    const __m128i shift_a    = _mm_cvtsi32_si128(2 * (bit_depth - 8));
+    const __m128i shift_b    = _mm_cvtsi32_si128(bit_depth - 8);
+    const __m512i a          = _mm512_srl_epi32(_mm512_add_epi32(sum2, rounding_a), shift_a);
+    const __m512i b          = _mm512_srl_epi32(_mm512_add_epi32(sum1, rounding_b), shift_b);
+    // b < 2^14, so we can use a 16-bit madd rather than a 32-bit
+    // mullo to square it
+    const __m512i bb = _mm512_madd_epi16(b, b);
+    const __m512i an = _mm512_max_epi32(_mm512_mullo_epi32(a, _mm512_set1_epi32(n)), bb);
+    return _mm512_sub_epi32(an, bb);
+}
+
+// Assumes that C, D are integral images for the original buffer which has been
+// extended to have a padding of SGRPROJ_BORDER_VERT/SGRPROJ_BORDER_HORZ pixels
+// on the sides. A, b, C, D point at logical position (0, 0). The fast variant
+// of the filter only needs every other row (row_step 2).
+static AOM_FORCE_INLINE void calc_ab(int32_t *A, int32_t *b, const int32_t *C, const int32_t *D, int32_t width,
+                                     int32_t height, int32_t buf_stride, int32_t bit_depth, int32_t sgr_params_idx,
+                                     int32_t radius_idx, int32_t row_step) {
+    const SgrParamsType *const params = &svt_aom_eb_sgr_params[sgr_params_idx];
+    const int32_t              r      = params->r[radius_idx];
+    const int32_t              n      = (2 * r + 1) * (2 * r + 1);
+    const __m512i              s      = _mm512_set1_epi32(params->s[radius_idx]);
+    // one_over_n[n-1] is 2^12/n, so easily fits in an int16
+    const __m512i one_over_n = _mm512_set1_epi32(svt_aom_eb_one_by_x[n - 1]);
+    const __m512i rnd_z      = round_for_shift(SGRPROJ_MTABLE_BITS);
+    const __m512i rnd_res    = round_for_shift(SGRPROJ_RECIP_BITS);
+    const __m512i max_z      = _mm512_set1_epi32(255);
+    const __m512i sgr        = _mm512_set1_epi32(SGRPROJ_SGR);
+
+    A -= buf_stride + 1;
+    b -= buf_stride + 1;
+    C -= buf_stride + 1;
+    D -= buf_stride + 1;
+
+    for (int32_t i = 0; i < height + 2; i += row_step) {
+        for (int32_t j = 0; j < width + 2; j += 16) {
+            const __mmask16 mask = tail_mask(width + 2 - j);
+            const __m512i   sum1 = boxsum_from_ii(D + j, buf_stride, r, mask);
+            const __m512i   sum2 = boxsum_from_ii(C + j, buf_stride, r, mask);
+            const __m512i   p    = compute_p(sum1, sum2, bit_depth, n);
+            const __m512i   z    = _mm512_min_epi32(
+                _mm512_srli_epi32(_mm512_add_epi32(_mm512_mullo_epi32(p, s), rnd_z), SGRPROJ_MTABLE_BITS), max_z);
+            const __m512i a_res = _mm512_i32gather_epi32(z, svt_aom_eb_x_by_xplus1, 4);
+            _mm512_mask_storeu_epi32(A + j, mask, a_res);
+
+            const __m512i a_complement = _mm512_sub_epi32(sgr, a_res);
+
+            // sum1 might have lanes greater than 2^15, so we can't use madd to do
+            // multiplication involving sum1. However, a_complement and one_over_n
+            // are both less than 256, so we can multiply them first.
+            const __m512i a_comp_over_n = _mm512_madd_epi16(a_complement, one_over_n);
+            const __m512i b_int         = _mm512_mullo_epi32(a_comp_over_n, sum1);
+            const __m512i b_res = _mm512_srli_epi32(_mm512_add_epi32(b_int, rnd_res), SGRPROJ_RECIP_BITS);
+            _mm512_mask_storeu_epi32(b + j, mask, b_res);
+        }
+
+        A += row_step * buf_stride;
+        b += row_step * buf_stride;
+        C += row_step * buf_stride;
+        D += row_step * buf_stride;
+    }
+}
+
+// Calculate 16 values of the "cross sum" starting at buf. This is a 3x3 filter
+// where the outer four corners have weight 3 and all other pixels have weight
+// 4.
+//
+// Pixels are indexed as follows:
+// xtl  xt   xtr
+// xl    x   xr
+// xbl  xb   xbr
+//
+// buf points to x
+//
+// fours = xl + xt + xr + xb + x
+// threes = xtl + xtr + xbr + xbl
+// cross_sum = 4 * fours + 3 * threes
+//           = 4 * (fours + threes) - threes
+//           = (fours + threes) << 2 - threes
+static INLINE __m512i cross_sum(const int32_t *buf, int32_t stride, __mmask16 mask) {
+    const __m512i xtl = _mm512_maskz_loadu_epi32(mask, buf - 1 - stride);
+    const __m512i xt  = _mm512_maskz_loadu_epi32(mask, buf - stride);
+    const __m512i xtr = _mm512_maskz_loadu_epi32(mask, buf + 1 - stride);
+    const __m512i xl  = _mm512_maskz_loadu_epi32(mask, buf - 1);
+    const __m512i x   = _mm512_maskz_loadu_epi32(mask, buf);
+    const __m512i xr  = _mm512_maskz_loadu_epi32(mask, buf + 1);
+    const __m512i xbl = _mm512_maskz_loadu_epi32(mask, buf - 1 + stride);
+    const __m512i xb  = _mm512_maskz_loadu_epi32(mask, buf + stride);
+    const __m512i xbr = _mm512_maskz_loadu_epi32(mask, buf + 1 + stride);
+
+    const __m512i fours  = _mm512_add_epi32(xl, _mm512_add_epi32(xt, _mm512_add_epi32(xr, _mm512_add_epi32(xb, x))));
+    const __m512i threes = _mm512_add_epi32(xtl, _mm512_add_epi32(xtr, _mm512_add_epi32(xbr, xbl)));
+
+    return _mm512_sub_epi32(_mm512_slli_epi32(_mm512_add_epi32(fours, threes), 2), threes);
+}
+
+// Calculate 16 values of the "cross sum" starting at buf.
+//
+// Pixels are indexed like this:
+// xtl  xt   xtr
+//  -   buf   -
+// xbl  xb   xbr
+//
+// Pixels are weighted like this:
+//  5    6    5
+//  0    0    0
+//  5    6    5
+//
+// fives = xtl + xtr + xbl + xbr
+// sixes = xt + xb
+// cross_sum = 6 * sixes + 5 * fives
+//           = 5 * (fives + sixes) - sixes
+//           = (fives + sixes) << 2 + (fives + sixes) + sixes
+static INLINE __m512i cross_sum_fast_even_row(const int32_t *buf, int32_t stride, __mmask16 mask) {
+    const __m512i xtl = _mm512_maskz_loadu_epi32(mask, buf - 1 - stride);
+    const __m512i xt  = _mm512_maskz_loadu_epi32(mask, buf - stride);
+    const __m512i xtr = _mm512_maskz_loadu_epi32(mask, buf + 1 - stride);
+    const __m512i xbl = _mm512_maskz_loadu_epi32(mask, buf - 1 + stride);
+    const __m512i xb  = _mm512_maskz_loadu_epi32(mask, buf + stride);
+    const __m512i xbr = _mm512_maskz_loadu_epi32(mask, buf + 1 + stride);
+
+    const __m512i fives            = _mm512_add_epi32(xtl, _mm512_add_epi32(xtr, _mm512_add_epi32(xbr, xbl)));
+    const __m512i sixes            = _mm512_add_epi32(xt, xb);
+    const __m512i fives_plus_sixes = _mm512_add_epi32(fives, sixes);
+
+    return _mm512_add_epi32(_mm512_add_epi32(_mm512_slli_epi32(fives_plus_sixes, 2), fives_plus_sixes), sixes);
+}
+
+// Calculate 16 values of the "cross sum" starting at buf.
+//
+// Pixels are indexed like this:
+// xl    x   xr
+//
+// Pixels are weighted like this:
+//  5    6    5
+//
+// buf points to x
+//
+// fives = xl + xr
+// sixes = x
+// cross_sum = 5 * fives + 6 * sixes
+//           = 4 * (fives + sixes) + (fives + sixes) + sixes
+//           = (fives + sixes) << 2 + (fives + sixes) + sixes
+static INLINE __m512i cross_sum_fast_odd_row(const int32_t *buf, __mmask16 mask) {
+    const __m512i xl = _mm512_maskz_loadu_epi32(mask, buf - 1);
+    const __m512i x  = _mm512_maskz_loadu_epi32(mask, buf);
+    const __m512i xr = _mm512_maskz_loadu_epi32(mask, buf + 1);
+
+    const __m512i fives = _mm512_add_epi32(xl, xr);
+    const __m512i sixes = x;
+
+    const __m512i fives_plus_sixes = _mm512_add_epi32(fives, sixes);
+
+    return _mm512_add_epi32(_mm512_add_epi32(_mm512_slli_epi32(fives_plus_sixes, 2), fives_plus_sixes), sixes);
+}
+
+static INLINE __m512i load_dgd_epi32(const uint8_t *dgd8, int32_t j, __mmask16 mask, int32_t highbd) {
+    if (highbd)
+        return _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(mask, CONVERT_TO_SHORTPTR(dgd8) + j));
+    return _mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(mask, dgd8 + j));
+}
+
+// The final filter for self-guided restoration. Computes a weighted average
+// across A, b with "cross sums" (see cross_sum implementation above).
+static AOM_FORCE_INLINE void final_filter(int32_t *dst, int32_t dst_stride, const int32_t *A, const int32_t *B,
+                                          int32_t buf_stride, const uint8_t *dgd8, int32_t dgd_stride, int32_t width,
+                                          int32_t height, int32_t highbd) {
+    const int32_t nb       = 5;
+    const __m512i rounding = round_for_shift(SGRPROJ_SGR_BITS + nb - SGRPROJ_RST_BITS);
+
+    for (int32_t i = 0; i < height; ++i) {
+        for (int32_t j = 0; j < width; j += 16) {
+            const __mmask16 mask = tail_mask(width - j);
+            const __m512i   a    = cross_sum(A + j, buf_stride, mask);
+            const __m512i   b    = cross_sum(B + j, buf_stride, mask);
+            const __m512i   src  = load_dgd_epi32(dgd8, j, mask, highbd);
+            const __m512i   v    = _mm512_add_epi32(_mm512_madd_epi16(a, src), b);
+            const __m512i   w    = _mm512_srai_epi32(_mm512_add_epi32(v, rounding),
+                                                SGRPROJ_SGR_BITS + nb - SGRPROJ_RST_BITS);
+            _mm512_mask_storeu_epi32(dst + j, mask, w);
+        }
+
+        A += buf_stride;
+        B += buf_stride;
+        dgd8 += dgd_stride;
+        dst += dst_stride;
+    }
+}
+
+// The final filter for the self-guided restoration. Computes a
+// weighted average across A, b with "cross sums" (see cross_sum_...
+// implementations above).
+static AOM_FORCE_INLINE void final_filter_fast(int32_t *dst, int32_t dst_stride, const int32_t *A, const int32_t *B,
+                                               int32_t buf_stride, const uint8_t *dgd8, int32_t dgd_stride,
+                                               int32_t width, int32_t height, int32_t highbd) {
+    const int32_t nb0       = 5;
+    const int32_t nb1       = 4;
+    const __m512i rounding0 = round_for_shift(SGRPROJ_SGR_BITS + nb0 - SGRPROJ_RST_BITS);
+    const __m512i rounding1 = round_for_shift(SGRPROJ_SGR_BITS + nb1 - SGRPROJ_RST_BITS);
+
+    for (int32_t i = 0; i < height; ++i) {
+        if (!(i & 1)) { // even row
+            for (int32_t j = 0; j < width; j += 16) {
+                const __mmask16 mask = tail_mask(width - j);
+                const __m512i   a    = cross_sum_fast_even_row(A + j, buf_stride, mask);
+                const __m512i   b    = cross_sum_fast_even_row(B + j, buf_stride, mask);
+                const __m512i   src  = load_dgd_epi32(dgd8, j, mask, highbd);
+                const __m512i   v    = _mm512_add_epi32(_mm512_madd_epi16(a, src), b);
+                const __m512i   w    = _mm512_srai_epi32(_mm512_add_epi32(v, rounding0),
+                                                    SGRPROJ_SGR_BITS + nb0 - SGRPROJ_RST_BITS);
+                _mm512_mask_storeu_epi32(dst + j, mask, w);
+            }
+        } else { // odd row
+            for (int32_t j = 0; j < width; j += 16) {
+                const __mmask16 mask = tail_mask(width - j);
+                const __m512i   a    = cross_sum_fast_odd_row(A + j, mask);
+                const __m512i   b    = cross_sum_fast_odd_row(B + j, mask);
+                const __m512i   src  = load_dgd_epi32(dgd8, j, mask, highbd);
+                const __m512i   v    = _mm512_add_epi32(_mm512_madd_epi16(a, src), b);
+                const __m512i   w    = _mm512_srai_epi32(_mm512_add_epi32(v, rounding1),
+                                                    SGRPROJ_SGR_BITS + nb1 - SGRPROJ_RST_BITS);
+                _mm512_mask_storeu_epi32(dst + j, mask, w);
+            }
+        }
+
+        A += buf_stride;
+        B += buf_stride;
+        dgd8 += dgd_stride;
+        dst += dst_stride;
+    }
+}
+
+void svt_av1_selfguided_restoration_avx512(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride,
+                                           int32_t *flt0, int32_t *flt1, int32_t flt_stride, int32_t sgr_params_idx,
+                                           int32_t bit_depth, int32_t highbd) {
+    const int32_t buf_elts = ALIGN_POWER_OF_TWO(RESTORATION_PROC_UNIT_PELS, 4);
+
+    DECLARE_ALIGNED(64, int32_t, buf[4 * ALIGN_POWER_OF_TWO(RESTORATION_PROC_UNIT_PELS, 4)]);
+
+    const int32_t width_ext  = width + 2 * SGRPROJ_BORDER_HORZ;
+    const int32_t height_ext = height + 2 * SGRPROJ_BORDER_VERT;
+
+    // Adjusting the stride of A and b here appears to avoid bad cache effects,
+    // leading to a significant speed improvement.
+    // We also align the stride to a multiple of 32 bytes for efficiency.
+    int32_t buf_stride = ALIGN_POWER_OF_TWO(width_ext + 16, 3);
+
+    // The "tl" pointers point at the top-left of the initialised data for the
+    // array.
+    int32_t *atl = buf + 0 * buf_elts + 7;
+    int32_t *btl = buf + 1 * buf_elts + 7;
+    int32_t *ctl = buf + 2 * buf_elts + 7;
+    int32_t *dtl = buf + 3 * buf_elts + 7;
+
+    // The "0" pointers are (- SGRPROJ_BORDER_VERT, -SGRPROJ_BORDER_HORZ). Note
+    // there's a zero row and column in A, b (integral images), so we move down
+    // and right one for them.
+    const int32_t buf_diag_border = SGRPROJ_BORDER_HORZ + buf_stride * SGRPROJ_BORDER_VERT;
+
+    int32_t *a0 = atl + 1 + buf_stride;
+    int32_t *b0 = btl + 1 + buf_stride;
+    int32_t *c0 = ctl + 1 + buf_stride;
+    int32_t *d0 = dtl + 1 + buf_stride;
+
+    // Finally, A, b, C, D point at position (0, 0).
+    int32_t *A = a0 + buf_diag_border;
+    int32_t *b = b0 + buf_diag_border;
+    int32_t *C = c0 + buf_diag_border;
+    int32_t *D = d0 + buf_diag_border;
+
+    const int32_t  dgd_diag_border = SGRPROJ_BORDER_HORZ + dgd_stride * SGRPROJ_BORDER_VERT;
+    const uint8_t *dgd0            = dgd8 - dgd_diag_border;
+
+    // Generate integral images from the input. C will contain sums of squares; D
+    // will contain just sums
+    integral_images(dgd0, dgd_stride, width_ext, height_ext, ctl, dtl, buf_stride, highbd);
+
+    const SgrParamsType *const params = &svt_aom_eb_sgr_params[sgr_params_idx];
+    // Write to flt0 and flt1
+    // If params->r == 0 we skip the corresponding filter. We only allow one of
+    // the radii to be 0, as having both equal to 0 would be equivalent to
+    // skipping SGR entirely.
+    assert(!(params->r[0] == 0 && params->r[1] == 0));
+    assert(params->r[0] < 3); // AOMMIN(SGRPROJ_BORDER_VERT, SGRPROJ_BORDER_HORZ) == 3
+    assert(params->r[1] < 3); // AOMMIN(SGRPROJ_BORDER_VERT, SGRPROJ_BORDER_HORZ) == 3
+
+    if (params->r[0] > 0) {
+        calc_ab(A, b, C, D, width, height, buf_stride, bit_depth, sgr_params_idx, 0, 2);
+        final_filter_fast(flt0, flt_stride, A, b, buf_stride, dgd8, dgd_stride, width, height, highbd);
+    }
+
+    if (params->r[1] > 0) {
+        calc_ab(A, b, C, D, width, height, buf_stride, bit_depth, sgr_params_idx, 1, 1);
+        final_filter(flt1, flt_stride, A, b, buf_stride, dgd8, dgd_stride, width, height, highbd);
+    }
+}
+
+void svt_apply_selfguided_restoration_avx512(const uint8_t *dat8, int32_t width, int32_t height, int32_t stride,
+                                             int32_t eps, const int32_t *xqd, uint8_t *dst8, int32_t dst_stride,
+                                             int32_t *tmpbuf, int32_t bit_depth, int32_t highbd) {
+    int32_t *flt0 = tmpbuf;
+    int32_t *flt1 = flt0 + RESTORATION_UNITPELS_MAX;
+    assert(width * height <= RESTORATION_UNITPELS_MAX);
+    svt_av1_selfguided_restoration_avx512(dat8, width, height, stride, flt0, flt1, width, eps, bit_depth, highbd);
+    const SgrParamsType *const params = &svt_aom_eb_sgr_params[eps];
+    int32_t                    xq[2];
+    svt_decode_xq(xqd, xq, params);
+
+    const __m512i xq0      = _mm512_set1_epi32(xq[0]);
+    const __m512i xq1      = _mm512_set1_epi32(xq[1]);
+    const __m512i rounding = round_for_shift(SGRPROJ_PRJ_BITS + SGRPROJ_RST_BITS);
+    const __m512i zero     = _mm512_setzero_si512();
+    const __m512i max      = _mm512_set1_epi32((1 << bit_depth) - 1);
+
+    for (int32_t i = 0; i < height; ++i) {
+        // Calculate output in batches of 16 pixels
+        for (int32_t j = 0; j < width; j += 16) {
+            const __mmask16 mask = tail_mask(width - j);
+            const __m512i   u    = _mm512_slli_epi32(load_dgd_epi32(dat8, j, mask, highbd), SGRPROJ_RST_BITS);
+            __m512i         v    = _mm512_slli_epi32(u, SGRPROJ_PRJ_BITS);
+
+            if (params->r[0] > 0) {
+                const __m512i f1 = _mm512_sub_epi32(_mm512_maskz_loadu_epi32(mask, flt0 + j), u);
+                v                = _mm512_add_epi32(v, _mm512_mullo_epi32(xq0, f1));
+            }
+
+            if (params->r[1] > 0) {
+                const __m512i f2 = _mm512_sub_epi32(_mm512_maskz_loadu_epi32(mask, flt1 + j), u);
+                v                = _mm512_add_epi32(v, _mm512_mullo_epi32(xq1, f2));
+            }
+
+            // Clamp to [0, 2^bit_depth) before narrowing
+            __m512i w = _mm512_srai_epi32(_mm512_add_epi32(v, rounding), SGRPROJ_PRJ_BITS + SGRPROJ_RST_BITS);
+            w         = _mm512_min_epi32(_mm512_max_epi32(w, zero), max);
+            if (highbd)
+                _mm256_mask_storeu_epi16(CONVERT_TO_SHORTPTR(dst8) + j, mask, _mm512_cvtepi32_epi16(w));
+            else
+                _mm_mask_storeu_epi8(dst8 + j, mask, _mm512_cvtepi32_epi8(w));
+        }
+
+        dat8 += stride;
+        flt0 += width;
+        flt1 += width;
+        dst8 += dst_stride;
+    }
+}
+
+#endif // EN_AVX512_SUPPORT
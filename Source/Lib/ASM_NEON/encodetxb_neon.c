@@ -594,6 +594,74 @@ void svt_av1_get_nz_map_contexts_neon(const uint8_t *const levels, const int16_t
     }
 }
 
+int32_t svt_av1_cost_coeffs_txb_loop_neon(const TranLow *const qcoeff, const int16_t *const scan,
+                                          const int8_t *const coeff_contexts, const uint8_t *const levels,
+                                          const struct LvMapCoeffCost *const coeff_costs, const int32_t c_start,
+                                          const int32_t bwl, const TxClass tx_class) {
+    const int32_t *const base_cost = &coeff_costs->base_cost[0][0];
+    const int32x4_t      num_base  = vdupq_n_s32(NUM_BASE_LEVELS);
+    const int32x4_t      max_base  = vdupq_n_s32(NUM_BASE_LEVELS + 1);
+    int32x4_t            cost_acc  = vdupq_n_s32(0);
+    uint32x4_t           nz_acc    = vdupq_n_u32(0);
+    int32_t              cost      = 0;
+    int32_t              c         = 1;
+
+    // No gathers on NEON: load 4 coefficients and contexts per iteration lane by lane, derive the
+    // base_cost[coeff_ctx][min(level, 3)] indices and the non-zero count in vector registers, and
+    // add the base-range and Golomb cost of coefficients above NUM_BASE_LEVELS in scalar.
+    for (; c + 4 <= c_start + 1; c += 4) {
+        const int32_t p0 = scan[c + 0];
+        const int32_t p1 = scan[c + 1];
+        const int32_t p2 = scan[c + 2];
+        const int32_t p3 = scan[c + 3];
+        int32x4_t     q  = vld1q_lane_s32(qcoeff + p0, vdupq_n_s32(0), 0);
+        q                = vld1q_lane_s32(qcoeff + p1, q, 1);
+        q                = vld1q_lane_s32(qcoeff + p2, q, 2);
+        q                = vld1q_lane_s32(qcoeff + p3, q, 3);
+        int32x4_t ctx    = vdupq_n_s32(coeff_contexts[p0]);
+        ctx              = vsetq_lane_s32(coeff_contexts[p1], ctx, 1);
+        ctx              = vsetq_lane_s32(coeff_contexts[p2], ctx, 2);
+        ctx              = vsetq_lane_s32(coeff_contexts[p3], ctx, 3);
+
+        const int32x4_t level = vabsq_s32(q);
+        const int32x4_t idx   = vaddq_s32(vshlq_n_s32(ctx, 3), vminq_s32(level, max_base));
+        int32x4_t       bc    = vld1q_lane_s32(base_cost + vgetq_lane_s32(idx, 0), vdupq_n_s32(0), 0);
+        bc                    = vld1q_lane_s32(base_cost + vgetq_lane_s32(idx, 1), bc, 1);
+        bc                    = vld1q_lane_s32(base_cost + vgetq_lane_s32(idx, 2), bc, 2);
+        bc                    = vld1q_lane_s32(base_cost + vgetq_lane_s32(idx, 3), bc, 3);
+        cost_acc              = vaddq_s32(cost_acc, bc);
+        nz_acc                = vsubq_u32(nz_acc, vtstq_s32(q, q));
+
+        const uint32x4_t br_mask = vcgtq_s32(level, num_base);
+        if (vmaxvq_u32(br_mask)) {
+            const int32_t pos_arr[4] = {p0, p1, p2, p3};
+            for (int32_t i = 0; i < 4; i++) {
+                const int32_t lvl = abs(qcoeff[pos_arr[i]]);
+                if (lvl > NUM_BASE_LEVELS) {
+                    const int32_t br_ctx = get_br_ctx(levels, pos_arr[i], bwl, tx_class);
+                    cost += get_br_golomb_cost(coeff_costs->lps_cost[br_ctx], lvl);
+                }
+            }
+        }
+    }
+    cost += vaddvq_s32(cost_acc);
+    uint32_t cost_literal_cnt = vaddvq_u32(nz_acc);
+
+    for (; c <= c_start; ++c) {
+        const int32_t pos   = scan[c];
+        const int32_t level = abs(qcoeff[pos]);
+        cost_literal_cnt += !!level;
+        if (level > NUM_BASE_LEVELS) {
+            const int32_t br_ctx = get_br_ctx(levels, pos, bwl, tx_class);
+            cost += coeff_costs->base_cost[coeff_contexts[pos]][3] +
+                get_br_golomb_cost(coeff_costs->lps_cost[br_ctx], level);
+        } else {
+            cost += coeff_costs->base_cost[coeff_contexts[pos]][level];
+        }
+    }
+    return cost + cost_literal_cnt * av1_cost_literal(1);
+}
+
 static INLINE uint8x8_t compute_sum(uint8x16_t *in, uint8x16_t *prev_in) {
     int16x8_t prev_in_lo_half = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(*prev_in)));
     int16x8_t prev_in_hi_half = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(*prev_in)));
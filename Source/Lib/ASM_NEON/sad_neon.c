@@ -203,3 +203,74 @@ void svt_ext_all_sad_calculation_8x8_16x16_neon(uint8_t *src, uint32_t src_strid
         }
     }
 }
+
+/* SADs of the four 8x8 blocks of a 16x16 block, the source rows of the top blocks are in
+   src_rows[0..rows - 1] and the ones of the bottom blocks in src_rows[8..8 + rows - 1] */
+static AOM_FORCE_INLINE uint32x4_t sad_8x8_quad_neon(const uint8x16_t *src_rows, const int rows, const uint8_t *ref,
+                                                     const uint32_t ref_step, const uint32_t ref_stride) {
+    uint16x8_t sum_top    = vdupq_n_u16(0);
+    uint16x8_t sum_bottom = vdupq_n_u16(0);
+
+    for (int i = 0; i < rows; i++) {
+        sum_top    = vpadalq_u8(sum_top, vabdq_u8(src_rows[i], vld1q_u8(ref)));
+        sum_bottom = vpadalq_u8(sum_bottom, vabdq_u8(src_rows[8 + i], vld1q_u8(ref + 8 * ref_stride)));
+        ref += ref_step;
+    }
+
+    return vpaddq_u32(vpaddlq_u16(sum_top), vpaddlq_u16(sum_bottom));
+}
+
+void svt_ext_all_sad_calculation_8x8_16x16_multi_neon(uint8_t *src, uint32_t src_stride, MeSadRef *refs,
+                                                      uint32_t ref_count, Bool sub_sad) {
+    static const char offsets[16] = {0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15};
+    const int         rows        = sub_sad ? 4 : 8;
+    const uint32_t    src_step    = sub_sad ? 2 * src_stride : src_stride;
+
+    //---- 16x16 : 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            const uint32_t start_16x16_pos = offsets[4 * y + x];
+            const uint32_t start_8x8_pos   = 4 * start_16x16_pos;
+            const uint8_t *s               = src + 16 * y * src_stride + 16 * x;
+            uint8x16_t     src_rows[16];
+
+            // The source rows are loaded once and kept for all the references
+            for (int i = 0; i < rows; i++) {
+                src_rows[i]     = vld1q_u8(s);
+                src_rows[8 + i] = vld1q_u8(s + 8 * src_stride);
+                s += src_step;
+            }
+
+            for (uint32_t ref_idx = 0; ref_idx < ref_count; ref_idx++) {
+                const MeSadRef *sad_ref      = &refs[ref_idx];
+                const uint32_t  ref_stride   = sad_ref->ref_stride;
+                const uint32_t  ref_step     = sub_sad ? 2 * ref_stride : ref_stride;
+                const uint8_t  *r            = sad_ref->ref + 16 * y * ref_stride + 16 * x;
+                const uint32_t  y_mv         = sad_ref->mv & 0xFFFF0000;
+                const uint16_t  x_mv         = (uint16_t)sad_ref->mv;
+                uint32x4_t      best_sad_vec = vld1q_u32(sad_ref->p_best_sad_8x8 + start_8x8_pos);
+                uint32x4_t      best_mv_vec  = vld1q_u32(sad_ref->p_best_mv8x8 + start_8x8_pos);
+
+                for (int search_index = 0; search_index < 8; search_index++) {
+                    const uint32_t tmp_mv = y_mv | (uint16_t)(x_mv + search_index);
+                    uint32x4_t     sad    = sad_8x8_quad_neon(src_rows, rows, r + search_index, ref_step, ref_stride);
+                    if (sub_sad)
+                        sad = vaddq_u32(sad, sad);
+
+                    const uint32x4_t cmp = vcltq_u32(sad, best_sad_vec);
+                    best_sad_vec         = vbslq_u32(cmp, sad, best_sad_vec);
+                    best_mv_vec          = vbslq_u32(cmp, vdupq_n_u32(tmp_mv), best_mv_vec);
+
+                    const uint32_t sad16x16 = sad_ref->p_eight_sad16x16[start_16x16_pos][search_index] = vaddvq_u32(
+                        sad);
+                    if (sad16x16 < sad_ref->p_best_sad_16x16[start_16x16_pos]) {
+                        sad_ref->p_best_sad_16x16[start_16x16_pos] = sad16x16;
+                        sad_ref->p_best_mv16x16[start_16x16_pos]   = tmp_mv;
+                    }
+                }
+                vst1q_u32(sad_ref->p_best_sad_8x8 + start_8x8_pos, best_sad_vec);
+                vst1q_u32(sad_ref->p_best_mv8x8 + start_8x8_pos, best_mv_vec);
+            }
+        }
+    }
+}
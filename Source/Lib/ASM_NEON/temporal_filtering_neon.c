@@ -319,6 +319,96 @@ void svt_av1_apply_temporal_filter_planewise_medium_neon(
     }
 }
 
+static void svt_av1_apply_zz_based_temporal_filter_planewise_medium_partial_neon(
+    struct MeContext *me_ctx, const uint8_t *y_pre, int y_pre_stride, unsigned int block_width,
+    unsigned int block_height, uint32_t *y_accum, uint16_t *y_count, const uint32_t tf_decay_factor) {
+    unsigned int i, j, k, subblock_idx;
+
+    const int32_t idx_32x32 = me_ctx->tf_block_col + me_ctx->tf_block_row * 2;
+    uint32_t      block_error_fp8[4];
+
+    if (me_ctx->tf_32x32_block_split_flag[idx_32x32]) {
+        for (i = 0; i < 4; ++i) { block_error_fp8[i] = (uint32_t)(me_ctx->tf_16x16_block_error[idx_32x32 * 4 + i]); }
+    } else {
+        block_error_fp8[0] = block_error_fp8[1] = block_error_fp8[2] = block_error_fp8[3] =
+            (uint32_t)(me_ctx->tf_32x32_block_error[idx_32x32] >> 2);
+    }
+
+    uint16x8_t adjusted_weight_int16[4];
+    uint32x4_t adjusted_weight_int32[4];
+
+    for (subblock_idx = 0; subblock_idx < 4; subblock_idx++) {
+        const uint32_t avg_err_fp10 = (block_error_fp8[subblock_idx]) << 2;
+        FP_ASSERT((((int64_t)block_error_fp8[subblock_idx]) << 2) < ((int64_t)1 << 31));
+
+        const uint32_t scaled_diff16 = AOMMIN(
+            /*((16*avg_err)<<8)*/ (avg_err_fp10) / AOMMAX((tf_decay_factor >> 10), 1), 7 * 16);
+        const uint32_t adjusted_weight = (expf_tab_fp16[scaled_diff16] * TF_WEIGHT_SCALE) >> 17;
+
+        adjusted_weight_int16[subblock_idx] = vdupq_n_u16((uint16_t)adjusted_weight);
+        adjusted_weight_int32[subblock_idx] = vdupq_n_u32(adjusted_weight);
+    }
+
+    for (i = 0; i < block_height; i++) {
+        const int subblock_idx_h = (i >= block_height / 2) * 2;
+        for (j = 0; j < block_width; j += 8) {
+            k = i * y_pre_stride + j;
+
+            //y_count[k] += adjusted_weight;
+            uint16x8_t count_array = vld1q_u16(y_count + k);
+            count_array = vaddq_u16(count_array, adjusted_weight_int16[subblock_idx_h + (j >= block_width / 2)]);
+            vst1q_u16(y_count + k, count_array);
+
+            //y_accum[k] += adjusted_weight * pixel_value;
+            uint32x4_t       accumulator_array1 = vld1q_u32(y_accum + k);
+            uint32x4_t       accumulator_array2 = vld1q_u32(y_accum + k + 4);
+            const uint16x8_t frame2_array       = vmovl_u8(vld1_u8(y_pre + k));
+            accumulator_array1                  = vmlaq_u32(accumulator_array1,
+                                           vmovl_u16(vget_low_u16(frame2_array)),
+                                           adjusted_weight_int32[subblock_idx_h + (j >= block_width / 2)]);
+            accumulator_array2                  = vmlaq_u32(accumulator_array2,
+                                           vmovl_u16(vget_high_u16(frame2_array)),
+                                           adjusted_weight_int32[subblock_idx_h + (j >= block_width / 2)]);
+            vst1q_u32(y_accum + k, accumulator_array1);
+            vst1q_u32(y_accum + k + 4, accumulator_array2);
+        }
+    }
+}
+
+void svt_av1_apply_zz_based_temporal_filter_planewise_medium_neon(
+    struct MeContext *me_ctx, const uint8_t *y_pre, int y_pre_stride, const uint8_t *u_pre, const uint8_t *v_pre,
+    int uv_pre_stride, unsigned int block_width, unsigned int block_height, int ss_x, int ss_y, uint32_t *y_accum,
+    uint16_t *y_count, uint32_t *u_accum, uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count) {
+    svt_av1_apply_zz_based_temporal_filter_planewise_medium_partial_neon(me_ctx,
+                                                                         y_pre,
+                                                                         y_pre_stride,
+                                                                         (unsigned int)block_width,
+                                                                         (unsigned int)block_height,
+                                                                         y_accum,
+                                                                         y_count,
+                                                                         me_ctx->tf_decay_factor_fp16[C_Y]);
+
+    if (me_ctx->tf_chroma) {
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_partial_neon(me_ctx,
+                                                                             u_pre,
+                                                                             uv_pre_stride,
+                                                                             (unsigned int)block_width >> ss_x,
+                                                                             (unsigned int)block_height >> ss_y,
+                                                                             u_accum,
+                                                                             u_count,
+                                                                             me_ctx->tf_decay_factor_fp16[C_U]);
+
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_partial_neon(me_ctx,
+                                                                             v_pre,
+                                                                             uv_pre_stride,
+                                                                             (unsigned int)block_width >> ss_x,
+                                                                             (unsigned int)block_height >> ss_y,
+                                                                             v_accum,
+                                                                             v_count,
+                                                                             me_ctx->tf_decay_factor_fp16[C_V]);
+    }
+}
+
 // Divide two int32x4 vectors
 static uint32x4_t div_u32(const uint32x4_t *a, const uint32x4_t *b) {
     uint32x4_t result = vdupq_n_u32(0);
@@ -900,6 +990,100 @@ void svt_av1_apply_temporal_filter_planewise_medium_hbd_neon(
     }
 }
 
+static void svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_partial_neon(
+    struct MeContext *me_ctx, const uint16_t *y_pre, int y_pre_stride, unsigned int block_width,
+    unsigned int block_height, uint32_t *y_accum, uint16_t *y_count, const uint32_t tf_decay_factor) {
+    unsigned int i, j, k, subblock_idx;
+
+    const int32_t idx_32x32 = me_ctx->tf_block_col + me_ctx->tf_block_row * 2;
+    uint32_t      block_error_fp8[4];
+
+    if (me_ctx->tf_32x32_block_split_flag[idx_32x32]) {
+        for (i = 0; i < 4; ++i) {
+            block_error_fp8[i] = (uint32_t)(me_ctx->tf_16x16_block_error[idx_32x32 * 4 + i] >> 4);
+        }
+    } else {
+        block_error_fp8[0] = block_error_fp8[1] = block_error_fp8[2] = block_error_fp8[3] =
+            (uint32_t)(me_ctx->tf_32x32_block_error[idx_32x32] >> 6);
+    }
+
+    uint16x8_t adjusted_weight_int16[4];
+    uint32x4_t adjusted_weight_int32[4];
+
+    for (subblock_idx = 0; subblock_idx < 4; subblock_idx++) {
+        const uint32_t avg_err_fp10 = (block_error_fp8[subblock_idx]) << 2;
+        FP_ASSERT((((int64_t)block_error_fp8[subblock_idx]) << 2) < ((int64_t)1 << 31));
+
+        const uint32_t scaled_diff16 = AOMMIN(
+            /*((16*avg_err)<<8)*/ (avg_err_fp10) / AOMMAX((tf_decay_factor >> 10), 1), 7 * 16);
+        const uint32_t adjusted_weight = (expf_tab_fp16[scaled_diff16] * TF_WEIGHT_SCALE) >> 17;
+
+        adjusted_weight_int16[subblock_idx] = vdupq_n_u16((uint16_t)adjusted_weight);
+        adjusted_weight_int32[subblock_idx] = vdupq_n_u32(adjusted_weight);
+    }
+
+    for (i = 0; i < block_height; i++) {
+        const int subblock_idx_h = (i >= block_height / 2) * 2;
+        for (j = 0; j < block_width; j += 8) {
+            k = i * y_pre_stride + j;
+
+            //y_count[k] += adjusted_weight;
+            uint16x8_t count_array = vld1q_u16(y_count + k);
+            count_array = vaddq_u16(count_array, adjusted_weight_int16[subblock_idx_h + (j >= block_width / 2)]);
+            vst1q_u16(y_count + k, count_array);
+
+            //y_accum[k] += adjusted_weight * pixel_value;
+            uint32x4_t       accumulator_array1 = vld1q_u32(y_accum + k);
+            uint32x4_t       accumulator_array2 = vld1q_u32(y_accum + k + 4);
+            const uint16x8_t frame2_array       = vld1q_u16(y_pre + k);
+            accumulator_array1                  = vmlaq_u32(accumulator_array1,
+                                           vmovl_u16(vget_low_u16(frame2_array)),
+                                           adjusted_weight_int32[subblock_idx_h + (j >= block_width / 2)]);
+            accumulator_array2                  = vmlaq_u32(accumulator_array2,
+                                           vmovl_u16(vget_high_u16(frame2_array)),
+                                           adjusted_weight_int32[subblock_idx_h + (j >= block_width / 2)]);
+            vst1q_u32(y_accum + k, accumulator_array1);
+            vst1q_u32(y_accum + k + 4, accumulator_array2);
+        }
+    }
+}
+
+void svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_neon(
+    struct MeContext *me_ctx, const uint16_t *y_pre, int y_pre_stride, const uint16_t *u_pre, const uint16_t *v_pre,
+    int uv_pre_stride, unsigned int block_width, unsigned int block_height, int ss_x, int ss_y, uint32_t *y_accum,
+    uint16_t *y_count, uint32_t *u_accum, uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count,
+    uint32_t encoder_bit_depth) {
+    (void)encoder_bit_depth;
+    svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_partial_neon(me_ctx,
+                                                                             y_pre,
+                                                                             y_pre_stride,
+                                                                             (unsigned int)block_width,
+                                                                             (unsigned int)block_height,
+                                                                             y_accum,
+                                                                             y_count,
+                                                                             me_ctx->tf_decay_factor_fp16[C_Y]);
+
+    if (me_ctx->tf_chroma) {
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_partial_neon(me_ctx,
+                                                                                 u_pre,
+                                                                                 uv_pre_stride,
+                                                                                 (unsigned int)block_width >> ss_x,
+                                                                                 (unsigned int)block_height >> ss_y,
+                                                                                 u_accum,
+                                                                                 u_count,
+                                                                                 me_ctx->tf_decay_factor_fp16[C_U]);
+
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_partial_neon(me_ctx,
+                                                                                 v_pre,
+                                                                                 uv_pre_stride,
+                                                                                 (unsigned int)block_width >> ss_x,
+                                                                                 (unsigned int)block_height >> ss_y,
+                                                                                 v_accum,
+                                                                                 v_count,
+                                                                                 me_ctx->tf_decay_factor_fp16[C_V]);
+    }
+}
+
 int32_t svt_estimate_noise_highbd_fp16_neon(const uint16_t *src, int width, int height, int stride, int bd) {
     int64_t sum = 0;
     int64_t num = 0;
@@ -153,3 +153,87 @@ void svt_av1_compute_stats_highbd_sve(int32_t wiener_win, const uint8_t *dgd8, c
 
     svt_aom_free(d);
 }
+
+int64_t svt_av1_highbd_pixel_proj_error_sve(const uint8_t *src8, int32_t width, int32_t height, int32_t src_stride,
+                                            const uint8_t *dat8, int32_t dat_stride, int32_t *flt0, int32_t flt0_stride,
+                                            int32_t *flt1, int32_t flt1_stride, int32_t xq[2],
+                                            const SgrParamsType *params) {
+    const int32_t   shift = SGRPROJ_RST_BITS + SGRPROJ_PRJ_BITS;
+    const uint16_t *src   = CONVERT_TO_SHORTPTR(src8);
+    const uint16_t *dat   = CONVERT_TO_SHORTPTR(dat8);
+    int64x2_t       sse   = vdupq_n_s64(0);
+    int64_t         err   = 0;
+    int             i, j;
+
+    // The error of 12-bit content still fits in 16 bits, so the 16-bit dot product squares and accumulates it
+    // straight into 64 bits.
+    if (params->r[0] > 0 && params->r[1] > 0) {
+        for (i = 0; i < height; ++i) {
+            for (j = 0; j <= width - 8; j += 8) {
+                const uint16x8_t d    = vld1q_u16(dat + j);
+                const uint16x8_t s    = vld1q_u16(src + j);
+                const int32x4_t  u_lo = vreinterpretq_s32_u32(vshll_n_u16(vget_low_u16(d), SGRPROJ_RST_BITS));
+                const int32x4_t  u_hi = vreinterpretq_s32_u32(vshll_high_n_u16(d, SGRPROJ_RST_BITS));
+
+                int32x4_t v_lo     = vmulq_n_s32(vsubq_s32(vld1q_s32(flt0 + j), u_lo), xq[0]);
+                v_lo               = vmlaq_n_s32(v_lo, vsubq_s32(vld1q_s32(flt1 + j), u_lo), xq[1]);
+                int32x4_t v_hi     = vmulq_n_s32(vsubq_s32(vld1q_s32(flt0 + j + 4), u_hi), xq[0]);
+                v_hi               = vmlaq_n_s32(v_hi, vsubq_s32(vld1q_s32(flt1 + j + 4), u_hi), xq[1]);
+                const int16x8_t vr = vcombine_s16(vqrshrn_n_s32(v_lo, shift), vqrshrn_n_s32(v_hi, shift));
+                const int16x8_t e  = vaddq_s16(vr, vreinterpretq_s16_u16(vsubq_u16(d, s)));
+                sse                = svt_sdotq_s16(sse, e, e);
+            }
+            for (; j < width; ++j) {
+                const int32_t u = dat[j] << SGRPROJ_RST_BITS;
+                const int32_t v = xq[0] * (flt0[j] - u) + xq[1] * (flt1[j] - u);
+                const int32_t e = ROUND_POWER_OF_TWO(v, shift) + dat[j] - src[j];
+                err += e * e;
+            }
+            dat += dat_stride;
+            src += src_stride;
+            flt0 += flt0_stride;
+            flt1 += flt1_stride;
+        }
+    } else if (params->r[0] > 0 || params->r[1] > 0) {
+        const int      xq_active  = (params->r[0] > 0) ? xq[0] : xq[1];
+        const int32_t *flt        = (params->r[0] > 0) ? flt0 : flt1;
+        const int      flt_stride = (params->r[0] > 0) ? flt0_stride : flt1_stride;
+        for (i = 0; i < height; ++i) {
+            for (j = 0; j <= width - 8; j += 8) {
+                const uint16x8_t d    = vld1q_u16(dat + j);
+                const uint16x8_t s    = vld1q_u16(src + j);
+                const int32x4_t  u_lo = vreinterpretq_s32_u32(vshll_n_u16(vget_low_u16(d), SGRPROJ_RST_BITS));
+                const int32x4_t  u_hi = vreinterpretq_s32_u32(vshll_high_n_u16(d, SGRPROJ_RST_BITS));
+
+                const int32x4_t v_lo = vmulq_n_s32(vsubq_s32(vld1q_s32(flt + j), u_lo), xq_active);
+                const int32x4_t v_hi = vmulq_n_s32(vsubq_s32(vld1q_s32(flt + j + 4), u_hi), xq_active);
+                const int16x8_t vr   = vcombine_s16(vqrshrn_n_s32(v_lo, shift), vqrshrn_n_s32(v_hi, shift));
+                const int16x8_t e    = vaddq_s16(vr, vreinterpretq_s16_u16(vsubq_u16(d, s)));
+                sse                  = svt_sdotq_s16(sse, e, e);
+            }
+            for (; j < width; ++j) {
+                const int32_t u = dat[j] << SGRPROJ_RST_BITS;
+                const int32_t v = xq_active * (flt[j] - u);
+                const int32_t e = ROUND_POWER_OF_TWO(v, shift) + dat[j] - src[j];
+                err += e * e;
+            }
+            dat += dat_stride;
+            src += src_stride;
+            flt += flt_stride;
+        }
+    } else {
+        for (i = 0; i < height; ++i) {
+            for (j = 0; j <= width - 8; j += 8) {
+                const int16x8_t e = vreinterpretq_s16_u16(vsubq_u16(vld1q_u16(dat + j), vld1q_u16(src + j)));
+                sse               = svt_sdotq_s16(sse, e, e);
+            }
+            for (; j < width; ++j) {
+                const int32_t e = dat[j] - src[j];
+                err += e * e;
+            }
+            dat += dat_stride;
+            src += src_stride;
+        }
+    }
+    return err + vaddvq_s64(sse);
+}
@@ -11,6 +11,7 @@
 
 #include <arm_neon.h>
 #include <arm_sve.h>
+#include <math.h>
 
 #include "aom_dsp_rtcd.h"
 #include "definitions.h"
@@ -125,3 +126,254 @@ void svt_av1_compute_stats_sve(int32_t wiener_win, const uint8_t *dgd, const uin
 
     svt_aom_free(d);
 }
+
+int64_t svt_av1_lowbd_pixel_proj_error_sve(const uint8_t *src8, int32_t width, int32_t height, int32_t src_stride,
+                                           const uint8_t *dat8, int32_t dat_stride, int32_t *flt0, int32_t flt0_stride,
+                                           int32_t *flt1, int32_t flt1_stride, int32_t xq[2],
+                                           const SgrParamsType *params) {
+    const int32_t  shift = SGRPROJ_RST_BITS + SGRPROJ_PRJ_BITS;
+    const uint8_t *src   = src8;
+    const uint8_t *dat   = dat8;
+    int64x2_t      sse   = vdupq_n_s64(0);
+    int64_t        err   = 0;
+    int            i, j;
+
+    // The error is a 16-bit value, so the 16-bit dot product squares and accumulates it straight into 64 bits.
+    if (params->r[0] > 0 && params->r[1] > 0) {
+        for (i = 0; i < height; ++i) {
+            for (j = 0; j <= width - 8; j += 8) {
+                const uint8x8_t d        = vld1_u8(dat + j);
+                const uint8x8_t s        = vld1_u8(src + j);
+                const int16x8_t u        = vreinterpretq_s16_u16(vshll_n_u8(d, SGRPROJ_RST_BITS));
+                const int16x8_t flt0_16b = vcombine_s16(vqmovn_s32(vld1q_s32(flt0 + j)),
+                                                        vqmovn_s32(vld1q_s32(flt0 + j + 4)));
+                const int16x8_t flt1_16b = vcombine_s16(vqmovn_s32(vld1q_s32(flt1 + j)),
+                                                        vqmovn_s32(vld1q_s32(flt1 + j + 4)));
+                const int16x8_t f0       = vsubq_s16(flt0_16b, u);
+                const int16x8_t f1       = vsubq_s16(flt1_16b, u);
+
+                int32x4_t v_lo     = vmull_n_s16(vget_low_s16(f0), (int16_t)xq[0]);
+                v_lo               = vmlal_n_s16(v_lo, vget_low_s16(f1), (int16_t)xq[1]);
+                int32x4_t v_hi     = vmull_n_s16(vget_high_s16(f0), (int16_t)xq[0]);
+                v_hi               = vmlal_n_s16(v_hi, vget_high_s16(f1), (int16_t)xq[1]);
+                const int16x8_t vr = vcombine_s16(vqrshrn_n_s32(v_lo, shift), vqrshrn_n_s32(v_hi, shift));
+                const int16x8_t e  = vaddq_s16(vr, vreinterpretq_s16_u16(vsubl_u8(d, s)));
+                sse                = svt_sdotq_s16(sse, e, e);
+            }
+            for (; j < width; ++j) {
+                const int32_t u = dat[j] << SGRPROJ_RST_BITS;
+                const int32_t v = xq[0] * (flt0[j] - u) + xq[1] * (flt1[j] - u);
+                const int32_t e = ROUND_POWER_OF_TWO(v, shift) + dat[j] - src[j];
+                err += e * e;
+            }
+            dat += dat_stride;
+            src += src_stride;
+            flt0 += flt0_stride;
+            flt1 += flt1_stride;
+        }
+    } else if (params->r[0] > 0 || params->r[1] > 0) {
+        const int      xq_active  = (params->r[0] > 0) ? xq[0] : xq[1];
+        const int32_t *flt        = (params->r[0] > 0) ? flt0 : flt1;
+        const int      flt_stride = (params->r[0] > 0) ? flt0_stride : flt1_stride;
+        for (i = 0; i < height; ++i) {
+            for (j = 0; j <= width - 8; j += 8) {
+                const uint8x8_t d       = vld1_u8(dat + j);
+                const uint8x8_t s       = vld1_u8(src + j);
+                const int16x8_t u       = vreinterpretq_s16_u16(vshll_n_u8(d, SGRPROJ_RST_BITS));
+                const int16x8_t flt_16b = vcombine_s16(vqmovn_s32(vld1q_s32(flt + j)),
+                                                       vqmovn_s32(vld1q_s32(flt + j + 4)));
+                const int16x8_t f       = vsubq_s16(flt_16b, u);
+
+                const int32x4_t v_lo = vmull_n_s16(vget_low_s16(f), (int16_t)xq_active);
+                const int32x4_t v_hi = vmull_n_s16(vget_high_s16(f), (int16_t)xq_active);
+                const int16x8_t vr   = vcombine_s16(vqrshrn_n_s32(v_lo, shift), vqrshrn_n_s32(v_hi, shift));
+                const int16x8_t e    = vaddq_s16(vr, vreinterpretq_s16_u16(vsubl_u8(d, s)));
+                sse                  = svt_sdotq_s16(sse, e, e);
+            }
+            for (; j < width; ++j) {
+                const int32_t u = dat[j] << SGRPROJ_RST_BITS;
+                const int32_t v = xq_active * (flt[j] - u);
+                const int32_t e = ROUND_POWER_OF_TWO(v, shift) + dat[j] - src[j];
+                err += e * e;
+            }
+            dat += dat_stride;
+            src += src_stride;
+            flt += flt_stride;
+        }
+    } else {
+        for (i = 0; i < height; ++i) {
+            for (j = 0; j <= width - 8; j += 8) {
+                const int16x8_t e = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(dat + j), vld1_u8(src + j)));
+                sse               = svt_sdotq_s16(sse, e, e);
+            }
+            for (; j < width; ++j) {
+                const int32_t e = dat[j] - src[j];
+                err += e * e;
+            }
+            dat += dat_stride;
+            src += src_stride;
+        }
+    }
+    return err + vaddvq_s64(sse);
+}
+
+static INLINE int64x2_t mlal_s32_x2(int64x2_t acc, const int32x4_t a, const int32x4_t b) {
+    acc = vmlal_s32(acc, vget_low_s32(a), vget_low_s32(b));
+    return vmlal_high_s32(acc, a, b);
+}
+
+/* All the sums are accumulated as exact integers, so H and C end up identical
+ * to the double accumulation of the C version. */
+void svt_get_proj_subspace_sve(const uint8_t *src8, int width, int height, int src_stride, const uint8_t *dat8,
+                               int dat_stride, int use_highbitdepth, int32_t *flt0, int flt0_stride, int32_t *flt1,
+                               int flt1_stride, int *xq, const SgrParamsType *params) {
+    double    H[2][2] = {{0, 0}, {0, 0}};
+    double    C[2]    = {0, 0};
+    double    det;
+    double    x[2];
+    const int size = width * height;
+    int64x2_t h_00 = vdupq_n_s64(0);
+    int64x2_t h_01 = vdupq_n_s64(0);
+    int64x2_t h_11 = vdupq_n_s64(0);
+    int64x2_t c_0  = vdupq_n_s64(0);
+    int64x2_t c_1  = vdupq_n_s64(0);
+
+    // Default
+    xq[0] = 0;
+    xq[1] = 0;
+
+    if (!use_highbitdepth) {
+        // At 8-bit f1, f2 and s fit in 16 bits: use the 16-bit dot product.
+        const uint8_t *src = src8;
+        const uint8_t *dat = dat8;
+        for (int i = 0; i < height; ++i) {
+            int j = 0;
+            for (; j <= width - 8; j += 8) {
+                const uint8x8_t d  = vld1_u8(dat + i * dat_stride + j);
+                const uint8x8_t s0 = vld1_u8(src + i * src_stride + j);
+                const int16x8_t u  = vreinterpretq_s16_u16(vshll_n_u8(d, SGRPROJ_RST_BITS));
+                const int16x8_t s  = vsubq_s16(vreinterpretq_s16_u16(vshll_n_u8(s0, SGRPROJ_RST_BITS)), u);
+                int16x8_t       f1 = vdupq_n_s16(0);
+                int16x8_t       f2 = vdupq_n_s16(0);
+
+                if (params->r[0] > 0) {
+                    const int32_t *flt = flt0 + i * flt0_stride + j;
+                    f1 = vsubq_s16(vcombine_s16(vqmovn_s32(vld1q_s32(flt)), vqmovn_s32(vld1q_s32(flt + 4))), u);
+                }
+                if (params->r[1] > 0) {
+                    const int32_t *flt = flt1 + i * flt1_stride + j;
+                    f2 = vsubq_s16(vcombine_s16(vqmovn_s32(vld1q_s32(flt)), vqmovn_s32(vld1q_s32(flt + 4))), u);
+                }
+                h_00 = svt_sdotq_s16(h_00, f1, f1);
+                h_11 = svt_sdotq_s16(h_11, f2, f2);
+                h_01 = svt_sdotq_s16(h_01, f1, f2);
+                c_0  = svt_sdotq_s16(c_0, f1, s);
+                c_1  = svt_sdotq_s16(c_1, f2, s);
+            }
+
+            //Complement when width not divided by 8
+            for (; j < width; ++j) {
+                const double u  = (double)(dat[i * dat_stride + j] << SGRPROJ_RST_BITS);
+                const double s  = (double)(src[i * src_stride + j] << SGRPROJ_RST_BITS) - u;
+                const double f1 = (params->r[0] > 0) ? (double)flt0[i * flt0_stride + j] - u : 0;
+                const double f2 = (params->r[1] > 0) ? (double)flt1[i * flt1_stride + j] - u : 0;
+                H[0][0] += f1 * f1;
+                H[1][1] += f2 * f2;
+                H[0][1] += f1 * f2;
+                C[0] += f1 * s;
+                C[1] += f2 * s;
+            }
+        }
+    } else {
+        // At 12-bit the differences do not fit in 16 bits: multiply into 64-bit lanes.
+        const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+        const uint16_t *dat = CONVERT_TO_SHORTPTR(dat8);
+        for (int i = 0; i < height; ++i) {
+            int j = 0;
+            for (; j <= width - 8; j += 8) {
+                const uint16x8_t d     = vld1q_u16(dat + i * dat_stride + j);
+                const int16x8_t  diff  = vreinterpretq_s16_u16(vsubq_u16(vld1q_u16(src + i * src_stride + j), d));
+                const int32x4_t  u_lo  = vreinterpretq_s32_u32(vshll_n_u16(vget_low_u16(d), SGRPROJ_RST_BITS));
+                const int32x4_t  u_hi  = vreinterpretq_s32_u32(vshll_high_n_u16(d, SGRPROJ_RST_BITS));
+                const int32x4_t  s_lo  = vshll_n_s16(vget_low_s16(diff), SGRPROJ_RST_BITS);
+                const int32x4_t  s_hi  = vshll_high_n_s16(diff, SGRPROJ_RST_BITS);
+                int32x4_t        f1_lo = vdupq_n_s32(0);
+                int32x4_t        f1_hi = vdupq_n_s32(0);
+                int32x4_t        f2_lo = vdupq_n_s32(0);
+                int32x4_t        f2_hi = vdupq_n_s32(0);
+
+                if (params->r[0] > 0) {
+                    f1_lo = vsubq_s32(vld1q_s32(flt0 + i * flt0_stride + j), u_lo);
+                    f1_hi = vsubq_s32(vld1q_s32(flt0 + i * flt0_stride + j + 4), u_hi);
+                }
+                if (params->r[1] > 0) {
+                    f2_lo = vsubq_s32(vld1q_s32(flt1 + i * flt1_stride + j), u_lo);
+                    f2_hi = vsubq_s32(vld1q_s32(flt1 + i * flt1_stride + j + 4), u_hi);
+                }
+                h_00 = mlal_s32_x2(mlal_s32_x2(h_00, f1_lo, f1_lo), f1_hi, f1_hi);
+                h_11 = mlal_s32_x2(mlal_s32_x2(h_11, f2_lo, f2_lo), f2_hi, f2_hi);
+                h_01 = mlal_s32_x2(mlal_s32_x2(h_01, f1_lo, f2_lo), f1_hi, f2_hi);
+                c_0  = mlal_s32_x2(mlal_s32_x2(c_0, f1_lo, s_lo), f1_hi, s_hi);
+                c_1  = mlal_s32_x2(mlal_s32_x2(c_1, f2_lo, s_lo), f2_hi, s_hi);
+            }
+
+            //Complement when width not divided by 8
+            for (; j < width; ++j) {
+                const double u  = (double)(dat[i * dat_stride + j] << SGRPROJ_RST_BITS);
+                const double s  = (double)(src[i * src_stride + j] << SGRPROJ_RST_BITS) - u;
+                const double f1 = (params->r[0] > 0) ? (double)flt0[i * flt0_stride + j] - u : 0;
+                const double f2 = (params->r[1] > 0) ? (double)flt1[i * flt1_stride + j] - u : 0;
+                H[0][0] += f1 * f1;
+                H[1][1] += f2 * f2;
+                H[0][1] += f1 * f2;
+                C[0] += f1 * s;
+                C[1] += f2 * s;
+            }
+        }
+    }
+
+    H[0][0] += (double)vaddvq_s64(h_00);
+    H[0][1] += (double)vaddvq_s64(h_01);
+    H[1][1] += (double)vaddvq_s64(h_11);
+    C[0] += (double)vaddvq_s64(c_0);
+    C[1] += (double)vaddvq_s64(c_1);
+
+    H[0][0] /= size;
+    H[0][1] /= size;
+    H[1][1] /= size;
+    H[1][0] = H[0][1];
+    C[0] /= size;
+    C[1] /= size;
+    if (params->r[0] == 0) {
+        // H matrix is now only the scalar H[1][1]
+        // C vector is now only the scalar C[1]
+        det = H[1][1];
+        if (det < 1e-8)
+            return; // ill-posed, return default values
+        x[0] = 0;
+        x[1] = C[1] / det;
+
+        xq[0] = 0;
+        xq[1] = (int)rint(x[1] * (1 << SGRPROJ_PRJ_BITS));
+    } else if (params->r[1] == 0) {
+        // H matrix is now only the scalar H[0][0]
+        // C vector is now only the scalar C[0]
+        det = H[0][0];
+        if (det < 1e-8)
+            return; // ill-posed, return default values
+        x[0] = C[0] / det;
+        x[1] = 0;
+
+        xq[0] = (int)rint(x[0] * (1 << SGRPROJ_PRJ_BITS));
+        xq[1] = 0;
+    } else {
+        det = (H[0][0] * H[1][1] - H[0][1] * H[1][0]);
+        if (det < 1e-8)
+            return; // ill-posed, return default values
+        x[0] = (H[1][1] * C[0] - H[0][1] * C[1]) / det;
+        x[1] = (H[0][0] * C[1] - H[1][0] * C[0]) / det;
+
+        xq[0] = (int)rint(x[0] * (1 << SGRPROJ_PRJ_BITS));
+        xq[1] = (int)rint(x[1] * (1 << SGRPROJ_PRJ_BITS));
+    }
+}
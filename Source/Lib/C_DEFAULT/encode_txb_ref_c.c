@@ -13,6 +13,7 @@
 #include "common_utils.h"
 #include "coefficients.h"
 #include "full_loop.h"
+#include "md_rate_estimation.h"
 
 static INLINE int get_nz_map_ctx(const uint8_t* const levels, const int coeff_idx, const int bwl, const int height,
                                  const int scan_idx, const int is_eob, const TxSize tx_size, const TxClass tx_class) {
@@ -38,3 +39,27 @@ void svt_av1_get_nz_map_contexts_c(const uint8_t* const levels, const int16_t* c
         coeff_contexts[pos] = get_nz_map_ctx(levels, pos, bwl, height, i, i == eob - 1, tx_size, tx_class);
     }
 }
+
+/* Rate of the coefficients at scan indices [1, c_start] of a transform block: base level (or
+base-range and Golomb) cost plus one sign bit per non-zero coefficient. The first (eob - 1) and
+last (DC) scan indices are costed separately by the caller. */
+int32_t svt_av1_cost_coeffs_txb_loop_c(const TranLow* const qcoeff, const int16_t* const scan,
+                                       const int8_t* const coeff_contexts, const uint8_t* const levels,
+                                       const struct LvMapCoeffCost* const coeff_costs, const int32_t c_start,
+                                       const int32_t bwl, const TxClass tx_class) {
+    int32_t  cost             = 0;
+    uint32_t cost_literal_cnt = 0;
+    for (int32_t c = c_start; c >= 1; --c) {
+        const int32_t pos   = scan[c];
+        const int32_t level = abs(qcoeff[pos]);
+        cost_literal_cnt += !!level;
+        if (level > NUM_BASE_LEVELS) {
+            const int32_t br_ctx = get_br_ctx(levels, pos, bwl, tx_class);
+            cost += coeff_costs->base_cost[coeff_contexts[pos]][3] +
+                get_br_golomb_cost(coeff_costs->lps_cost[br_ctx], level);
+        } else {
+            cost += coeff_costs->base_cost[coeff_contexts[pos]][level];
+        }
+    }
+    return cost + cost_literal_cnt * av1_cost_literal(1);
+}
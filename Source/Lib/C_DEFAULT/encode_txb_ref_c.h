@@ -21,6 +21,11 @@ extern "C" {
 
 void svt_av1_get_nz_map_contexts_c(const uint8_t* const levels, const int16_t* const scan, const uint16_t eob,
                                    const TxSize tx_size, const TxClass tx_class, int8_t* const coeff_contexts);
+struct LvMapCoeffCost;
+int32_t svt_av1_cost_coeffs_txb_loop_c(const TranLow* const qcoeff, const int16_t* const scan,
+                                       const int8_t* const coeff_contexts, const uint8_t* const levels,
+                                       const struct LvMapCoeffCost* const coeff_costs, const int32_t c_start,
+                                       const int32_t bwl, const TxClass tx_class);
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -88,6 +88,9 @@ typedef struct Av1Common {
     int32_t       sg_frame_ep;
     int8_t        sg_ref_frame_ep[2];
     uint8_t       use_boundaries_in_rest_search; // Use boundary pixels in restoration filtering search
+    // Pick the restoration type and coarse filter params on a subsampled grid of blocks of each restoration unit,
+    // then search only the winning type on the whole unit
+    Bool          use_sub_rest_search;
 
     FrameSize frm_size;
     TilesInfo tiles_info;
@@ -12,6 +12,7 @@
 #include "cdef.h"
 #include "common_dsp_rtcd.h"
 #include "bitstream_unit.h"
+#include "svt_malloc.h"
 
 //-------memory stuff
 
@@ -54,7 +55,7 @@ void *svt_aom_memalign(size_t align, size_t size) {
     if (!check_size_argument_overflow(1, aligned_size))
         return NULL;
 #endif
-    void *const addr = malloc(aligned_size);
+    void *const addr = svt_mem_malloc(aligned_size);
     if (addr) {
         x = align_addr((uint8_t *)addr + ADDRESS_STORAGE_SIZE, align);
         set_actual_malloc_address(x, addr);
@@ -67,7 +68,7 @@ void *svt_aom_malloc(size_t size) { return svt_aom_memalign(DEFAULT_ALIGNMENT, s
 void svt_aom_free(void *memblk) {
     if (memblk) {
         void *addr = get_actual_malloc_address(memblk);
-        free(addr);
+        svt_mem_free(addr);
     }
 }
 
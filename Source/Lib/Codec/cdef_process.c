@@ -25,6 +25,7 @@
 #include "utility.h"
 #include "pcs.h"
 #include "resize.h"
+#include "svt_trace.h"
 
 void svt_aom_copy_sb8_16(uint16_t *dst, int32_t dstride, const uint8_t *src, int32_t src_voffset, int32_t src_hoffset,
                          int32_t sstride, int32_t vsize, int32_t hsize, Bool is_16bit);
@@ -35,6 +36,8 @@ void   *svt_aom_malloc(size_t size);
 int32_t svt_sb_all_skip(PictureControlSet *pcs, const Av1Common *const cm, int32_t mi_row, int32_t mi_col);
 int32_t svt_sb_compute_cdef_list(PictureControlSet *pcs, const Av1Common *const cm, int32_t mi_row, int32_t mi_col,
                                  CdefList *dlist, BlockSize bs);
+void    svt_aom_cdef_prepare_strength_search(PictureControlSet *pcs);
+void    svt_aom_cdef_search_strength_bits(PictureControlSet *pcs, int32_t nb_strength_bits);
 void    finish_cdef_search(PictureControlSet *pcs);
 void    svt_av1_cdef_frame(SequenceControlSet *scs, PictureControlSet *pcs);
 void    svt_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
@@ -49,6 +52,7 @@ void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_p
 typedef struct CdefContext {
     EbFifo *cdef_input_fifo_ptr;
     EbFifo *cdef_output_fifo_ptr;
+    EbFifo *cdef_feedback_fifo_ptr;
 } CdefContext;
 
 static void cdef_context_dctor(EbPtr p) {
@@ -71,6 +75,9 @@ EbErrorType svt_aom_cdef_context_ctor(EbThreadContext *thread_ctx, const EbEncHa
                                                                           index);
     cdef_ctx->cdef_output_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->cdef_results_resource_ptr,
                                                                            index);
+    cdef_ctx->cdef_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->dlf_results_resource_ptr,
+        enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count + index);
 
     return EB_ErrorNone;
 }
@@ -348,6 +355,97 @@ static void cdef_seg_search(PictureControlSet *pcs, SequenceControlSet *scs, uin
     }
 }
 
+/******************************************************
+ * Apply CDEF once the strengths are picked, prepare the restoration and post the REST segments
+ ******************************************************/
+static void cdef_finish_picture(CdefContext *context_ptr, PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper) {
+    PictureParentControlSet *ppcs     = pcs->ppcs;
+    SequenceControlSet      *scs      = pcs->scs;
+    Bool                     is_16bit = scs->is_16bit_pipeline;
+    Av1Common               *cm       = ppcs->av1_cm;
+    FrameHeader             *frm_hdr  = &ppcs->frm_hdr;
+    EbObjectWrapper         *cdef_results_wrapper;
+    CdefResults             *cdef_results;
+
+    if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level) {
+        if (ppcs->enable_restoration || pcs->ppcs->is_ref || scs->static_config.recon_enabled) {
+            // Do application iff there are non-zero filters
+            if (frm_hdr->cdef_params.cdef_y_strength[0] != 0 || frm_hdr->cdef_params.cdef_uv_strength[0] != 0 ||
+                pcs->ppcs->nb_cdef_strengths != 1) {
+                svt_av1_cdef_frame(scs, pcs);
+            }
+        }
+    } else {
+        frm_hdr->cdef_params.cdef_bits           = 0;
+        frm_hdr->cdef_params.cdef_y_strength[0]  = 0;
+        pcs->ppcs->nb_cdef_strengths             = 1;
+        frm_hdr->cdef_params.cdef_uv_strength[0] = 0;
+    }
+
+    //restoration prep
+    Bool is_lr = ppcs->enable_restoration && frm_hdr->allow_intrabc == 0;
+    if (is_lr) {
+        svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
+        if (is_16bit) {
+            set_unscaled_input_16bit(pcs);
+        }
+    }
+
+    // ------- start: Normative upscaling - super-resolution tool
+    if (frm_hdr->allow_intrabc == 0 && pcs->ppcs->frame_superres_enabled) {
+        svt_av1_superres_upscale_frame(cm, pcs, scs);
+    }
+    if (scs->static_config.resize_mode != RESIZE_NONE) {
+        EbPictureBufferDesc *recon = NULL;
+        svt_aom_get_recon_pic(pcs, &recon, is_16bit);
+        recon->width  = pcs->ppcs->render_width;
+        recon->height = pcs->ppcs->render_height;
+        if (is_lr) {
+            EbPictureBufferDesc *input_pic = is_16bit ? pcs->input_frame16bit : pcs->ppcs->enhanced_unscaled_pic;
+
+            svt_aom_assert_err(pcs->scaled_input_pic == NULL, "pcs_ptr->scaled_input_pic is not desctoried!");
+            EbPictureBufferDesc *scaled_input_pic = NULL;
+            // downscale input picture if recon is resized
+            Bool is_resized = recon->width != input_pic->width || recon->height != input_pic->height;
+            if (is_resized) {
+                superres_params_type spr_params = {recon->width, recon->height, 0};
+                svt_aom_downscaled_source_buffer_desc_ctor(&scaled_input_pic, input_pic, spr_params);
+                svt_aom_resize_frame(input_pic,
+                                     scaled_input_pic,
+                                     scs->static_config.encoder_bit_depth,
+                                     av1_num_planes(&scs->seq_header.color_config),
+                                     scs->subsampling_x,
+                                     scs->subsampling_y,
+                                     input_pic->packed_flag,
+                                     PICTURE_BUFFER_DESC_FULL_MASK,
+                                     0); // is_2bcompress
+                pcs->scaled_input_pic = scaled_input_pic;
+            }
+        }
+    }
+    // ------- end: Normative upscaling - super-resolution tool
+
+    pcs->rest_segments_column_count = scs->rest_segment_column_count;
+    pcs->rest_segments_row_count    = scs->rest_segment_row_count;
+    pcs->rest_segments_total_count = (uint16_t)(pcs->rest_segments_column_count * pcs->rest_segments_row_count);
+    pcs->tot_seg_searched_rest     = 0;
+    pcs->ppcs->av1_cm->use_boundaries_in_rest_search = scs->use_boundaries_in_rest_search;
+    pcs->rest_extend_flag[0]                         = FALSE;
+    pcs->rest_extend_flag[1]                         = FALSE;
+    pcs->rest_extend_flag[2]                         = FALSE;
+
+    uint32_t segment_index;
+    for (segment_index = 0; segment_index < pcs->rest_segments_total_count; ++segment_index) {
+        // Get Empty Cdef Results to Rest
+        svt_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper);
+        cdef_results                = (struct CdefResults *)cdef_results_wrapper->object_ptr;
+        cdef_results->pcs_wrapper   = pcs_wrapper;
+        cdef_results->segment_index = segment_index;
+        // Post Cdef Results
+        svt_post_full_object(cdef_results_wrapper);
+    }
+}
+
 /******************************************************
  * CDEF Kernel
  ******************************************************/
@@ -362,27 +460,31 @@ void *svt_aom_cdef_kernel(void *input_ptr) {
     EbObjectWrapper *dlf_results_wrapper;
     DlfResults      *dlf_results;
 
-    //// Output
-    EbObjectWrapper *cdef_results_wrapper;
-    CdefResults     *cdef_results;
-
     // SB Loop variables
 
     for (;;) {
-        FrameHeader *frm_hdr;
-
         // Get DLF Results
         EB_GET_FULL_OBJECT(context_ptr->cdef_input_fifo_ptr, &dlf_results_wrapper);
 
-        dlf_results                   = (DlfResults *)dlf_results_wrapper->object_ptr;
-        pcs                           = (PictureControlSet *)dlf_results->pcs_wrapper->object_ptr;
-        PictureParentControlSet *ppcs = pcs->ppcs;
-        scs                           = pcs->scs;
+        dlf_results = (DlfResults *)dlf_results_wrapper->object_ptr;
+        pcs         = (PictureControlSet *)dlf_results->pcs_wrapper->object_ptr;
+        scs         = pcs->scs;
+        svt_trace_picture(pcs->picture_number, (int32_t)dlf_results->segment_index);
 
-        Bool       is_16bit      = scs->is_16bit_pipeline;
-        Av1Common *cm            = pcs->ppcs->av1_cm;
-        frm_hdr                  = &pcs->ppcs->frm_hdr;
         CdefControls *cdef_ctrls = &pcs->ppcs->cdef_ctrls;
+        if (dlf_results->strength_search) {
+            // Strength search for one number of signalling bits, the last one picks the strengths
+            svt_aom_cdef_search_strength_bits(pcs, (int32_t)dlf_results->segment_index);
+            svt_block_on_mutex(pcs->cdef_search_mutex);
+            const Bool last_search = ++pcs->tot_cdef_strength_searched == CDEF_STRENGTH_SEARCH_COUNT;
+            svt_release_mutex(pcs->cdef_search_mutex);
+            if (last_search) {
+                finish_cdef_search(pcs);
+                cdef_finish_picture(context_ptr, pcs, dlf_results->pcs_wrapper);
+            }
+            svt_release_object(dlf_results_wrapper);
+            continue;
+        }
         if (!cdef_ctrls->use_reference_cdef_fs) {
             if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level) {
                 cdef_seg_search(pcs, scs, dlf_results->segment_index);
@@ -390,91 +492,29 @@ void *svt_aom_cdef_kernel(void *input_ptr) {
         }
         //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
         svt_block_on_mutex(pcs->cdef_search_mutex);
+        const Bool last_segment = ++pcs->tot_seg_searched_cdef == pcs->cdef_segments_total_count;
+        svt_release_mutex(pcs->cdef_search_mutex);
 
-        pcs->tot_seg_searched_cdef++;
-        if (pcs->tot_seg_searched_cdef == pcs->cdef_segments_total_count) {
-            // SVT_LOG("    CDEF all seg here  %i\n", pcs->picture_number);
-            if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level) {
-                finish_cdef_search(pcs);
-                if (ppcs->enable_restoration || pcs->ppcs->is_ref || scs->static_config.recon_enabled) {
-                    // Do application iff there are non-zero filters
-                    if (frm_hdr->cdef_params.cdef_y_strength[0] != 0 || frm_hdr->cdef_params.cdef_uv_strength[0] != 0 ||
-                        pcs->ppcs->nb_cdef_strengths != 1) {
-                        svt_av1_cdef_frame(scs, pcs);
-                    }
+        if (last_segment) {
+            if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level && !cdef_ctrls->use_reference_cdef_fs) {
+                // Run the strength search for each number of signalling bits as a separate CDEF task
+                svt_aom_cdef_prepare_strength_search(pcs);
+                pcs->tot_cdef_strength_searched = 0;
+                for (uint32_t nb_strength_bits = 0; nb_strength_bits < CDEF_STRENGTH_SEARCH_COUNT; nb_strength_bits++) {
+                    EbObjectWrapper *search_wrapper;
+                    svt_get_empty_object(context_ptr->cdef_feedback_fifo_ptr, &search_wrapper);
+                    DlfResults *search_task      = (DlfResults *)search_wrapper->object_ptr;
+                    search_task->pcs_wrapper     = dlf_results->pcs_wrapper;
+                    search_task->segment_index   = nb_strength_bits;
+                    search_task->strength_search = TRUE;
+                    svt_post_full_object(search_wrapper);
                 }
             } else {
-                frm_hdr->cdef_params.cdef_bits           = 0;
-                frm_hdr->cdef_params.cdef_y_strength[0]  = 0;
-                pcs->ppcs->nb_cdef_strengths             = 1;
-                frm_hdr->cdef_params.cdef_uv_strength[0] = 0;
-            }
-
-            //restoration prep
-            Bool is_lr = ppcs->enable_restoration && frm_hdr->allow_intrabc == 0;
-            if (is_lr) {
-                svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
-                if (is_16bit) {
-                    set_unscaled_input_16bit(pcs);
-                }
-            }
-
-            // ------- start: Normative upscaling - super-resolution tool
-            if (frm_hdr->allow_intrabc == 0 && pcs->ppcs->frame_superres_enabled) {
-                svt_av1_superres_upscale_frame(cm, pcs, scs);
-            }
-            if (scs->static_config.resize_mode != RESIZE_NONE) {
-                EbPictureBufferDesc *recon = NULL;
-                svt_aom_get_recon_pic(pcs, &recon, is_16bit);
-                recon->width  = pcs->ppcs->render_width;
-                recon->height = pcs->ppcs->render_height;
-                if (is_lr) {
-                    EbPictureBufferDesc *input_pic = is_16bit ? pcs->input_frame16bit
-                                                              : pcs->ppcs->enhanced_unscaled_pic;
-
-                    svt_aom_assert_err(pcs->scaled_input_pic == NULL, "pcs_ptr->scaled_input_pic is not desctoried!");
-                    EbPictureBufferDesc *scaled_input_pic = NULL;
-                    // downscale input picture if recon is resized
-                    Bool is_resized = recon->width != input_pic->width || recon->height != input_pic->height;
-                    if (is_resized) {
-                        superres_params_type spr_params = {recon->width, recon->height, 0};
-                        svt_aom_downscaled_source_buffer_desc_ctor(&scaled_input_pic, input_pic, spr_params);
-                        svt_aom_resize_frame(input_pic,
-                                             scaled_input_pic,
-                                             scs->static_config.encoder_bit_depth,
-                                             av1_num_planes(&scs->seq_header.color_config),
-                                             scs->subsampling_x,
-                                             scs->subsampling_y,
-                                             input_pic->packed_flag,
-                                             PICTURE_BUFFER_DESC_FULL_MASK,
-                                             0); // is_2bcompress
-                        pcs->scaled_input_pic = scaled_input_pic;
-                    }
-                }
-            }
-            // ------- end: Normative upscaling - super-resolution tool
-
-            pcs->rest_segments_column_count = scs->rest_segment_column_count;
-            pcs->rest_segments_row_count    = scs->rest_segment_row_count;
-            pcs->rest_segments_total_count = (uint16_t)(pcs->rest_segments_column_count * pcs->rest_segments_row_count);
-            pcs->tot_seg_searched_rest     = 0;
-            pcs->ppcs->av1_cm->use_boundaries_in_rest_search = scs->use_boundaries_in_rest_search;
-            pcs->rest_extend_flag[0]                         = FALSE;
-            pcs->rest_extend_flag[1]                         = FALSE;
-            pcs->rest_extend_flag[2]                         = FALSE;
-
-            uint32_t segment_index;
-            for (segment_index = 0; segment_index < pcs->rest_segments_total_count; ++segment_index) {
-                // Get Empty Cdef Results to Rest
-                svt_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper);
-                cdef_results                = (struct CdefResults *)cdef_results_wrapper->object_ptr;
-                cdef_results->pcs_wrapper   = dlf_results->pcs_wrapper;
-                cdef_results->segment_index = segment_index;
-                // Post Cdef Results
-                svt_post_full_object(cdef_results_wrapper);
+                if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level)
+                    finish_cdef_search(pcs);
+                cdef_finish_picture(context_ptr, pcs, dlf_results->pcs_wrapper);
             }
         }
-        svt_release_mutex(pcs->cdef_search_mutex);
 
         // Release Dlf Results
         svt_release_object(dlf_results_wrapper);
@@ -16,6 +16,7 @@
 #include "definitions.h"
 #include "block_structures.h"
 #include "cabac_context_model.h"
+#include "bitstream_unit.h"
 
 #define MAX_OFFSET_WIDTH 64
 #define MAX_OFFSET_HEIGHT 0
@@ -139,4 +140,14 @@ static AOM_FORCE_INLINE int get_br_ctx(const uint8_t *const levels,
     }
     return mag + 14;
 }
+
+// Base-range (lps) and Golomb cost of a coefficient whose level is above NUM_BASE_LEVELS, given the
+// lps cost row of its base-range context.
+static AOM_FORCE_INLINE int32_t get_br_golomb_cost(const int32_t *const lps_cost, const int32_t level) {
+    const int32_t base_range = level - 1 - NUM_BASE_LEVELS;
+    if (base_range < COEFF_BASE_RANGE)
+        return lps_cost[base_range];
+    const int32_t length = get_msb(level - COEFF_BASE_RANGE - NUM_BASE_LEVELS) + 1;
+    return lps_cost[COEFF_BASE_RANGE] + ((2 * length - 1) << AV1_PROB_COST_SHIFT);
+}
 #endif //EbCommonUtils_h
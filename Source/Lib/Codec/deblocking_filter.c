@@ -20,8 +20,11 @@
 #include "sequence_control_set.h"
 #include "reference_object.h"
 #include "common_utils.h"
+#include "svt_threads.h"
 //#include "svt_log.h"
 #define DLF_MAX_LVL 4
+// Number of luma lines above a SB row that are modified when filtering the horizontal edges of the row
+#define DLF_SEARCH_ROW_OVERLAP 8
 const int32_t  inter_frame_multiplier[INPUT_SIZE_COUNT]      = {6017, 6017, 6017, 12034, 12034, 12034, 12034};
 const uint32_t disable_dlf_th[DLF_MAX_LVL][INPUT_SIZE_COUNT] = {{0, 0, 0, 0, 0, 0, 0},
                                                                 {100, 200, 500, 800, 1000, 1000, 1000},
@@ -652,6 +655,42 @@ void svt_av1_loop_filter_frame(EbPictureBufferDesc *frame_buffer, PictureControl
     }
 }
 
+/*************************************************************************************************
+* svt_av1_loop_filter_sb_row
+* Filter one superblock row of the frame, in the order of svt_av1_loop_filter_frame(). The horizontal
+* edges of a superblock also modify the bottom of the superblock above, so they are filtered once the
+* row above has filtered its horizontal edges up to the same column. Rows may then be filtered by
+* several threads, each waiting on row_progress[sb_row - 1].
+*************************************************************************************************/
+void svt_av1_loop_filter_sb_row(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs, CondVar *row_progress,
+                                uint32_t sb_row, int32_t plane_start, int32_t plane_end) {
+    SequenceControlSet *scs             = pcs->scs;
+    uint8_t             sb_size_log2    = (uint8_t)svt_log2f(scs->sb_size);
+    uint32_t            pic_width_in_sb = (pcs->ppcs->aligned_width + scs->sb_size - 1) / scs->sb_size;
+    uint32_t            sb_origin_y     = sb_row << sb_size_log2;
+
+    for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+        const Bool end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? TRUE : FALSE;
+        // Horizontal edges are filtered up to the previous SB, or up to this one at the end of the row
+        const int32_t horz_done = (int32_t)x_sb_index + (end_of_row_flag ? 1 : 0);
+        if (sb_row) {
+            CondVar *above = &row_progress[sb_row - 1];
+            int32_t  above_done;
+            while ((above_done = (int32_t)svt_atomic_load_u32((volatile uint32_t *)&above->val)) < horz_done)
+                svt_wait_cond_var(above, above_done);
+        }
+        svt_aom_loop_filter_sb(frame_buffer,
+                               pcs,
+                               sb_origin_y >> 2,
+                               (x_sb_index << sb_size_log2) >> 2,
+                               plane_start,
+                               plane_end,
+                               end_of_row_flag);
+        if (horz_done)
+            svt_set_cond_var(&row_progress[sb_row], horz_done);
+    }
+}
+
 void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuffer, PictureControlSet *pcs,
                      uint8_t plane) {
     Bool is_16bit           = pcs->ppcs->scs->is_16bit_pipeline;
@@ -713,7 +752,47 @@ void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuf
         }
     }
 }
-static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBufferDesc *recon_ptr, int32_t plane)
+/*************************************************************************************************
+* copy_buffer_rows
+* Copy a plane of srcBuffer to dstBuffer on the luma rows [row_start, row_end) (clipped to the picture).
+* Both buffers must share the same layout, i.e. dstBuffer was set up by svt_copy_buffer() from srcBuffer.
+*************************************************************************************************/
+static void copy_buffer_rows(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuffer, PictureControlSet *pcs,
+                             uint8_t plane, uint32_t row_start, uint32_t row_end) {
+    Bool           is_16bit    = pcs->ppcs->scs->is_16bit_pipeline;
+    const uint32_t luma_height = ALIGN_POWER_OF_TWO(srcBuffer->height, 3);
+    uint32_t       width       = ALIGN_POWER_OF_TWO(srcBuffer->width, 3) << is_16bit;
+    uint32_t       stride;
+    uint32_t       offset;
+    uint8_t       *src;
+    uint8_t       *dst;
+
+    row_end = AOMMIN(row_end, luma_height);
+    if (plane == 0) {
+        stride = srcBuffer->stride_y << is_16bit;
+        offset = (srcBuffer->org_x + srcBuffer->org_y * srcBuffer->stride_y) << is_16bit;
+        src    = srcBuffer->buffer_y;
+        dst    = dstBuffer->buffer_y;
+    } else {
+        const uint32_t stride_c = plane == 1 ? srcBuffer->stride_cb : srcBuffer->stride_cr;
+        stride                  = stride_c << is_16bit;
+        offset                  = (srcBuffer->org_x / 2 + srcBuffer->org_y / 2 * stride_c) << is_16bit;
+        src                     = plane == 1 ? srcBuffer->buffer_cb : srcBuffer->buffer_cr;
+        dst                     = plane == 1 ? dstBuffer->buffer_cb : dstBuffer->buffer_cr;
+        width >>= 1;
+        row_start >>= 1;
+        row_end >>= 1;
+    }
+    for (uint32_t row = row_start; row < row_end; row++)
+        svt_memcpy(dst + offset + stride * row, src + offset + stride * row, width);
+}
+/*************************************************************************************************
+* picture_sse_calculations
+* Compute the SSE of a plane between the input and the recon, on the luma rows [row_start, row_end)
+* (clipped to the picture).
+*************************************************************************************************/
+static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBufferDesc *recon_ptr, int32_t plane,
+                                         uint32_t row_start, uint32_t row_end)
 
 {
     SequenceControlSet *scs      = pcs->ppcs->scs;
@@ -729,12 +808,16 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
     const uint16_t input_align_height = pcs->ppcs->aligned_height;
     const uint32_t ss_x               = scs->subsampling_x;
     const uint32_t ss_y               = scs->subsampling_y;
+    const uint32_t plane_ss_y         = plane ? ss_y : 0;
 
     uint8_t *input_buffer;
     uint8_t *recon_coeff_buffer;
 
     if (!is_16bit) {
-        EbPictureBufferDesc *input_pic = (EbPictureBufferDesc *)pcs->ppcs->enhanced_pic;
+        EbPictureBufferDesc *input_pic    = (EbPictureBufferDesc *)pcs->ppcs->enhanced_pic;
+        const uint32_t       plane_height = plane ? input_align_height >> ss_y : input_align_height;
+        const uint32_t       first_row    = AOMMIN(row_start >> plane_ss_y, plane_height);
+        const uint32_t       last_row     = AOMMIN(row_end >> plane_ss_y, plane_height);
 
         if (plane == 0) {
             recon_coeff_buffer = (uint8_t *)&(
@@ -743,13 +826,13 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                 (input_pic->buffer_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
 
             return svt_spatial_full_distortion_kernel(input_buffer,
-                                                      0,
+                                                      first_row * input_pic->stride_y,
                                                       input_pic->stride_y,
                                                       recon_coeff_buffer,
-                                                      0,
+                                                      first_row * recon_ptr->stride_y,
                                                       recon_ptr->stride_y,
                                                       input_align_width,
-                                                      input_align_height);
+                                                      last_row - first_row);
         } else if (plane == 1) {
             recon_coeff_buffer = (uint8_t *)&(
                 (recon_ptr->buffer_cb)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cb]);
@@ -757,13 +840,13 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                 (input_pic->buffer_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
 
             return svt_spatial_full_distortion_kernel(input_buffer,
-                                                      0,
+                                                      first_row * input_pic->stride_cb,
                                                       input_pic->stride_cb,
                                                       recon_coeff_buffer,
-                                                      0,
+                                                      first_row * recon_ptr->stride_cb,
                                                       recon_ptr->stride_cb,
                                                       input_align_width >> ss_x,
-                                                      input_align_height >> ss_y);
+                                                      last_row - first_row);
         } else if (plane == 2) {
             recon_coeff_buffer = (uint8_t *)&(
                 (recon_ptr->buffer_cr)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cr]);
@@ -771,17 +854,20 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                 (input_pic->buffer_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
 
             return svt_spatial_full_distortion_kernel(input_buffer,
-                                                      0,
+                                                      first_row * input_pic->stride_cr,
                                                       input_pic->stride_cr,
                                                       recon_coeff_buffer,
-                                                      0,
+                                                      first_row * recon_ptr->stride_cr,
                                                       recon_ptr->stride_cr,
                                                       input_align_width >> ss_x,
-                                                      input_align_height >> ss_y);
+                                                      last_row - first_row);
         }
         return 0;
     } else {
-        EbPictureBufferDesc *input_pic = (EbPictureBufferDesc *)pcs->input_frame16bit;
+        EbPictureBufferDesc *input_pic    = (EbPictureBufferDesc *)pcs->input_frame16bit;
+        const uint32_t       plane_height = plane ? (input_pic->height + ss_y) >> ss_y : input_pic->height;
+        const uint32_t       first_row    = AOMMIN(row_start >> plane_ss_y, plane_height);
+        const uint32_t       last_row     = AOMMIN(row_end >> plane_ss_y, plane_height);
 
         if (plane == 0) {
             recon_coeff_buffer = (uint8_t *)&(
@@ -790,13 +876,13 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                 (input_pic->buffer_y)[(input_pic->org_x + input_pic->org_y * input_pic->stride_y) << is_16bit]);
 
             return svt_full_distortion_kernel16_bits(input_buffer,
-                                                     0,
+                                                     first_row * input_pic->stride_y,
                                                      input_pic->stride_y,
                                                      recon_coeff_buffer,
-                                                     0,
+                                                     first_row * recon_ptr->stride_y,
                                                      recon_ptr->stride_y,
                                                      input_pic->width,
-                                                     input_pic->height);
+                                                     last_row - first_row);
         } else if (plane == 1) {
             recon_coeff_buffer = (uint8_t *)&(
                 (recon_ptr
@@ -806,13 +892,13 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                      ->buffer_cb)[(input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb) << is_16bit]);
 
             return svt_full_distortion_kernel16_bits(input_buffer,
-                                                     0,
+                                                     first_row * input_pic->stride_cb,
                                                      input_pic->stride_cb,
                                                      recon_coeff_buffer,
-                                                     0,
+                                                     first_row * recon_ptr->stride_cb,
                                                      recon_ptr->stride_cb,
                                                      (input_pic->width + ss_x) >> ss_x,
-                                                     (input_pic->height + ss_y) >> ss_y);
+                                                     last_row - first_row);
         } else if (plane == 2) {
             recon_coeff_buffer = (uint8_t *)&(
                 (recon_ptr
@@ -822,13 +908,13 @@ static uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBuffer
                      ->buffer_cr)[(input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr) << is_16bit]);
 
             return svt_full_distortion_kernel16_bits(input_buffer,
-                                                     0,
+                                                     first_row * input_pic->stride_cr,
                                                      input_pic->stride_cr,
                                                      recon_coeff_buffer,
-                                                     0,
+                                                     first_row * recon_ptr->stride_cr,
                                                      recon_ptr->stride_cr,
                                                      (input_pic->width + ss_x) >> ss_x,
-                                                     (input_pic->height + ss_y) >> ss_y);
+                                                     last_row - first_row);
         }
         return 0;
     }
@@ -844,8 +930,6 @@ static int64_t try_filter_frame(
     const EbPictureBufferDesc *sd, EbPictureBufferDesc *temp_lf_recon_buffer, PictureControlSet *pcs,
     int32_t filt_level, int32_t partial_frame, int32_t plane, int32_t dir) {
     (void)sd;
-    (void)partial_frame;
-    (void)sd;
     int64_t      filt_err;
     FrameHeader *frm_hdr = &pcs->ppcs->frm_hdr;
     assert(plane >= 0 && plane <= 2);
@@ -869,13 +953,43 @@ static int64_t try_filter_frame(
     case 2: frm_hdr->loop_filter_params.filter_level_v = filter_level[0]; break;
     }
 
-    svt_av1_loop_filter_frame(recon_buffer, pcs, plane, plane + 1);
+    if (!partial_frame) {
+        svt_av1_loop_filter_frame(recon_buffer, pcs, plane, plane + 1);
 
-    filt_err = picture_sse_calculations(pcs, recon_buffer, plane);
+        filt_err = picture_sse_calculations(pcs, recon_buffer, plane, 0, pcs->ppcs->aligned_height);
 
-    // Re-instate the unfiltered frame
-    svt_copy_buffer(
-        temp_lf_recon_buffer /*cpi->last_frame_uf*/, recon_buffer /*cm->frame_to_show*/, pcs, (uint8_t)plane);
+        // Re-instate the unfiltered frame
+        svt_copy_buffer(
+            temp_lf_recon_buffer /*cpi->last_frame_uf*/, recon_buffer /*cm->frame_to_show*/, pcs, (uint8_t)plane);
+        return filt_err;
+    }
+    // Filter and measure every search_sb_row_step-th SB row only. The horizontal edges at the top of
+    // a SB row also modify the bottom lines of the row above, so these lines are measured and restored
+    // with the row.
+    const uint32_t sb_size              = pcs->scs->sb_size;
+    const uint8_t  sb_size_log2         = (uint8_t)svt_log2f(sb_size);
+    const uint32_t sb_row_step          = pcs->ppcs->dlf_ctrls.search_sb_row_step;
+    const uint32_t pic_width_in_sb      = (pcs->ppcs->aligned_width + sb_size - 1) / sb_size;
+    const uint32_t picture_height_in_sb = (pcs->ppcs->aligned_height + sb_size - 1) / sb_size;
+
+    svt_av1_loop_filter_frame_init(frm_hdr, &pcs->ppcs->lf_info, plane, plane + 1);
+    filt_err = 0;
+    for (uint32_t y_sb_index = 0; y_sb_index < picture_height_in_sb; y_sb_index += sb_row_step) {
+        const uint32_t sb_origin_y = y_sb_index << sb_size_log2;
+        for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index)
+            svt_aom_loop_filter_sb(recon_buffer,
+                                   pcs,
+                                   sb_origin_y >> 2,
+                                   (x_sb_index << sb_size_log2) >> 2,
+                                   plane,
+                                   plane + 1,
+                                   x_sb_index == pic_width_in_sb - 1);
+
+        const uint32_t row_start = y_sb_index ? sb_origin_y - DLF_SEARCH_ROW_OVERLAP : 0;
+        const uint32_t row_end   = sb_origin_y + sb_size;
+        filt_err += picture_sse_calculations(pcs, recon_buffer, plane, row_start, row_end);
+        copy_buffer_rows(temp_lf_recon_buffer, recon_buffer, pcs, (uint8_t)plane, row_start, row_end);
+    }
 
     return filt_err;
 }
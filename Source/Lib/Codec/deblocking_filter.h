@@ -51,6 +51,9 @@ void svt_av1_loop_filter_frame(
         /*MacroBlockD *xd,*/ int32_t plane_start, int32_t plane_end/*,
         int32_t partial_frame*/);
 
+void svt_av1_loop_filter_sb_row(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs, CondVar *row_progress,
+                                uint32_t sb_row, int32_t plane_start, int32_t plane_end);
+
 EbErrorType svt_av1_pick_filter_level(EbPictureBufferDesc *srcBuffer, // source input
                                       PictureControlSet *pcs, LpfPickMethod method);
 void        svt_av1_pick_filter_level_by_q(PictureControlSet *pcs, uint8_t qindex, int32_t *filter_level);
@@ -211,6 +211,13 @@ typedef struct TfControls {
     uint8_t ref_frame_factor;
     // Specifies whether to tune the params using qp (0: OFF, 1: ON)
     uint8_t qp_opt;
+    // Specifies the zero-motion luma MSE, in % of the luma noise variance, under which the 64x64
+    // block is predicted with the (0, 0) MV without ME and Sub-Pel search (0: OFF)
+    uint16_t zz_skip_th;
+    // Specifies whether the ME of a reference frame starts from the 64x64 MV found for the
+    // previous reference frame on the same side, scaled by the temporal distance, instead of HME
+    // (0: OFF, 1: ON)
+    uint8_t seed_me;
 } TfControls;
 typedef enum GM_LEVEL {
     GM_FULL   = 0, // Exhaustive search mode.
@@ -319,6 +326,7 @@ enum {
 #define MAX_TXB_COUNT 16 // Maximum number of transform blocks per depth
 #define MAX_TXB_COUNT_UV 4 // Maximum number of transform blocks per depth for chroma planes
 #define MAX_LAD 120 // max lookahead-distance 2x60fps
+#define MAX_WORKER_POOL_SIZE 1024 // max execution slots shared by the encoder threads
 #define ROUND_UV(x) (((x) >> 3) << 3)
 #define AV1_PROB_COST_SHIFT 9
 #define AOMINNERBORDERINPIXELS 160
@@ -2079,6 +2087,20 @@ static const EbWarpedMotionParams default_warp_params = {
 #define    SUB_SAD_SEARCH      0
 #define    FULL_SAD_SEARCH     1
 #define    SSD_SEARCH          2
+
+/* One reference of svt_ext_all_sad_calculation_8x8_16x16_multi(): the reference
+   block at the current eight search positions, their MV, the best SAD / MV arrays
+   of the reference and where to store the eight 16x16 SADs */
+typedef struct MeSadRef {
+    uint8_t  *ref;
+    uint32_t  ref_stride;
+    uint32_t  mv;
+    uint32_t *p_best_sad_8x8;
+    uint32_t *p_best_sad_16x16;
+    uint32_t *p_best_mv8x8;
+    uint32_t *p_best_mv16x16;
+    uint32_t (*p_eight_sad16x16)[8];
+} MeSadRef;
 /************************ INPUT CLASS **************************/
 
 #define EbInputResolution             uint8_t
@@ -20,11 +20,16 @@
 #include "sequence_control_set.h"
 #include "pcs.h"
 #include "aom_dsp_rtcd.h"
+#include "svt_trace.h"
 void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 void svt_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
 void svt_convert_pic_8bit_to_16bit(EbPictureBufferDesc *src_8bit, EbPictureBufferDesc *dst_16bit, uint16_t ss_x,
                                    uint16_t ss_y);
 
+// Luma lines below a CDEF segment read by its search (the CDEF border) or modified by the DLF of the
+// next SB row
+#define CDEF_DLF_ROW_MARGIN 16
+
 extern void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 
 static void dlf_context_dctor(EbPtr p) {
@@ -49,6 +54,126 @@ EbErrorType svt_aom_dlf_context_ctor(EbThreadContext *thread_ctx, const EbEncHan
     return EB_ErrorNone;
 }
 
+/******************************************************
+ * Frame level DLF
+ * The frame is filtered when the SB based DLF of EncDec is off, or when
+ * several tile groups were coded in parallel.
+ ******************************************************/
+static Bool use_frame_level_dlf(PictureControlSet *pcs) {
+    const uint16_t tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
+    return pcs->ppcs->dlf_ctrls.enabled && (!pcs->ppcs->dlf_ctrls.sb_based_dlf || tg_count > 1);
+}
+
+static uint32_t get_dlf_sb_rows(PictureControlSet *pcs) {
+    return (pcs->ppcs->aligned_height + pcs->scs->sb_size - 1) / pcs->scs->sb_size;
+}
+
+/******************************************************
+ * Number of DLF tasks a picture is split into: the frame
+ * level DLF is shared by the DLF threads one SB row at a time
+ ******************************************************/
+uint16_t svt_aom_get_dlf_segment_count(PictureControlSet *pcs) {
+    if (!use_frame_level_dlf(pcs))
+        return 1;
+    return (uint16_t)MIN(pcs->scs->dlf_process_init_count, get_dlf_sb_rows(pcs));
+}
+
+/******************************************************
+ * Picture setup, done by the first DLF task of the picture:
+ * 16 bit conversions, the frame level DLF parameters
+ * and the CDEF inputs
+ ******************************************************/
+static void dlf_picture_setup(PictureControlSet *pcs) {
+    SequenceControlSet *scs      = pcs->scs;
+    Bool                is_16bit = scs->is_16bit_pipeline;
+    if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
+        svt_convert_pic_8bit_to_16bit(pcs->ppcs->enhanced_pic,
+                                      pcs->input_frame16bit,
+                                      pcs->ppcs->scs->subsampling_x,
+                                      pcs->ppcs->scs->subsampling_y);
+        // convert 8-bit recon to 16-bit for it bypass encdec process
+        if (pcs->pic_bypass_encdec) {
+            EbPictureBufferDesc *recon_pic;
+            EbPictureBufferDesc *recon_picture_16bit_ptr;
+            svt_aom_get_recon_pic(pcs, &recon_pic, 0);
+            svt_aom_get_recon_pic(pcs, &recon_picture_16bit_ptr, 1);
+            svt_convert_pic_8bit_to_16bit(
+                recon_pic, recon_picture_16bit_ptr, pcs->ppcs->scs->subsampling_x, pcs->ppcs->scs->subsampling_y);
+        }
+    }
+    if (use_frame_level_dlf(pcs)) {
+        svt_av1_loop_filter_init(pcs);
+        svt_av1_pick_filter_level((EbPictureBufferDesc *)pcs->ppcs->enhanced_pic,
+                                  pcs,
+                                  pcs->ppcs->dlf_ctrls.search_sb_row_step > 1 ? LPF_PICK_FROM_SUBIMAGE
+                                                                              : LPF_PICK_FROM_FULL_IMAGE);
+        svt_av1_loop_filter_frame_init(&pcs->ppcs->frm_hdr, &pcs->ppcs->lf_info, 0, 3);
+        for (uint32_t sb_row = 0; sb_row < get_dlf_sb_rows(pcs); sb_row++)
+            svt_set_cond_var(&pcs->dlf_row_progress[sb_row], 0);
+        pcs->dlf_next_sb_row = 0;
+    }
+
+    // CDEF segments are posted while the picture is filtered, see post_cdef_segments()
+    if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level) {
+        EbPictureBufferDesc *recon_pic;
+        svt_aom_get_recon_pic(pcs, &recon_pic, is_16bit);
+        const uint32_t offset_y  = recon_pic->org_x + recon_pic->org_y * recon_pic->stride_y;
+        pcs->cdef_input_recon[0] = recon_pic->buffer_y + (offset_y << is_16bit);
+        const uint32_t offset_cb = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cb) >> 1;
+        pcs->cdef_input_recon[1] = recon_pic->buffer_cb + (offset_cb << is_16bit);
+        const uint32_t offset_cr = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cr) >> 1;
+        pcs->cdef_input_recon[2] = recon_pic->buffer_cr + (offset_cr << is_16bit);
+
+        EbPictureBufferDesc *input_pic      = is_16bit ? pcs->input_frame16bit : pcs->ppcs->enhanced_pic;
+        const uint32_t       input_offset_y = input_pic->org_x + input_pic->org_y * input_pic->stride_y;
+        pcs->cdef_input_source[0]           = input_pic->buffer_y + (input_offset_y << is_16bit);
+        const uint32_t input_offset_cb      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cb) >> 1;
+        pcs->cdef_input_source[1]           = input_pic->buffer_cb + (input_offset_cb << is_16bit);
+        const uint32_t input_offset_cr      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cr) >> 1;
+        pcs->cdef_input_source[2]           = input_pic->buffer_cr + (input_offset_cr << is_16bit);
+    }
+    pcs->cdef_segments_column_count = scs->cdef_segment_column_count;
+    pcs->cdef_segments_row_count    = scs->cdef_segment_row_count;
+    pcs->cdef_segments_total_count  = (uint16_t)(pcs->cdef_segments_column_count * pcs->cdef_segments_row_count);
+    pcs->cdef_segments_posted       = 0;
+    pcs->tot_seg_searched_cdef      = 0;
+}
+
+/******************************************************
+ * Number of DLF SB rows that must be filtered before a
+ * CDEF segment can be searched: the rows it covers, its
+ * CDEF border, and the next row whose horizontal edges
+ * modify the bottom lines of the rows above
+ ******************************************************/
+static uint32_t get_cdef_segment_dlf_rows(PictureControlSet *pcs, uint32_t segment_index) {
+    const uint32_t sb_size        = pcs->scs->sb_size;
+    const uint32_t b64_pic_height = (pcs->ppcs->aligned_height + 64 - 1) / 64;
+    const uint32_t y_seg_idx      = segment_index / pcs->cdef_segments_column_count;
+    const uint32_t y_b64_end_idx  = SEGMENT_END_IDX(y_seg_idx, b64_pic_height, pcs->cdef_segments_row_count);
+    return MIN(get_dlf_sb_rows(pcs), ((y_b64_end_idx << 6) + CDEF_DLF_ROW_MARGIN) / sb_size + 1);
+}
+
+/******************************************************
+ * Post the CDEF segments, in order, whose DLF rows are
+ * all among the first dlf_rows_done rows
+ ******************************************************/
+static void post_cdef_segments(DlfContext *context_ptr, PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper,
+                               uint32_t dlf_rows_done) {
+    while (pcs->cdef_segments_posted < pcs->cdef_segments_total_count &&
+           get_cdef_segment_dlf_rows(pcs, pcs->cdef_segments_posted) <= dlf_rows_done) {
+        // Get Empty DLF Results to Cdef
+        EbObjectWrapper   *dlf_results_wrapper;
+        struct DlfResults *dlf_results;
+        svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper);
+        dlf_results                  = (struct DlfResults *)dlf_results_wrapper->object_ptr;
+        dlf_results->pcs_wrapper     = pcs_wrapper;
+        dlf_results->segment_index   = pcs->cdef_segments_posted++;
+        dlf_results->strength_search = FALSE;
+        // Post DLF Results
+        svt_post_full_object(dlf_results_wrapper);
+    }
+}
+
 /******************************************************
  * Dlf Kernel
  ******************************************************/
@@ -63,10 +188,6 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
     EbObjectWrapper *enc_dec_results_wrapper;
     EncDecResults   *enc_dec_results;
 
-    //// Output
-    EbObjectWrapper   *dlf_results_wrapper;
-    struct DlfResults *dlf_results;
-
     // SB Loop variables
     for (;;) {
         // Get EncDec Results
@@ -76,34 +197,43 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
         pcs                           = (PictureControlSet *)enc_dec_results->pcs_wrapper->object_ptr;
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
+        svt_trace_picture(pcs->picture_number, (int32_t)enc_dec_results->segment_index);
 
         Bool is_16bit = scs->is_16bit_pipeline;
-        if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
-            svt_convert_pic_8bit_to_16bit(pcs->ppcs->enhanced_pic,
-                                          pcs->input_frame16bit,
-                                          pcs->ppcs->scs->subsampling_x,
-                                          pcs->ppcs->scs->subsampling_y);
-            // convert 8-bit recon to 16-bit for it bypass encdec process
-            if (pcs->pic_bypass_encdec) {
-                EbPictureBufferDesc *recon_pic;
-                EbPictureBufferDesc *recon_picture_16bit_ptr;
-                svt_aom_get_recon_pic(pcs, &recon_pic, 0);
-                svt_aom_get_recon_pic(pcs, &recon_picture_16bit_ptr, 1);
-                svt_convert_pic_8bit_to_16bit(
-                    recon_pic, recon_picture_16bit_ptr, pcs->ppcs->scs->subsampling_x, pcs->ppcs->scs->subsampling_y);
-            }
+        svt_block_on_mutex(pcs->dlf_mutex);
+        if (!pcs->dlf_setup_done) {
+            dlf_picture_setup(pcs);
+            pcs->dlf_setup_done = TRUE;
         }
-        Bool           dlf_enable_flag = (Bool)pcs->ppcs->dlf_ctrls.enabled;
-        const uint16_t tg_count        = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
-        // Move sb level lf to here if tile_parallel
-        if ((dlf_enable_flag && !pcs->ppcs->dlf_ctrls.sb_based_dlf) ||
-            (dlf_enable_flag && pcs->ppcs->dlf_ctrls.sb_based_dlf && tg_count > 1)) {
+        svt_release_mutex(pcs->dlf_mutex);
+
+        // Frame level DLF: every task of the picture filters SB rows until none is left
+        if (use_frame_level_dlf(pcs)) {
             EbPictureBufferDesc *recon_buffer;
             svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
-            svt_av1_loop_filter_init(pcs);
-            svt_av1_pick_filter_level((EbPictureBufferDesc *)pcs->ppcs->enhanced_pic, pcs, LPF_PICK_FROM_FULL_IMAGE);
+            const uint32_t sb_rows = get_dlf_sb_rows(pcs);
+            uint32_t       sb_row;
+            while ((sb_row = svt_atomic_fetch_add_u32(&pcs->dlf_next_sb_row, 1)) < sb_rows) {
+                svt_av1_loop_filter_sb_row(recon_buffer, pcs, pcs->dlf_row_progress, sb_row, 0, 3);
+                // A row is done once the rows above are, so CDEF can start searching the segments above it.
+                // The segments that need the last row are posted by the last task, after the CDEF prep.
+                svt_block_on_mutex(pcs->dlf_mutex);
+                post_cdef_segments(context_ptr, pcs, enc_dec_results->pcs_wrapper, AOMMIN(sb_row + 1, sb_rows - 1));
+                svt_release_mutex(pcs->dlf_mutex);
+            }
+        }
 
-            svt_av1_loop_filter_frame(recon_buffer, pcs, 0, 3);
+        // The last task of the picture prepares CDEF
+        svt_block_on_mutex(pcs->dlf_mutex);
+        const Bool last_segment = ++pcs->tot_dlf_segments_done == pcs->dlf_segments_total_count;
+        if (last_segment) {
+            pcs->tot_dlf_segments_done = 0;
+            pcs->dlf_setup_done        = FALSE;
+        }
+        svt_release_mutex(pcs->dlf_mutex);
+        if (!last_segment) {
+            svt_release_object(enc_dec_results_wrapper);
+            continue;
         }
 
         //pre-cdef prep
@@ -117,40 +247,9 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
                     recon_pic, cm->frame_to_show, scs->max_input_pad_right, scs->max_input_pad_bottom, is_16bit);
                 svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
             }
-
-            if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level) {
-                const uint32_t offset_y  = recon_pic->org_x + recon_pic->org_y * recon_pic->stride_y;
-                pcs->cdef_input_recon[0] = recon_pic->buffer_y + (offset_y << is_16bit);
-                const uint32_t offset_cb = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cb) >> 1;
-                pcs->cdef_input_recon[1] = recon_pic->buffer_cb + (offset_cb << is_16bit);
-                const uint32_t offset_cr = (recon_pic->org_x + recon_pic->org_y * recon_pic->stride_cr) >> 1;
-                pcs->cdef_input_recon[2] = recon_pic->buffer_cr + (offset_cr << is_16bit);
-
-                EbPictureBufferDesc *input_pic      = is_16bit ? pcs->input_frame16bit : pcs->ppcs->enhanced_pic;
-                const uint32_t       input_offset_y = input_pic->org_x + input_pic->org_y * input_pic->stride_y;
-                pcs->cdef_input_source[0]           = input_pic->buffer_y + (input_offset_y << is_16bit);
-                const uint32_t input_offset_cb      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cb) >> 1;
-                pcs->cdef_input_source[1]           = input_pic->buffer_cb + (input_offset_cb << is_16bit);
-                const uint32_t input_offset_cr      = (input_pic->org_x + input_pic->org_y * input_pic->stride_cr) >> 1;
-                pcs->cdef_input_source[2]           = input_pic->buffer_cr + (input_offset_cr << is_16bit);
-            }
         }
 
-        pcs->cdef_segments_column_count = scs->cdef_segment_column_count;
-        pcs->cdef_segments_row_count    = scs->cdef_segment_row_count;
-        pcs->cdef_segments_total_count  = (uint16_t)(pcs->cdef_segments_column_count * pcs->cdef_segments_row_count);
-        pcs->tot_seg_searched_cdef      = 0;
-        uint32_t segment_index;
-
-        for (segment_index = 0; segment_index < pcs->cdef_segments_total_count; ++segment_index) {
-            // Get Empty DLF Results to Cdef
-            svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper);
-            dlf_results                = (struct DlfResults *)dlf_results_wrapper->object_ptr;
-            dlf_results->pcs_wrapper   = enc_dec_results->pcs_wrapper;
-            dlf_results->segment_index = segment_index;
-            // Post DLF Results
-            svt_post_full_object(dlf_results_wrapper);
-        }
+        post_cdef_segments(context_ptr, pcs, enc_dec_results->pcs_wrapper, get_dlf_sb_rows(pcs));
 
         // Release EncDec Results
         svt_release_object(enc_dec_results_wrapper);
@@ -32,4 +32,7 @@ extern EbErrorType svt_aom_dlf_context_ctor(EbThreadContext *thread_ctx, const E
 
 extern void *svt_aom_dlf_kernel(void *input_ptr);
 
+struct PictureControlSet;
+extern uint16_t svt_aom_get_dlf_segment_count(struct PictureControlSet *pcs);
+
 #endif // EbEntropyCodingProcess_h
@@ -37,6 +37,8 @@ typedef struct EntropyTileInfo {
     EbDctor       dctor;
     EntropyCoder* ec;
     Bool          entropy_coding_tile_done;
+    // Sub-frame output: SBs of the tile EncDec is done with
+    volatile uint32_t enc_dec_coded_sb_count;
 } EntropyTileInfo;
 
 extern EbErrorType svt_aom_entropy_tile_info_ctor(EntropyTileInfo* entropy_tile_info_ptr, uint32_t buf_size);
@@ -20,6 +20,7 @@
 #include "cabac_context_model.h"
 #include "svt_log.h"
 #include "common_dsp_rtcd.h"
+#include "svt_trace.h"
 void svt_av1_reset_loop_restoration(PictureControlSet *piCSetPtr, uint16_t tile_idx);
 
 static void rest_context_dctor(EbPtr p) {
@@ -185,6 +186,71 @@ static void reset_entropy_coding_picture(EntropyCodingContext *ctx, PictureContr
     }
 }
 
+/* Releases what the picture held for entropy coding and hands it to packetization */
+static void entropy_coding_pic_done(EntropyCodingContext *context_ptr, PictureControlSet *pcs,
+                                    EbObjectWrapper *pcs_wrapper) {
+    EbObjectWrapper      *entropy_coding_results_wrapper_ptr;
+    EntropyCodingResults *entropy_coding_results_ptr;
+
+    if (pcs->ppcs->superres_total_recode_loop == 0) {
+        // Release the List 0 Reference Pictures
+        for (uint32_t ref_idx = 0; ref_idx < pcs->ppcs->ref_list0_count; ++ref_idx) {
+            if (pcs->ref_pic_ptr_array[0][ref_idx] != NULL) {
+                svt_release_object(pcs->ref_pic_ptr_array[0][ref_idx]);
+            }
+        }
+        // Release the List 1 Reference Pictures
+        for (uint32_t ref_idx = 0; ref_idx < pcs->ppcs->ref_list1_count; ++ref_idx) {
+            if (pcs->ref_pic_ptr_array[1][ref_idx] != NULL) {
+                svt_release_object(pcs->ref_pic_ptr_array[1][ref_idx]);
+            }
+        }
+
+        //free palette data
+        if (pcs->tile_tok[0][0])
+            EB_FREE_ARRAY(pcs->tile_tok[0][0]);
+    }
+
+    // Get Empty Entropy Coding Results
+    svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr, &entropy_coding_results_wrapper_ptr);
+    entropy_coding_results_ptr = (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
+    entropy_coding_results_ptr->pcs_wrapper = pcs_wrapper;
+    entropy_coding_results_ptr->sub_frame   = FALSE;
+
+    // Post EntropyCoding Results
+    svt_post_full_object(entropy_coding_results_wrapper_ptr);
+}
+
+/* Sub-frame output: tells packetization about the tile rows of the picture that are now fully
+ * coded, called under entropy_coding_pic_mutex so the posts keep the order of the rows and come
+ * before the one of entropy_coding_pic_done() */
+static void post_coded_tile_rows(EntropyCodingContext *context_ptr, PictureControlSet *pcs,
+                                 EbObjectWrapper *pcs_wrapper) {
+    const Av1Common *const cm        = pcs->ppcs->av1_cm;
+    const uint16_t         tile_cols = cm->tiles_info.tile_cols;
+    uint16_t               rows      = pcs->ec_tile_rows_posted;
+
+    while (rows < cm->tiles_info.tile_rows) {
+        uint16_t col = 0;
+        while (col < tile_cols && pcs->ec_info[rows * tile_cols + col]->entropy_coding_tile_done) col++;
+        if (col < tile_cols)
+            break;
+        rows++;
+    }
+    if (rows == pcs->ec_tile_rows_posted)
+        return;
+    pcs->ec_tile_rows_posted = rows;
+
+    EbObjectWrapper *entropy_coding_results_wrapper_ptr;
+    svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr, &entropy_coding_results_wrapper_ptr);
+    EntropyCodingResults *entropy_coding_results_ptr = (EntropyCodingResults *)
+                                                           entropy_coding_results_wrapper_ptr->object_ptr;
+    entropy_coding_results_ptr->pcs_wrapper    = pcs_wrapper;
+    entropy_coding_results_ptr->sub_frame      = TRUE;
+    entropy_coding_results_ptr->tile_rows_done = rows;
+    svt_post_full_object(entropy_coding_results_wrapper_ptr);
+}
+
 /* Entropy Coding */
 
 /*********************************************************************************
@@ -213,16 +279,13 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
     // Input
     EbObjectWrapper *rest_results_wrapper;
 
-    // Output
-    EbObjectWrapper      *entropy_coding_results_wrapper_ptr;
-    EntropyCodingResults *entropy_coding_results_ptr;
-
     for (;;) {
         // Get Mode Decision Results
         EB_GET_FULL_OBJECT(context_ptr->enc_dec_input_fifo_ptr, &rest_results_wrapper);
 
         RestResults        *rest_results = (RestResults *)rest_results_wrapper->object_ptr;
         PictureControlSet  *pcs          = (PictureControlSet *)rest_results->pcs_wrapper->object_ptr;
+        svt_trace_picture(pcs->picture_number, rest_results->tile_index);
         SequenceControlSet *scs          = pcs->scs;
         // SB Constants
 
@@ -245,7 +308,17 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
                                       cm->tiles_info.tile_row_start_mi[tile_row]) >>
             scs->seq_header.sb_size_log2;
 
-        Bool frame_entropy_done = FALSE;
+        if (rest_results->filters_done) {
+            // Sub-frame output: the tiles come from EncDec, the picture is done once they are coded too
+            svt_block_on_mutex(pcs->entropy_coding_pic_mutex);
+            pcs->ec_filters_done = TRUE;
+            const Bool pic_ready = pcs->ec_tile_rows_posted == cm->tiles_info.tile_rows;
+            svt_release_mutex(pcs->entropy_coding_pic_mutex);
+            if (pic_ready)
+                entropy_coding_pic_done(context_ptr, pcs, rest_results->pcs_wrapper);
+            svt_release_object(rest_results_wrapper);
+            continue;
+        }
 
         svt_block_on_mutex(pcs->entropy_coding_pic_mutex);
         if (pcs->entropy_coding_pic_reset_flag) {
@@ -286,38 +359,13 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
                 break;
             }
         }
-        svt_release_mutex(pcs->entropy_coding_pic_mutex);
-        if (pic_ready) {
-            if (pcs->ppcs->superres_total_recode_loop == 0) {
-                // Release the List 0 Reference Pictures
-                for (uint32_t ref_idx = 0; ref_idx < pcs->ppcs->ref_list0_count; ++ref_idx) {
-                    if (pcs->ref_pic_ptr_array[0][ref_idx] != NULL) {
-                        svt_release_object(pcs->ref_pic_ptr_array[0][ref_idx]);
-                    }
-                }
-                // Release the List 1 Reference Pictures
-                for (uint32_t ref_idx = 0; ref_idx < pcs->ppcs->ref_list1_count; ++ref_idx) {
-                    if (pcs->ref_pic_ptr_array[1][ref_idx] != NULL) {
-                        svt_release_object(pcs->ref_pic_ptr_array[1][ref_idx]);
-                    }
-                }
-
-                //free palette data
-                if (pcs->tile_tok[0][0])
-                    EB_FREE_ARRAY(pcs->tile_tok[0][0]);
-            }
-            frame_entropy_done = TRUE;
-        }
-
-        if (frame_entropy_done) {
-            // Get Empty Entropy Coding Results
-            svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr, &entropy_coding_results_wrapper_ptr);
-            entropy_coding_results_ptr = (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
-            entropy_coding_results_ptr->pcs_wrapper = rest_results->pcs_wrapper;
-
-            // Post EntropyCoding Results
-            svt_post_full_object(entropy_coding_results_wrapper_ptr);
+        if (scs->static_config.sub_frame_output) {
+            post_coded_tile_rows(context_ptr, pcs, rest_results->pcs_wrapper);
+            pic_ready = pic_ready && pcs->ec_filters_done;
         }
+        svt_release_mutex(pcs->entropy_coding_pic_mutex);
+        if (pic_ready)
+            entropy_coding_pic_done(context_ptr, pcs, rest_results->pcs_wrapper);
 
         // Release Mode Decision Results
         svt_release_object(rest_results_wrapper);
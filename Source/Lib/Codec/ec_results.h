@@ -24,6 +24,9 @@ extern "C" {
 typedef struct EntropyCodingResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
+    // Sub-frame output: only the first tile_rows_done tile rows of the picture are coded
+    Bool     sub_frame;
+    uint16_t tile_rows_done;
 } EntropyCodingResults;
 
 typedef struct EntropyCodingResultsInitData {
@@ -725,6 +725,86 @@ static uint64_t joint_strength_search_dual(int32_t *best_lev0, int32_t *best_lev
     }
     return best_tot_mse;
 }
+/*
+ * Collect the filter blocks to search and their MSEs for the CDEF strength search, once all the CDEF
+ * segments are searched. The search itself is split by number of signalling bits, see
+ * svt_aom_cdef_search_strength_bits().
+*/
+void svt_aom_cdef_prepare_strength_search(PictureControlSet *pcs) {
+    struct PictureParentControlSet *ppcs       = pcs->ppcs;
+    Av1Common                      *cm         = ppcs->av1_cm;
+    CdefControls                   *cdef_ctrls = &ppcs->cdef_ctrls;
+    const int32_t                   nvfb       = (cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    const int32_t                   nhfb       = (cm->mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    uint64_t                      **mse[2]     = {pcs->cdef_search_mse[0], pcs->cdef_search_mse[1]};
+    int32_t                         sb_count   = 0;
+
+    for (int32_t fbr = 0; fbr < nvfb; ++fbr) {
+        for (int32_t fbc = 0; fbc < nhfb; ++fbc) {
+            ModeInfo        **mi   = pcs->mi_grid_base + MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc;
+            const MbModeInfo *mbmi = &mi[0]->mbmi;
+
+            if (((fbc & 1) && (mbmi->block_mi.bsize == BLOCK_128X128 || mbmi->block_mi.bsize == BLOCK_128X64)) ||
+                ((fbr & 1) && (mbmi->block_mi.bsize == BLOCK_128X128 || mbmi->block_mi.bsize == BLOCK_64X128))) {
+                continue;
+            }
+
+            // No filtering if the entire filter block is skipped
+            if (pcs->skip_cdef_seg[fbr * nhfb + fbc])
+                continue;
+            // point to the MSE data
+            mse[0][sb_count] = pcs->mse_seg[0][fbr * nhfb + fbc];
+            mse[1][sb_count] = pcs->mse_seg[1][fbr * nhfb + fbc];
+
+            pcs->cdef_search_sb_index[sb_count] = MI_SIZE_64X64 * fbr * pcs->mi_stride + MI_SIZE_64X64 * fbc;
+            sb_count++;
+        }
+    }
+    pcs->cdef_search_sb_count = sb_count;
+
+    // Scale down the cost of the (0,0) filter strength to bias selection towards off.
+    // When off, can save the cost of the application.
+    if (cdef_ctrls->zero_fs_cost_bias) {
+        const uint16_t factor = cdef_ctrls->zero_fs_cost_bias;
+        for (int32_t i = 0; i < sb_count; i++) {
+            mse[0][i][0] = (factor * mse[0][i][0]) >> 6;
+            mse[1][i][0] = (factor * mse[1][i][0]) >> 6;
+        }
+    }
+}
+/*
+ * Search the best set of 1 << nb_strength_bits strength pairs and its RD cost, including the
+ * signalling cost. The searches for the different numbers of bits are independent and may run in
+ * parallel; finish_cdef_search() then keeps the cheapest.
+*/
+void svt_aom_cdef_search_strength_bits(PictureControlSet *pcs, int32_t nb_strength_bits) {
+    CdefControls       *cdef_ctrls   = &pcs->ppcs->cdef_ctrls;
+    CdefStrengthSearch *search       = &pcs->cdef_strength_search[nb_strength_bits];
+    const int32_t       sb_count     = pcs->cdef_search_sb_count;
+    const int32_t       end_gi       = cdef_ctrls->first_pass_fs_num + cdef_ctrls->default_second_pass_fs_num;
+    const int32_t       nb_strengths = 1 << nb_strength_bits;
+    uint32_t            fast_lambda, full_lambda = 0;
+    (*svt_aom_av1_lambda_assignment_function_table[pcs->ppcs->pred_structure])(
+        pcs,
+        &fast_lambda,
+        &full_lambda,
+        (uint8_t)pcs->ppcs->enhanced_pic->bit_depth,
+        pcs->ppcs->frm_hdr.quantization_params.base_q_idx,
+        FALSE);
+
+    memset(search->best_lev0, 0, sizeof(search->best_lev0));
+    memset(search->best_lev1, 0, sizeof(search->best_lev1));
+    const uint64_t tot_mse = joint_strength_search_dual(
+        search->best_lev0, search->best_lev1, nb_strengths, pcs->cdef_search_mse, sb_count, 0, end_gi);
+    /* Count superblock signalling cost. */
+    const int total_bits = sb_count * nb_strength_bits + nb_strengths * CDEF_STRENGTH_BITS * 2;
+    const int rate_cost  = av1_cost_literal(total_bits);
+    search->rd_cost      = RDCOST(full_lambda, rate_cost, tot_mse * 16);
+}
+/*
+ * Pick the number of signalling bits from the results of svt_aom_cdef_search_strength_bits() and
+ * assign the strength of each filter block.
+*/
 void finish_cdef_search(PictureControlSet *pcs) {
     struct PictureParentControlSet *ppcs    = pcs->ppcs;
     FrameHeader                    *frm_hdr = &ppcs->frm_hdr;
@@ -793,84 +873,25 @@ void finish_cdef_search(PictureControlSet *pcs) {
         free(sb_index);
         return;
     }
-    int32_t *sb_index = (int32_t *)malloc(nvfb * nhfb * sizeof(*sb_index));
-    // to keep track of the sb_address in units of SBs (not mi_size)
-    int32_t *sb_addr  = (int32_t *)malloc(nvfb * nhfb * sizeof(*sb_index));
-    int32_t  start_gi = 0;
-    int32_t  end_gi   = first_pass_fs_num + default_second_pass_fs_num;
-    assert(sb_index != NULL);
-    uint64_t **mse[2];
-    int32_t    i;
-    int32_t    nb_strengths;
-    int32_t    nb_strength_bits;
-    uint64_t   lambda;
-    uint32_t   fast_lambda, full_lambda = 0;
-    (*svt_aom_av1_lambda_assignment_function_table[pcs->ppcs->pred_structure])(
-        pcs,
-        &fast_lambda,
-        &full_lambda,
-        (uint8_t)pcs->ppcs->enhanced_pic->bit_depth,
-        pcs->ppcs->frm_hdr.quantization_params.base_q_idx,
-        FALSE);
-    lambda   = full_lambda;
-    mse[0]   = (uint64_t **)malloc(sizeof(*mse) * nvfb * nhfb);
-    mse[1]   = (uint64_t **)malloc(sizeof(*mse) * nvfb * nhfb);
-    sb_count = 0;
-    for (fbr = 0; fbr < nvfb; ++fbr) {
-        for (fbc = 0; fbc < nhfb; ++fbc) {
-            ModeInfo        **mi   = pcs->mi_grid_base + MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc;
-            const MbModeInfo *mbmi = &mi[0]->mbmi;
-
-            if (((fbc & 1) && (mbmi->block_mi.bsize == BLOCK_128X128 || mbmi->block_mi.bsize == BLOCK_128X64)) ||
-                ((fbr & 1) && (mbmi->block_mi.bsize == BLOCK_128X128 || mbmi->block_mi.bsize == BLOCK_64X128))) {
-                continue;
-            }
-
-            // No filtering if the entire filter block is skipped
-            if (pcs->skip_cdef_seg[fbr * nhfb + fbc])
-                continue;
-            // point to the MSE data
-            mse[0][sb_count] = pcs->mse_seg[0][fbr * nhfb + fbc];
-            mse[1][sb_count] = pcs->mse_seg[1][fbr * nhfb + fbc];
-
-            sb_index[sb_count] = MI_SIZE_64X64 * fbr * pcs->mi_stride + MI_SIZE_64X64 * fbc;
-            sb_addr[sb_count]  = fbr * nhfb + fbc;
-            sb_count++;
-        }
-    }
-
-    nb_strength_bits = 0;
-    // Scale down the cost of the (0,0) filter strength to bias selection towards off.
-    // When off, can save the cost of the application.
-    if (cdef_ctrls->zero_fs_cost_bias) {
-        const uint16_t factor = cdef_ctrls->zero_fs_cost_bias;
-        for (i = 0; i < sb_count; i++) {
-            mse[0][i][0] = (factor * mse[0][i][0]) >> 6;
-            mse[1][i][0] = (factor * mse[1][i][0]) >> 6;
-        }
-    }
-    /* Search for different number of signalling bits. */
-    for (i = 0; i <= 3; i++) {
-        int32_t best_lev0[CDEF_MAX_STRENGTHS] = {0};
-        int32_t best_lev1[CDEF_MAX_STRENGTHS] = {0};
-        nb_strengths                          = 1 << i;
-        uint64_t tot_mse                      = joint_strength_search_dual(
-            best_lev0, best_lev1, nb_strengths, mse, sb_count, start_gi, end_gi);
-        /* Count superblock signalling cost. */
-        const int      total_bits = sb_count * i + nb_strengths * CDEF_STRENGTH_BITS * 2;
-        const int      rate_cost  = av1_cost_literal(total_bits);
-        const uint64_t dist       = tot_mse * 16;
-        tot_mse                   = RDCOST(lambda, rate_cost, dist);
-        if (tot_mse < best_tot_mse) {
-            best_tot_mse     = tot_mse;
+    int32_t i;
+    int32_t nb_strength_bits = 0;
+    /* Pick the number of signalling bits with the lowest RD cost. */
+    for (i = 0; i < CDEF_STRENGTH_SEARCH_COUNT; i++) {
+        const CdefStrengthSearch *search = &pcs->cdef_strength_search[i];
+        if (search->rd_cost < best_tot_mse) {
+            best_tot_mse     = search->rd_cost;
             nb_strength_bits = i;
             for (int32_t j = 0; j < 1 << nb_strength_bits; j++) {
-                frm_hdr->cdef_params.cdef_y_strength[j]  = best_lev0[j];
-                frm_hdr->cdef_params.cdef_uv_strength[j] = best_lev1[j];
+                frm_hdr->cdef_params.cdef_y_strength[j]  = search->best_lev0[j];
+                frm_hdr->cdef_params.cdef_uv_strength[j] = search->best_lev1[j];
             }
         }
     }
-    nb_strengths = 1 << nb_strength_bits;
+    const int32_t nb_strengths = 1 << nb_strength_bits;
+
+    uint64_t **mse[2]   = {pcs->cdef_search_mse[0], pcs->cdef_search_mse[1]};
+    int32_t   *sb_index = pcs->cdef_search_sb_index;
+    sb_count            = pcs->cdef_search_sb_count;
 
     frm_hdr->cdef_params.cdef_bits = nb_strength_bits;
     ppcs->nb_cdef_strengths        = nb_strengths;
@@ -919,8 +940,4 @@ void finish_cdef_search(PictureControlSet *pcs) {
     }
     //cdef_pri_damping & cdef_sec_damping consolidated to cdef_damping
     frm_hdr->cdef_params.cdef_damping = 3 + (frm_hdr->quantization_params.base_q_idx >> 6);
-    free(mse[0]);
-    free(mse[1]);
-    free(sb_index);
-    free(sb_addr);
 }
@@ -26,6 +26,8 @@
 #include "pic_analysis_process.h"
 #include "resize.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
+#include "dlf_process.h"
 
 void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate);
@@ -69,6 +71,10 @@ EbErrorType svt_aom_enc_dec_context_ctor(EbThreadContext *thread_ctx, const EbEn
         enc_handle_ptr->enc_dec_results_resource_ptr, index);
     ed_ctx->enc_dec_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->enc_dec_tasks_resource_ptr, tasks_index);
+    if (static_config->sub_frame_output)
+        ed_ctx->ec_output_fifo_ptr = svt_system_resource_get_producer_fifo(
+            enc_handle_ptr->rest_results_resource_ptr,
+            enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count + index);
 
     // Prediction Buffer
     ed_ctx->input_sample16bit_buffer = NULL;
@@ -3118,6 +3124,46 @@ static void lpd0_detector(PictureControlSet *pcs, ModeDecisionContext *md_ctx, u
     assert(IMPLIES(pcs->slice_type == I_SLICE, lpd0_ctrls->pd0_level != VERY_LIGHT_PD0));
 }
 
+/* Sub-frame output: hands a tile to entropy coding once EncDec is done with all its SBs */
+static void sub_frame_sb_coded(EncDecContext *ed_ctx, PictureControlSet *pcs, EbObjectWrapper *pcs_wrapper,
+                               uint16_t tile_idx) {
+    const Av1Common *const cm        = pcs->ppcs->av1_cm;
+    const uint8_t          sb_log2   = pcs->scs->seq_header.sb_size_log2;
+    const uint16_t         tile_col  = tile_idx % cm->tiles_info.tile_cols;
+    const uint16_t         tile_row  = tile_idx / cm->tiles_info.tile_cols;
+    const uint32_t         tile_sb_w = (cm->tiles_info.tile_col_start_mi[tile_col + 1] -
+                                cm->tiles_info.tile_col_start_mi[tile_col]) >>
+        sb_log2;
+    const uint32_t tile_sb_h = (cm->tiles_info.tile_row_start_mi[tile_row + 1] -
+                                cm->tiles_info.tile_row_start_mi[tile_row]) >>
+        sb_log2;
+
+    // The atomic add orders the SBs coded by the other EncDec threads before the post
+    if (svt_atomic_fetch_add_u32(&pcs->ec_info[tile_idx]->enc_dec_coded_sb_count, 1) + 1 < tile_sb_w * tile_sb_h)
+        return;
+    EbObjectWrapper *rest_results_wrapper;
+    svt_get_empty_object(ed_ctx->ec_output_fifo_ptr, &rest_results_wrapper);
+    RestResults *rest_results  = (RestResults *)rest_results_wrapper->object_ptr;
+    rest_results->pcs_wrapper  = pcs_wrapper;
+    rest_results->tile_index   = tile_idx;
+    rest_results->filters_done = FALSE;
+    svt_post_full_object(rest_results_wrapper);
+}
+
+/* Posts the picture to DLF, split into the DLF tasks of svt_aom_get_dlf_segment_count() */
+static void post_enc_dec_results(EncDecContext *ed_ctx, EbObjectWrapper *pcs_wrapper) {
+    PictureControlSet *pcs        = (PictureControlSet *)pcs_wrapper->object_ptr;
+    pcs->dlf_segments_total_count = svt_aom_get_dlf_segment_count(pcs);
+    for (uint16_t segment_index = 0; segment_index < pcs->dlf_segments_total_count; segment_index++) {
+        EbObjectWrapper *enc_dec_results_wrapper;
+        svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
+        EncDecResults *enc_dec_results = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
+        enc_dec_results->pcs_wrapper   = pcs_wrapper;
+        enc_dec_results->segment_index = segment_index;
+        svt_post_full_object(enc_dec_results_wrapper);
+    }
+}
+
 /* EncDec (Encode Decode) Kernel */
 /*********************************************************************************
  *
@@ -3164,9 +3210,6 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
     // Input
     EbObjectWrapper *enc_dec_tasks_wrapper;
 
-    // Output
-    EbObjectWrapper *enc_dec_results_wrapper;
-    EncDecResults   *enc_dec_results;
     // SB Loop variables
     SuperBlock *sb_ptr;
     uint16_t    sb_index;
@@ -3203,6 +3246,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
         md_ctx->corrupted_mv_check                    = (pcs->ppcs->aligned_width >= (1 << (MV_IN_USE_BITS - 3))) ||
             (pcs->ppcs->aligned_height >= (1 << (MV_IN_USE_BITS - 3)));
         ed_ctx->tile_group_index = enc_dec_tasks->tile_group_index;
+        svt_trace_picture(pcs->picture_number, enc_dec_tasks->tile_group_index);
         ed_ctx->coded_sb_count   = 0;
         segments_ptr             = pcs->enc_dec_segment_ctrl[ed_ctx->tile_group_index];
         // SB Constants
@@ -3218,13 +3262,8 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
             svt_release_object(pcs->ppcs->me_data_wrapper);
             pcs->ppcs->me_data_wrapper = (EbObjectWrapper *)NULL;
             pcs->ppcs->pa_me_data      = NULL;
-            // Get Empty EncDec Results
-            svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
-            enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
-            enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
-
             // Post EncDec Results
-            svt_post_full_object(enc_dec_results_wrapper);
+            post_enc_dec_results(ed_ctx, enc_dec_tasks->pcs_wrapper);
         } else {
             if (enc_dec_tasks->input_type == ENCDEC_TASKS_SUPERRES_INPUT) {
                 // do as dorecode do
@@ -3390,6 +3429,8 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
 
                         // Initialize is_subres_safe
                         ed_ctx->md_ctx->is_subres_safe = (uint8_t)~0;
+                        // Invalidate the MDS0 candidate cache of the previous SB
+                        md_ctx->cand_cache_gen++;
                         // Signal initialized here; if needed, will be set in md_encode_block before MDS3
                         md_ctx->need_hbd_comp_mds3 = 0;
                         uint8_t skip_pd_pass_0     = (scs->super_block_size == 64 &&
@@ -3522,11 +3563,15 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                         svt_aom_encdec_update(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
 
                         ed_ctx->coded_sb_count++;
+                        if (scs->static_config.sub_frame_output)
+                            sub_frame_sb_coded(
+                                ed_ctx, pcs, enc_dec_tasks->pcs_wrapper, sb_ptr->tile_info.tile_rs_index);
                     }
                     x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
                 }
             }
 
+            svt_trace_sb_count(ed_ctx->coded_sb_count);
             svt_block_on_mutex(pcs->intra_mutex);
             pcs->intra_coded_area += (uint32_t)ed_ctx->tot_intra_coded_area;
             pcs->skip_coded_area += (uint32_t)ed_ctx->tot_skip_coded_area;
@@ -3612,13 +3657,8 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                         pcs->ppcs->me_data_wrapper = (EbObjectWrapper *)NULL;
                         pcs->ppcs->pa_me_data      = NULL;
                     }
-                    // Get Empty EncDec Results
-                    svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
-                    enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
-                    enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
-
                     // Post EncDec Results
-                    svt_post_full_object(enc_dec_results_wrapper);
+                    post_enc_dec_results(ed_ctx, enc_dec_tasks->pcs_wrapper);
                 }
             }
         }
@@ -35,6 +35,7 @@ typedef struct EncDecContext {
     EbFifo              *mode_decision_input_fifo_ptr;
     EbFifo              *enc_dec_output_fifo_ptr;
     EbFifo              *enc_dec_feedback_fifo_ptr;
+    EbFifo              *ec_output_fifo_ptr; // sub-frame output: coded tiles straight to entropy coding
     EbFifo              *picture_demux_output_fifo_ptr; // to picture-manager
     ModeDecisionContext *md_ctx;
     const BlockGeom     *blk_geom;
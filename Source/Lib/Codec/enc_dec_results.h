@@ -24,12 +24,15 @@ extern "C" {
 typedef struct EncDecResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
+    uint16_t         segment_index; // DLF task of the picture, see svt_aom_get_dlf_segment_count()
 } EncDecResults;
 
 typedef struct DlfResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
     uint32_t         segment_index;
+    // CDEF strength search task posted back by CDEF, segment_index is then the number of signalling bits
+    Bool strength_search;
 } DlfResults;
 
 typedef struct CdefResults {
@@ -42,6 +45,8 @@ typedef struct RestResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
     uint16_t         tile_index;
+    // Sub-frame output: the in-loop filters are done with the picture, there is no tile to code
+    Bool filters_done;
 } RestResults;
 
 typedef struct EncDecResultsInitData {
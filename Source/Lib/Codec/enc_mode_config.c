@@ -1458,6 +1458,7 @@ static uint8_t svt_aom_get_wn_filter_level(EncMode enc_mode, uint8_t input_resol
     else
         wn_filter_lvl = 0;
 
+    if (getenv("WNL") && enc_mode >= ENC_M7) wn_filter_lvl = is_not_last_layer ? atoi(getenv("WNL")) : atoi(getenv("WNLL")); //TMP
     // higher resolutions will shut restoration to save memory
     if (input_resolution >= INPUT_SIZE_8K_RANGE)
         wn_filter_lvl = 0;
@@ -1475,6 +1476,7 @@ static uint8_t svt_aom_get_sg_filter_level(EncMode enc_mode, uint8_t input_resol
     else
         sg_filter_lvl = 0;
 
+    if (getenv("SGL") && enc_mode >= ENC_M7) sg_filter_lvl = atoi(getenv("SGL")); //TMP
     // higher resolutions will shut restoration to save memory
     if (input_resolution >= INPUT_SIZE_8K_RANGE || (fast_decode && !(input_resolution <= INPUT_SIZE_360p_RANGE)))
         sg_filter_lvl = 0;
@@ -1620,6 +1622,7 @@ static void svt_aom_set_dlf_controls(PictureParentControlSet *pcs, uint8_t dlf_l
         ctrls->dlf_avg_uv               = 0;
         ctrls->early_exit_convergence   = 0;
         ctrls->zero_filter_strength_lvl = 0;
+        ctrls->search_sb_row_step       = 1;
         break;
     case 1:
         ctrls->enabled                  = 1;
@@ -1628,6 +1631,7 @@ static void svt_aom_set_dlf_controls(PictureParentControlSet *pcs, uint8_t dlf_l
         ctrls->dlf_avg_uv               = 0;
         ctrls->early_exit_convergence   = 0;
         ctrls->zero_filter_strength_lvl = 0;
+        ctrls->search_sb_row_step       = 1;
         break;
     case 2:
         ctrls->enabled                  = 1;
@@ -1636,6 +1640,7 @@ static void svt_aom_set_dlf_controls(PictureParentControlSet *pcs, uint8_t dlf_l
         ctrls->dlf_avg_uv               = 1;
         ctrls->early_exit_convergence   = 1;
         ctrls->zero_filter_strength_lvl = 0;
+        ctrls->search_sb_row_step       = 2;
         break;
     case 3:
         ctrls->enabled      = 1;
@@ -1645,6 +1650,7 @@ static void svt_aom_set_dlf_controls(PictureParentControlSet *pcs, uint8_t dlf_l
         ctrls->dlf_avg_uv               = 0;
         ctrls->early_exit_convergence   = 0;
         ctrls->zero_filter_strength_lvl = 1;
+        ctrls->search_sb_row_step       = 1;
         break;
     case 4:
         ctrls->enabled                  = 1;
@@ -1653,6 +1659,7 @@ static void svt_aom_set_dlf_controls(PictureParentControlSet *pcs, uint8_t dlf_l
         ctrls->dlf_avg_uv               = 0;
         ctrls->early_exit_convergence   = 0;
         ctrls->zero_filter_strength_lvl = 2;
+        ctrls->search_sb_row_step       = 1;
         break;
     case 5:
         ctrls->enabled                  = 1;
@@ -1661,6 +1668,7 @@ static void svt_aom_set_dlf_controls(PictureParentControlSet *pcs, uint8_t dlf_l
         ctrls->dlf_avg_uv               = 0;
         ctrls->early_exit_convergence   = 0;
         ctrls->zero_filter_strength_lvl = 3;
+        ctrls->search_sb_row_step       = 1;
         break;
     default: assert(0); break;
     }
@@ -1929,6 +1937,8 @@ void svt_aom_sig_deriv_multi_processes(SequenceControlSet *scs, PictureParentCon
     Av1Common *cm = pcs->av1_cm;
     svt_aom_set_wn_filter_ctrls(cm, wn);
     svt_aom_set_sg_filter_ctrls(cm, sg);
+    // Search the restoration filters on subsampled restoration units in the fast presets
+    cm->use_sub_rest_search = getenv("SUBRS") ? atoi(getenv("SUBRS")) : enc_mode >= ENC_M7; //TMP
 
     // Set whether restoration filtering is enabled for this frame
     pcs->enable_restoration = (wn > 0 || sg > 0);
@@ -9062,6 +9072,10 @@ void svt_aom_sig_deriv_mode_decision_config(SequenceControlSet *scs, PictureCont
                                   rtc_tune,
                                   sc_class1,
                                   (pcs->temporal_layer_index == 0));
+        // Sub-frame output needs the filter level before the frame is coded: deblock per SB
+        // in EncDec with the level picked from q
+        if (pcs->scs->static_config.sub_frame_output && dlf_level && dlf_level < 3)
+            dlf_level = 3;
     }
     svt_aom_set_dlf_controls(pcs->ppcs, dlf_level);
 }
@@ -77,6 +77,8 @@ static void encode_context_dctor(EbPtr p) {
     EB_FREE(obj->stats_out.stat);
     destroy_stats_buffer(&obj->stats_buf_context, obj->frame_stats_buffer);
     EB_DELETE_PTR_ARRAY(obj->rc.coded_frames_stat_queue, CODED_FRAMES_STAT_QUEUE_MAX_DEPTH);
+    EB_DELETE(obj->hme_cache);
+    EB_DELETE(obj->mv_rate_cache);
 
     if (obj->rc_param_queue)
         EB_FREE_2D(obj->rc_param_queue);
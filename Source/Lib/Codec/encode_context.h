@@ -28,6 +28,7 @@
 #include "encoder.h"
 #include "firstpass.h"
 #include "rc_process.h"
+#include "hme_cache.h"
 
 // *Note - the queues are small for testing purposes.  They should be increased when they are done.
 #define PRE_ASSIGNMENT_MAX_DEPTH 128 // should be large enough to hold an entire prediction period
@@ -204,6 +205,18 @@ typedef struct EncodeContext {
     Dequants         deq_bd; // follows input bit depth
     Quants           quants_8bit; // 8bit
     Dequants         deq_8bit; // 8bit
+    // Pipeline telemetry, see SVT_AV1_STREAM_INFO_PIPELINE_TELEMETRY
+    EbStageStats      stage_stats[SVT_AV1_STAGE_COUNT];
+    volatile uint64_t picture_count;
+    volatile uint64_t picture_latency_histogram[SVT_AV1_LATENCY_HISTOGRAM_BINS];
+    // HME results shared by the open loop ME and TF searches
+    HmeCache *hme_cache;
+    // MV cost tables shared by the pictures that start from the same MV CDFs
+    MvRateCache *mv_rate_cache;
+    // TF block early exit, see SVT_AV1_STREAM_INFO_TF_STATS
+    volatile uint64_t tf_tot_blks;
+    volatile uint64_t tf_skip_blks;
+    volatile uint64_t tf_seed_blks;
 } EncodeContext;
 
 typedef struct EncodeContextInitData {
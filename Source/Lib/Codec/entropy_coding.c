@@ -2573,9 +2573,13 @@ static void write_tile_info(const PictureParentControlSet *const pcs,
 
         // Number of bytes in tile size - 1
         uint32_t max_tile_size = 0;
-        for (int tile_idx = 0; tile_idx < tile_cnt - 1; tile_idx++) {
-            max_tile_size = AOMMAX(max_tile_size, pcs->child_pcs->ec_info[tile_idx]->ec->ec_writer.pos);
-        }
+        if (pcs->scs->static_config.sub_frame_output)
+            // The header goes out before the last tiles are coded, sizes take 4 bytes
+            max_tile_size = UINT32_MAX;
+        else
+            for (int tile_idx = 0; tile_idx < tile_cnt - 1; tile_idx++) {
+                max_tile_size = AOMMAX(max_tile_size, pcs->child_pcs->ec_info[tile_idx]->ec->ec_writer.pos);
+            }
         if (max_tile_size >> 24 != 0)
             pcs->child_pcs->tile_size_bytes_minus_1 = 3;
         else if (max_tile_size >> 16 != 0)
@@ -3504,7 +3508,10 @@ static void write_uncompressed_header_obu(SequenceControlSet *scs /*Av1Comp *cpi
         svt_aom_wb_write_bit(wb, frm_hdr->delta_q_params.delta_q_present);
         if (frm_hdr->delta_q_params.delta_q_present) {
             svt_aom_wb_write_literal(wb, OD_ILOG_NZ(frm_hdr->delta_q_params.delta_q_res) - 1, 2);
-            for (uint16_t tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
+            // With sub-frame output the header is written while the last tiles are still coded,
+            // reset_entropy_coding_picture() already did these resets
+            const Bool reset_prev = !scs->static_config.sub_frame_output;
+            for (uint16_t tile_idx = 0; reset_prev && tile_idx < tile_cnt; tile_idx++) {
                 pcs->prev_qindex[tile_idx] = frm_hdr->quantization_params.base_q_idx;
             }
             if (frm_hdr->allow_intrabc)
@@ -3513,10 +3520,11 @@ static void write_uncompressed_header_obu(SequenceControlSet *scs /*Av1Comp *cpi
                 svt_aom_wb_write_bit(wb, frm_hdr->delta_lf_params.delta_lf_present);
             if (frm_hdr->delta_lf_params.delta_lf_present) {
                 svt_aom_wb_write_literal(wb, OD_ILOG_NZ(frm_hdr->delta_lf_params.delta_lf_res) - 1, 2);
-                pcs->prev_delta_lf_from_base = 0;
+                if (reset_prev)
+                    pcs->prev_delta_lf_from_base = 0;
                 svt_aom_wb_write_bit(wb, frm_hdr->delta_lf_params.delta_lf_multi);
                 const int32_t frame_lf_count = pcs->monochrome == 0 ? FRAME_LF_COUNT : FRAME_LF_COUNT - 2;
-                for (int32_t lf_id = 0; lf_id < frame_lf_count; ++lf_id) pcs->prev_delta_lf[lf_id] = 0;
+                for (int32_t lf_id = 0; reset_prev && lf_id < frame_lf_count; ++lf_id) pcs->prev_delta_lf[lf_id] = 0;
             }
         }
     }
@@ -3775,6 +3783,38 @@ EbErrorType svt_aom_write_metadata_av1(Bitstream *bitstream_ptr, SvtMetadataArra
     return return_error;
 }
 
+/* Adds tiles [tile_start, tile_end) from the EC streams to the picture stream at *data_ptr +
+ * curr_data_size, each but the last one of the tile group prefixed with its size. Returns the new
+ * data size */
+static int32_t write_tiles(OutputBitstreamUnit *output_bitstream_ptr, PictureControlSet *pcs, uint8_t **data_ptr,
+                           int32_t curr_data_size, int tile_start, int tile_end) {
+    uint8_t *data = *data_ptr;
+    for (int tile_idx = tile_start; tile_idx < tile_end; tile_idx++) {
+        const int32_t tile_size       = pcs->ec_info[tile_idx]->ec->ec_writer.pos;
+        uint8_t       tile_size_bytes = 0;
+        if (tile_idx != tile_end - 1) {
+            tile_size_bytes = pcs->tile_size_bytes_minus_1 + 1;
+            mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
+        }
+        OutputBitstreamUnit *ec_output_bitstream_ptr =
+            (OutputBitstreamUnit *)pcs->ec_info[tile_idx]->ec->ec_output_bitstream_ptr;
+        assert(output_bitstream_ptr->buffer_av1 >= output_bitstream_ptr->buffer_begin_av1);
+        // Size of the buffer needed to store all data; if buffer is too small, increase buffer
+        // size
+        uint32_t data_size = (uint32_t)tile_size + curr_data_size + tile_size_bytes + 10 /*MAX length_field_size*/ +
+            (uint32_t)(output_bitstream_ptr->buffer_av1 - output_bitstream_ptr->buffer_begin_av1);
+        if (output_bitstream_ptr->size < data_size) {
+            svt_realloc_output_bitstream_unit(output_bitstream_ptr,
+                                              data_size + 1); // plus one for good measure
+            data = output_bitstream_ptr->buffer_av1;
+        }
+        svt_memcpy(data + curr_data_size + tile_size_bytes, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
+        curr_data_size += (tile_size + tile_size_bytes);
+    }
+    *data_ptr = data;
+    return curr_data_size;
+}
+
 /**************************************************
 * EncodeFrameHeaderHeader
 **************************************************/
@@ -3807,32 +3847,8 @@ EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceCon
     curr_data_size += write_tile_group_header(
         data + curr_data_size, 0, 0, n_log2_tiles, tile_start_and_end_present_flag);
 
-    if (!show_existing) {
-        // Add data from EC stream to Picture Stream.
-        for (int tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
-            const int32_t tile_size       = pcs->ec_info[tile_idx]->ec->ec_writer.pos;
-            uint8_t       tile_size_bytes = 0;
-            // tile_size += (tile_idx != tile_cnt - 1) ? 4 : 0;
-            if (tile_idx != tile_cnt - 1 && tile_cnt > 1) {
-                tile_size_bytes = pcs->tile_size_bytes_minus_1 + 1;
-                mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
-            }
-            OutputBitstreamUnit *ec_output_bitstream_ptr =
-                (OutputBitstreamUnit *)pcs->ec_info[tile_idx]->ec->ec_output_bitstream_ptr;
-            assert(output_bitstream_ptr->buffer_av1 >= output_bitstream_ptr->buffer_begin_av1);
-            // Size of the buffer needed to store all data; if buffer is too small, increase buffer
-            // size
-            uint32_t data_size = (uint32_t)tile_size + curr_data_size + tile_size_bytes + 10 /*MAX length_field_size*/ +
-                (uint32_t)(output_bitstream_ptr->buffer_av1 - output_bitstream_ptr->buffer_begin_av1);
-            if (output_bitstream_ptr->size < data_size) {
-                svt_realloc_output_bitstream_unit(output_bitstream_ptr,
-                                                  data_size + 1); // plus one for good measure
-                data = output_bitstream_ptr->buffer_av1;
-            }
-            svt_memcpy(data + curr_data_size + tile_size_bytes, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
-            curr_data_size += (tile_size + tile_size_bytes);
-        }
-    }
+    if (!show_existing)
+        curr_data_size = write_tiles(output_bitstream_ptr, pcs, &data, curr_data_size, 0, tile_cnt);
     const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
     const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
     if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
@@ -3845,6 +3861,54 @@ EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceCon
     return return_error;
 }
 
+/**************************************************
+* svt_aom_write_frame_header_obu_av1
+*   Frame header in its own OBU, the tiles follow in
+*   tile group OBUs (sub-frame output)
+**************************************************/
+EbErrorType svt_aom_write_frame_header_obu_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
+                                               PictureControlSet *pcs) {
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit *)bitstream_ptr->output_bitstream_ptr;
+    uint8_t             *data                 = output_bitstream_ptr->buffer_av1;
+
+    const uint32_t obu_header_size = write_obu_header(OBU_FRAME_HEADER, 0, data);
+    const uint32_t obu_payload_size = write_frame_header_obu(scs, pcs->ppcs, data + obu_header_size, 0, 1);
+    const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
+        assert(0);
+    }
+    data += obu_header_size + obu_payload_size + length_field_size;
+    output_bitstream_ptr->buffer_av1 = data;
+    return EB_ErrorNone;
+}
+
+/**************************************************
+* svt_aom_write_tile_group_av1
+*   Tiles [tile_start, tile_end) of the picture in a
+*   tile group OBU (sub-frame output)
+**************************************************/
+EbErrorType svt_aom_write_tile_group_av1(Bitstream *bitstream_ptr, PictureControlSet *pcs, int tile_start,
+                                         int tile_end) {
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit *)bitstream_ptr->output_bitstream_ptr;
+    Av1Common *const     cm                   = pcs->ppcs->av1_cm;
+    uint8_t             *data                 = output_bitstream_ptr->buffer_av1;
+
+    const uint32_t obu_header_size = write_obu_header(OBU_TILE_GROUP, 0, data);
+    int32_t        curr_data_size  = obu_header_size;
+    curr_data_size += write_tile_group_header(
+        data + curr_data_size, tile_start, tile_end - 1, cm->log2_tile_rows + cm->log2_tile_cols, 1);
+    curr_data_size = write_tiles(output_bitstream_ptr, pcs, &data, curr_data_size, tile_start, tile_end);
+
+    const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
+    const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
+        assert(0);
+    }
+    data += curr_data_size + length_field_size;
+    output_bitstream_ptr->buffer_av1 = data;
+    return EB_ErrorNone;
+}
+
 /**************************************************
 * svt_aom_encode_sps_av1
 **************************************************/
@@ -182,6 +182,11 @@ extern EbErrorType svt_aom_write_metadata_av1(Bitstream *bitstream_ptr, SvtMetad
                                               const EbAv1MetadataType type);
 extern EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
                                                   PictureControlSet *pcs, uint8_t show_existing);
+// Sub-frame output: the frame header OBU, then one tile group OBU per run of coded tiles
+extern EbErrorType svt_aom_write_frame_header_obu_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs,
+                                                      PictureControlSet *pcs);
+extern EbErrorType svt_aom_write_tile_group_av1(Bitstream *bitstream_ptr, PictureControlSet *pcs, int tile_start,
+                                                int tile_end);
 extern EbErrorType svt_aom_encode_td_av1(uint8_t *bitstream_ptr);
 extern EbErrorType svt_aom_encode_sps_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs);
 
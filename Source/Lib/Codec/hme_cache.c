@@ -0,0 +1,211 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+#include "hme_cache.h"
+#include "me_context.h"
+#include "pcs.h"
+#include "reference_object.h"
+#include "svt_threads.h"
+#include "svt_malloc.h"
+
+static void hme_cache_dctor(EbPtr p) {
+    HmeCache *obj = (HmeCache *)p;
+    for (uint32_t i = 0; i < HME_CACHE_FIELD_COUNT; i++) EB_FREE_ARRAY(obj->fields[i].blocks);
+    EB_DESTROY_MUTEX(obj->lock);
+}
+
+EbErrorType svt_aom_hme_cache_ctor(HmeCache *cache, uint32_t b64_count) {
+    cache->dctor     = hme_cache_dctor;
+    cache->b64_count = b64_count;
+    for (uint32_t i = 0; i < HME_CACHE_FIELD_COUNT; i++) EB_CALLOC_ARRAY(cache->fields[i].blocks, b64_count);
+    EB_CREATE_MUTEX(cache->lock);
+    return EB_ErrorNone;
+}
+
+// FNV-1a
+static void hash_add(uint64_t *hash, const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++) *hash = (*hash ^ bytes[i]) * 0x100000001b3ULL;
+}
+#define HASH_ADD(hash, field) hash_add(hash, &(field), sizeof(field))
+
+static void hash_add_sa(uint64_t *hash, const SearchAreaMinMax *sa) {
+    HASH_ADD(hash, sa->sa_min.width);
+    HASH_ADD(hash, sa->sa_min.height);
+    HASH_ADD(hash, sa->sa_max.width);
+    HASH_ADD(hash, sa->sa_max.height);
+}
+
+static const EbPaReferenceObject *get_ref_object(PictureParentControlSet *pcs, MeContext *me_ctx, uint8_t list_i,
+                                                 uint8_t ref_i) {
+    // TF searches a single reference, the picture being filtered with the centre one
+    if (me_ctx->me_type == ME_MCTF)
+        return (const EbPaReferenceObject *)me_ctx->alt_ref_reference_ptr;
+    return (const EbPaReferenceObject *)pcs->ref_pa_pic_ptr_array[list_i][ref_i]->object_ptr;
+}
+
+static uint32_t get_src_version(PictureParentControlSet *pcs) {
+    return ((const EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr)->content_version;
+}
+
+uint64_t svt_aom_hme_cache_signature(PictureParentControlSet *pcs, MeContext *me_ctx) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    HASH_ADD(&hash, me_ctx->me_type);
+    HASH_ADD(&hash, me_ctx->hme_search_method);
+    HASH_ADD(&hash, me_ctx->enable_hme_flag);
+    HASH_ADD(&hash, me_ctx->enable_hme_level0_flag);
+    HASH_ADD(&hash, me_ctx->enable_hme_level1_flag);
+    HASH_ADD(&hash, me_ctx->enable_hme_level2_flag);
+    HASH_ADD(&hash, me_ctx->num_hme_sa_w);
+    HASH_ADD(&hash, me_ctx->num_hme_sa_h);
+    hash_add_sa(&hash, &me_ctx->hme_l0_sa);
+    HASH_ADD(&hash, me_ctx->hme_l1_sa.width);
+    HASH_ADD(&hash, me_ctx->hme_l1_sa.height);
+    HASH_ADD(&hash, me_ctx->hme_l2_sa.width);
+    HASH_ADD(&hash, me_ctx->hme_l2_sa.height);
+    HASH_ADD(&hash, me_ctx->prehme_ctrl.enable);
+    for (int sr_i = 0; sr_i < SEARCH_REGION_COUNT; sr_i++) hash_add_sa(&hash, &me_ctx->prehme_ctrl.prehme_sa_cfg[sr_i]);
+    HASH_ADD(&hash, me_ctx->prehme_ctrl.skip_search_line);
+    HASH_ADD(&hash, me_ctx->prehme_ctrl.l1_early_exit);
+    HASH_ADD(&hash, me_ctx->me_hme_prune_ctrls.zz_sad_th);
+    HASH_ADD(&hash, me_ctx->me_hme_prune_ctrls.zz_sad_pct);
+    HASH_ADD(&hash, me_ctx->me_hme_prune_ctrls.phme_sad_th);
+    HASH_ADD(&hash, me_ctx->me_hme_prune_ctrls.phme_sad_pct);
+    HASH_ADD(&hash, me_ctx->me_sr_adjustment_ctrls.enable_me_sr_adjustment);
+    HASH_ADD(&hash, me_ctx->me_sr_adjustment_ctrls.distance_based_hme_resizing);
+    HASH_ADD(&hash, me_ctx->reduce_hme_l0_sr_th_min);
+    HASH_ADD(&hash, me_ctx->reduce_hme_l0_sr_th_max);
+    HASH_ADD(&hash, me_ctx->me_early_exit_th);
+    HASH_ADD(&hash, me_ctx->me_safe_limit_zz_th);
+    HASH_ADD(&hash, me_ctx->prev_me_stage_based_exit_th);
+    HASH_ADD(&hash, me_ctx->temporal_layer_index);
+    HASH_ADD(&hash, me_ctx->is_ref);
+    HASH_ADD(&hash, me_ctx->b64_width);
+    HASH_ADD(&hash, me_ctx->b64_height);
+    HASH_ADD(&hash, me_ctx->b64_src_stride);
+    HASH_ADD(&hash, me_ctx->sixteenth_b64_buffer_stride);
+    HASH_ADD(&hash, pcs->hierarchical_levels);
+    HASH_ADD(&hash, pcs->temporal_layer_index);
+    HASH_ADD(&hash, pcs->similar_brightness_refs);
+    HASH_ADD(&hash, pcs->is_overlay);
+    // The references are pruned against each other, the whole set has to match
+    HASH_ADD(&hash, me_ctx->num_of_list_to_search);
+    for (uint8_t list_i = 0; list_i < me_ctx->num_of_list_to_search; list_i++) {
+        HASH_ADD(&hash, me_ctx->num_of_ref_pic_to_search[list_i]);
+        for (uint8_t ref_i = 0; ref_i < me_ctx->num_of_ref_pic_to_search[list_i]; ref_i++) {
+            const EbDownScaledBufDescPtrArray *ref = &me_ctx->me_ds_ref_array[list_i][ref_i];
+            HASH_ADD(&hash, ref->picture_number);
+            HASH_ADD(&hash, ref->picture_ptr);
+            HASH_ADD(&hash, ref->quarter_picture_ptr);
+            HASH_ADD(&hash, ref->sixteenth_picture_ptr);
+            HASH_ADD(&hash, get_ref_object(pcs, me_ctx, list_i, ref_i)->content_version);
+        }
+    }
+    return hash;
+}
+
+static void get_key(PictureParentControlSet *pcs, MeContext *me_ctx, uint8_t list_i, uint8_t ref_i,
+                    uint64_t search_sig, HmeFieldKey *key) {
+    // zeroed so keys compare with memcmp
+    memset(key, 0, sizeof(*key));
+    key->search_sig  = search_sig;
+    key->src_poc     = pcs->picture_number;
+    key->ref_poc     = me_ctx->me_ds_ref_array[list_i][ref_i].picture_number;
+    key->src_version = get_src_version(pcs);
+    key->ref_version = get_ref_object(pcs, me_ctx, list_i, ref_i)->content_version;
+    key->block_size  = BLOCK_SIZE_64;
+    key->list_idx    = list_i;
+    key->ref_idx     = ref_i;
+}
+
+static HmeMotionField *find_field(HmeCache *cache, const HmeFieldKey *key) {
+    for (uint32_t i = 0; i < HME_CACHE_FIELD_COUNT; i++) {
+        HmeMotionField *field = &cache->fields[i];
+        if (field->last_use && !memcmp(&field->key, key, sizeof(*key)))
+            return field;
+    }
+    return NULL;
+}
+
+Bool svt_aom_hme_cache_lookup(HmeCache *cache, PictureParentControlSet *pcs, MeContext *me_ctx, uint32_t b64_index,
+                              uint64_t search_sig) {
+    if (b64_index >= cache->b64_count || !me_ctx->num_of_list_to_search)
+        return FALSE;
+    const HmeBlockResult *results[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    HmeMotionField       *fields[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    Bool                  hit = TRUE;
+    svt_block_on_mutex(cache->lock);
+    for (uint8_t list_i = 0; list_i < me_ctx->num_of_list_to_search && hit; list_i++) {
+        for (uint8_t ref_i = 0; ref_i < me_ctx->num_of_ref_pic_to_search[list_i] && hit; ref_i++) {
+            HmeFieldKey key;
+            get_key(pcs, me_ctx, list_i, ref_i, search_sig, &key);
+            fields[list_i][ref_i]  = find_field(cache, &key);
+            results[list_i][ref_i] = fields[list_i][ref_i] ? &fields[list_i][ref_i]->blocks[b64_index] : NULL;
+            hit = results[list_i][ref_i] && results[list_i][ref_i]->src == me_ctx->b64_src_ptr;
+        }
+    }
+    if (hit) {
+        for (uint8_t list_i = 0; list_i < me_ctx->num_of_list_to_search; list_i++) {
+            for (uint8_t ref_i = 0; ref_i < me_ctx->num_of_ref_pic_to_search[list_i]; ref_i++) {
+                const HmeBlockResult *res             = results[list_i][ref_i];
+                SearchResults        *search_results = &me_ctx->search_results[list_i][ref_i];
+                search_results->hme_sc_x             = res->hme_sc_x;
+                search_results->hme_sc_y             = res->hme_sc_y;
+                search_results->hme_sad              = res->hme_sad;
+                search_results->do_ref               = res->do_ref;
+                me_ctx->zz_sad[list_i][ref_i]        = res->zz_sad;
+                me_ctx->best_list_idx                = res->best_list_idx;
+                me_ctx->best_ref_idx                 = res->best_ref_idx;
+                fields[list_i][ref_i]->last_use      = ++cache->use_count;
+            }
+        }
+    }
+    svt_release_mutex(cache->lock);
+    svt_atomic_fetch_add_u64(hit ? &cache->hits : &cache->misses, 1);
+    return hit;
+}
+
+void svt_aom_hme_cache_store(HmeCache *cache, PictureParentControlSet *pcs, MeContext *me_ctx, uint32_t b64_index,
+                             uint64_t search_sig) {
+    if (b64_index >= cache->b64_count)
+        return;
+    svt_block_on_mutex(cache->lock);
+    for (uint8_t list_i = 0; list_i < me_ctx->num_of_list_to_search; list_i++) {
+        for (uint8_t ref_i = 0; ref_i < me_ctx->num_of_ref_pic_to_search[list_i]; ref_i++) {
+            HmeFieldKey key;
+            get_key(pcs, me_ctx, list_i, ref_i, search_sig, &key);
+            HmeMotionField *field = find_field(cache, &key);
+            if (!field) {
+                // Replace the least recently used field
+                field = &cache->fields[0];
+                for (uint32_t i = 1; i < HME_CACHE_FIELD_COUNT; i++)
+                    if (cache->fields[i].last_use < field->last_use)
+                        field = &cache->fields[i];
+                field->key = key;
+                memset(field->blocks, 0, sizeof(*field->blocks) * cache->b64_count);
+            }
+            field->last_use = ++cache->use_count;
+
+            const SearchResults *search_results = &me_ctx->search_results[list_i][ref_i];
+            HmeBlockResult      *res            = &field->blocks[b64_index];
+            res->src                            = me_ctx->b64_src_ptr;
+            res->hme_sc_x                       = search_results->hme_sc_x;
+            res->hme_sc_y                       = search_results->hme_sc_y;
+            res->hme_sad                        = search_results->hme_sad;
+            res->do_ref                         = search_results->do_ref;
+            res->zz_sad                         = me_ctx->zz_sad[list_i][ref_i];
+            res->best_list_idx                  = me_ctx->best_list_idx;
+            res->best_ref_idx                   = me_ctx->best_ref_idx;
+        }
+    }
+    svt_release_mutex(cache->lock);
+}
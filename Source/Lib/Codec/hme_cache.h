@@ -0,0 +1,92 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbHmeCache_h
+#define EbHmeCache_h
+
+#include "definitions.h"
+#include "object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct PictureParentControlSet;
+struct MeContext;
+
+/**************************************
+     * HME cache
+     *   Keeps the HME output (search centre, HME SAD, (0,0) SAD and the
+     *   reference pruning decision) of every 64x64 block of the last
+     *   searched picture pairs, keyed by (source POC, reference POC, block
+     *   size), so a later search of the same pair skips HME. A motion field
+     *   is only reused when everything the search reads matches: the search
+     *   settings, the whole reference set and the pixels of the pictures
+     *   (see EbPaReferenceObject content_version), so the ME output does not
+     *   depend on whether HME was taken from the cache.
+     **************************************/
+#define HME_CACHE_FIELD_COUNT 64
+
+typedef struct HmeBlockResult {
+    const uint8_t *src; // source block the results were searched for, NULL when not cached
+    uint64_t       hme_sad;
+    uint32_t       zz_sad;
+    int16_t        hme_sc_x;
+    int16_t        hme_sc_y;
+    uint8_t        do_ref;
+    uint8_t        best_list_idx;
+    uint8_t        best_ref_idx;
+} HmeBlockResult;
+
+typedef struct HmeFieldKey {
+    uint64_t search_sig; // hash of the search settings and of the whole reference set
+    uint64_t src_poc;
+    uint64_t ref_poc;
+    uint32_t src_version;
+    uint32_t ref_version;
+    uint8_t  block_size;
+    uint8_t  list_idx;
+    uint8_t  ref_idx;
+} HmeFieldKey;
+
+// Results of one picture pair, one entry per 64x64 block
+typedef struct HmeMotionField {
+    HmeFieldKey     key;
+    uint64_t        last_use;
+    HmeBlockResult *blocks;
+} HmeMotionField;
+
+typedef struct HmeCache {
+    EbDctor        dctor;
+    EbHandle       lock;
+    uint32_t       b64_count;
+    uint64_t       use_count;
+    HmeMotionField fields[HME_CACHE_FIELD_COUNT];
+    // Blocks whose HME was taken from the cache / had to be searched, see SVT_AV1_STREAM_INFO_HME_CACHE_STATS
+    volatile uint64_t hits;
+    volatile uint64_t misses;
+} HmeCache;
+
+EbErrorType svt_aom_hme_cache_ctor(HmeCache *cache, uint32_t b64_count);
+
+// Hash of what the HME of me_ctx depends on besides the source block, taken before HME runs
+uint64_t svt_aom_hme_cache_signature(struct PictureParentControlSet *pcs, struct MeContext *me_ctx);
+// Fills the HME output of me_ctx for block b64_index from the cache, returns FALSE when not cached
+Bool svt_aom_hme_cache_lookup(HmeCache *cache, struct PictureParentControlSet *pcs, struct MeContext *me_ctx,
+                              uint32_t b64_index, uint64_t search_sig);
+// Saves the HME output of me_ctx for block b64_index
+void svt_aom_hme_cache_store(HmeCache *cache, struct PictureParentControlSet *pcs, struct MeContext *me_ctx,
+                             uint32_t b64_index, uint64_t search_sig);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbHmeCache_h
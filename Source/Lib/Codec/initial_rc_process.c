@@ -23,6 +23,7 @@
 #include "svt_log.h"
 #include "pd_process.h"
 #include "firstpass.h"
+#include "svt_trace.h"
 /**************************************
  * Context
  **************************************/
@@ -376,6 +377,7 @@ static void set_tpl_params(PictureParentControlSet *pcs, uint8_t tpl_level) {
         break;
     default: assert(0); break;
     }
+    tpl_ctrls->ds_shift = scs->static_config.tpl_downscale;
 }
 
 /*
@@ -676,6 +678,7 @@ void *svt_aom_initial_rate_control_kernel(void *input_ptr) {
 
         MotionEstimationResults *in_results_ptr = (MotionEstimationResults *)in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet *pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
+        svt_trace_picture(pcs->picture_number, (int32_t)in_results_ptr->segment_index);
 
         // Set the segment counter
         pcs->me_segments_completion_count++;
@@ -61,6 +61,7 @@ static void mode_decision_context_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->fast_cand_ptr_array);
     EB_FREE_2D(obj->injected_mvs);
     EB_FREE_ARRAY(obj->injected_ref_types);
+    EB_FREE_ARRAY(obj->cand_cache);
     EB_FREE_ARRAY(obj->fast_cost_array);
     EB_FREE_ARRAY(obj->full_cost_array);
     if (obj->md_blk_arr_nsq) {
@@ -263,6 +264,8 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
     svt_aom_assert_err(max_can_count > ind_uv_cands, "Max. candidates is too low");
     EB_MALLOC_2D(ctx->injected_mvs, (uint16_t)(max_can_count - ind_uv_cands), 2);
     EB_MALLOC_ARRAY(ctx->injected_ref_types, (max_can_count - ind_uv_cands));
+    EB_CALLOC_ARRAY(ctx->cand_cache, (1 << MD_CAND_CACHE_LOG2));
+    ctx->cand_cache_gen = 0;
 
     for (cand_index = 0; cand_index < max_can_count; ++cand_index) {
         ctx->fast_cand_ptr_array[cand_index]               = &ctx->fast_cand_array[cand_index];
@@ -891,6 +891,27 @@ typedef struct CompoundPredictionStore {
     IntMv    pred1_mv[4];
 } CompoundPredictionStore;
 
+// Number of entries (log2) of the per-SB MDS0 candidate distortion cache
+#define MD_CAND_CACHE_LOG2 12
+/* MDS0 luma distortion of an inter candidate. The key holds everything the prediction and the
+ * distortion kernel read, so an entry can be reused by any candidate of any PD pass that lands on
+ * the same block with the same motion. Entries are only valid for the SB generation they were
+ * written in. */
+typedef struct MdCandCacheEntry {
+    uint32_t sb_gen;
+    uint32_t mv[MAX_NUM_OF_REF_PIC_LIST];
+    uint32_t interp_filters;
+    uint32_t luma_dist;
+    uint16_t org_x;
+    uint16_t org_y;
+    uint8_t  bsize;
+    uint8_t  ref_frame_type;
+    // interinter_comp.type and compound_idx
+    uint8_t comp;
+    // hbd_md and mds0_dist_type
+    uint8_t dist_cfg;
+} MdCandCacheEntry;
+
 typedef struct ModeDecisionContext {
     EbDctor dctor;
 
@@ -1250,6 +1271,10 @@ typedef struct ModeDecisionContext {
     // SSIM_LVL_1: use ssim cost to find best candidate in product_full_mode_decision()
     // SSIM_LVL_2: addition to level 1, also use ssim cost to find best tx type in tx_type_search()
     SsimLevel tune_ssim_level;
+    // MDS0 inter distortions of the current SB, shared by all PD passes; cand_cache_gen is bumped
+    // at each new SB to invalidate the previous entries
+    MdCandCacheEntry *cand_cache;
+    uint32_t          cand_cache_gen;
 } ModeDecisionContext;
 
 typedef void (*EbAv1LambdaAssignFunc)(PictureControlSet *pcs, uint32_t *fast_lambda, uint32_t *full_lambda,
@@ -19,6 +19,9 @@
 #include "bitstream_unit.h"
 #include "rd_cost.h"
 #include "inter_prediction.h"
+#include "encode_context.h"
+#include "svt_threads.h"
+#include "svt_malloc.h"
 
 static INLINE int32_t get_interinter_wedge_bits(BlockSize bsize) {
     const int32_t wbits = svt_aom_get_wedge_params_bits(bsize);
@@ -126,12 +129,15 @@ void svt_aom_estimate_syntax_rate(MdRateEstimationContext *md_rate_est_ctx, Bool
 
     for (i = 0; i < SKIP_CONTEXTS; ++i)
         svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
-    for (i = 0; i < KF_MODE_CONTEXTS; ++i)
-        for (j = 0; j < KF_MODE_CONTEXTS; ++j)
-            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
-
-    for (i = 0; i < BlockSize_GROUPS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+    // MD only reads the key frame luma mode rates in I slices, and the inter frame ones elsewhere
+    if (is_i_slice) {
+        for (i = 0; i < KF_MODE_CONTEXTS; ++i)
+            for (j = 0; j < KF_MODE_CONTEXTS; ++j)
+                svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
+    } else {
+        for (i = 0; i < BlockSize_GROUPS; ++i)
+            svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+    }
 
     for (i = 0; i < CFL_ALLOWED_TYPES; ++i) {
         for (j = 0; j < INTRA_MODES; ++j)
@@ -146,9 +152,6 @@ void svt_aom_estimate_syntax_rate(MdRateEstimationContext *md_rate_est_ctx, Bool
                     md_rate_est_ctx->filter_intra_fac_bits[i], fc->filter_intra_cdfs[i], NULL);
         }
     }
-    for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
-        svt_aom_get_syntax_rate_from_cdf(
-            md_rate_est_ctx->switchable_interp_fac_bitss[i], fc->switchable_interp_cdf[i], NULL);
     if (allow_screen_content_tools) {
         for (i = 0; i < PALATTE_BSIZE_CTXS; ++i) {
             svt_aom_get_syntax_rate_from_cdf(
@@ -231,6 +234,9 @@ void svt_aom_estimate_syntax_rate(MdRateEstimationContext *md_rate_est_ctx, Bool
     }
 
     if (!is_i_slice) { // NM - Hardcoded to true
+        for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
+            svt_aom_get_syntax_rate_from_cdf(
+                md_rate_est_ctx->switchable_interp_fac_bitss[i], fc->switchable_interp_cdf[i], NULL);
         for (i = 0; i < COMP_INTER_CONTEXTS; ++i)
             svt_aom_get_syntax_rate_from_cdf(md_rate_est_ctx->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
         for (i = 0; i < REF_CONTEXTS; ++i) {
@@ -345,6 +351,53 @@ MvClassType svt_av1_get_mv_class(int32_t z, int32_t *offset) {
 void svt_av1_build_nmv_cost_table(int32_t *mvjoint, int32_t *mvcost[2], const NmvContext *ctx,
                                   MvSubpelPrecision precision);
 
+static void mv_rate_cache_dctor(EbPtr p) {
+    MvRateCache *obj = (MvRateCache *)p;
+    EB_DESTROY_MUTEX(obj->lock);
+}
+
+EbErrorType svt_aom_mv_rate_cache_ctor(MvRateCache *cache) {
+    cache->dctor = mv_rate_cache_dctor;
+    EB_CREATE_MUTEX(cache->lock);
+    return EB_ErrorNone;
+}
+
+// Copies the MV cost tables built from nmvc at the given precision, returns FALSE when not cached
+static Bool mv_rate_cache_lookup(MvRateCache *cache, const NmvContext *nmvc, uint8_t allow_high_precision_mv,
+                                 int32_t *nmv_vec_cost, int32_t (*nmv_costs)[MV_VALS]) {
+    Bool found = FALSE;
+    svt_block_on_mutex(cache->lock);
+    for (int i = 0; i < MV_RATE_CACHE_SIZE; i++) {
+        MvRateCacheEntry *entry = &cache->entries[i];
+        if (entry->last_use && entry->allow_high_precision_mv == allow_high_precision_mv &&
+            !memcmp(&entry->nmvc, nmvc, sizeof(*nmvc))) {
+            memcpy(nmv_vec_cost, entry->nmv_vec_cost, sizeof(entry->nmv_vec_cost));
+            memcpy(nmv_costs, entry->nmv_costs, sizeof(entry->nmv_costs));
+            entry->last_use = ++cache->use_count;
+            found           = TRUE;
+            break;
+        }
+    }
+    svt_release_mutex(cache->lock);
+    return found;
+}
+
+// Saves the MV cost tables built from nmvc, replacing the least recently used entry
+static void mv_rate_cache_store(MvRateCache *cache, const NmvContext *nmvc, uint8_t allow_high_precision_mv,
+                                const int32_t *nmv_vec_cost, int32_t (*nmv_costs)[MV_VALS]) {
+    svt_block_on_mutex(cache->lock);
+    MvRateCacheEntry *entry = &cache->entries[0];
+    for (int i = 1; i < MV_RATE_CACHE_SIZE; i++)
+        if (cache->entries[i].last_use < entry->last_use)
+            entry = &cache->entries[i];
+    entry->nmvc                    = *nmvc;
+    entry->allow_high_precision_mv = allow_high_precision_mv;
+    memcpy(entry->nmv_vec_cost, nmv_vec_cost, sizeof(entry->nmv_vec_cost));
+    memcpy(entry->nmv_costs, nmv_costs, sizeof(entry->nmv_costs));
+    entry->last_use = ++cache->use_count;
+    svt_release_mutex(cache->lock);
+}
+
 /**************************************************************************
  * svt_aom_estimate_mv_rate()
  * Estimate the rate of motion vectors
@@ -371,10 +424,20 @@ void svt_aom_estimate_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *m
     nmvcost_hp[1]                   = &md_rate_est_ctx->nmv_costs_hp[1][MV_MAX];
     uint8_t allow_high_precision_mv = pcs->ppcs->bypass_cost_table_gen ? 0 : frm_hdr->allow_high_precision_mv;
     if (!pcs->ppcs->bypass_cost_table_gen) {
-        svt_av1_build_nmv_cost_table(md_rate_est_ctx->nmv_vec_cost, // out
-                                     allow_high_precision_mv ? nmvcost_hp : nmvcost, // out
-                                     &fc->nmvc,
-                                     allow_high_precision_mv);
+        MvRateCache *cache = pcs->ppcs->scs->enc_ctx->mv_rate_cache;
+        int32_t(*nmv_costs)[MV_VALS] = allow_high_precision_mv ? md_rate_est_ctx->nmv_costs_hp
+                                                                : md_rate_est_ctx->nmv_costs;
+        if (!cache ||
+            !mv_rate_cache_lookup(
+                cache, &fc->nmvc, allow_high_precision_mv, md_rate_est_ctx->nmv_vec_cost, nmv_costs)) {
+            svt_av1_build_nmv_cost_table(md_rate_est_ctx->nmv_vec_cost, // out
+                                         allow_high_precision_mv ? nmvcost_hp : nmvcost, // out
+                                         &fc->nmvc,
+                                         allow_high_precision_mv);
+            if (cache)
+                mv_rate_cache_store(
+                    cache, &fc->nmvc, allow_high_precision_mv, md_rate_est_ctx->nmv_vec_cost, nmv_costs);
+        }
         md_rate_est_ctx->nmvcoststack[0] = allow_high_precision_mv ? &md_rate_est_ctx->nmv_costs_hp[0][MV_MAX]
                                                                    : &md_rate_est_ctx->nmv_costs[0][MV_MAX];
         md_rate_est_ctx->nmvcoststack[1] = allow_high_precision_mv ? &md_rate_est_ctx->nmv_costs_hp[1][MV_MAX]
@@ -134,6 +134,32 @@ extern "C" {
         int32_t switchable_interp_fac_bitss[SWITCHABLE_FILTER_CONTEXTS][SWITCHABLE_FILTERS];
         int32_t initialized;
     } MdRateEstimationContext;
+
+    /**************************************
+     * MV rate cache
+     *   Keeps the MV cost tables last built by svt_aom_estimate_mv_rate(),
+     *   keyed by the MV CDFs they were derived from and the MV precision.
+     *   Pictures that start from the same context (same primary reference
+     *   frame, or the default CDFs) copy the tables instead of rebuilding them.
+     **************************************/
+#define MV_RATE_CACHE_SIZE 4
+
+    typedef struct MvRateCacheEntry {
+        NmvContext nmvc;
+        uint8_t    allow_high_precision_mv;
+        uint64_t   last_use; // 0 when empty
+        int32_t    nmv_vec_cost[MV_JOINTS];
+        int32_t    nmv_costs[2][MV_VALS];
+    } MvRateCacheEntry;
+
+    typedef struct MvRateCache {
+        EbDctor          dctor;
+        EbHandle         lock;
+        uint64_t         use_count;
+        MvRateCacheEntry entries[MV_RATE_CACHE_SIZE];
+    } MvRateCache;
+
+    extern EbErrorType svt_aom_mv_rate_cache_ctor(MvRateCache *cache);
     /***************************************************************************
     * AV1 Probability table
     * // round(-log2(i/256.) * (1 << AV1_PROB_COST_SHIFT)); i = 128~255.
@@ -403,6 +403,8 @@ typedef struct MeContext {
     EB_ALIGN(64) uint32_t p_eight_sad32x32[4][8];
     EB_ALIGN(64) uint32_t p_eight_sad16x16[16][8];
     EB_ALIGN(64) uint32_t p_eight_sad8x8[64][8];
+    // 16x16 SADs of every reference searched by open_loop_me_fullpel_search_sblock_multi()
+    EB_ALIGN(64) uint32_t p_ref_eight_sad16x16[MAX_NUM_OF_REF_PIC_LIST * MAX_REF_IDX][16][8];
     EbBitFraction     *mvd_bits_array;
     uint8_t            hme_search_method;
     uint8_t            me_search_method;
@@ -500,6 +502,12 @@ typedef struct MeContext {
     uint32_t     me_safe_limit_zz_th;
     uint32_t     tf_tot_vert_blks; //total vertical motion blocks in TF
     uint32_t     tf_tot_horz_blks; //total horizontal motion blocks in TF
+    uint32_t     tf_tot_blks; //total 64x64 block / reference pairs in TF
+    uint32_t     tf_skip_blks; //pairs predicted with the (0, 0) MV without ME in TF
+    uint32_t     tf_seed_blks; //pairs searched from the previous reference MV in TF
+    uint8_t      tf_seed_valid; //use tf_seed_mv_x/y as the search centre of the TF ME (skips HME)
+    int16_t      tf_seed_mv_x; //full-pel
+    int16_t      tf_seed_mv_y;
     uint8_t      skip_frame;
     uint8_t      bypass_blk_step;
     uint32_t     b64_width;
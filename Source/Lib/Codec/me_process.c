@@ -34,6 +34,7 @@
 #include "firstpass.h"
 #include "initial_rc_process.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 /* --32x32-
 |00||01|
@@ -108,6 +109,7 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
         PictureParentControlSet *pcs = (PictureParentControlSet *)
                                                in_results_ptr->pcs_wrapper->object_ptr;
         SequenceControlSet *scs = pcs->scs;
+        svt_trace_picture(pcs->picture_number, (int32_t)in_results_ptr->segment_index);
         if (in_results_ptr->task_type == TASK_TFME)
             me_context_ptr->me_ctx->me_type = ME_MCTF;
         else if (in_results_ptr->task_type == TASK_PAME || in_results_ptr->task_type == TASK_SUPERRES_RE_ME)
@@ -361,6 +361,28 @@ void svt_ext_all_sad_calculation_8x8_16x16_c(uint8_t *src, uint32_t src_stride,
     }
 }
 
+/*******************************************
+Calculate the 8x8 and 16x16 SADs of eight search
+positions for several references of the same
+source block, and keep the best SAD+MV of each
+*******************************************/
+void svt_ext_all_sad_calculation_8x8_16x16_multi_c(uint8_t *src, uint32_t src_stride, MeSadRef *refs,
+                                                   uint32_t ref_count, Bool sub_sad) {
+    for (uint32_t i = 0; i < ref_count; i++)
+        svt_ext_all_sad_calculation_8x8_16x16_c(src,
+                                                src_stride,
+                                                refs[i].ref,
+                                                refs[i].ref_stride,
+                                                refs[i].mv,
+                                                refs[i].p_best_sad_8x8,
+                                                refs[i].p_best_sad_16x16,
+                                                refs[i].p_best_mv8x8,
+                                                refs[i].p_best_mv16x16,
+                                                refs[i].p_eight_sad16x16,
+                                                NULL,
+                                                sub_sad);
+}
+
 /*******************************************
 Calculate SAD for 32x32,64x64 from 16x16
 and check if there is improvment, if yes keep
@@ -816,6 +838,115 @@ static void open_loop_me_fullpel_search_sblock(MeContext *me_ctx, uint32_t list_
     }
 }
 
+// Full-pel search area of one reference, see open_loop_me_fullpel_search_sblock_multi()
+typedef struct MeRefSearchArea {
+    uint8_t  list_index;
+    uint8_t  ref_pic_index;
+    int16_t  x_search_area_origin;
+    int16_t  y_search_area_origin;
+    uint32_t search_area_width;
+    uint32_t search_area_height;
+} MeRefSearchArea;
+
+static void set_me_best_ptrs(MeContext *me_ctx, uint32_t list_index, uint32_t ref_pic_index) {
+    me_ctx->p_best_sad_64x64 = &(me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_64x64]);
+    me_ctx->p_best_sad_32x32 = &(me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_32x32_0]);
+    me_ctx->p_best_sad_16x16 = &(me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_16x16_0]);
+    me_ctx->p_best_sad_8x8   = &(me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_8x8_0]);
+
+    me_ctx->p_best_mv64x64 = &(me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_64x64]);
+    me_ctx->p_best_mv32x32 = &(me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_32x32_0]);
+    me_ctx->p_best_mv16x16 = &(me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_16x16_0]);
+    me_ctx->p_best_mv8x8   = &(me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_8x8_0]);
+}
+
+/*******************************************
+ * open_loop_me_fullpel_search_sblock_multi
+ *   Same search as open_loop_me_fullpel_search_sblock for
+ *   several references at once: every reference is scanned
+ *   in its own raster order, and the eight search positions
+ *   at a given offset of all the references are evaluated
+ *   by one svt_ext_all_sad_calculation_8x8_16x16_multi()
+ *   call, which reads the source block once for all of them.
+ *******************************************/
+static void open_loop_me_fullpel_search_sblock_multi(MeContext *me_ctx, const MeRefSearchArea *areas,
+                                                     uint32_t area_count) {
+    const Bool sub_sad     = (me_ctx->me_search_method == SUB_SAD_SEARCH);
+    uint32_t   max_width_8 = 0;
+    uint32_t   max_height  = 0;
+    MeSadRef   sad_refs[MAX_NUM_OF_REF_PIC_LIST * MAX_REF_IDX];
+    uint32_t   sad_ref_area[MAX_NUM_OF_REF_PIC_LIST * MAX_REF_IDX];
+
+    for (uint32_t i = 0; i < area_count; i++) {
+        max_width_8 = MAX(max_width_8, areas[i].search_area_width & ~7);
+        max_height  = MAX(max_height, areas[i].search_area_height);
+    }
+    for (uint32_t y_search_index = 0; y_search_index < max_height; y_search_index++) {
+        for (uint32_t x_search_index = 0; x_search_index < max_width_8; x_search_index += 8) {
+            uint32_t ref_count = 0;
+            for (uint32_t i = 0; i < area_count; i++) {
+                const MeRefSearchArea *area = &areas[i];
+                if (y_search_index >= area->search_area_height ||
+                    x_search_index >= (area->search_area_width & ~7))
+                    continue;
+                const uint32_t list_index    = area->list_index;
+                const uint32_t ref_pic_index = area->ref_pic_index;
+                const uint32_t stride        = me_ctx->interpolated_full_stride[list_index][ref_pic_index];
+                const int32_t  x_mv          = (int32_t)x_search_index + area->x_search_area_origin;
+                const int32_t  y_mv          = (int32_t)y_search_index + area->y_search_area_origin;
+                MeSadRef      *sad_ref       = &sad_refs[ref_count];
+
+                sad_ref->ref = me_ctx->integer_buffer_ptr[list_index][ref_pic_index] +
+                    ((ME_FILTER_TAP >> 1) * stride) + (ME_FILTER_TAP >> 1) + x_search_index +
+                    y_search_index * stride;
+                sad_ref->ref_stride       = stride;
+                sad_ref->mv               = (((uint16_t)y_mv) << 16) | ((uint16_t)x_mv);
+                sad_ref->p_best_sad_8x8   = &(me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_8x8_0]);
+                sad_ref->p_best_sad_16x16 = &(
+                    me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_16x16_0]);
+                sad_ref->p_best_mv8x8     = &(me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_8x8_0]);
+                sad_ref->p_best_mv16x16   = &(
+                    me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_16x16_0]);
+                sad_ref->p_eight_sad16x16 = me_ctx->p_ref_eight_sad16x16[i];
+                sad_ref_area[ref_count++] = i;
+            }
+            if (!ref_count)
+                continue;
+            svt_ext_all_sad_calculation_8x8_16x16_multi(
+                me_ctx->b64_src_ptr, me_ctx->b64_src_stride, sad_refs, ref_count, sub_sad);
+
+            for (uint32_t r = 0; r < ref_count; r++) {
+                const MeRefSearchArea *area = &areas[sad_ref_area[r]];
+                svt_ext_eight_sad_calculation_32x32_64x64(
+                    sad_refs[r].p_eight_sad16x16,
+                    &(me_ctx->p_sb_best_sad[area->list_index][area->ref_pic_index][ME_TIER_ZERO_PU_32x32_0]),
+                    &(me_ctx->p_sb_best_sad[area->list_index][area->ref_pic_index][ME_TIER_ZERO_PU_64x64]),
+                    &(me_ctx->p_sb_best_mv[area->list_index][area->ref_pic_index][ME_TIER_ZERO_PU_32x32_0]),
+                    &(me_ctx->p_sb_best_mv[area->list_index][area->ref_pic_index][ME_TIER_ZERO_PU_64x64]),
+                    sad_refs[r].mv,
+                    me_ctx->p_eight_sad32x32);
+            }
+        }
+
+        // Search positions left of the multiple of 8 width, one at a time
+        for (uint32_t i = 0; i < area_count; i++) {
+            const MeRefSearchArea *area = &areas[i];
+            if (y_search_index >= area->search_area_height || !(area->search_area_width & 7))
+                continue;
+            const uint32_t stride = me_ctx->interpolated_full_stride[area->list_index][area->ref_pic_index];
+            set_me_best_ptrs(me_ctx, area->list_index, area->ref_pic_index);
+            for (uint32_t x_search_index = area->search_area_width & ~7; x_search_index < area->search_area_width;
+                 x_search_index++)
+                open_loop_me_get_search_point_results_block(me_ctx,
+                                                            area->list_index,
+                                                            area->ref_pic_index,
+                                                            x_search_index + y_search_index * stride,
+                                                            (int32_t)x_search_index + area->x_search_area_origin,
+                                                            (int32_t)y_search_index + area->y_search_area_origin);
+        }
+    }
+}
+
 // Perform HME Level 0 for one 64x64 block on the given picture
 static void hme_level_0(
     MeContext *me_ctx, // ME context Ptr, used to get/update ME results
@@ -1272,6 +1403,10 @@ static void integer_search_b64(PictureParentControlSet *pcs, uint32_t b64_index,
     int16_t              x_search_center = 0;
     int16_t              y_search_center = 0;
     EbPictureBufferDesc *ref_pic_ptr;
+    MeRefSearchArea      areas[MAX_NUM_OF_REF_PIC_LIST * MAX_REF_IDX];
+    uint32_t             area_count         = 0;
+    uint32_t             last_list_index    = 0;
+    uint32_t             last_ref_pic_index = 0;
     num_of_list_to_search = me_ctx->num_of_list_to_search;
 
     // Uni-Prediction motion estimation loop
@@ -1367,23 +1502,7 @@ static void integer_search_b64(PictureParentControlSet *pcs, uint32_t b64_index,
             }
             svt_initialize_buffer_32bits(
                 me_ctx->p_sb_best_sad[list_index][ref_pic_index], 21, 1, MAX_SAD_VALUE);
-            me_ctx->p_best_sad_64x64 = &(
-                me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_64x64]);
-            me_ctx->p_best_sad_32x32 = &(
-                me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_32x32_0]);
-            me_ctx->p_best_sad_16x16 = &(
-                me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_16x16_0]);
-            me_ctx->p_best_sad_8x8 = &(
-                me_ctx->p_sb_best_sad[list_index][ref_pic_index][ME_TIER_ZERO_PU_8x8_0]);
-
-            me_ctx->p_best_mv64x64 = &(
-                me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_64x64]);
-            me_ctx->p_best_mv32x32 = &(
-                me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_32x32_0]);
-            me_ctx->p_best_mv16x16 = &(
-                me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_16x16_0]);
-            me_ctx->p_best_mv8x8 = &(
-                me_ctx->p_sb_best_mv[list_index][ref_pic_index][ME_TIER_ZERO_PU_8x8_0]);
+            set_me_best_ptrs(me_ctx, list_index, ref_pic_index);
 
             /* If search area is large enough, check the ME 8x8 SAD variance, and if low, reduce search area
             * (as the 64x64 MVs are likely good for all the 8x8 blocks that make it up).  If the search area
@@ -1571,18 +1690,27 @@ static void integer_search_b64(PictureParentControlSet *pcs, uint32_t b64_index,
             me_ctx->interpolated_full_stride[list_index][ref_pic_index] =
                 ref_pic_ptr->stride_y;
 
-            // Move to the top left of the search region
-            x_top_left_search_region = (int16_t)(ref_pic_ptr->org_x + b64_origin_x) + x_search_area_origin;
-            y_top_left_search_region = (int16_t)(ref_pic_ptr->org_y + b64_origin_y) + y_search_area_origin;
-            open_loop_me_fullpel_search_sblock(me_ctx,
-                                               list_index,
-                                               ref_pic_index,
-                                               x_search_area_origin,
-                                               y_search_area_origin,
-                                               search_area_width,
-                                               search_area_height);
+            MeRefSearchArea *area      = &areas[area_count++];
+            area->list_index           = (uint8_t)list_index;
+            area->ref_pic_index        = ref_pic_index;
+            area->x_search_area_origin = x_search_area_origin;
+            area->y_search_area_origin = y_search_area_origin;
+            area->search_area_width    = search_area_width;
+            area->search_area_height   = search_area_height;
+            last_list_index            = list_index;
+            last_ref_pic_index         = ref_pic_index;
+            // The search area of the other references depends on the best 64x64 SAD of the first one
+            if (!list_index && !ref_pic_index && me_ctx->me_sr_adjustment_ctrls.enable_me_sr_adjustment == 2) {
+                open_loop_me_fullpel_search_sblock_multi(me_ctx, areas, area_count);
+                area_count = 0;
+            }
         }
     }
+    // Full-pel search of all the references that were not pruned by HME, in one pass over the source block
+    open_loop_me_fullpel_search_sblock_multi(me_ctx, areas, area_count);
+    // Leave the best SAD / MV pointers on the last searched reference, as when searching one reference at a time
+    if (area_count)
+        set_me_best_ptrs(me_ctx, last_list_index, last_ref_pic_index);
 }
 
 /*
@@ -2535,13 +2663,6 @@ static void hme_b64(PictureParentControlSet *pcs, uint32_t org_x, uint32_t org_y
 
     // Set final MV centre
     set_final_seach_centre_sb(pcs, me_ctx);
-
-    if (me_ctx->me_type == ME_MCTF) {
-        if (ABS(me_ctx->search_results[0][0].hme_sc_x) > ABS(me_ctx->search_results[0][0].hme_sc_y))
-            me_ctx->tf_tot_horz_blks++;
-        else
-            me_ctx->tf_tot_vert_blks++;
-    }
 }
 
 static void hme_prune_ref_and_adjust_sr(MeContext *me_ctx) {
@@ -3138,6 +3259,35 @@ static INLINE void init_me_hme_data(MeContext *me_ctx) {
     memset(me_ctx->performed_phme,0,
         sizeof(uint8_t)*MAX_NUM_OF_REF_PIC_LIST*REF_LIST_MAX_DEPTH*SEARCH_REGION_COUNT);
 }
+/*
+ * Set the TF search centre to the seed MV (the MV of the previous reference frame) instead of
+ * performing HME; the seed is kept in the range searched by the Full-Pel search.
+ */
+static void tf_set_seed_search_centre(PictureParentControlSet *pcs, MeContext *me_ctx,
+                                      uint32_t b64_origin_x, uint32_t b64_origin_y) {
+    EbPictureBufferDesc *ref_pic_ptr = me_ctx->me_ds_ref_array[0][0].picture_ptr;
+    const int16_t        org_x       = (int16_t)b64_origin_x;
+    const int16_t        org_y       = (int16_t)b64_origin_y;
+    const int16_t        pad         = (int16_t)BLOCK_SIZE_64 - 1;
+    const int16_t        x_sc        = CLIP3(-pad - org_x, (int16_t)pcs->aligned_width - 1 - org_x,
+                                            me_ctx->tf_seed_mv_x);
+    const int16_t        y_sc        = CLIP3(-pad - org_y, (int16_t)pcs->aligned_height - 1 - org_y,
+                                            me_ctx->tf_seed_mv_y);
+    const uint32_t       subsample_sad = 1;
+
+    const uint32_t search_region_index = (int16_t)ref_pic_ptr->org_x + org_x + x_sc +
+        ((int16_t)ref_pic_ptr->org_y + org_y + y_sc) * ref_pic_ptr->stride_y;
+    uint32_t sad = svt_nxm_sad_kernel(me_ctx->b64_src_ptr,
+                                      me_ctx->b64_src_stride << subsample_sad,
+                                      &(ref_pic_ptr->buffer_y[search_region_index]),
+                                      ref_pic_ptr->stride_y << subsample_sad,
+                                      me_ctx->b64_height >> subsample_sad,
+                                      me_ctx->b64_width);
+
+    me_ctx->search_results[0][0].hme_sc_x = x_sc;
+    me_ctx->search_results[0][0].hme_sc_y = y_sc;
+    me_ctx->search_results[0][0].hme_sad  = sad << subsample_sad;
+}
 /*******************************************
 * motion_estimation
 *   performs ME on 64x64 blocks
@@ -3173,8 +3323,28 @@ EbErrorType svt_aom_motion_estimation_b64(
     uint8_t prune_ref = me_ctx->enable_hme_flag && me_ctx->me_type != ME_MCTF;
     // Initialize ME/HME buffers
     init_me_hme_data(me_ctx);
-    // HME: Perform Hierachical Motion Estimation for all refrence frames for the current 64x64 block.
-    hme_b64(pcs, b64_origin_x, b64_origin_y, me_ctx, input_ptr);
+    // HME: Perform Hierachical Motion Estimation for all refrence frames for the current 64x64 block,
+    // unless the block was already searched against the same references
+    // TF: a seed MV from the previous reference frame replaces HME
+    if (me_ctx->me_type == ME_MCTF && me_ctx->tf_seed_valid) {
+        if (me_ctx->me_early_exit_th || me_ctx->me_safe_limit_zz_th)
+            init_zz_sad(pcs, me_ctx, b64_origin_x, b64_origin_y);
+        tf_set_seed_search_centre(pcs, me_ctx, b64_origin_x, b64_origin_y);
+    } else {
+        HmeCache      *hme_cache  = pcs->scs->enc_ctx->hme_cache;
+        const uint64_t search_sig = svt_aom_hme_cache_signature(pcs, me_ctx);
+        if (!svt_aom_hme_cache_lookup(hme_cache, pcs, me_ctx, b64_index, search_sig)) {
+            hme_b64(pcs, b64_origin_x, b64_origin_y, me_ctx, input_ptr);
+            svt_aom_hme_cache_store(hme_cache, pcs, me_ctx, b64_index, search_sig);
+        }
+    }
+
+    if (me_ctx->me_type == ME_MCTF) {
+        if (ABS(me_ctx->search_results[0][0].hme_sc_x) > ABS(me_ctx->search_results[0][0].hme_sc_y))
+            me_ctx->tf_tot_horz_blks++;
+        else
+            me_ctx->tf_tot_vert_blks++;
+    }
 
     if (me_ctx->me_type == ME_MCTF &&
         me_ctx->search_results[0][0].hme_sad < me_ctx->tf_me_exit_th) {
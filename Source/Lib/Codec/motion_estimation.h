@@ -169,6 +169,12 @@ extern "C" {
         uint32_t p_eight_sad16x16[16][8],
         uint32_t p_eight_sad8x8[64][8],
         Bool sub_sad);
+    extern void svt_ext_all_sad_calculation_8x8_16x16_multi_c(
+        uint8_t  *src,
+        uint32_t  src_stride,
+        MeSadRef *refs,
+        uint32_t  ref_count,
+        Bool      sub_sad);
 
     /*******************************************
     Calculate SAD for 32x32,64x64 from 16x16
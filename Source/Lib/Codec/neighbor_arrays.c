@@ -48,6 +48,7 @@ EbErrorType svt_aom_neighbor_array_unit_ctor32(NeighborArrayUnit32 *na_unit_ptr,
                                                           na_unit_ptr->granularity_top_left_log2
                                                             : 0);
 
+    const SvtAv1AllocTag alloc_tag = svt_set_alloc_tag(SVT_AV1_ALLOC_TAG_NEIGHBOR_ARRAY);
     if (na_unit_ptr->left_array_size) {
         EB_MALLOC(na_unit_ptr->left_array, na_unit_ptr->unit_size * na_unit_ptr->left_array_size);
     }
@@ -59,6 +60,7 @@ EbErrorType svt_aom_neighbor_array_unit_ctor32(NeighborArrayUnit32 *na_unit_ptr,
     if (na_unit_ptr->top_left_array_size) {
         EB_MALLOC(na_unit_ptr->top_left_array, na_unit_ptr->unit_size * na_unit_ptr->top_left_array_size);
     }
+    svt_set_alloc_tag(alloc_tag);
     return EB_ErrorNone;
 }
 
@@ -93,6 +95,7 @@ EbErrorType svt_aom_neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uin
                                                           na_unit_ptr->granularity_top_left_log2
                                                       : 0);
 
+    const SvtAv1AllocTag alloc_tag = svt_set_alloc_tag(SVT_AV1_ALLOC_TAG_NEIGHBOR_ARRAY);
     if (na_unit_ptr->left_array_size) {
         EB_MALLOC(na_unit_ptr->left_array, na_unit_ptr->unit_size * na_unit_ptr->left_array_size);
     }
@@ -102,6 +105,7 @@ EbErrorType svt_aom_neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uin
     if (na_unit_ptr->top_left_array_size) {
         EB_MALLOC(na_unit_ptr->top_left_array, na_unit_ptr->unit_size * na_unit_ptr->top_left_array_size);
     }
+    svt_set_alloc_tag(alloc_tag);
     return EB_ErrorNone;
 }
 
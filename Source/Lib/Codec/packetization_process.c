@@ -26,6 +26,7 @@
 #include "restoration.h" // RDCOST_DBL
 #include "rc_process.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 #define RDCOST_DBL_WITH_NATIVE_BD_DIST(RM, R, D, BD) RDCOST_DBL((RM), (R), (double)((D) >> (2 * (BD - 8))))
 
@@ -50,6 +51,10 @@ typedef struct PacketizationContext {
     uint64_t     dpb_disp_order[8], dpb_dec_order[8];
     uint64_t     tot_shown_frames;
     uint64_t     disp_order_continuity_count;
+    // Application callbacks, packets skip the output fifo when packet_ready is set
+    const SvtAv1EncCallbacks *event_callbacks;
+    EbHandle                  eos_delivered_semaphore;
+    Bool                      eos_delivered;
 } PacketizationContext;
 
 static Bool is_passthrough_data(EbLinkedListNode *data_node) { return data_node->passthrough; }
@@ -93,6 +98,8 @@ EbErrorType svt_aom_packetization_context_ctor(EbThreadContext *thread_ctx, cons
     context_ptr->picture_decision_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_decision_results_resource_ptr, me_port_index);
     EB_MALLOC_ARRAY(context_ptr->pps_config, 1);
+    context_ptr->event_callbacks         = &enc_handle_ptr->event_callbacks;
+    context_ptr->eos_delivered_semaphore = enc_handle_ptr->eos_delivered_semaphore;
 
     return EB_ErrorNone;
 }
@@ -277,7 +284,7 @@ static void print_detailed_frame_info(PacketizationContext            *context_p
 }
 #endif
 
-static void collect_frames_info(PacketizationContext *context_ptr, const EncodeContext *enc_ctx, int frames) {
+static void collect_frames_info(PacketizationContext *context_ptr, EncodeContext *enc_ctx, int frames) {
     for (int i = 0; i < frames; i++) {
         PacketizationReorderEntry *queue_entry_ptr   = get_reorder_queue_entry(enc_ctx, i);
         EbBufferHeaderType        *output_stream_ptr = (EbBufferHeaderType *)
@@ -298,18 +305,44 @@ static void collect_frames_info(PacketizationContext *context_ptr, const EncodeC
             queue_entry_ptr->start_time_u_seconds,
             finish_time_seconds,
             finish_time_u_seconds);
+        svt_atomic_fetch_add_u64(&enc_ctx->picture_count, 1);
+        svt_latency_histogram_add(enc_ctx->picture_latency_histogram,
+                                  ((finish_time_seconds - queue_entry_ptr->start_time_seconds) * 1000000 +
+                                   finish_time_u_seconds - queue_entry_ptr->start_time_u_seconds) *
+                                      1000);
         output_stream_ptr->p_app_private = queue_entry_ptr->out_meta_data;
         if (queue_entry_ptr->is_alt_ref)
             output_stream_ptr->flags |= (uint32_t)EB_BUFFERFLAG_IS_ALT_REF;
     }
 }
 
+// Hand a finished packet to the application: straight to packet_ready when registered,
+// otherwise through the output fifo read by svt_av1_enc_get_packet()
+static void deliver_packet(PacketizationContext *context_ptr, EbObjectWrapper *output_stream_wrapper_ptr) {
+    const SvtAv1EncCallbacks *callbacks = context_ptr->event_callbacks;
+    if (!callbacks->packet_ready) {
+        svt_post_full_object(output_stream_wrapper_ptr);
+        return;
+    }
+    EbBufferHeaderType *packet = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
+    // The application may release the packet as soon as it gets it
+    const Bool eos      = (packet->flags & EB_BUFFERFLAG_EOS) != 0;
+    packet->wrapper_ptr = output_stream_wrapper_ptr;
+    callbacks->packet_ready(callbacks->user_data, packet);
+    if (eos && !context_ptr->eos_delivered) {
+        context_ptr->eos_delivered = TRUE;
+        svt_post_semaphore(context_ptr->eos_delivered_semaphore);
+    }
+}
+
 #define TD_SIZE 2
 
 // a tu start with a td, + 0 more not displable frame, + 1 display frame
 static EbErrorType encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_bytes,
                              EbBufferHeaderType *output_stream_ptr) {
-    total_bytes += TD_SIZE;
+    // With sub-frame output the td went out with the first part of the frame
+    const uint32_t td_size = get_reorder_queue_entry(enc_ctx, 0)->sub_frame_sent ? 0 : TD_SIZE;
+    total_bytes += td_size;
     if (total_bytes > output_stream_ptr->n_alloc_len) {
         uint8_t *pbuff;
         EB_MALLOC(pbuff, total_bytes);
@@ -345,10 +378,12 @@ static EbErrorType encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_
     }
     if (frames > 1)
         sort_undisplayed_frame(enc_ctx);
-    dst -= TD_SIZE;
-    svt_aom_encode_td_av1(dst);
     output_stream_ptr->n_filled_len = total_bytes;
-    output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+    if (td_size) {
+        dst -= TD_SIZE;
+        svt_aom_encode_td_av1(dst);
+        output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+    }
     return EB_ErrorNone;
 }
 
@@ -466,6 +501,103 @@ static EbErrorType realloc_output_bitstream(Bitstream *bitstream_ptr, uint32_t s
     }
     return EB_ErrorNone;
 }
+/* Writes the OBUs ahead of the frame header: the sequence header and HDR metadata of key frames,
+ * then the ITU-T T.35 metadata of shown frames, the one of the other frames waits for their show
+ * existing frame. Returns the size of the metadata held back */
+static size_t write_frame_prefix(EncodeContext *enc_ctx, SequenceControlSet *scs, PictureControlSet *pcs) {
+    FrameHeader *frm_hdr     = &pcs->ppcs->frm_hdr;
+    size_t       metadata_sz = 0;
+
+    if (frm_hdr->frame_type == KEY_FRAME) {
+        if (scs->static_config.mastering_display.max_luma)
+            svt_add_metadata(pcs->ppcs->input_ptr,
+                             EB_AV1_METADATA_TYPE_HDR_MDCV,
+                             (const uint8_t *)&scs->static_config.mastering_display,
+                             sizeof(scs->static_config.mastering_display));
+        if (scs->static_config.content_light_level.max_cll)
+            svt_add_metadata(pcs->ppcs->input_ptr,
+                             EB_AV1_METADATA_TYPE_HDR_CLL,
+                             (const uint8_t *)&scs->static_config.content_light_level,
+                             sizeof(scs->static_config.content_light_level));
+    }
+
+    // Code the SPS
+    if (frm_hdr->frame_type == KEY_FRAME) {
+        svt_aom_encode_sps_av1(pcs->bitstream_ptr, scs);
+        // Add CLL and MDCV meta when frame is keyframe and SPS is written
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_CLL);
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_MDCV);
+    }
+
+    if (frm_hdr->show_frame) {
+        // Add HDR10+ dynamic metadata when show frame flag is enabled
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+        svt_metadata_array_free(&pcs->ppcs->input_ptr->metadata);
+    } else {
+        // Copy metadata pointer to the queue entry related to current frame number
+        uint64_t                   current_picture_number = pcs->picture_number;
+        PacketizationReorderEntry *temp_entry =
+            enc_ctx->packetization_reorder_queue[current_picture_number % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+        temp_entry->metadata           = pcs->ppcs->input_ptr->metadata;
+        pcs->ppcs->input_ptr->metadata = NULL;
+        metadata_sz                    = svt_metadata_size(temp_entry->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+    }
+    return metadata_sz;
+}
+
+/* Sub-frame output: sends the tile rows of the head of the queue coded since its last part. The
+ * first part of a frame holds the td, the OBUs ahead of the frame header and the frame header,
+ * then each part holds a tile group OBU per tile row; the last rows go with the frame packet */
+static void deliver_sub_frames(PacketizationContext *context_ptr, EncodeContext *enc_ctx) {
+    PictureControlSet *pcs = get_reorder_queue_entry(enc_ctx, 0)->sub_frame_pcs;
+    if (!pcs || pcs->sub_frame_tile_rows_sent == pcs->sub_frame_tile_rows_ready)
+        return;
+    SequenceControlSet *scs       = pcs->scs;
+    const uint16_t      tile_cols = pcs->ppcs->av1_cm->tiles_info.tile_cols;
+    const Bool          first     = pcs->sub_frame_tile_rows_sent == 0;
+
+    svt_aom_bitstream_reset(pcs->bitstream_ptr);
+    if (first) {
+        write_frame_prefix(enc_ctx, scs, pcs);
+        svt_aom_write_frame_header_obu_av1(pcs->bitstream_ptr, scs, pcs);
+    }
+    for (uint16_t row = pcs->sub_frame_tile_rows_sent; row < pcs->sub_frame_tile_rows_ready; row++)
+        svt_aom_write_tile_group_av1(pcs->bitstream_ptr, pcs, row * tile_cols, (row + 1) * tile_cols);
+    const uint32_t size = (uint32_t)svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr);
+
+    EbObjectWrapper *output_stream_wrapper_ptr;
+    svt_get_empty_object(enc_ctx->stream_output_fifo_ptr, &output_stream_wrapper_ptr);
+    EbBufferHeaderType *output_stream_ptr = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
+    output_stream_ptr->flags              = EB_BUFFERFLAG_SUB_FRAME;
+    output_stream_ptr->n_filled_len       = 0;
+    output_stream_ptr->n_alloc_len        = size + (first ? TD_SIZE : 0);
+    malloc_p_buffer(output_stream_ptr);
+    if (first) {
+        svt_aom_encode_td_av1(output_stream_ptr->p_buffer);
+        output_stream_ptr->n_filled_len = TD_SIZE;
+        output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+    }
+    svt_aom_bitstream_copy(pcs->bitstream_ptr, output_stream_ptr->p_buffer + output_stream_ptr->n_filled_len, size);
+    output_stream_ptr->n_filled_len += size;
+    output_stream_ptr->pts           = pcs->ppcs->input_ptr->pts;
+    output_stream_ptr->dts           = output_stream_ptr->pts;
+    output_stream_ptr->pic_type      = pcs->ppcs->is_ref
+             ? pcs->ppcs->idr_flag ? EB_AV1_KEY_PICTURE : (EbAv1PictureType)pcs->slice_type
+             : EB_AV1_NON_REF_PICTURE;
+    output_stream_ptr->p_app_private = pcs->ppcs->input_ptr->p_app_private;
+    output_stream_ptr->qp            = pcs->ppcs->picture_qp;
+    output_stream_ptr->luma_sse      = 0;
+    output_stream_ptr->cr_sse        = 0;
+    output_stream_ptr->cb_sse        = 0;
+    output_stream_ptr->luma_ssim     = 0;
+    output_stream_ptr->cr_ssim       = 0;
+    output_stream_ptr->cb_ssim       = 0;
+
+    pcs->sub_frame_bytes_sent += size;
+    pcs->sub_frame_tile_rows_sent = pcs->sub_frame_tile_rows_ready;
+    deliver_packet(context_ptr, output_stream_wrapper_ptr);
+}
+
 void *svt_aom_packetization_kernel(void *input_ptr) {
     // Context
     EbThreadContext      *thread_ctx  = (EbThreadContext *)input_ptr;
@@ -494,6 +626,17 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         Av1Common *const         cm       = pcs->ppcs->av1_cm;
         uint16_t                 tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
         PictureParentControlSet *ppcs     = (PictureParentControlSet *)pcs->ppcs;
+        svt_trace_picture(pcs->picture_number, -1);
+
+        if (entropy_coding_results_ptr->sub_frame) {
+            // Sub-frame output: the first tile rows of the picture are coded
+            enc_ctx->packetization_reorder_queue[ppcs->decode_order % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH]
+                ->sub_frame_pcs            = pcs;
+            pcs->sub_frame_tile_rows_ready = entropy_coding_results_ptr->tile_rows_done;
+            svt_release_object(entropy_coding_results_wrapper_ptr);
+            deliver_sub_frames(context_ptr, enc_ctx);
+            continue;
+        }
 
         if (ppcs->superres_total_recode_loop > 0 && ppcs->superres_recode_loop < ppcs->superres_total_recode_loop) {
             // Reset the Bitstream before writing to it
@@ -697,23 +840,12 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         queue_entry_ptr->start_time_seconds          = pcs->ppcs->start_time_seconds;
         queue_entry_ptr->start_time_u_seconds        = pcs->ppcs->start_time_u_seconds;
         queue_entry_ptr->is_alt_ref                  = pcs->ppcs->is_alt_ref;
+        queue_entry_ptr->sub_frame_pcs               = NULL;
+        queue_entry_ptr->sub_frame_sent              = pcs->sub_frame_tile_rows_sent > 0;
         svt_get_empty_object(scs->enc_ctx->stream_output_fifo_ptr, &pcs->ppcs->output_stream_wrapper_ptr);
         EbObjectWrapper    *output_stream_wrapper_ptr = pcs->ppcs->output_stream_wrapper_ptr;
         EbBufferHeaderType *output_stream_ptr         = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
 
-        if (frm_hdr->frame_type == KEY_FRAME) {
-            if (scs->static_config.mastering_display.max_luma)
-                svt_add_metadata(pcs->ppcs->input_ptr,
-                                 EB_AV1_METADATA_TYPE_HDR_MDCV,
-                                 (const uint8_t *)&scs->static_config.mastering_display,
-                                 sizeof(scs->static_config.mastering_display));
-            if (scs->static_config.content_light_level.max_cll)
-                svt_add_metadata(pcs->ppcs->input_ptr,
-                                 EB_AV1_METADATA_TYPE_HDR_CLL,
-                                 (const uint8_t *)&scs->static_config.content_light_level,
-                                 sizeof(scs->static_config.content_light_level));
-        }
-
         output_stream_ptr->flags = 0;
 #if !OPT_LD_LATENCY2
         if (pcs->ppcs->end_of_sequence_flag) {
@@ -778,34 +910,16 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         svt_aom_bitstream_reset(pcs->bitstream_ptr);
 
         size_t metadata_sz = 0;
-
-        // Code the SPS
-        if (frm_hdr->frame_type == KEY_FRAME) {
-            svt_aom_encode_sps_av1(pcs->bitstream_ptr, scs);
-            // Add CLL and MDCV meta when frame is keyframe and SPS is written
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_CLL);
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_MDCV);
-        }
-
-        if (frm_hdr->show_frame) {
-            // Add HDR10+ dynamic metadata when show frame flag is enabled
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
-            svt_metadata_array_free(&pcs->ppcs->input_ptr->metadata);
+        if (pcs->sub_frame_tile_rows_sent) {
+            // Sub-frame output: the frame header and first tile rows are out, add the last ones
+            for (uint16_t row = pcs->sub_frame_tile_rows_sent; row < cm->tiles_info.tile_rows; row++)
+                svt_aom_write_tile_group_av1(
+                    pcs->bitstream_ptr, pcs, row * cm->tiles_info.tile_cols, (row + 1) * cm->tiles_info.tile_cols);
         } else {
-            // Copy metadata pointer to the queue entry related to current frame number
-            uint64_t                   current_picture_number = pcs->picture_number;
-            PacketizationReorderEntry *temp_entry =
-                enc_ctx->packetization_reorder_queue[current_picture_number % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
-            temp_entry->metadata           = pcs->ppcs->input_ptr->metadata;
-            pcs->ppcs->input_ptr->metadata = NULL;
-            metadata_sz                    = svt_metadata_size(temp_entry->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+            metadata_sz = write_frame_prefix(enc_ctx, scs, pcs);
+            svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
         }
 
-        svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
-
         output_stream_ptr->n_alloc_len = (uint32_t)(svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) + TD_SIZE +
                                                     metadata_sz);
         malloc_p_buffer(output_stream_ptr);
@@ -835,7 +949,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         }
 
         // Send the number of bytes per frame to RC
-        pcs->ppcs->total_num_bits = output_stream_ptr->n_filled_len << 3;
+        pcs->ppcs->total_num_bits = (uint64_t)(output_stream_ptr->n_filled_len + pcs->sub_frame_bytes_sent) << 3;
         if (scs->passes == 2 && scs->static_config.pass == ENC_FIRST_PASS) {
             StatStruct stat_struct;
             stat_struct.poc = pcs->picture_number;
@@ -934,7 +1048,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             if (eos && queue_entry_ptr->has_show_existing)
                 clear_eos_flag(output_stream_ptr);
 
-            svt_post_full_object(output_stream_wrapper_ptr);
+            deliver_packet(context_ptr, output_stream_wrapper_ptr);
             if (queue_entry_ptr->has_show_existing) {
                 EbObjectWrapper *existed = pop_undisplayed_frame(enc_ctx);
                 if (existed) {
@@ -942,7 +1056,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                     encode_show_existing(enc_ctx, queue_entry_ptr, existed_output_stream_ptr);
                     if (eos)
                         set_eos_flag(existed_output_stream_ptr);
-                    svt_post_full_object(existed);
+                    deliver_packet(context_ptr, existed);
                 }
             }
 
@@ -952,6 +1066,8 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                 enc_ctx->total_number_of_shown_frames++;
             eos = (enc_ctx->total_number_of_shown_frames == enc_ctx->terminating_picture_number + 1) ? 1 : 0;
             release_frames(enc_ctx, frames);
+            // The next frame may have tile rows waiting
+            deliver_sub_frames(context_ptr, enc_ctx);
 
 #else
             encode_tu(enc_ctx, frames, total_bytes, output_stream_ptr);
@@ -959,7 +1075,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             if (eos && queue_entry_ptr->has_show_existing)
                 clear_eos_flag(output_stream_ptr);
 
-            svt_post_full_object(output_stream_wrapper_ptr);
+            deliver_packet(context_ptr, output_stream_wrapper_ptr);
             if (queue_entry_ptr->has_show_existing) {
                 EbObjectWrapper *existed = pop_undisplayed_frame(enc_ctx);
                 if (existed) {
@@ -967,10 +1083,11 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                     encode_show_existing(enc_ctx, queue_entry_ptr, existed_output_stream_ptr);
                     if (eos)
                         set_eos_flag(existed_output_stream_ptr);
-                    svt_post_full_object(existed);
+                    deliver_packet(context_ptr, existed);
                 }
             }
             release_frames(enc_ctx, frames);
+            deliver_sub_frames(context_ptr, enc_ctx);
 #endif
         }
 #if OPT_LD_LATENCY2
@@ -982,7 +1099,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             tmp_out_str->flags        = EB_BUFFERFLAG_EOS;
             tmp_out_str->n_filled_len = 0;
 
-            svt_post_full_object(tmp_out_str_wrp);
+            deliver_packet(context_ptr, tmp_out_str_wrp);
             release_references_eos(scs);
 
 #if FTR_STILL_PICTURE
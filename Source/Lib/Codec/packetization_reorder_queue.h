@@ -50,6 +50,10 @@ typedef struct PacketizationReorderEntry {
     int64_t                  next_pts;
     uint8_t                  is_alt_ref;
     struct SvtMetadataArray *metadata;
+    // Sub-frame output: picture whose first tile rows are coded, until its last part is written
+    struct PictureControlSet *sub_frame_pcs;
+    // Sub-frame output: the temporal delimiter and frame header went out with the first part
+    Bool sub_frame_sent;
 } PacketizationReorderEntry;
 
 extern EbErrorType svt_aom_packetization_reorder_entry_ctor(PacketizationReorderEntry *entry_ptr,
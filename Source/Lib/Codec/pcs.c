@@ -203,6 +203,9 @@ static void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->mse_seg[0]);
     EB_FREE_ARRAY(obj->mse_seg[1]);
     EB_FREE_ARRAY(obj->skip_cdef_seg);
+    EB_FREE_ARRAY(obj->cdef_search_mse[0]);
+    EB_FREE_ARRAY(obj->cdef_search_mse[1]);
+    EB_FREE_ARRAY(obj->cdef_search_sb_index);
     EB_FREE_ARRAY(obj->cdef_dir_data);
     EB_FREE_ARRAY(obj->mi_grid_base);
     EB_FREE_ARRAY(obj->mip);
@@ -210,6 +213,8 @@ static void picture_control_set_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->entropy_coding_pic_mutex);
     EB_DESTROY_MUTEX(obj->intra_mutex);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
+    EB_DESTROY_MUTEX(obj->dlf_mutex);
+    EB_FREE_ARRAY(obj->dlf_row_progress);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
 }
 
@@ -1035,11 +1040,19 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
 
     EB_CREATE_MUTEX(object_ptr->cdef_search_mutex);
 
+    EB_CREATE_MUTEX(object_ptr->dlf_mutex);
+    EB_MALLOC_ARRAY(object_ptr->dlf_row_progress, picture_sb_height);
+    for (uint16_t sb_row = 0; sb_row < picture_sb_height; sb_row++)
+        svt_create_cond_var(&object_ptr->dlf_row_progress[sb_row]);
+
     //object_ptr->mse_seg[0] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
     // object_ptr->mse_seg[1] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
     EB_MALLOC_ARRAY(object_ptr->mse_seg[0], picture_sb_width * picture_sb_height);
     EB_MALLOC_ARRAY(object_ptr->mse_seg[1], picture_sb_width * picture_sb_height);
     EB_MALLOC_ARRAY(object_ptr->skip_cdef_seg, picture_sb_width * picture_sb_height);
+    EB_MALLOC_ARRAY(object_ptr->cdef_search_mse[0], picture_sb_width * picture_sb_height);
+    EB_MALLOC_ARRAY(object_ptr->cdef_search_mse[1], picture_sb_width * picture_sb_height);
+    EB_MALLOC_ARRAY(object_ptr->cdef_search_sb_index, picture_sb_width * picture_sb_height);
     EB_MALLOC_ARRAY(object_ptr->cdef_dir_data, picture_sb_width * picture_sb_height);
     EB_CREATE_MUTEX(object_ptr->rest_search_mutex);
 
@@ -1471,6 +1484,8 @@ static void me_dctor(EbPtr p) {
         EB_FREE_ARRAY(obj->tpl_sb_rdmult_scaling_factors);
     if (obj->tpl_src_stats_buffer)
         EB_FREE_ARRAY(obj->tpl_src_stats_buffer);
+    if (obj->tpl_disp_stats_buffer)
+        EB_FREE_ARRAY(obj->tpl_disp_stats_buffer);
     if (obj->ssim_rdmult_scaling_factors)
         EB_FREE_ARRAY(obj->ssim_rdmult_scaling_factors);
 }
@@ -1504,6 +1519,7 @@ static EbErrorType me_ctor(MotionEstimationData *object_ptr, EbPtr object_init_d
     }
 
     if (init_data_ptr->enable_tpl_la) {
+        const SvtAv1AllocTag alloc_tag               = svt_set_alloc_tag(SVT_AV1_ALLOC_TAG_TPL);
         const uint16_t picture_width_in_mb           = (uint16_t)((init_data_ptr->picture_width + 15) / 16);
         const uint16_t picture_height_in_mb          = (uint16_t)((init_data_ptr->picture_height + 15) / 16);
         uint16_t       adaptive_picture_width_in_mb  = (uint16_t)((init_data_ptr->picture_width + 15) / 16);
@@ -1532,11 +1548,17 @@ static EbErrorType me_ctor(MotionEstimationData *object_ptr, EbPtr object_init_d
                             (uint32_t)picture_width_in_mb * (uint32_t)picture_height_in_mb);
         else
             object_ptr->tpl_src_stats_buffer = NULL;
+        if (init_data_ptr->tpl_lad_mg > 0 && init_data_ptr->static_config.incremental_tpl)
+            EB_MALLOC_ARRAY(object_ptr->tpl_disp_stats_buffer,
+                            (uint32_t)((adaptive_picture_width_in_mb) * (adaptive_picture_height_in_mb)));
+        else
+            object_ptr->tpl_disp_stats_buffer = NULL;
         EB_MALLOC_ARRAY(object_ptr->tpl_beta, sb_total_count);
         EB_MALLOC_ARRAY(object_ptr->tpl_rdmult_scaling_factors,
                         adaptive_picture_width_in_mb * adaptive_picture_height_in_mb);
         EB_MALLOC_ARRAY(object_ptr->tpl_sb_rdmult_scaling_factors,
                         adaptive_picture_width_in_mb * adaptive_picture_height_in_mb);
+        svt_set_alloc_tag(alloc_tag);
     } else {
         object_ptr->ois_mb_results                = NULL;
         object_ptr->tpl_stats                     = NULL;
@@ -1544,6 +1566,7 @@ static EbErrorType me_ctor(MotionEstimationData *object_ptr, EbPtr object_init_d
         object_ptr->tpl_rdmult_scaling_factors    = NULL;
         object_ptr->tpl_sb_rdmult_scaling_factors = NULL;
         object_ptr->tpl_src_stats_buffer          = NULL;
+        object_ptr->tpl_disp_stats_buffer         = NULL;
         object_ptr->ssim_rdmult_scaling_factors   = NULL;
     }
     return return_error;
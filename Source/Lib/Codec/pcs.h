@@ -216,6 +216,14 @@ typedef struct CdefDirData {
     uint8_t dir[CDEF_NBLOCKS][CDEF_NBLOCKS];
     int32_t var[CDEF_NBLOCKS][CDEF_NBLOCKS];
 } CdefDirData;
+// Number of CDEF signalling bits (0..3) tried by the CDEF strength search, one CDEF task each
+#define CDEF_STRENGTH_SEARCH_COUNT 4
+// Result of the CDEF strength search for one number of signalling bits, see finish_cdef_search()
+typedef struct CdefStrengthSearch {
+    uint64_t rd_cost;
+    int32_t  best_lev0[CDEF_MAX_STRENGTHS];
+    int32_t  best_lev1[CDEF_MAX_STRENGTHS];
+} CdefStrengthSearch;
 
 typedef struct PicVqCtrls {
     uint8_t detect_high_freq_lvl;
@@ -252,6 +260,13 @@ typedef struct PictureControlSet {
     EntropyTileInfo **ec_info;
     EbHandle          entropy_coding_pic_mutex;
     Bool              entropy_coding_pic_reset_flag;
+    // Sub-frame output: tile rows posted to packetization and whether the in-loop filters are done,
+    // both under entropy_coding_pic_mutex, then the tile rows and bytes packetization sent out
+    uint16_t ec_tile_rows_posted;
+    Bool     ec_filters_done;
+    uint16_t sub_frame_tile_rows_ready;
+    uint16_t sub_frame_tile_rows_sent;
+    uint32_t sub_frame_bytes_sent;
     uint8_t           tile_size_bytes_minus_1;
     EbHandle          intra_mutex;
     uint32_t          intra_coded_area;
@@ -263,6 +278,24 @@ typedef struct PictureControlSet {
     uint16_t cdef_segments_total_count;
     uint8_t  cdef_segments_column_count;
     uint8_t  cdef_segments_row_count;
+    // CDEF segments posted by the DLF, each segment is posted once the DLF SB rows it reads are done
+    uint16_t cdef_segments_posted;
+    // CDEF strength search, run as CDEF_STRENGTH_SEARCH_COUNT CDEF tasks once all the segments are
+    // searched: the MSEs of the filter blocks to search, and the result of each task
+    uint64_t         **cdef_search_mse[2];
+    int32_t           *cdef_search_sb_index;
+    int32_t            cdef_search_sb_count;
+    CdefStrengthSearch cdef_strength_search[CDEF_STRENGTH_SEARCH_COUNT];
+    uint8_t            tot_cdef_strength_searched;
+    // Frame level DLF, see svt_aom_dlf_kernel(): the picture is filtered by dlf_segments_total_count DLF
+    // tasks taking SB rows in order, dlf_row_progress[row] counts the SBs of a row whose horizontal
+    // edges are filtered
+    uint16_t          dlf_segments_total_count;
+    uint16_t          tot_dlf_segments_done;
+    Bool              dlf_setup_done;
+    volatile uint32_t dlf_next_sb_row;
+    CondVar          *dlf_row_progress;
+    EbHandle          dlf_mutex;
 
     uint64_t (*mse_seg[2])[TOTAL_STRENGTHS];
     uint8_t     *skip_cdef_seg;
@@ -502,6 +535,7 @@ typedef struct MotionEstimationData {
     TplStats     **tpl_stats;
 
     TplSrcStats *tpl_src_stats_buffer; // tpl src based stats
+    TplStats    *tpl_disp_stats_buffer; // tpl dispenser output, replayed by incremental tpl
 
     int32_t base_rdmult;
     double *tpl_beta;
@@ -536,6 +570,9 @@ typedef struct TplControls {
     subpel_depth;
     // Specifies the subpel accuracy for diagonal position(s)
     uint8_t subpel_diag_refinement;
+    // 0: run the dispenser at full resolution; 1: on the 1/4 PA picture; 2: on the 1/16 PA picture.
+    // Used as a shift of the block positions/sizes; the stats are stored at full resolution
+    uint8_t ds_shift;
 } TplControls;
 
 typedef struct {
@@ -643,6 +680,9 @@ typedef struct DlfCtrls {
     uint8_t early_exit_convergence;
     // Threshold used when sb_based_dlf is used to use filter strength zero, there are four levels of thresholds [0..3], 0 = off
     uint8_t zero_filter_strength_lvl;
+    // Search the filter levels (LPF_PICK_FROM_SUBIMAGE) by filtering and measuring every <n>th SB row only,
+    // 0/1 = search on the full picture (LPF_PICK_FROM_FULL_IMAGE)
+    uint8_t search_sb_row_step;
 } DlfCtrls;
 typedef struct IntraBCCtrls {
     // Shift for full_pixel_exhaustive search threshold:   0: No Shift   1:Shift to left by 1
@@ -1133,6 +1173,9 @@ typedef struct PictureParentControlSet {
 
     uint32_t         tf_tot_vert_blks; // total vertical motion blocks in TF
     uint32_t         tf_tot_horz_blks; // total horizontal motion blocks in TF
+    uint32_t         tf_tot_blks; // total 64x64 block / reference pairs in TF
+    uint32_t         tf_skip_blks; // pairs predicted with the (0, 0) MV without ME in TF
+    uint32_t         tf_seed_blks; // pairs searched from the previous reference MV in TF
     int8_t           tf_motion_direction; // motion direction in TF   -1:invalid   0:horz  1:vert
     int32_t          is_noise_level;
     bool             r0_based_qps_qpm;
@@ -37,6 +37,7 @@
 #include "aom_dsp_rtcd.h"
 
 #include "pic_operators.h"
+#include "svt_trace.h"
 /************************************************
  * Defines
  ************************************************/
@@ -3392,6 +3393,7 @@ static void mctf_frame(
             pd_ctx);
         pcs->temp_filt_prep_done = 0;
         pcs->tf_tot_horz_blks = pcs->tf_tot_vert_blks = 0;
+        pcs->tf_tot_blks = pcs->tf_skip_blks = pcs->tf_seed_blks = 0;
 
         // Start Filtering in ME processes
         {
@@ -4546,6 +4548,7 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
         pcs = (PictureParentControlSet*)in_results_ptr->pcs_wrapper->object_ptr;
         scs = pcs->scs;
         enc_ctx = (EncodeContext*)scs->enc_ctx;
+        svt_trace_picture(pcs->picture_number, -1);
 
         // Input Picture Analysis Results into the Picture Decision Reordering Queue
         // Since the prior Picture Analysis processes stage is multithreaded, inputs to the Picture Decision Process
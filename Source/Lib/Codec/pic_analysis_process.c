@@ -29,6 +29,7 @@
 #include "pic_operators.h"
 #include "resize.h"
 #include "av1me.h"
+#include "svt_trace.h"
 
 #define VARIANCE_PRECISION 16
 
@@ -1976,6 +1977,31 @@ void svt_aom_downsample_filtering_input_picture(PictureParentControlSet *pcs, Eb
                                      sixteenth_picture_ptr->org_y);
         }
     }
+    // Downsample input picture for the downscaled TPL when HME does not use that resolution
+    const uint8_t tpl_downscale = pcs->scs->static_config.tpl_downscale;
+    const Bool    hme_quarter   = (pcs->enable_hme_flag || pcs->tf_enable_hme_flag) &&
+        (pcs->enable_hme_level1_flag || pcs->tf_enable_hme_level1_flag);
+    const Bool hme_sixteenth = (pcs->enable_hme_flag || pcs->tf_enable_hme_flag) &&
+        (pcs->enable_hme_level0_flag || pcs->tf_enable_hme_level0_flag);
+    EbPictureBufferDesc *tpl_ds_pic = tpl_downscale == 1 && !hme_quarter ? quarter_picture_ptr
+        : tpl_downscale == 2 && !hme_sixteenth                            ? sixteenth_picture_ptr
+                                                                          : NULL;
+    if (tpl_ds_pic) {
+        downsample_2d(
+            &input_padded_pic->buffer_y[input_padded_pic->org_x + input_padded_pic->org_y * input_padded_pic->stride_y],
+            input_padded_pic->stride_y,
+            input_padded_pic->width,
+            input_padded_pic->height,
+            &tpl_ds_pic->buffer_y[tpl_ds_pic->org_x + tpl_ds_pic->org_y * tpl_ds_pic->stride_y],
+            tpl_ds_pic->stride_y,
+            1 << tpl_downscale);
+        svt_aom_generate_padding(&tpl_ds_pic->buffer_y[0],
+                                 tpl_ds_pic->stride_y,
+                                 tpl_ds_pic->width,
+                                 tpl_ds_pic->height,
+                                 tpl_ds_pic->org_x,
+                                 tpl_ds_pic->org_y);
+    }
 }
 
 void svt_aom_pad_input_pictures(SequenceControlSet *scs, EbPictureBufferDesc *input_pic) {
@@ -2085,6 +2111,7 @@ void *svt_aom_picture_analysis_kernel(void *input_ptr) {
         in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
         pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
         scs            = pcs->scs;
+        svt_trace_picture(pcs->picture_number, -1);
 
         // Mariana : save enhanced picture ptr, move this from here
         pcs->enhanced_unscaled_pic                    = pcs->enhanced_pic;
@@ -2119,8 +2146,9 @@ void *svt_aom_picture_analysis_kernel(void *input_ptr) {
                 // Original path
                 // Get PA ref, copy 8bit luma to pa_ref->input_padded_pic
                 pa_ref_obj_                 = (EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr;
-                pa_ref_obj_->picture_number = pcs->picture_number;
-                input_padded_pic            = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_pic;
+                pa_ref_obj_->picture_number  = pcs->picture_number;
+                pa_ref_obj_->content_version = 0;
+                input_padded_pic             = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_pic;
 
                 // 1/4 & 1/16 input picture downsampling through filtering
                 svt_aom_downsample_filtering_input_picture(
@@ -72,6 +72,10 @@ typedef struct EbPictureBufferDesc {
     // internal bit-depth: when equals 1 internal bit-depth is 16bits regardless of the input
     // bit-depth
     Bool is_16bit_pipeline;
+
+    // Caller owned input frame the planes point into (zero-copy input), NULL when the
+    // planes are the ones allocated with the descriptor
+    struct EbInputFrameRef *ext_frame_ref;
 } EbPictureBufferDesc;
 
 #define YV12_FLAG_HIGHBITDEPTH 8
@@ -25,6 +25,7 @@
 #include "EbSvtAv1ErrorCodes.h"
 #include "entropy_coding.h"
 #include "svt_log.h"
+#include "svt_trace.h"
 
 // Token buffer is only used for palette tokens.
 static INLINE unsigned int get_token_alloc(int mb_rows, int mb_cols, int sb_size_log2, const int num_planes) {
@@ -199,9 +200,15 @@ void svt_aom_init_enc_dec_segement(PictureParentControlSet *ppcs) {
                 for (uint16_t d = top_left_tile_col_idx; d < bottom_right_tile_col_idx; d++) {
                     uint16_t tileIdx                                            = s * tile_cols + d;
                     ppcs->child_pcs->ec_info[tileIdx]->entropy_coding_tile_done = FALSE;
+                    ppcs->child_pcs->ec_info[tileIdx]->enc_dec_coded_sb_count   = 0;
                 }
             }
             ppcs->child_pcs->entropy_coding_pic_reset_flag = TRUE;
+            ppcs->child_pcs->ec_tile_rows_posted           = 0;
+            ppcs->child_pcs->ec_filters_done               = FALSE;
+            ppcs->child_pcs->sub_frame_tile_rows_ready     = 0;
+            ppcs->child_pcs->sub_frame_tile_rows_sent      = 0;
+            ppcs->child_pcs->sub_frame_bytes_sent          = 0;
         }
     }
 }
@@ -336,6 +343,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
         EB_GET_FULL_OBJECT(context_ptr->picture_input_fifo_ptr, &input_pic_demux_wrapper);
 
         input_pic_demux = (PictureDemuxResults *)input_pic_demux_wrapper->object_ptr;
+        svt_trace_picture(input_pic_demux->picture_number, -1);
 
         // *Note - This should be overhauled and/or replaced when we
         //   need hierarchical support.
@@ -1301,6 +1301,59 @@ static void obmc_trans_face_off(ModeDecisionCandidateBuffer *cand_bf, PictureCon
         }
     }
 }
+/* Returns the slot of the MDS0 candidate cache that holds the luma distortion of cand, and fills
+ * the key of the candidate in *key. Returns NULL if the prediction of cand reads more than the
+ * reference pictures (e.g. neighbouring recon or MVs), or may change the candidate (IFS), in which
+ * case the distortion cannot be reused. */
+static MdCandCacheEntry *get_cand_cache_entry(PictureControlSet *pcs, ModeDecisionContext *ctx,
+                                              ModeDecisionCandidate *cand, MdCandCacheEntry *key) {
+    // Light-PD0 uses its own prediction path, so only a regular PD0 can share candidates with PD1
+    if (ctx->lpd0_ctrls.pd0_level != REGULAR_PD0)
+        return NULL;
+    if (!is_inter_mode(cand->pred_mode) || cand->use_intrabc || cand->motion_mode != SIMPLE_TRANSLATION ||
+        cand->is_interintra_used || !ctx->mds_skip_uv_pred)
+        return NULL;
+    if (!ctx->mds_skip_ifs && pcs->ppcs->frm_hdr.interpolation_filter == SWITCHABLE)
+        return NULL;
+    const uint8_t is_compound = is_inter_compound_mode(cand->pred_mode);
+    if (is_compound && cand->interinter_comp.type != COMPOUND_AVERAGE &&
+        cand->interinter_comp.type != COMPOUND_DISTWTD)
+        return NULL;
+
+    MvReferenceFrame rf[2];
+    av1_set_ref_frame(rf, cand->ref_frame_type);
+    key->sb_gen = ctx->cand_cache_gen;
+    if (is_compound) {
+        key->mv[REF_LIST_0] = cand->mv[REF_LIST_0].as_int;
+        key->mv[REF_LIST_1] = cand->mv[REF_LIST_1].as_int;
+    } else {
+        const uint8_t list_idx = get_list_idx(rf[0]);
+        key->mv[list_idx]      = cand->mv[list_idx].as_int;
+        key->mv[!list_idx]     = 0;
+    }
+    key->interp_filters = cand->interp_filters;
+    key->org_x          = ctx->blk_org_x;
+    key->org_y          = ctx->blk_org_y;
+    key->bsize          = ctx->blk_geom->bsize;
+    key->ref_frame_type = cand->ref_frame_type;
+    key->comp           = is_compound ? (uint8_t)((cand->interinter_comp.type << 1) | cand->compound_idx) : 0;
+    key->dist_cfg       = (uint8_t)((ctx->mds0_ctrls.mds0_dist_type << 2) | ctx->hbd_md);
+
+    uint32_t hash = key->org_x * 0x9E3779B1u;
+    hash ^= key->org_y * 0x85EBCA77u;
+    hash ^= (key->bsize | (key->ref_frame_type << 8) | (key->comp << 16)) * 0xC2B2AE3Du;
+    hash ^= key->mv[REF_LIST_0] * 0x27D4EB2Fu;
+    hash ^= key->mv[REF_LIST_1] * 0x165667B1u;
+    hash ^= key->interp_filters;
+    hash ^= hash >> 15;
+    return &ctx->cand_cache[(hash ^ (hash >> MD_CAND_CACHE_LOG2)) & ((1 << MD_CAND_CACHE_LOG2) - 1)];
+}
+static INLINE bool cand_cache_match(const MdCandCacheEntry *entry, const MdCandCacheEntry *key) {
+    return entry->sb_gen == key->sb_gen && entry->mv[REF_LIST_0] == key->mv[REF_LIST_0] &&
+        entry->mv[REF_LIST_1] == key->mv[REF_LIST_1] && entry->interp_filters == key->interp_filters &&
+        entry->org_x == key->org_x && entry->org_y == key->org_y && entry->bsize == key->bsize &&
+        entry->ref_frame_type == key->ref_frame_type && entry->comp == key->comp && entry->dist_cfg == key->dist_cfg;
+}
 void fast_loop_core(ModeDecisionCandidateBuffer *cand_bf, PictureControlSet *pcs, ModeDecisionContext *ctx,
                     EbPictureBufferDesc *input_pic, BlockLocation *loc) {
     const uint32_t input_origin_index       = loc->input_origin_index;
@@ -1316,13 +1369,32 @@ void fast_loop_core(ModeDecisionCandidateBuffer *cand_bf, PictureControlSet *pcs
     ModeDecisionCandidate *cand = cand_bf->cand;
     EbPictureBufferDesc   *pred = cand_bf->pred;
     ctx->pu_itr                 = 0;
+    // Reuse the luma distortion if the same prediction was already evaluated for this block (by an
+    // earlier PD pass or by another candidate with the same motion)
+    MdCandCacheEntry  cache_key;
+    MdCandCacheEntry *cache_entry = get_cand_cache_entry(pcs, ctx, cand, &cache_key);
+    const bool        cache_hit   = cache_entry && cand_cache_match(cache_entry, &cache_key);
     // Prediction
     ctx->uv_intra_comp_only = FALSE;
-    svt_product_prediction_fun_table[is_inter_mode(cand->pred_mode) || cand->use_intrabc](
-        ctx->hbd_md, ctx, pcs, cand_bf);
+    if (cache_hit) {
+        // The prediction is skipped, so only update what the prediction would have set for the rate
+        if (pcs->ppcs->frm_hdr.allow_warped_motion)
+            svt_aom_wm_count_samples(ctx->blk_ptr,
+                                     pcs->scs->seq_header.sb_size,
+                                     ctx->blk_geom,
+                                     ctx->blk_org_x,
+                                     ctx->blk_org_y,
+                                     cand->ref_frame_type,
+                                     pcs,
+                                     &cand->num_proj_ref);
+    } else
+        svt_product_prediction_fun_table[is_inter_mode(cand->pred_mode) || cand->use_intrabc](
+            ctx->hbd_md, ctx, pcs, cand_bf);
     // Distortion
     // Y
-    if (ctx->mds0_ctrls.mds0_dist_type == SSD) {
+    if (cache_hit) {
+        cand_bf->luma_fast_dist = luma_fast_dist = cache_entry->luma_dist;
+    } else if (ctx->mds0_ctrls.mds0_dist_type == SSD) {
         EbSpatialFullDistType spatial_full_dist_type_fun = ctx->hbd_md ? svt_full_distortion_kernel16_bits
                                                                        : svt_spatial_full_distortion_kernel;
         cand_bf->luma_fast_dist = luma_fast_dist = (uint32_t)(spatial_full_dist_type_fun(input_pic->buffer_y,
@@ -1378,6 +1450,10 @@ void fast_loop_core(ModeDecisionCandidateBuffer *cand_bf, PictureControlSet *pcs
                                                      ctx->blk_geom->bwidth));
         }
     }
+    if (cache_entry && !cache_hit) {
+        *cache_entry           = cache_key;
+        cache_entry->luma_dist = luma_fast_dist;
+    }
     if (ctx->blk_geom->has_uv && ctx->uv_ctrls.uv_mode <= CHROMA_MODE_1 && ctx->mds_skip_uv_pred == FALSE) {
         if (ctx->mds0_ctrls.mds0_dist_type == SSD) {
             EbSpatialFullDistType spatial_full_dist_type_fun = ctx->hbd_md ? svt_full_distortion_kernel16_bits
@@ -1458,10 +1534,17 @@ void fast_loop_core(ModeDecisionCandidateBuffer *cand_bf, PictureControlSet *pcs
             luma_fast_dist,
             chroma_fast_distortion);
     }
-    cand_bf->valid_pred = 1;
+    // On a cache hit the pred buffer was not written; later stages will redo the prediction
+    cand_bf->valid_pred = !cache_hit;
     if (ctx->obmc_ctrls.enabled && ctx->obmc_ctrls.trans_face_off == 1 &&
-        (*(cand_bf->fast_cost) * ctx->obmc_ctrls.trans_face_off_th) <= (ctx->mds0_best_class0_cost * 100))
+        (*(cand_bf->fast_cost) * ctx->obmc_ctrls.trans_face_off_th) <= (ctx->mds0_best_class0_cost * 100)) {
+        // OBMC is blended on top of the simple-translation prediction
+        if (!cand_bf->valid_pred) {
+            svt_product_prediction_fun_table[1](ctx->hbd_md, ctx, pcs, cand_bf);
+            cand_bf->valid_pred = 1;
+        }
         obmc_trans_face_off(cand_bf, pcs, ctx, input_pic, loc);
+    }
     // Init full cost in case we by pass stage1/stage2
     if (ctx->nic_ctrls.md_staging_mode == MD_STAGING_MODE_0)
         *(cand_bf->full_cost) = *(cand_bf->fast_cost);
@@ -1523,42 +1606,48 @@ void set_md_stage_counts(PictureControlSet *pcs, ModeDecisionContext *ctx) {
             ctx->md_stage_3_count[cidx] = ctx->md_stage_2_count[cidx];
     }
 }
+/* Sort cand_buff_indices[0..count-1] by increasing cost. The costs are read straight from the
+contiguous per-buffer cost array (indexed by buffer index) rather than through the candidate
+buffers, and the running minimum is kept in a register; the exchange order (and so the order of
+equal-cost candidates) is the same as the original pairwise exchange sort. */
+static INLINE void sort_cand_buff_indices(const uint64_t *cost_array, uint32_t count, uint32_t *cand_buff_indices) {
+    for (uint32_t i = 0; i < count - 1; ++i) {
+        uint32_t best_idx  = cand_buff_indices[i];
+        uint64_t best_cost = cost_array[best_idx];
+        for (uint32_t j = i + 1; j < count; ++j) {
+            const uint32_t idx  = cand_buff_indices[j];
+            const uint64_t cost = cost_array[idx];
+            if (cost < best_cost) {
+                cand_buff_indices[j] = best_idx;
+                best_idx             = idx;
+                best_cost            = cost;
+            }
+        }
+        cand_buff_indices[i] = best_idx;
+    }
+}
 static void sort_fast_cost_based_candidates(
     struct ModeDecisionContext *ctx, uint32_t input_buffer_start_idx,
     uint32_t  input_buffer_count, //how many cand buffers to sort. one of the buffer can have max cost.
     uint32_t *cand_buff_indices) {
-    ModeDecisionCandidateBuffer **buffer_ptr_array     = ctx->cand_bf_ptr_array;
-    uint32_t                      input_buffer_end_idx = input_buffer_start_idx + input_buffer_count - 1;
-    uint32_t                      buffer_index, i, j;
-    uint32_t                      k = 0;
-    for (buffer_index = input_buffer_start_idx; buffer_index <= input_buffer_end_idx; buffer_index++, k++) {
-        cand_buff_indices[k] = buffer_index;
-    }
-    for (i = 0; i < input_buffer_count - 1; ++i) {
-        for (j = i + 1; j < input_buffer_count; ++j) {
-            if (*(buffer_ptr_array[cand_buff_indices[j]]->fast_cost) <
-                *(buffer_ptr_array[cand_buff_indices[i]]->fast_cost)) {
-                buffer_index         = cand_buff_indices[i];
-                cand_buff_indices[i] = (uint32_t)cand_buff_indices[j];
-                cand_buff_indices[j] = (uint32_t)buffer_index;
-            }
-        }
-    }
+    for (uint32_t k = 0; k < input_buffer_count; k++) cand_buff_indices[k] = input_buffer_start_idx + k;
+    sort_cand_buff_indices(ctx->fast_cost_array, input_buffer_count, cand_buff_indices);
 }
-void sort_full_cost_based_candidates(struct ModeDecisionContext *ctx, uint32_t num_of_cand_to_sort,
-                                     uint32_t *cand_buff_indices) {
-    uint32_t                      i, j, index;
-    ModeDecisionCandidateBuffer **buffer_ptr_array = ctx->cand_bf_ptr_array;
-    for (i = 0; i < num_of_cand_to_sort - 1; ++i) {
-        for (j = i + 1; j < num_of_cand_to_sort; ++j) {
-            if (*(buffer_ptr_array[cand_buff_indices[j]]->full_cost) <
-                *(buffer_ptr_array[cand_buff_indices[i]]->full_cost)) {
-                index                = cand_buff_indices[i];
-                cand_buff_indices[i] = (uint32_t)cand_buff_indices[j];
-                cand_buff_indices[j] = (uint32_t)index;
-            }
+static void sort_full_cost_based_candidates(struct ModeDecisionContext *ctx, uint32_t num_of_cand_to_sort,
+                                            uint32_t *cand_buff_indices) {
+    sort_cand_buff_indices(ctx->full_cost_array, num_of_cand_to_sort, cand_buff_indices);
+}
+/* Return the index of the first buffer in [start, start + count) holding the highest cost. */
+static INLINE uint32_t get_highest_cost_buffer_index(const uint64_t *cost_array, uint32_t start, uint32_t count) {
+    uint32_t highest_idx  = start;
+    uint64_t highest_cost = cost_array[start];
+    for (uint32_t i = start + 1; i < start + count; i++) {
+        if (cost_array[i] > highest_cost) {
+            highest_idx  = i;
+            highest_cost = cost_array[i];
         }
     }
+    return highest_idx;
 }
 static void construct_best_sorted_arrays_md_stage_3(
     struct ModeDecisionContext *ctx,
@@ -1592,11 +1681,9 @@ static bool perform_ind_uv_search_last_mds(struct ModeDecisionContext   *ctx,
             ? 1
             : 0;
         if (is_inter) {
-            if (*buffer_ptr_array[id]->full_cost < best_inter_cost)
-                best_inter_cost = *buffer_ptr_array[id]->full_cost;
+            best_inter_cost = MIN(best_inter_cost, ctx->full_cost_array[id]);
         } else {
-            if (*buffer_ptr_array[id]->full_cost < best_intra_cost)
-                best_intra_cost = *buffer_ptr_array[id]->full_cost;
+            best_intra_cost = MIN(best_intra_cost, ctx->full_cost_array[id]);
         }
     }
 
@@ -1777,23 +1864,8 @@ static void md_stage_0(PictureControlSet *pcs, ModeDecisionContext *ctx,
             if (tot_processed_cand < max_buffers) {
                 highest_cost_index++;
             } else {
-                const uint64_t *fast_cost_array    = ctx->fast_cost_array;
-                const uint32_t  buffer_index_start = cand_bf_start_index;
-                const uint32_t  buffer_index_end   = buffer_index_start + max_buffers;
-                if (max_buffers == 2)
-                    highest_cost_index = fast_cost_array[buffer_index_start] < fast_cost_array[buffer_index_start + 1]
-                        ? buffer_index_start + 1
-                        : buffer_index_start;
-                else {
-                    highest_cost_index    = buffer_index_start;
-                    uint64_t highest_cost = fast_cost_array[buffer_index_start];
-                    for (uint32_t buff = buffer_index_start + 1; buff < buffer_index_end; buff++) {
-                        if (fast_cost_array[buff] > highest_cost) {
-                            highest_cost_index = buff;
-                            highest_cost       = fast_cost_array[buff];
-                        }
-                    }
-                }
+                highest_cost_index = get_highest_cost_buffer_index(
+                    ctx->fast_cost_array, cand_bf_start_index, max_buffers);
             }
         }
     }
@@ -7673,13 +7745,13 @@ static void post_mds0_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
     uint16_t                      mds1_cand_th_rank_factor = pruning_ctrls.mds1_cand_th_rank_factor;
     uint64_t                      mds1_cand_base_th_intra  = (pruning_ctrls.mds1_cand_base_th_intra * q_weight) / 1000;
     uint64_t                      mds1_cand_base_th_inter  = (pruning_ctrls.mds1_cand_base_th_inter * q_weight) / 1000;
-    ModeDecisionCandidateBuffer **cand_bf_arr              = ctx->cand_bf_ptr_array;
+    const uint64_t               *fast_cost_array          = ctx->fast_cost_array;
     for (CandClass cidx = CAND_CLASS_0; cidx < CAND_CLASS_TOTAL; cidx++) {
         const uint64_t mds1_cand_th = is_intra_class(cidx) ? mds1_cand_base_th_intra : mds1_cand_base_th_inter;
         if ((mds1_cand_th != (uint64_t)~0 || mds1_class_th != (uint64_t)~0) && ctx->md_stage_0_count[cidx] > 0 &&
             ctx->md_stage_1_count[cidx] > 0) {
             const uint32_t *cand_buff = ctx->cand_buff_indices[cidx];
-            const uint64_t  best_cost = *cand_bf_arr[cand_buff[0]]->fast_cost;
+            const uint64_t  best_cost = fast_cost_array[cand_buff[0]];
             // inter class pruning
             if (best_cost && best_md_stage_cost && best_cost != best_md_stage_cost) {
                 if (mds1_class_th == 0) {
@@ -7702,7 +7774,7 @@ static void post_mds0_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
             uint32_t cand_count = 1;
             if (best_cost) {
                 while (cand_count < ctx->md_stage_1_count[cidx] &&
-                       (*cand_bf_arr[cand_buff[cand_count]]->fast_cost - best_cost) * 100 / best_cost <
+                       (fast_cost_array[cand_buff[cand_count]] - best_cost) * 100 / best_cost <
                            mds1_cand_th / (mds1_cand_th_rank_factor ? mds1_cand_th_rank_factor * cand_count : 1))
                     cand_count++;
             }
@@ -7750,12 +7822,12 @@ static void post_mds1_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
     const uint64_t                mds2_class_th        = (pruning_ctrls.mds2_class_th * q_weight) / 1000;
     const uint8_t                 mds2_band_cnt        = pruning_ctrls.mds2_band_cnt;
     const uint16_t                mds2_relative_dev_th = pruning_ctrls.mds2_relative_dev_th;
-    ModeDecisionCandidateBuffer **cand_bf_arr          = ctx->cand_bf_ptr_array;
+    const uint64_t               *full_cost_array      = ctx->full_cost_array;
     for (CandClass cidx = CAND_CLASS_0; cidx < CAND_CLASS_TOTAL; cidx++) {
         if ((mds2_cand_th != (uint64_t)~0 || mds2_class_th != (uint64_t)~0) && ctx->md_stage_1_count[cidx] > 0 &&
             ctx->md_stage_2_count[cidx] > 0 && ctx->bypass_md_stage_1 == FALSE) {
             const uint32_t *cand_buff = ctx->cand_buff_indices[cidx];
-            const uint64_t  best_cost = *cand_bf_arr[cand_buff[0]]->full_cost;
+            const uint64_t  best_cost = full_cost_array[cand_buff[0]];
 
             // class pruning
             if (best_cost && best_md_stage_cost && best_cost != best_md_stage_cost) {
@@ -7788,7 +7860,7 @@ static void post_mds1_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
                         else if (ctx->mds0_best_idx == ctx->mds1_best_idx)
                             mds2_cand_th_rank_factor += 2;
                     }
-                    uint64_t dev      = (*cand_bf_arr[cand_buff[cand_count]]->full_cost - best_cost) * 100 / best_cost;
+                    uint64_t dev      = (full_cost_array[cand_buff[cand_count]] - best_cost) * 100 / best_cost;
                     uint64_t prev_dev = dev;
                     while (
                         (!mds2_relative_dev_th || dev <= prev_dev + mds2_relative_dev_th) &&
@@ -7798,7 +7870,7 @@ static void post_mds1_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
                         if (cand_count >= ctx->md_stage_2_count[cidx])
                             break;
                         prev_dev = dev;
-                        dev      = (*cand_bf_arr[cand_buff[cand_count]]->full_cost - best_cost) * 100 / best_cost;
+                        dev      = (full_cost_array[cand_buff[cand_count]] - best_cost) * 100 / best_cost;
                     }
                 }
                 ctx->md_stage_2_count[cidx] = cand_count;
@@ -7828,13 +7900,13 @@ static void post_mds2_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
     const uint64_t                mds3_cand_th  = (pruning_ctrls.mds3_cand_base_th * q_weight) / 1000;
     const uint64_t                mds3_class_th = (pruning_ctrls.mds3_class_th * q_weight) / 1000;
     const uint8_t                 mds3_band_cnt = pruning_ctrls.mds3_band_cnt;
-    ModeDecisionCandidateBuffer **cand_bf_arr   = ctx->cand_bf_ptr_array;
+    const uint64_t               *full_cost_array = ctx->full_cost_array;
     ctx->md_stage_3_total_count                 = 0;
     for (CandClass cidx = CAND_CLASS_0; cidx < CAND_CLASS_TOTAL; cidx++) {
         if ((mds3_cand_th != (uint64_t)~0 || mds3_class_th != (uint64_t)~0) && ctx->md_stage_2_count[cidx] > 0 &&
             ctx->md_stage_3_count[cidx] > 0 && ctx->bypass_md_stage_2 == FALSE) {
             const uint32_t *cand_buff = ctx->cand_buff_indices[cidx];
-            const uint64_t  best_cost = *cand_bf_arr[cand_buff[0]]->full_cost;
+            const uint64_t  best_cost = full_cost_array[cand_buff[0]];
 
             // inter class pruning
             if (best_cost && best_md_stage_cost && best_cost != best_md_stage_cost) {
@@ -7859,7 +7931,7 @@ static void post_mds2_nic_pruning(PictureControlSet *pcs, ModeDecisionContext *c
             if (best_cost)
                 while (
                     cand_count < ctx->md_stage_3_count[cidx] &&
-                    (((*cand_bf_arr[cand_buff[cand_count]]->full_cost - best_cost) * 100) / best_cost < mds3_cand_th)) {
+                    (((full_cost_array[cand_buff[cand_count]] - best_cost) * 100) / best_cost < mds3_cand_th)) {
                     cand_count++;
                 }
             ctx->md_stage_3_count[cidx] = cand_count;
@@ -9236,8 +9308,8 @@ static void md_encode_block(PictureControlSet *pcs, ModeDecisionContext *ctx, ui
             //Sort:  md_stage_1_count[cand_class_it]
             uint32_t *cand_buff_indices = ctx->cand_buff_indices[cand_class_it];
             if (ctx->md_stage_1_count[cand_class_it] == 1) {
-                cand_buff_indices[0] = *(cand_bf_ptr_array[buffer_start_idx]->fast_cost) <
-                        *(cand_bf_ptr_array[buffer_start_idx + 1]->fast_cost)
+                cand_buff_indices[0] = ctx->fast_cost_array[buffer_start_idx] <
+                        ctx->fast_cost_array[buffer_start_idx + 1]
                     ? buffer_start_idx
                     : buffer_start_idx + 1;
             } else {
@@ -9248,8 +9320,8 @@ static void md_encode_block(PictureControlSet *pcs, ModeDecisionContext *ctx, ui
                         1, // # cands to sort. buffer_count_for_curr_class may be wrong when multiple iterations used at MDS0
                     ctx->cand_buff_indices[cand_class_it]);
             }
-            if (*(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->fast_cost) < best_md_stage_cost) {
-                best_md_stage_cost      = *(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->fast_cost);
+            if (ctx->fast_cost_array[cand_buff_indices[0]] < best_md_stage_cost) {
+                best_md_stage_cost      = ctx->fast_cost_array[cand_buff_indices[0]];
                 best_md_stage_dist      = ctx->cand_bf_ptr_array[cand_buff_indices[0]]->luma_fast_dist;
                 ctx->mds0_best_idx      = cand_buff_indices[0];
                 ctx->mds0_best_class_it = cand_class_it;
@@ -9289,8 +9361,8 @@ static void md_encode_block(PictureControlSet *pcs, ModeDecisionContext *ctx, ui
                     sort_full_cost_based_candidates(
                         ctx, ctx->md_stage_1_count[cand_class_it], ctx->cand_buff_indices[cand_class_it]);
                 uint32_t *cand_buff_indices = ctx->cand_buff_indices[cand_class_it];
-                if (*(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->full_cost) < best_md_stage_cost) {
-                    best_md_stage_cost      = *(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->full_cost);
+                if (ctx->full_cost_array[cand_buff_indices[0]] < best_md_stage_cost) {
+                    best_md_stage_cost      = ctx->full_cost_array[cand_buff_indices[0]];
                     ctx->mds1_best_idx      = cand_buff_indices[0];
                     ctx->mds1_best_class_it = cand_class_it;
                 }
@@ -9328,7 +9400,7 @@ static void md_encode_block(PictureControlSet *pcs, ModeDecisionContext *ctx, ui
                     ctx, ctx->md_stage_2_count[cand_class_it], ctx->cand_buff_indices[cand_class_it]);
 
             uint32_t *cand_buff_indices = ctx->cand_buff_indices[cand_class_it];
-            best_md_stage_cost = MIN((*(ctx->cand_bf_ptr_array[cand_buff_indices[0]]->full_cost)), best_md_stage_cost);
+            best_md_stage_cost = MIN(ctx->full_cost_array[cand_buff_indices[0]], best_md_stage_cost);
         }
     }
 
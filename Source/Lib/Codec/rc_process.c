@@ -39,6 +39,7 @@
 #include "resize.h"
 #include "src_ops_process.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 // Specifies the weights of the ref frame in calculating qindex of non base layer frames
 static const int non_base_qindex_weight_ref[EB_MAX_TEMPORAL_LAYERS] = {100, 100, 100, 100, 100, 100};
@@ -3145,6 +3146,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
         case RC_INPUT:
             pcs = (PictureControlSet *)rc_tasks->pcs_wrapper->object_ptr;
             scs = pcs->scs;
+            svt_trace_picture(pcs->picture_number, -1);
             // Get r0
             if (pcs->ppcs->r0_based_qps_qpm) {
                 svt_aom_generate_r0beta(pcs->ppcs);
@@ -3497,6 +3499,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
 
             ppcs = (PictureParentControlSet *)rc_tasks->pcs_wrapper->object_ptr;
             scs  = ppcs->scs;
+            svt_trace_picture(ppcs->picture_number, -1);
             // Prevent double counting fames with overlay to so we don't
             // increase processed_frame_number twice per frame
             if (!ppcs->is_overlay) {
@@ -402,31 +402,12 @@ static INLINE int32_t av1_cost_coeffs_txb_loop_cost_eob(struct ModeDecisionConte
             }
         }
     }
-    int32_t c;
-    /* Optimized Loop, omitted first (eob - 1) and last (0) index */
+    /* Omitted first (eob - 1) and last (0) index */
     // Estimate the rate of the first(eob / fast_coeff_est_level) coeff(s), DC and last coeff only
-    int32_t  c_start = MIN(eob - 2, eob / MAX(1, (int)(md_ctx->mds_fast_coeff_est_level - md_ctx->mds_subres_step)));
-    uint32_t cost_literal_cnt = 0;
-    for (c = c_start; c >= 1; --c) {
-        const int32_t pos = scan[c];
-        cost_literal_cnt += !!(qcoeff[pos]);
-        const int32_t level = abs(qcoeff[pos]);
-        if (level > NUM_BASE_LEVELS) {
-            int32_t       ctx        = get_br_ctx(levels, pos, bwl, tx_type_to_class[transform_type]);
-            const int32_t base_range = level - 1 - NUM_BASE_LEVELS;
-
-            cost += coeff_costs->base_cost[coeff_contexts[pos]][3];
-            if (base_range < COEFF_BASE_RANGE) {
-                cost += coeff_costs->lps_cost[ctx][base_range];
-            } else {
-                cost += get_golomb_cost(level) + coeff_costs->lps_cost[ctx][COEFF_BASE_RANGE];
-            }
-        } else {
-            cost += coeff_costs->base_cost[coeff_contexts[pos]][level];
-        }
-    }
-    cost += cost_literal_cnt * cost_literal;
-
+    int32_t c_start = MIN(eob - 2, eob / MAX(1, (int)(md_ctx->mds_fast_coeff_est_level - md_ctx->mds_subres_step)));
+    if (c_start >= 1)
+        cost += svt_av1_cost_coeffs_txb_loop(
+            qcoeff, scan, coeff_contexts, levels, coeff_costs, c_start, bwl, tx_type_to_class[transform_type]);
     return cost;
 }
 
@@ -86,6 +86,8 @@ typedef struct EbPaReferenceObject {
     uint64_t picture_number;
     uint64_t avg_luma;
     uint8_t  dummy_obj;
+    // Bumped when the pictures are overwritten (by temporal filtering), tells the HME cache apart
+    uint32_t content_version;
 } EbPaReferenceObject;
 
 typedef struct EbPaReferenceObjectDescInitData {
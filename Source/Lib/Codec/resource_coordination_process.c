@@ -29,6 +29,7 @@
 #include "resize.h"
 #include "metadata_handle.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 typedef struct ResourceCoordinationContext {
     EbFifo                        *input_cmd_fifo_ptr;
@@ -1093,6 +1094,7 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                 pcs->picture_number = context_ptr->picture_number_array[instance_index]++;
             else
                 pcs->picture_number = context_ptr->picture_number_array[instance_index];
+            svt_trace_picture(pcs->picture_number, -1);
             if (scs->passes == 2 && !end_of_sequence_flag && scs->static_config.pass == ENC_SECOND_PASS &&
                 scs->static_config.rate_control_mode) {
                 pcs->stat_struct = (scs->twopass.stats_buf_ctx->stats_in_start + pcs->picture_number)->stat_struct;
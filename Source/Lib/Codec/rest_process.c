@@ -22,6 +22,7 @@
 #include "resource_coordination_process.h"
 #include "resize.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 /**************************************
  * Rest Context
@@ -547,6 +548,7 @@ void *svt_aom_rest_kernel(void *input_ptr) {
         pcs                           = (PictureControlSet *)cdef_results->pcs_wrapper->object_ptr;
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
+        svt_trace_picture(pcs->picture_number, (int32_t)cdef_results->segment_index);
         FrameHeader *frm_hdr          = &pcs->ppcs->frm_hdr;
         Bool         is_16bit         = scs->is_16bit_pipeline;
         Av1Common   *cm               = pcs->ppcs->av1_cm;
@@ -747,15 +749,26 @@ void *svt_aom_rest_kernel(void *input_ptr) {
             tile_cols = pcs->ppcs->av1_cm->tiles_info.tile_cols;
             tile_rows = pcs->ppcs->av1_cm->tiles_info.tile_rows;
 
-            for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
-                for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
-                    const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
-                    svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
-                    rest_results              = (struct RestResults *)rest_results_wrapper->object_ptr;
-                    rest_results->pcs_wrapper = cdef_results->pcs_wrapper;
-                    rest_results->tile_index  = tile_idx;
-                    // Post Rest Results
-                    svt_post_full_object(rest_results_wrapper);
+            if (scs->static_config.sub_frame_output) {
+                // The tiles went to entropy coding from EncDec, only tell it the filters are done
+                svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
+                rest_results               = (struct RestResults *)rest_results_wrapper->object_ptr;
+                rest_results->pcs_wrapper  = cdef_results->pcs_wrapper;
+                rest_results->tile_index   = 0;
+                rest_results->filters_done = TRUE;
+                svt_post_full_object(rest_results_wrapper);
+            } else {
+                for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
+                    for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
+                        const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
+                        svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
+                        rest_results               = (struct RestResults *)rest_results_wrapper->object_ptr;
+                        rest_results->pcs_wrapper  = cdef_results->pcs_wrapper;
+                        rest_results->tile_index   = tile_idx;
+                        rest_results->filters_done = FALSE;
+                        // Post Rest Results
+                        svt_post_full_object(rest_results_wrapper);
+                    }
                 }
             }
         }
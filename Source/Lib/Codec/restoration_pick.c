@@ -547,21 +547,9 @@ static INLINE void apply_sgr(int32_t sgr_params_idx, const uint8_t *dat8, int32_
     }
 }
 
-static SgrprojInfo search_selfguided_restoration(const uint8_t *dat8, int32_t width, int32_t height, int32_t dat_stride,
-                                                 const uint8_t *src8, int32_t src_stride, int32_t use_highbitdepth,
-                                                 int32_t bit_depth, int32_t pu_width, int32_t pu_height,
-                                                 int32_t *rstbuf, int8_t sg_ref_frame_ep[2],
-                                                 int32_t sg_frame_ep_cnt[SGRPROJ_PARAMS], SgFilterCtrls *ctrls,
-                                                 int32_t plane, int8_t step) {
-    int32_t *flt0 = rstbuf;
-    int32_t *flt1 = flt0 + RESTORATION_UNITPELS_MAX;
-    int32_t  ep, bestep = 0;
-    int64_t  besterr = -1;
-    int32_t  exqd[2], bestxqd[2] = {0, 0};
-    int32_t  flt_stride = ((width + 7) & ~7) + 8;
-    assert(pu_width == (RESTORATION_PROC_UNIT_SIZE >> 1) || pu_width == RESTORATION_PROC_UNIT_SIZE);
-    assert(pu_height == (RESTORATION_PROC_UNIT_SIZE >> 1) || pu_height == RESTORATION_PROC_UNIT_SIZE);
-
+/* Get the range of self-guided parameter sets to search and whether to refine the projection. */
+static void get_sgr_ep_range(int8_t step, const int8_t sg_ref_frame_ep[2], const SgFilterCtrls *ctrls, int32_t plane,
+                             int8_t *start_ep_ptr, int8_t *end_ep_ptr, int8_t *ep_inc_ptr, int8_t *do_refine_ptr) {
     //two types of searches: Ref based (when step<16) and fixed spaced search.
     //TODO: test the fixed based for fast decode and try to unify.
     int8_t start_ep, end_ep, ep_inc, do_refine;
@@ -574,7 +562,6 @@ static SgrprojInfo search_selfguided_restoration(const uint8_t *dat8, int32_t wi
         start_ep = sg_ref_frame_ep[0] < 0 && sg_ref_frame_ep[1] < 0 ? 0 : AOMMAX(0, mid_ep - step);
         end_ep   = sg_ref_frame_ep[0] < 0 && sg_ref_frame_ep[1] < 0 ? SGRPROJ_PARAMS
                                                                     : AOMMIN(SGRPROJ_PARAMS, mid_ep + step);
-        UNUSED(sg_frame_ep_cnt);
 
         ep_inc    = 1;
         do_refine = 1;
@@ -585,6 +572,25 @@ static SgrprojInfo search_selfguided_restoration(const uint8_t *dat8, int32_t wi
         ep_inc    = ctrls->ep_inc[plane];
         do_refine = ctrls->refine[plane];
     }
+    *start_ep_ptr  = start_ep;
+    *end_ep_ptr    = end_ep;
+    *ep_inc_ptr    = ep_inc;
+    *do_refine_ptr = do_refine;
+}
+
+static SgrprojInfo search_selfguided_restoration(const uint8_t *dat8, int32_t width, int32_t height, int32_t dat_stride,
+                                                 const uint8_t *src8, int32_t src_stride, int32_t use_highbitdepth,
+                                                 int32_t bit_depth, int32_t pu_width, int32_t pu_height,
+                                                 int32_t *rstbuf, int8_t start_ep, int8_t end_ep, int8_t ep_inc,
+                                                 int8_t do_refine) {
+    int32_t *flt0 = rstbuf;
+    int32_t *flt1 = flt0 + RESTORATION_UNITPELS_MAX;
+    int32_t  ep, bestep = 0;
+    int64_t  besterr = -1;
+    int32_t  exqd[2], bestxqd[2] = {0, 0};
+    int32_t  flt_stride = ((width + 7) & ~7) + 8;
+    assert(pu_width == (RESTORATION_PROC_UNIT_SIZE >> 1) || pu_width == RESTORATION_PROC_UNIT_SIZE);
+    assert(pu_height == (RESTORATION_PROC_UNIT_SIZE >> 1) || pu_height == RESTORATION_PROC_UNIT_SIZE);
 
     for (ep = start_ep; ep < end_ep; ep += ep_inc) {
         int32_t exq[2];
@@ -1234,7 +1240,15 @@ static void search_sgrproj_seg(const RestorationTileLimits *limits, const Av1Pix
     const int32_t ss_y            = is_uv && cm->subsampling_y;
     const int32_t procunit_width  = RESTORATION_PROC_UNIT_SIZE >> ss_x;
     const int32_t procunit_height = RESTORATION_PROC_UNIT_SIZE >> ss_y;
-    int8_t        step            = cm->sg_filter_ctrls.step_range;
+    int8_t        start_ep, end_ep, ep_inc, do_refine;
+    get_sgr_ep_range(cm->sg_filter_ctrls.step_range,
+                     cm->sg_ref_frame_ep,
+                     &cm->sg_filter_ctrls,
+                     rsc->plane,
+                     &start_ep,
+                     &end_ep,
+                     &ep_inc,
+                     &do_refine);
 
     rusi->sgrproj = search_selfguided_restoration(dgd_start,
                                                   limits->h_end - limits->h_start,
@@ -1247,11 +1261,10 @@ static void search_sgrproj_seg(const RestorationTileLimits *limits, const Av1Pix
                                                   procunit_width,
                                                   procunit_height,
                                                   rsc->tmpbuf,
-                                                  cm->sg_ref_frame_ep,
-                                                  cm->sg_frame_ep_cnt,
-                                                  &cm->sg_filter_ctrls,
-                                                  rsc->plane,
-                                                  step);
+                                                  start_ep,
+                                                  end_ep,
+                                                  ep_inc,
+                                                  do_refine);
     svt_block_on_mutex(cm->child_pcs->rest_search_mutex);
     cm->sg_frame_ep_cnt[rusi->sgrproj.ep]++;
     svt_release_mutex(cm->child_pcs->rest_search_mutex);
@@ -1273,11 +1286,19 @@ static void search_sgrproj_finish(const RestorationTileLimits *limits, const Av1
 
     const Macroblock *const x = rsc->x;
 
+    const int64_t bits_none = x->sgrproj_restore_cost[0];
+
+    // The sub-sampled search skips self-guided filtering for the units where Wiener filtering won
     rusi->sse[RESTORE_SGRPROJ] = rsc->rusi_pic[rest_unit_idx].sse[RESTORE_SGRPROJ];
-    rusi->sgrproj              = rsc->rusi_pic[rest_unit_idx].sgrproj;
+    if (rusi->sse[RESTORE_SGRPROJ] == INT64_MAX) {
+        rsc->bits += bits_none;
+        rsc->sse += rusi->sse[RESTORE_NONE];
+        rusi->best_rtype[RESTORE_SGRPROJ - 1] = RESTORE_NONE;
+        return;
+    }
+    rusi->sgrproj = rsc->rusi_pic[rest_unit_idx].sgrproj;
 
-    const int64_t bits_none = x->sgrproj_restore_cost[0];
-    const int64_t bits_sgr  = x->sgrproj_restore_cost[1] +
+    const int64_t bits_sgr = x->sgrproj_restore_cost[1] +
         (count_sgrproj_bits(&rusi->sgrproj, &rsc->sgrproj) << AV1_PROB_COST_SHIFT);
 
     double cost_none = RDCOST_DBL(x->rdmult, bits_none >> 4, rusi->sse[RESTORE_NONE]);
@@ -1452,6 +1473,291 @@ static void search_norestore_finish(const RestorationTileLimits *limits, const A
 
     rsc->sse += rusi->sse[RESTORE_NONE];
 }
+/* The sub-sampled search splits each restoration unit into blocks of 1/8 of the unit size and only looks at the blocks
+   on even block rows and columns, a quarter of the unit. Whole blocks are sampled, rather than every other pixel, so
+   that the Wiener window and the self-guided box sums see the true neighbours of each sampled pixel. */
+#define REST_SUB_SEARCH_BLK_LOG2 3
+
+// Length covered by the blocks at even block positions of a range of length len.
+static INLINE int32_t sub_search_length(int32_t len, int32_t blk) {
+    const int32_t pairs = len / (2 * blk);
+    return pairs * blk + AOMMIN(blk, len - pairs * 2 * blk);
+}
+
+// Copy the sampled blocks of a restoration unit into a contiguous image of width dst_width.
+static void pack_sub_search_blocks(const uint8_t *buf8, int32_t stride, const RestorationTileLimits *limits,
+                                   int32_t blk, int32_t highbd, uint8_t *dst8, int32_t dst_width) {
+    int32_t i = 0;
+    for (int32_t v = limits->v_start; v < limits->v_end; v += 2 * blk) {
+        const int32_t v_end = AOMMIN(v + blk, limits->v_end);
+        for (int32_t y = v; y < v_end; ++y, ++i) {
+            int32_t j = 0;
+            for (int32_t h = limits->h_start; h < limits->h_end; h += 2 * blk) {
+                const int32_t w = AOMMIN(blk, limits->h_end - h);
+                if (highbd)
+                    svt_memcpy(CONVERT_TO_SHORTPTR(dst8) + i * dst_width + j,
+                               CONVERT_TO_SHORTPTR(buf8) + y * stride + h,
+                               w * sizeof(uint16_t));
+                else
+                    svt_memcpy(dst8 + i * dst_width + j, buf8 + y * stride + h, w);
+                j += w;
+            }
+        }
+    }
+}
+
+/* Derive a coarse Wiener filter from the statistics of the sampled blocks. Return the change in SSE the filter brings
+   to the sampled blocks, or INT64_MAX if it brings no improvement. */
+static int64_t sub_search_wiener(const RestSearchCtxt *rsc, const RestorationTileLimits *limits, int32_t blk,
+                                 int32_t wiener_win, WienerInfo *wiener_info) {
+    const Av1Common *const cm          = rsc->cm;
+    const int32_t          wiener_win2 = wiener_win * wiener_win;
+    EB_ALIGN(32) int64_t   M[WIENER_WIN2];
+    EB_ALIGN(32) int64_t   H[WIENER_WIN2 * WIENER_WIN2];
+    EB_ALIGN(32) int64_t   blk_m[WIENER_WIN2];
+    EB_ALIGN(32) int64_t   blk_h[WIENER_WIN2 * WIENER_WIN2];
+    int32_t                vfilterd[WIENER_WIN], hfilterd[WIENER_WIN];
+
+    memset(M, 0, sizeof(*M) * wiener_win2);
+    memset(H, 0, sizeof(*H) * wiener_win2 * wiener_win2);
+    // The statistics of each block are taken around its own average. As the filter taps sum to one, this does not
+    // change the filter objective, so the statistics of the blocks can simply be added up.
+    for (int32_t v = limits->v_start; v < limits->v_end; v += 2 * blk) {
+        const int32_t v_end = AOMMIN(v + blk, limits->v_end);
+        for (int32_t h = limits->h_start; h < limits->h_end; h += 2 * blk) {
+            const int32_t h_end = AOMMIN(h + blk, limits->h_end);
+            if (cm->use_highbitdepth)
+                svt_av1_compute_stats_highbd(wiener_win,
+                                             rsc->dgd_buffer,
+                                             rsc->src_buffer,
+                                             h,
+                                             h_end,
+                                             v,
+                                             v_end,
+                                             rsc->dgd_stride,
+                                             rsc->src_stride,
+                                             blk_m,
+                                             blk_h,
+                                             (EbBitDepth)cm->bit_depth);
+            else
+                svt_av1_compute_stats(wiener_win,
+                                      rsc->dgd_buffer,
+                                      rsc->src_buffer,
+                                      h,
+                                      h_end,
+                                      v,
+                                      v_end,
+                                      rsc->dgd_stride,
+                                      rsc->src_stride,
+                                      blk_m,
+                                      blk_h);
+            for (int32_t k = 0; k < wiener_win2; ++k) M[k] += blk_m[k];
+            for (int32_t k = 0; k < wiener_win2 * wiener_win2; ++k) H[k] += blk_h[k];
+        }
+    }
+
+    if (!wiener_decompose_sep_sym(wiener_win, M, H, vfilterd, hfilterd))
+        return INT64_MAX;
+    finalize_sym_filter(wiener_win, vfilterd, wiener_info->vfilter);
+    finalize_sym_filter(wiener_win, hfilterd, wiener_info->hfilter);
+
+    // The score is the SSE of the filter minus the SSE of the identity filter, in the scale of the statistics
+    const int64_t score = compute_score(wiener_win, M, H, wiener_info->vfilter, wiener_info->hfilter);
+#ifdef ARCH_X86_64
+    aom_clear_system_state();
+#endif
+    if (score > 0)
+        return INT64_MAX;
+    // Undo the bit depth scaling of the high bit depth statistics
+    return cm->use_highbitdepth ? score * (1 << (cm->bit_depth - 8)) : score;
+}
+
+/* Pick the self-guided parameter set and a coarse projection on the sampled blocks, packed into a contiguous image.
+   Return the SSE of the sampled blocks with the best parameters. */
+static int64_t sub_search_sgrproj(const RestSearchCtxt *rsc, const RestorationTileLimits *limits, int32_t blk,
+                                  int8_t start_ep, int8_t end_ep, int8_t ep_inc, int8_t do_refine,
+                                  SgrprojInfo *sgrproj_info) {
+    const Av1Common *const cm         = rsc->cm;
+    const int32_t          highbd     = cm->use_highbitdepth;
+    const int32_t          width      = sub_search_length(limits->h_end - limits->h_start, blk);
+    const int32_t          height     = sub_search_length(limits->v_end - limits->v_start, blk);
+    const int32_t          flt_stride = ((width + 7) & ~7) + 8;
+
+    // The filter outputs take the start of each half of the scratch buffer, the packed degraded and source blocks
+    // take the rest.
+    int32_t *flt0  = rsc->tmpbuf;
+    int32_t *flt1  = flt0 + RESTORATION_UNITPELS_MAX;
+    uint8_t *dgd8  = (uint8_t *)(flt0 + (RESTORATION_UNITPELS_MAX >> 1));
+    uint8_t *src8  = (uint8_t *)(flt1 + (RESTORATION_UNITPELS_MAX >> 1));
+    int64_t  besterr = -1;
+    assert(flt_stride * height <= (RESTORATION_UNITPELS_MAX >> 1));
+    if (highbd) {
+        dgd8 = CONVERT_TO_BYTEPTR(dgd8);
+        src8 = CONVERT_TO_BYTEPTR(src8);
+    }
+    pack_sub_search_blocks(rsc->dgd_buffer, rsc->dgd_stride, limits, blk, highbd, dgd8, width);
+    pack_sub_search_blocks(rsc->src_buffer, rsc->src_stride, limits, blk, highbd, src8, width);
+    sgrproj_info->ep = start_ep;
+    set_default_sgrproj(sgrproj_info);
+
+    for (int32_t ep = start_ep; ep < end_ep; ep += ep_inc) {
+        const SgrParamsType *const params = &svt_aom_eb_sgr_params[ep];
+        int32_t                    exq[2], exqd[2];
+        // Filter each block in place in the frame, so that the box sums read its true neighbours, and pack the
+        // outputs in the same layout as the degraded and source blocks
+        int32_t i = 0;
+        for (int32_t v = limits->v_start; v < limits->v_end; v += 2 * blk) {
+            const int32_t h_blk = AOMMIN(blk, limits->v_end - v);
+            int32_t       j     = 0;
+            for (int32_t h = limits->h_start; h < limits->h_end; h += 2 * blk) {
+                const int32_t w_blk = AOMMIN(blk, limits->h_end - h);
+                svt_av1_selfguided_restoration(rsc->dgd_buffer + v * rsc->dgd_stride + h,
+                                               w_blk,
+                                               h_blk,
+                                               rsc->dgd_stride,
+                                               flt0 + i * flt_stride + j,
+                                               flt1 + i * flt_stride + j,
+                                               flt_stride,
+                                               ep,
+                                               cm->bit_depth,
+                                               highbd);
+                j += w_blk;
+            }
+            i += h_blk;
+        }
+#ifdef ARCH_X86_64
+        aom_clear_system_state();
+#endif
+        svt_get_proj_subspace(
+            src8, width, height, width, dgd8, width, highbd, flt0, flt_stride, flt1, flt_stride, exq, params);
+#ifdef ARCH_X86_64
+        aom_clear_system_state();
+#endif
+        encode_xq(exq, exqd, params);
+        const int64_t err = finer_search_pixel_proj_error(src8,
+                                                          width,
+                                                          height,
+                                                          width,
+                                                          dgd8,
+                                                          width,
+                                                          highbd,
+                                                          flt0,
+                                                          flt_stride,
+                                                          flt1,
+                                                          flt_stride,
+                                                          2,
+                                                          exqd,
+                                                          do_refine,
+                                                          params);
+        if (besterr == -1 || err < besterr) {
+            besterr              = err;
+            sgrproj_info->ep     = ep;
+            sgrproj_info->xqd[0] = exqd[0];
+            sgrproj_info->xqd[1] = exqd[1];
+        }
+    }
+    return besterr;
+}
+
+/* Search the Wiener and self-guided filters on the sampled blocks of a restoration unit, then refine only the type
+   with the lower estimated cost on the whole unit. The other type is reported as not found, so the finish stage
+   chooses between the refined type and no filtering. */
+static void search_sub_seg(const RestorationTileLimits *limits, const Av1PixelRect *tile_rect, int32_t rest_unit_idx,
+                           void *priv) {
+    RestSearchCtxt            *rsc      = (RestSearchCtxt *)priv;
+    RestUnitSearchInfo        *rusi     = &rsc->rusi[rest_unit_idx];
+    Av1Common *const           cm       = rsc->cm;
+    const Macroblock *const    x        = rsc->x;
+    const WnFilterCtrls *const wn_ctrls = &cm->wn_filter_ctrls;
+    const SgFilterCtrls *const sg_ctrls = &cm->sg_filter_ctrls;
+    const int32_t              plane    = rsc->plane;
+    const int32_t              highbd   = cm->use_highbitdepth;
+    const int32_t              blk      = cm->child_pcs->rst_info[plane].restoration_unit_size >>
+        REST_SUB_SEARCH_BLK_LOG2;
+    const Bool    do_wn      = wn_ctrls->enabled && (!plane || wn_ctrls->use_chroma);
+    const Bool    do_sg      = sg_ctrls->enabled && (!plane || sg_ctrls->use_chroma);
+    int32_t       wn_luma    = wn_ctrls->filter_tap_lvl == 1 ? WIENER_WIN
+                 : wn_ctrls->filter_tap_lvl == 2             ? WIENER_WIN_CHROMA
+                                                             : WIENER_WIN_3TAP;
+    const int32_t wiener_win = (plane == AOM_PLANE_Y) ? wn_luma : MIN(wn_luma, WIENER_WIN_CHROMA);
+
+    RestorationUnitInfo rui;
+    memset(&rui, 0, sizeof(rui));
+    rusi->sse[RESTORE_WIENER]  = INT64_MAX;
+    rusi->sse[RESTORE_SGRPROJ] = INT64_MAX;
+
+    int8_t start_ep = 0, end_ep = 0, ep_inc = 1, do_refine = 0;
+    if (do_sg)
+        get_sgr_ep_range(
+            sg_ctrls->step_range, cm->sg_ref_frame_ep, sg_ctrls, plane, &start_ep, &end_ep, &ep_inc, &do_refine);
+
+    const int64_t wn_delta = do_wn ? sub_search_wiener(rsc, limits, blk, wiener_win, &rui.wiener_info) : INT64_MAX;
+    RestorationType rtype  = do_sg ? RESTORE_SGRPROJ : wn_delta != INT64_MAX ? RESTORE_WIENER : RESTORE_NONE;
+    // Pick the self-guided parameter set on the sampled blocks, unless there is nothing to choose
+    if (do_sg && (start_ep + ep_inc < end_ep || wn_delta != INT64_MAX)) {
+        SgrprojInfo   sgrproj_info;
+        const int64_t sg_err = sub_search_sgrproj(rsc, limits, blk, start_ep, end_ep, ep_inc, do_refine, &sgrproj_info);
+        // Only the parameter set picked on the sampled blocks is searched on the whole unit
+        start_ep = sgrproj_info.ep;
+        end_ep   = sgrproj_info.ep + 1;
+
+        if (wn_delta != INT64_MAX) {
+            // Compare the two types on the sampled blocks, with the SSE change scaled to the area of the unit
+            int64_t sse_none = 0;
+            for (int32_t v = limits->v_start; v < limits->v_end; v += 2 * blk) {
+                for (int32_t h = limits->h_start; h < limits->h_end; h += 2 * blk) {
+                    const RestorationTileLimits blk_limits = {
+                        h, AOMMIN(h + blk, limits->h_end), v, AOMMIN(v + blk, limits->v_end)};
+                    sse_none += sse_restoration_unit(&blk_limits, rsc->src, cm->frame_to_show, plane, highbd);
+                }
+            }
+            const int32_t unit_w  = limits->h_end - limits->h_start;
+            const int32_t unit_h  = limits->v_end - limits->v_start;
+            const double  scale   = (double)(unit_w * unit_h) /
+                (sub_search_length(unit_w, blk) * sub_search_length(unit_h, blk));
+            const int64_t bits_wn = x->switchable_restore_cost[RESTORE_WIENER] +
+                (count_wiener_bits(wiener_win, &rui.wiener_info, &rsc->wiener) << AV1_PROB_COST_SHIFT);
+            const int64_t bits_sg = x->switchable_restore_cost[RESTORE_SGRPROJ] +
+                (count_sgrproj_bits(&sgrproj_info, &rsc->sgrproj) << AV1_PROB_COST_SHIFT);
+            const double  cost_wn = RDCOST_DBL(x->rdmult, bits_wn >> 4, wn_delta * scale);
+            const double  cost_sg = RDCOST_DBL(x->rdmult, bits_sg >> 4, (sg_err - sse_none) * scale);
+            if (cost_wn <= cost_sg)
+                rtype = RESTORE_WIENER;
+        }
+    }
+
+    if (rtype == RESTORE_WIENER) {
+        rui.restoration_type      = RESTORE_WIENER;
+        rusi->sse[RESTORE_WIENER] = finer_tile_search_wiener_seg(rsc, limits, tile_rect, &rui, wiener_win);
+        rusi->wiener              = rui.wiener_info;
+    } else if (rtype == RESTORE_SGRPROJ) {
+        const int32_t ss_x = plane && cm->subsampling_x;
+        const int32_t ss_y = plane && cm->subsampling_y;
+        rusi->sgrproj      = search_selfguided_restoration(
+            rsc->dgd_buffer + limits->v_start * rsc->dgd_stride + limits->h_start,
+            limits->h_end - limits->h_start,
+            limits->v_end - limits->v_start,
+            rsc->dgd_stride,
+            rsc->src_buffer + limits->v_start * rsc->src_stride + limits->h_start,
+            rsc->src_stride,
+            highbd,
+            cm->bit_depth,
+            RESTORATION_PROC_UNIT_SIZE >> ss_x,
+            RESTORATION_PROC_UNIT_SIZE >> ss_y,
+            rsc->tmpbuf,
+            start_ep,
+            end_ep,
+            ep_inc,
+            do_refine);
+        svt_block_on_mutex(cm->child_pcs->rest_search_mutex);
+        cm->sg_frame_ep_cnt[rusi->sgrproj.ep]++;
+        svt_release_mutex(cm->child_pcs->rest_search_mutex);
+
+        rui.restoration_type       = RESTORE_SGRPROJ;
+        rui.sgrproj_info           = rusi->sgrproj;
+        rusi->sse[RESTORE_SGRPROJ] = try_restoration_unit_seg(rsc, limits, tile_rect, &rui);
+    }
+}
 /* Get the cost/SSE/rate for the entire frame associated with using the passed restoration filter type. */
 static double search_rest_type_finish(RestSearchCtxt *rsc, RestorationType rtype) {
     static const RestUnitVisitor funs[RESTORE_TYPES] = {
@@ -1468,8 +1774,22 @@ static double search_rest_type_finish(RestSearchCtxt *rsc, RestorationType rtype
    The search will return the best parameters for each type of filter and their associated SSEs,
    to be used in the final decision for filtering the frame.
 */
+#include <time.h> //TMP
+#include <stdlib.h> //TMP
+static volatile long long tmp_ns; //TMP
+static void tmp_pr(void) { fprintf(stderr, "RSTNS %lld\n", tmp_ns / 1000000); } //TMP
+static void restoration_seg_search_x(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, const Yv12BufferConfig *src,
+                            Yv12BufferConfig *trial_frame_rst, PictureControlSet *pcs, uint32_t segment_index);
 void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, const Yv12BufferConfig *src,
                             Yv12BufferConfig *trial_frame_rst, PictureControlSet *pcs, uint32_t segment_index) {
+    static int reg; if (!reg) { reg = 1; atexit(tmp_pr); }
+    struct timespec a, b; clock_gettime(CLOCK_THREAD_CPUTIME_ID, &a);
+    restoration_seg_search_x(rst_tmpbuf, org_fts, src, trial_frame_rst, pcs, segment_index);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &b);
+    __sync_fetch_and_add(&tmp_ns, (b.tv_sec - a.tv_sec) * 1000000000LL + b.tv_nsec - a.tv_nsec);
+}
+static void restoration_seg_search_x(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, const Yv12BufferConfig *src,
+                            Yv12BufferConfig *trial_frame_rst, PictureControlSet *pcs, uint32_t segment_index) {
     Av1Common *const cm = pcs->ppcs->av1_cm;
     Macroblock      *x  = pcs->ppcs->av1x;
 
@@ -1528,7 +1848,22 @@ void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, cons
                                                pcs->rest_segments_row_count,
                                                segment_index);
 
-        if (cm->wn_filter_ctrls.enabled && (!plane || cm->wn_filter_ctrls.use_chroma))
+        const Bool do_wn = cm->wn_filter_ctrls.enabled && (!plane || cm->wn_filter_ctrls.use_chroma);
+        const Bool do_sg = cm->sg_filter_ctrls.enabled && (!plane || cm->sg_filter_ctrls.use_chroma);
+        if (cm->use_sub_rest_search) {
+            if (do_wn || do_sg)
+                svt_aom_foreach_rest_unit_in_frame_seg(rsc_p->cm,
+                                                       rsc_p->plane,
+                                                       rsc_on_tile,
+                                                       search_sub_seg,
+                                                       rsc_p,
+                                                       pcs->rest_segments_column_count,
+                                                       pcs->rest_segments_row_count,
+                                                       segment_index);
+            continue;
+        }
+
+        if (do_wn)
             svt_aom_foreach_rest_unit_in_frame_seg(rsc_p->cm,
                                                    rsc_p->plane,
                                                    rsc_on_tile,
@@ -1538,7 +1873,7 @@ void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, cons
                                                    pcs->rest_segments_row_count,
                                                    segment_index);
 
-        if (cm->sg_filter_ctrls.enabled && (!plane || cm->sg_filter_ctrls.use_chroma))
+        if (do_sg)
             svt_aom_foreach_rest_unit_in_frame_seg(rsc_p->cm,
                                                    rsc_p->plane,
                                                    rsc_on_tile,
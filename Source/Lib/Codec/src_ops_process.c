@@ -34,6 +34,13 @@
 #include "av1me.h"
 #include "enc_inter_prediction.h"
 #include "resize.h"
+#include "svt_trace.h"
+typedef struct TplRefList {
+    EbObjectWrapper *ref;
+    int32_t          frame_idx;
+    uint8_t          refresh_frame_mask;
+    bool             is_valid;
+} TplRefList;
 /**************************************
  * Context
  **************************************/
@@ -45,6 +52,11 @@ typedef struct SourceBasedOperationsContext {
     uint8_t *y_mean_ptr;
     uint8_t *cr_mean_ptr;
     uint8_t *cb_mean_ptr;
+    // Incremental TPL: tpl recon references still in use and frames of the previous tpl group
+    TplRefList tpl_ref_list[REF_FRAMES + 1];
+    uint64_t   tpl_prev_poc[MAX_TPL_LA_SW];
+    uint8_t    tpl_prev_valid[MAX_TPL_LA_SW];
+    int32_t    tpl_prev_frames;
 } SourceBasedOperationsContext;
 typedef struct TplDispenserContext {
     EbDctor  dctor;
@@ -136,9 +148,11 @@ static void tpl_regular_setup_me_refs(PictureParentControlSet *base_pcs, Picture
 
             cur_pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_idx].picture_number = ref_obj->picture_number;
             cur_pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_idx].picture_ptr    = ref_obj->input_padded_pic;
-            //not needed for TPL but could be linked.
-            cur_pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_idx].sixteenth_picture_ptr = NULL;
-            cur_pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_idx].quarter_picture_ptr   = NULL;
+            // only used by the downscaled TPL
+            cur_pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_idx].sixteenth_picture_ptr =
+                ref_obj->sixteenth_downsampled_picture_ptr;
+            cur_pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_idx].quarter_picture_ptr =
+                ref_obj->quarter_downsampled_picture_ptr;
         }
     }
 }
@@ -370,6 +384,13 @@ static inline void get_neighbor_samples_dc(uint8_t *src, uint32_t src_stride, ui
         read_ptr += src_stride;
     }
 }
+// Source picture of a TPL reference at the resolution processed by the dispenser
+static AOM_INLINE EbPictureBufferDesc *tpl_get_ref_src_pic(EbDownScaledBufDescPtrArray *ref_ds_pics,
+                                                           uint8_t                      ds_shift) {
+    return ds_shift == 2 ? ref_ds_pics->sixteenth_picture_ptr
+        : ds_shift == 1  ? ref_ds_pics->quarter_picture_ptr
+                         : ref_ds_pics->picture_ptr;
+}
 #define MAX_TPL_MODE 3
 #define MAX_TPL_SIZE 32
 #define MAX_TPL_SAMPLES_PER_BLOCK MAX_TPL_SIZE *MAX_TPL_SIZE
@@ -380,6 +401,8 @@ static uint32_t blk_end_array[MAX_TPL_MODE]      = {20, 4, 0};
 static TxSize   tx_size_array[MAX_TPL_MODE]      = {TX_16X16, TX_32X32, TX_64X64};
 static TxSize   sub2_tx_size_array[MAX_TPL_MODE] = {TX_16X8, TX_32X16, TX_64X32};
 static TxSize   sub4_tx_size_array[MAX_TPL_MODE] = {TX_16X4, TX_32X8, TX_64X16};
+static TxSize   ds2_tx_size_array[MAX_TPL_MODE]  = {TX_8X8, TX_16X16, TX_32X32};
+static TxSize   ds4_tx_size_array[MAX_TPL_MODE]  = {TX_4X4, TX_8X8, TX_16X16};
 static void     svt_tpl_init_mv_cost_params(MV_COST_PARAMS *mv_cost_params, const MV *ref_mv, uint8_t base_q_idx,
                                             uint32_t rdmult, uint8_t hbd_md) {
     mv_cost_params->ref_mv        = ref_mv;
@@ -401,15 +424,15 @@ static void     svt_tpl_init_mv_cost_params(MV_COST_PARAMS *mv_cost_params, cons
 
 // Initialize xd fields required by TPL dispenser
 static void init_xd_tpl(MacroBlockD *xd, const Av1Common *const cm, const BlockSize block_size,
-                        const uint32_t mb_origin_x, const uint32_t mb_origin_y) {
+                        const uint32_t mb_origin_x, const uint32_t mb_origin_y, const uint8_t ds_shift) {
     const int32_t bw      = mi_size_wide[block_size];
     const int32_t bh      = mi_size_high[block_size];
     const int     mi_row  = mb_origin_y >> MI_SIZE_LOG2;
     const int     mi_col  = mb_origin_x >> MI_SIZE_LOG2;
     xd->mb_to_top_edge    = -((mi_row * MI_SIZE) * 8);
-    xd->mb_to_bottom_edge = ((cm->mi_rows - bh - mi_row) * MI_SIZE) * 8;
+    xd->mb_to_bottom_edge = (((cm->mi_rows >> ds_shift) - bh - mi_row) * MI_SIZE) * 8;
     xd->mb_to_left_edge   = -((mi_col * MI_SIZE) * 8);
-    xd->mb_to_right_edge  = ((cm->mi_cols - bw - mi_col) * MI_SIZE) * 8;
+    xd->mb_to_right_edge  = (((cm->mi_cols >> ds_shift) - bw - mi_col) * MI_SIZE) * 8;
     xd->mi_row            = -xd->mb_to_top_edge / (8 * MI_SIZE);
     xd->mi_col            = -xd->mb_to_left_edge / (8 * MI_SIZE);
 }
@@ -519,21 +542,35 @@ static void tpl_subpel_search(SequenceControlSet *scs, PictureParentControlSet *
 static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceControlSet *scs,
                                              PictureParentControlSet *pcs, int32_t frame_idx, uint32_t sb_index,
                                              int32_t qIndex, uint8_t dispenser_search_level) {
-    uint32_t size      = size_array[dispenser_search_level];
-    uint32_t blk_start = blk_start_array[dispenser_search_level];
-    uint32_t blk_end   = blk_end_array[dispenser_search_level];
-
-    int16_t      x_curr_mv    = 0;
-    int16_t      y_curr_mv    = 0;
-    uint32_t     me_mb_offset = 0;
-    TplControls *tpl_ctrls    = &pcs->tpl_ctrls;
-
-    TxSize tx_size = (tpl_ctrls->subsample_tx == 2) ? sub4_tx_size_array[dispenser_search_level]
-        : (tpl_ctrls->subsample_tx == 1)            ? sub2_tx_size_array[dispenser_search_level]
-                                                    : tx_size_array[dispenser_search_level];
+    TplControls *tpl_ctrls = &pcs->tpl_ctrls;
+    // Downscaled TPL: the blocks are processed on the downsampled pictures (positions and sizes
+    // shifted by ds_shift), then the stats are stored at full resolution
+    const uint8_t ds_shift     = tpl_ctrls->ds_shift;
+    const uint8_t subsample_tx = ds_shift ? 0 : tpl_ctrls->subsample_tx;
+    // rates and distortions are scaled to the full resolution block area
+    const uint8_t stats_shift  = subsample_tx + 2 * ds_shift;
+    uint32_t      size         = size_array[dispenser_search_level] >> ds_shift;
+    uint32_t      blk_start    = blk_start_array[dispenser_search_level];
+    uint32_t      blk_end      = blk_end_array[dispenser_search_level];
+
+    int16_t  x_curr_mv    = 0;
+    int16_t  y_curr_mv    = 0;
+    uint32_t me_mb_offset = 0;
+
+    const TxSize pred_tx_size = ds_shift == 2 ? ds4_tx_size_array[dispenser_search_level]
+        : ds_shift == 1                       ? ds2_tx_size_array[dispenser_search_level]
+                                              : tx_size_array[dispenser_search_level];
+    TxSize       tx_size      = (subsample_tx == 2) ? sub4_tx_size_array[dispenser_search_level]
+                     : (subsample_tx == 1)          ? sub2_tx_size_array[dispenser_search_level]
+                                                    : pred_tx_size;
+    // the partial frequency shapes are not used on the small downscaled transforms
+    const EB_TRANS_COEFF_SHAPE pf_shape = ds_shift ? DEFAULT_SHAPE : tpl_ctrls->pf_shape;
 
     EbPictureBufferDesc *ref_pic_ptr;
-    EbPictureBufferDesc *input_pic = pcs->enhanced_pic;
+    EbPaReferenceObject *pa_ref_obj = (EbPaReferenceObject *)pcs->pa_ref_pic_wrapper->object_ptr;
+    EbPictureBufferDesc *input_pic  = ds_shift == 2 ? pa_ref_obj->sixteenth_downsampled_picture_ptr
+         : ds_shift == 1                            ? pa_ref_obj->quarter_downsampled_picture_ptr
+                                                    : pcs->enhanced_pic;
     EbPictureBufferDesc *recon_pic = enc_ctx->mc_flow_rec_picture_buffer[frame_idx];
     TplStats             tpl_stats;
 
@@ -556,7 +593,7 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
     mb_plane.round_qtx       = scs->enc_ctx->quants_8bit.y_round[qIndex];
     mb_plane.dequant_qtx     = scs->enc_ctx->deq_8bit.y_dequant_qtx[qIndex];
 
-    const uint32_t src_stride      = pcs->enhanced_pic->stride_y;
+    const uint32_t src_stride      = input_pic->stride_y;
     B64Geom       *b64_geom        = &scs->b64_geom[sb_index];
     const int      aligned16_width = (pcs->aligned_width + 15) >> 4;
 
@@ -567,21 +604,25 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
     for (uint32_t blk_index = blk_start; blk_index <= blk_end; blk_index++) {
         uint32_t               z_blk_index   = tpl_blk_idx_tab[0][blk_index];
         const CodedBlockStats *blk_stats_ptr = svt_aom_get_coded_blk_stats(z_blk_index);
-        const uint8_t          bsize         = blk_stats_ptr->size;
-        const BlockSize        block_size    = bsize == 8 ? BLOCK_8X8
+        const uint8_t          bsize         = blk_stats_ptr->size >> ds_shift;
+        const BlockSize        block_size    = bsize == 4 ? BLOCK_4X4
+                      : bsize == 8                        ? BLOCK_8X8
                       : bsize == 16                       ? BLOCK_16X16
                       : bsize == 32                       ? BLOCK_32X32
                                                           : BLOCK_64X64;
-        const uint32_t         mb_origin_x   = b64_geom->org_x + blk_stats_ptr->org_x;
-        const uint32_t         mb_origin_y   = b64_geom->org_y + blk_stats_ptr->org_y;
+        // full resolution position, used for the stats
+        const uint32_t blk_origin_x = b64_geom->org_x + blk_stats_ptr->org_x;
+        const uint32_t blk_origin_y = b64_geom->org_y + blk_stats_ptr->org_y;
+        const uint32_t mb_origin_x  = blk_origin_x >> ds_shift;
+        const uint32_t mb_origin_y  = blk_origin_y >> ds_shift;
 
         // at least half of the block inside
-        if (mb_origin_x + (size >> 1) > pcs->enhanced_pic->width ||
-            mb_origin_y + (size >> 1) > pcs->enhanced_pic->height)
+        if (blk_origin_x + (blk_stats_ptr->size >> 1) > pcs->enhanced_pic->width ||
+            blk_origin_y + (blk_stats_ptr->size >> 1) > pcs->enhanced_pic->height)
             continue;
 
         MacroBlockD xd;
-        init_xd_tpl(&xd, pcs->av1_cm, block_size, mb_origin_x, mb_origin_y);
+        init_xd_tpl(&xd, pcs->av1_cm, block_size, mb_origin_x, mb_origin_y, ds_shift);
 
         const int dst_buffer_stride = recon_pic->stride_y;
         const int dst_mb_offset     = mb_origin_y * dst_buffer_stride + mb_origin_x;
@@ -602,7 +643,7 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
         PredictionMode best_intra_mode = DC_PRED;
 
         TplSrcStats *tpl_src_stats_buffer =
-            &pcs->pa_me_data->tpl_src_stats_buffer[(mb_origin_y >> 4) * aligned16_width + (mb_origin_x >> 4)];
+            &pcs->pa_me_data->tpl_src_stats_buffer[(blk_origin_y >> 4) * aligned16_width + (blk_origin_x >> 4)];
 
         //perform src based path if not yet done in previous TPL groups
         if (pcs->tpl_src_data_ready == 0) {
@@ -610,7 +651,8 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
             int64_t best_inter_cost = INT64_MAX;
             int64_t best_intra_cost = INT64_MAX;
             if (!disable_intra_pred) {
-                if (scs->in_loop_ois == 0) {
+                // the OIS results are computed at full resolution
+                if (scs->in_loop_ois == 0 && !ds_shift) {
                     uint32_t      picture_width_in_mb = (pcs->enhanced_pic->width + size - 1) / size;
                     OisMbResults *ois_mb_results_ptr =
                         pcs->pa_me_data
@@ -627,8 +669,8 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                         uint8_t *above0_row = above0_data + MAX_TPL_SIZE;
                         uint8_t *left0_col  = left0_data + MAX_TPL_SIZE;
 
-                        const uint8_t mb_inside = (mb_origin_x + size <= pcs->enhanced_pic->width) &&
-                            (mb_origin_y + size <= pcs->enhanced_pic->height);
+                        const uint8_t mb_inside = (mb_origin_x + size <= input_pic->width) &&
+                            (mb_origin_y + size <= input_pic->height);
                         if (mb_origin_x > 0 && mb_origin_y > 0 && mb_inside)
 
                             get_neighbor_samples_dc(src_mb, src_stride, above0_row, left0_col, bsize);
@@ -650,7 +692,7 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                             DC_PRED,
                             mb_origin_x,
                             mb_origin_y,
-                            tx_size_array[dispenser_search_level], // use full block for prediction
+                            pred_tx_size, // use full block for prediction
                             above0_row,
                             left0_col,
                             predictor,
@@ -701,8 +743,8 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                                 left_col  = left_data + MAX_TPL_SIZE;
                                 filter_intra_edge(NULL,
                                                   ois_intra_mode,
-                                                  scs->max_input_luma_width,
-                                                  scs->max_input_luma_height,
+                                                  scs->max_input_luma_width >> ds_shift,
+                                                  scs->max_input_luma_height >> ds_shift,
                                                   p_angle,
                                                   (int32_t)mb_origin_x,
                                                   (int32_t)mb_origin_y,
@@ -718,7 +760,7 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                                 ois_intra_mode,
                                 mb_origin_x,
                                 mb_origin_y,
-                                tx_size_array[dispenser_search_level], // use full block for prediction
+                                pred_tx_size, // use full block for prediction
                                 above_row,
                                 left_col,
                                 predictor,
@@ -730,21 +772,20 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                                 intra_cost = svt_nxm_sad_kernel(
                                     src_mb, input_pic->stride_y, predictor, size, size, size);
                             } else {
-                                svt_aom_subtract_block(size >> tpl_ctrls->subsample_tx,
+                                svt_aom_subtract_block(size >> subsample_tx,
                                                        size,
                                                        src_diff,
-                                                       size << tpl_ctrls->subsample_tx,
+                                                       size << subsample_tx,
                                                        src_mb,
-                                                       input_pic->stride_y << tpl_ctrls->subsample_tx,
+                                                       input_pic->stride_y << subsample_tx,
                                                        predictor,
-                                                       size << tpl_ctrls->subsample_tx);
+                                                       size << subsample_tx);
 
-                                EB_TRANS_COEFF_SHAPE pf_shape = pcs->tpl_ctrls.pf_shape;
                                 svt_av1_wht_fwd_txfm(
-                                    src_diff, size << tpl_ctrls->subsample_tx, coeff, tx_size, pf_shape, 8, 0);
+                                    src_diff, size << subsample_tx, coeff, tx_size, pf_shape, 8, 0);
 
-                                intra_cost = svt_aom_satd(coeff, (size * size) >> tpl_ctrls->subsample_tx)
-                                    << tpl_ctrls->subsample_tx;
+                                intra_cost = svt_aom_satd(coeff, (size * size) >> subsample_tx)
+                                    << subsample_tx;
                             }
 
                             if (intra_cost < best_intra_cost) {
@@ -783,27 +824,30 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                 const uint32_t rf_idx    = svt_get_ref_frame_type(list_index, ref_pic_index) - 1;
                 const uint32_t me_offset = me_mb_offset * pcs->pa_me_data->max_refs +
                     (list_index ? pcs->pa_me_data->max_l0 : 0) + ref_pic_index;
-                x_curr_mv = (me_results->me_mv_array[me_offset].x_mv) << 3;
-                y_curr_mv = (me_results->me_mv_array[me_offset].y_mv) << 3;
+                // the full-pel ME MVs become subpel MVs on the downsampled pictures
+                x_curr_mv = ((me_results->me_mv_array[me_offset].x_mv) << 3) >> ds_shift;
+                y_curr_mv = ((me_results->me_mv_array[me_offset].y_mv) << 3) >> ds_shift;
 
-                ref_pic_ptr =
-                    (EbPictureBufferDesc *)pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_pic_index].picture_ptr;
+                ref_pic_ptr = tpl_get_ref_src_pic(&pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_pic_index],
+                                                  ds_shift);
 
-                if (((int)mb_origin_x + (x_curr_mv >> 3)) < -TPL_PADX)
-                    x_curr_mv = (-TPL_PADX - mb_origin_x) << 3;
+                const int pad_x = TPL_PADX >> ds_shift;
+                const int pad_y = TPL_PADY >> ds_shift;
+                if (((int)mb_origin_x + (x_curr_mv >> 3)) < -pad_x)
+                    x_curr_mv = (-pad_x - mb_origin_x) << 3;
 
-                if (((int)mb_origin_x + (int)bsize + (x_curr_mv >> 3)) > (TPL_PADX + (int)ref_pic_ptr->max_width - 1))
-                    x_curr_mv = ((TPL_PADX + ref_pic_ptr->max_width - 1) - (mb_origin_x + bsize)) << 3;
+                if (((int)mb_origin_x + (int)bsize + (x_curr_mv >> 3)) > (pad_x + (int)ref_pic_ptr->max_width - 1))
+                    x_curr_mv = ((pad_x + ref_pic_ptr->max_width - 1) - (mb_origin_x + bsize)) << 3;
 
-                if (((int)mb_origin_y + (y_curr_mv >> 3)) < -TPL_PADY)
-                    y_curr_mv = (-TPL_PADY - mb_origin_y) << 3;
+                if (((int)mb_origin_y + (y_curr_mv >> 3)) < -pad_y)
+                    y_curr_mv = (-pad_y - mb_origin_y) << 3;
 
-                if (((int)mb_origin_y + (int)bsize + (y_curr_mv >> 3)) > (TPL_PADY + (int)ref_pic_ptr->max_height - 1))
-                    y_curr_mv = ((TPL_PADY + ref_pic_ptr->max_height - 1) - (mb_origin_y + bsize)) << 3;
+                if (((int)mb_origin_y + (int)bsize + (y_curr_mv >> 3)) > (pad_y + (int)ref_pic_ptr->max_height - 1))
+                    y_curr_mv = ((pad_y + ref_pic_ptr->max_height - 1) - (mb_origin_y + bsize)) << 3;
 
                 MV best_mv = {y_curr_mv, x_curr_mv};
 
-                if (pcs->tpl_ctrls.subpel_depth != FULL_PEL) {
+                if (pcs->tpl_ctrls.subpel_depth != FULL_PEL && !ds_shift) {
                     tpl_subpel_search(scs, pcs, ref_pic_ptr, input_pic, &xd, mb_origin_x, mb_origin_y, bsize, &best_mv);
                 }
                 int32_t ref_origin_index = (int32_t)ref_pic_ptr->org_x + ((int32_t)mb_origin_x + (best_mv.col / 8)) +
@@ -857,19 +901,18 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                         size,
                         size);
                 } else {
-                    svt_aom_subtract_block(size >> tpl_ctrls->subsample_tx,
+                    svt_aom_subtract_block(size >> subsample_tx,
                                            size,
                                            src_diff,
-                                           size << tpl_ctrls->subsample_tx,
+                                           size << subsample_tx,
                                            src_mb,
-                                           input_pic->stride_y << tpl_ctrls->subsample_tx,
+                                           input_pic->stride_y << subsample_tx,
                                            subpel_mv ? compensated_blk : ref_pic_ptr->buffer_y + ref_origin_index,
-                                           (subpel_mv ? size : ref_pic_ptr->stride_y) << tpl_ctrls->subsample_tx);
-                    EB_TRANS_COEFF_SHAPE pf_shape = pcs->tpl_ctrls.pf_shape;
-                    svt_av1_wht_fwd_txfm(src_diff, size << tpl_ctrls->subsample_tx, coeff, tx_size, pf_shape, 8, 0);
+                                           (subpel_mv ? size : ref_pic_ptr->stride_y) << subsample_tx);
+                    svt_av1_wht_fwd_txfm(src_diff, size << subsample_tx, coeff, tx_size, pf_shape, 8, 0);
 
-                    inter_cost = svt_aom_satd(coeff, (size * size) >> tpl_ctrls->subsample_tx)
-                        << tpl_ctrls->subsample_tx;
+                    inter_cost = svt_aom_satd(coeff, (size * size) >> subsample_tx)
+                        << subsample_tx;
                 }
 
                 if (inter_cost < best_inter_cost) {
@@ -892,7 +935,8 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                 if (pcs->tpl_ctrls.use_sad_in_src_search) {
                     uint32_t list_index    = best_rf_idx < 4 ? 0 : 1;
                     uint32_t ref_pic_index = best_rf_idx >= 4 ? (best_rf_idx - 4) : best_rf_idx;
-                    ref_pic_ptr            = pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_pic_index].picture_ptr;
+                    ref_pic_ptr = tpl_get_ref_src_pic(&pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_pic_index],
+                                                      ds_shift);
                     int32_t ref_origin_index = (int32_t)ref_pic_ptr->org_x +
                         ((int32_t)mb_origin_x + (final_best_mv.col >> 3)) +
                         ((int32_t)mb_origin_y + (final_best_mv.row >> 3) + (int32_t)ref_pic_ptr->org_y) *
@@ -935,25 +979,24 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                             0); // is16bit
                     }
 
-                    svt_aom_subtract_block(size >> tpl_ctrls->subsample_tx,
+                    svt_aom_subtract_block(size >> subsample_tx,
                                            size,
                                            src_diff,
-                                           size << tpl_ctrls->subsample_tx,
+                                           size << subsample_tx,
                                            src_mb,
-                                           input_pic->stride_y << tpl_ctrls->subsample_tx,
+                                           input_pic->stride_y << subsample_tx,
                                            subpel_mv ? compensated_blk : ref_pic_ptr->buffer_y + ref_origin_index,
-                                           (subpel_mv ? size : ref_pic_ptr->stride_y) << tpl_ctrls->subsample_tx);
-                    EB_TRANS_COEFF_SHAPE pf_shape = pcs->tpl_ctrls.pf_shape;
+                                           (subpel_mv ? size : ref_pic_ptr->stride_y) << subsample_tx);
 
                     svt_av1_wht_fwd_txfm(
-                        src_diff, size << tpl_ctrls->subsample_tx, best_coeff, tx_size, pf_shape, 8, 0);
+                        src_diff, size << subsample_tx, best_coeff, tx_size, pf_shape, 8, 0);
                 }
 
                 get_quantize_error(&mb_plane, best_coeff, qcoeff, dqcoeff, tx_size, &eob, &recon_error, &sse);
 
                 int rate_cost        = pcs->tpl_ctrls.compute_rate ? rate_estimator(qcoeff, eob, tx_size) : 0;
-                tpl_stats.srcrf_rate = (rate_cost << TPL_DEP_COST_SCALE_LOG2) << tpl_ctrls->subsample_tx;
-                tpl_stats.srcrf_dist = (recon_error << (TPL_DEP_COST_SCALE_LOG2)) << tpl_ctrls->subsample_tx;
+                tpl_stats.srcrf_rate = (rate_cost << TPL_DEP_COST_SCALE_LOG2) << stats_shift;
+                tpl_stats.srcrf_dist = (recon_error << (TPL_DEP_COST_SCALE_LOG2)) << stats_shift;
             }
             if (scs->tpl_lad_mg > 0) {
                 //store src based stats
@@ -989,8 +1032,8 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                 assert(ref_frame_idx != MAX_TPL_LA_SW);
                 ref_pic_ptr = enc_ctx->mc_flow_rec_picture_buffer[ref_frame_idx];
             } else
-                ref_pic_ptr =
-                    (EbPictureBufferDesc *)pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_pic_index].picture_ptr;
+                ref_pic_ptr = tpl_get_ref_src_pic(&pcs->tpl_data.tpl_ref_ds_ptr_array[list_index][ref_pic_index],
+                                                  ds_shift);
 
             int32_t ref_origin_index = (int32_t)ref_pic_ptr->org_x + ((int32_t)mb_origin_x + (final_best_mv.col >> 3)) +
                 ((int32_t)mb_origin_y + (final_best_mv.row >> 3) + (int32_t)ref_pic_ptr->org_y) *
@@ -1052,8 +1095,8 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
             uint8_t *recon_buffer = recon_pic->buffer_y + dst_basic_offset;
 
             if (intra_dc_sad_path) {
-                const uint8_t mb_inside = (mb_origin_x + size <= pcs->enhanced_pic->width) &&
-                    (mb_origin_y + size <= pcs->enhanced_pic->height);
+                const uint8_t mb_inside = (mb_origin_x + size <= input_pic->width) &&
+                    (mb_origin_y + size <= input_pic->height);
                 if (mb_origin_x > 0 && mb_origin_y > 0 && mb_inside)
                     get_neighbor_samples_dc(recon_buffer + mb_origin_x + mb_origin_y * dst_buffer_stride,
                                             dst_buffer_stride,
@@ -1079,7 +1122,7 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                     DC_PRED,
                     mb_origin_x,
                     mb_origin_y,
-                    tx_size_array[dispenser_search_level], // use full block for prediction
+                    pred_tx_size, // use full block for prediction
                     above_row,
                     left_col,
                     dst_buffer,
@@ -1106,8 +1149,8 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                 if (av1_is_directional_mode((PredictionMode)ois_intra_mode)) {
                     filter_intra_edge(NULL,
                                       ois_intra_mode,
-                                      scs->max_input_luma_width,
-                                      scs->max_input_luma_height,
+                                      scs->max_input_luma_width >> ds_shift,
+                                      scs->max_input_luma_height >> ds_shift,
                                       p_angle,
                                       mb_origin_x,
                                       mb_origin_y,
@@ -1120,7 +1163,7 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                     ois_intra_mode,
                     mb_origin_x,
                     mb_origin_y,
-                    tx_size_array[dispenser_search_level], // use full block for prediction
+                    pred_tx_size, // use full block for prediction
                     above_row,
                     left_col,
                     dst_buffer,
@@ -1128,16 +1171,15 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
             }
         }
 
-        svt_aom_subtract_block(size >> tpl_ctrls->subsample_tx,
+        svt_aom_subtract_block(size >> subsample_tx,
                                size,
                                src_diff,
-                               size << tpl_ctrls->subsample_tx,
+                               size << subsample_tx,
                                src_mb,
-                               input_pic->stride_y << tpl_ctrls->subsample_tx,
+                               input_pic->stride_y << subsample_tx,
                                dst_buffer,
-                               dst_buffer_stride << tpl_ctrls->subsample_tx);
-        EB_TRANS_COEFF_SHAPE pf_shape = pcs->tpl_ctrls.pf_shape;
-        svt_av1_wht_fwd_txfm(src_diff, size << tpl_ctrls->subsample_tx, coeff, tx_size, pf_shape, 8, 0);
+                               dst_buffer_stride << subsample_tx);
+        svt_av1_wht_fwd_txfm(src_diff, size << subsample_tx, coeff, tx_size, pf_shape, 8, 0);
 
         uint16_t eob = 0;
 
@@ -1148,9 +1190,9 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
             if (eob) {
                 svt_aom_inv_transform_recon8bit((int32_t *)dqcoeff,
                                                 dst_buffer,
-                                                dst_buffer_stride << tpl_ctrls->subsample_tx,
+                                                dst_buffer_stride << subsample_tx,
                                                 dst_buffer,
-                                                dst_buffer_stride << tpl_ctrls->subsample_tx,
+                                                dst_buffer_stride << subsample_tx,
                                                 tx_size,
                                                 DCT_DCT,
                                                 PLANE_TYPE_Y,
@@ -1158,7 +1200,7 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                                                 0);
 
                 // If subsampling is used for the TX, need to populate the missing rows in recon with a copy of the neighbouring rows
-                if (tpl_ctrls->subsample_tx == 2) {
+                if (subsample_tx == 2) {
                     for (int i = 0; i < (int)size; i += 4) {
                         EB_MEMCPY(dst_buffer + (i + 1) * dst_buffer_stride,
                                   dst_buffer + i * dst_buffer_stride,
@@ -1170,7 +1212,7 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
                                   dst_buffer + i * dst_buffer_stride,
                                   sizeof(uint8_t) * (size));
                     }
-                } else if (tpl_ctrls->subsample_tx == 1) {
+                } else if (subsample_tx == 1) {
                     for (int i = 0; i < (int)size; i += 2) {
                         EB_MEMCPY(dst_buffer + (i + 1) * dst_buffer_stride,
                                   dst_buffer + i * dst_buffer_stride,
@@ -1180,22 +1222,23 @@ static void tpl_mc_flow_dispenser_sb_generic(EncodeContext *enc_ctx, SequenceCon
             }
         }
 
-        tpl_stats.recrf_dist = (recon_error << (TPL_DEP_COST_SCALE_LOG2)) << tpl_ctrls->subsample_tx;
-        tpl_stats.recrf_rate = (rate_cost << TPL_DEP_COST_SCALE_LOG2) << tpl_ctrls->subsample_tx;
+        tpl_stats.recrf_dist = (recon_error << (TPL_DEP_COST_SCALE_LOG2)) << stats_shift;
+        tpl_stats.recrf_rate = (rate_cost << TPL_DEP_COST_SCALE_LOG2) << stats_shift;
         if (best_mode != NEWMV) {
-            tpl_stats.srcrf_dist = (recon_error << (TPL_DEP_COST_SCALE_LOG2)) << tpl_ctrls->subsample_tx;
-            tpl_stats.srcrf_rate = (rate_cost << TPL_DEP_COST_SCALE_LOG2) << tpl_ctrls->subsample_tx;
+            tpl_stats.srcrf_dist = (recon_error << (TPL_DEP_COST_SCALE_LOG2)) << stats_shift;
+            tpl_stats.srcrf_rate = (rate_cost << TPL_DEP_COST_SCALE_LOG2) << stats_shift;
         }
 
         tpl_stats.recrf_dist = AOMMAX(tpl_stats.srcrf_dist, tpl_stats.recrf_dist);
         tpl_stats.recrf_rate = AOMMAX(tpl_stats.srcrf_rate, tpl_stats.recrf_rate);
         if (pcs->tpl_data.tpl_slice_type != I_SLICE && best_rf_idx != -1) {
-            tpl_stats.mv            = final_best_mv;
+            tpl_stats.mv.row        = final_best_mv.row * (1 << ds_shift);
+            tpl_stats.mv.col        = final_best_mv.col * (1 << ds_shift);
             tpl_stats.ref_frame_poc = best_ref_poc;
         }
 
         // Motion flow dependency dispenser.
-        result_model_store(pcs, &tpl_stats, mb_origin_x, mb_origin_y, size);
+        result_model_store(pcs, &tpl_stats, blk_origin_x, blk_origin_y, blk_stats_ptr->size);
     }
 }
 
@@ -1397,11 +1440,11 @@ static void tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *sc
         }
     }
 
-    // padding current recon picture
+    // padding current recon picture (written at the dispenser resolution)
     svt_aom_generate_padding(recon_pic->buffer_y,
                              recon_pic->stride_y,
-                             recon_pic->width,
-                             recon_pic->height,
+                             recon_pic->width >> pcs->tpl_ctrls.ds_shift,
+                             recon_pic->height >> pcs->tpl_ctrls.ds_shift,
                              recon_pic->org_x,
                              recon_pic->org_y);
 
@@ -1770,12 +1813,28 @@ static void init_tpl_segments(SequenceControlSet *scs, PictureParentControlSet *
         }
     }
 }
-typedef struct TplRefList {
-    EbObjectWrapper *ref;
-    int32_t          frame_idx;
-    uint8_t          refresh_frame_mask;
-    bool             is_valid;
-} TplRefList;
+/************************************************
+ * Incremental TPL: return the number of leading frames of the tpl group that were the last
+ * frames of the previous tpl group, with the same tpl validity. The dispenser is not run again
+ * for these frames: their stats are restored, and the tpl recon references left by the
+ * previous group are used by the next frames.
+ ************************************************/
+static int32_t tpl_get_reused_frames(SourceBasedOperationsContext *context_ptr, PictureParentControlSet *pcs,
+                                     int32_t frames_in_sw) {
+    int32_t first_idx = 0;
+    while (first_idx < context_ptr->tpl_prev_frames &&
+           context_ptr->tpl_prev_poc[first_idx] != pcs->tpl_group[0]->picture_number)
+        first_idx++;
+    const int32_t reused_frames = context_ptr->tpl_prev_frames - first_idx;
+    if (reused_frames > frames_in_sw)
+        return 0;
+    for (int32_t frame_idx = 0; frame_idx < reused_frames; frame_idx++) {
+        if (pcs->tpl_group[frame_idx]->picture_number != context_ptr->tpl_prev_poc[first_idx + frame_idx] ||
+            pcs->tpl_valid_pic[frame_idx] != context_ptr->tpl_prev_valid[first_idx + frame_idx])
+            return 0;
+    }
+    return reused_frames;
+}
 
 /************************************************
  * Genrate TPL MC Flow Based on frames in the tpl group
@@ -1801,16 +1860,48 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
     TplRefList tpl_ref_list[REF_FRAMES + 1]; // Buffer for each ref pic and current pic
     memset(tpl_ref_list, 0, sizeof(tpl_ref_list[0]) * (REF_FRAMES + 1));
 
+    const Bool     incremental_tpl = scs->static_config.incremental_tpl && scs->tpl_lad_mg > 0;
+    const uint32_t tpl_stats_count = picture_width_in_mb * picture_height_in_mb;
     if (pcs->tpl_group[0]->tpl_data.tpl_temporal_layer_index == 0) {
         // no Tiles path
         if (scs->static_config.tile_rows == 0 && scs->static_config.tile_columns == 0)
             init_tpl_segments(scs, pcs, pcs->tpl_group, frames_in_sw);
 
+        int32_t reused_frames = 0;
+        if (incremental_tpl) {
+            reused_frames           = tpl_get_reused_frames(context_ptr, pcs, frames_in_sw);
+            const int32_t first_idx = context_ptr->tpl_prev_frames - reused_frames;
+            // Take over the references of the reused frames, release the ones that left the window
+            for (int i = 0; i < (REF_FRAMES + 1); i++) {
+                TplRefList *prev_ref = &context_ptr->tpl_ref_list[i];
+                if (!prev_ref->is_valid)
+                    continue;
+                if (reused_frames && prev_ref->frame_idx >= first_idx) {
+                    tpl_ref_list[i] = *prev_ref;
+                    tpl_ref_list[i].frame_idx -= first_idx;
+                    enc_ctx->mc_flow_rec_picture_buffer[tpl_ref_list[i].frame_idx] =
+                        ((EbTplReferenceObject *)prev_ref->ref->object_ptr)->ref_picture_ptr;
+                } else
+                    svt_release_object(prev_ref->ref);
+            }
+            memset(context_ptr->tpl_ref_list, 0, sizeof(context_ptr->tpl_ref_list));
+        }
+
         uint8_t tpl_on;
         enc_ctx->poc_map_idx[0] = pcs->tpl_group[0]->picture_number;
         //TPL main frame loop
         for (int32_t frame_idx = 0; frame_idx < frames_in_sw; frame_idx++) {
             enc_ctx->poc_map_idx[frame_idx] = pcs->tpl_group[frame_idx]->picture_number;
+            if (frame_idx < reused_frames) {
+                // Dispenser stats and recon from the previous tpl group
+                MotionEstimationData *pa_me_data = pcs->tpl_group[frame_idx]->pa_me_data;
+                if (pcs->tpl_valid_pic[frame_idx])
+                    svt_memcpy(
+                        pa_me_data->tpl_stats[0], pa_me_data->tpl_disp_stats_buffer, tpl_stats_count * sizeof(TplStats));
+                else
+                    memset(pa_me_data->tpl_stats[0], 0, tpl_stats_count * sizeof(TplStats));
+                continue;
+            }
             // NREF need recon buffer for intra pred
             EbObjectWrapper *ref_pic_wrapper;
             // Get Empty Reference Picture Object
@@ -1844,13 +1935,19 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
                        (picture_width_in_mb) * sizeof(TplStats));
             }
             tpl_on = pcs->tpl_valid_pic[frame_idx];
-            if (tpl_on)
+            if (tpl_on) {
                 tpl_mc_flow_dispenser(enc_ctx,
                                       scs,
                                       &pcs->tpl_group[frame_idx]->pa_me_data->base_rdmult,
                                       pcs->tpl_group[frame_idx],
                                       frame_idx,
                                       context_ptr);
+                // keep the dispenser stats for the next tpl group, the synthesizer updates them
+                if (incremental_tpl)
+                    svt_memcpy(pcs->tpl_group[frame_idx]->pa_me_data->tpl_disp_stats_buffer,
+                               pcs->tpl_group[frame_idx]->pa_me_data->tpl_stats[0],
+                               tpl_stats_count * sizeof(TplStats));
+            }
 
             if (scs->tpl_lad_mg > 0)
                 if (tpl_on)
@@ -1922,6 +2019,16 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
 #else
     }
 #endif
+    if (incremental_tpl && pcs->tpl_group[0]->tpl_data.tpl_temporal_layer_index == 0) {
+        // Keep the tpl references in use for the next tpl group
+        memcpy(context_ptr->tpl_ref_list, tpl_ref_list, sizeof(tpl_ref_list));
+        memset(tpl_ref_list, 0, sizeof(tpl_ref_list));
+        for (int32_t frame_idx = 0; frame_idx < frames_in_sw; frame_idx++) {
+            context_ptr->tpl_prev_poc[frame_idx]   = pcs->tpl_group[frame_idx]->picture_number;
+            context_ptr->tpl_prev_valid[frame_idx] = pcs->tpl_valid_pic[frame_idx];
+        }
+        context_ptr->tpl_prev_frames = frames_in_sw;
+    }
     // Release un-released tpl references
     for (int i = 0; i < (REF_FRAMES + 1); i++) {
         // Get empty list entry
@@ -1976,6 +2083,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
         SequenceControlSet *scs = (SequenceControlSet *)pcs->scs;
 
         int32_t frame_idx           = in_results_ptr->frame_index;
+        svt_trace_picture(pcs->picture_number, in_results_ptr->enc_dec_segment_row);
         context_ptr->coded_sb_count = 0;
 
         uint16_t tile_group_width_in_sb = pcs->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
@@ -2055,6 +2163,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
                 }
             }
 
+            svt_trace_sb_count(context_ptr->coded_sb_count);
             svt_block_on_mutex(pcs->tpl_disp_mutex);
             pcs->tpl_disp_coded_sb_count += (uint32_t)context_ptr->coded_sb_count;
             Bool last_sb_flag = (pcs->b64_total_count == pcs->tpl_disp_coded_sb_count);
@@ -2220,6 +2329,7 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
         InitialRateControlResults *in_results_ptr = (InitialRateControlResults *)in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet   *pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
         SequenceControlSet        *scs            = pcs->scs;
+        svt_trace_picture(pcs->picture_number, -1);
         if (in_results_ptr->superres_recode) {
             sbo_send_picture_out(context_ptr, pcs, TRUE);
 
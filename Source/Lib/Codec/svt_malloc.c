@@ -20,8 +20,6 @@ void svt_print_alloc_fail_impl(const char* file, int line) {
     SVT_FATAL("allocate memory failed, at %s:%d\n", file, line);
 }
 
-#ifdef DEBUG_MEMORY_USAGE
-
 static EbHandle g_malloc_mutex;
 
 static void malloc_mutex_cleanup(void) { svt_destroy_mutex(g_malloc_mutex); }
@@ -66,6 +64,203 @@ static inline uint32_t hash(const void* const p) {
     return (uint32_t)((v >> (sizeof(v) / 2 * CHAR_BIT)) + (v & bit_mask));
 }
 
+/*********************************************************************************
+* Host allocator routing
+*
+* Blocks handed out by a host allocator are kept in a registry so EB_FREE and
+* EB_REALLOC_ARRAY can give them back to their owner. Lookups are skipped
+* entirely while no encoder instance uses a host allocator.
+*********************************************************************************/
+typedef struct ExtAllocEntry {
+    struct ExtAllocEntry*  next;
+    void*                  ptr;
+    const SvtAv1Allocator* allocator;
+    size_t                 size;
+    SvtAv1AllocTag         tag;
+} ExtAllocEntry;
+
+#define EXT_ALLOC_BUCKET_COUNT (1 << 16)
+// blocks are at least 16 byte aligned, drop the always zero bits
+#define EXT_ALLOC_BUCKET(p) (g_ext_alloc_bucket + (hash(p) >> 4) % EXT_ALLOC_BUCKET_COUNT)
+
+static ExtAllocEntry**   g_ext_alloc_bucket;
+static uint32_t          g_ext_alloc_count;
+static volatile uint32_t g_ext_alloc_users;
+
+static SVT_THREAD_LOCAL const SvtAv1Allocator* g_alloc_scope;
+static SVT_THREAD_LOCAL SvtAv1AllocTag         g_alloc_scope_tag;
+static SVT_THREAD_LOCAL EbMemUsage*            g_alloc_scope_usage;
+
+void svt_set_alloc_scope(const SvtAv1Allocator* allocator, SvtAv1AllocTag tag, EbMemUsage* usage) {
+    g_alloc_scope       = allocator;
+    g_alloc_scope_tag   = tag;
+    g_alloc_scope_usage = usage;
+}
+
+SvtAv1AllocTag svt_set_alloc_tag(SvtAv1AllocTag tag) {
+    const SvtAv1AllocTag prev = g_alloc_scope_tag;
+    g_alloc_scope_tag         = tag;
+    return prev;
+}
+
+void svt_account_mem(EbPtrType type, size_t count) {
+    EbMemUsage* usage = g_alloc_scope_usage;
+    if (!usage)
+        return;
+    usage->by_type[type] += count;
+    if (type == EB_N_PTR || type == EB_C_PTR || type == EB_A_PTR)
+        usage->heap_by_tag[g_alloc_scope_tag] += count;
+}
+
+void svt_register_alloc_user(void) {
+    EbHandle m = get_malloc_mutex();
+    svt_block_on_mutex(m);
+    if (!g_ext_alloc_bucket)
+        g_ext_alloc_bucket = calloc(EXT_ALLOC_BUCKET_COUNT, sizeof(*g_ext_alloc_bucket));
+    if (g_ext_alloc_bucket)
+        svt_atomic_fetch_add_u32(&g_ext_alloc_users, 1);
+    svt_release_mutex(m);
+}
+
+void svt_unregister_alloc_user(void) {
+    EbHandle m = get_malloc_mutex();
+    svt_block_on_mutex(m);
+    if (svt_atomic_fetch_sub_u32(&g_ext_alloc_users, 1) == 1 && !g_ext_alloc_count) {
+        free(g_ext_alloc_bucket);
+        g_ext_alloc_bucket = NULL;
+    }
+    svt_release_mutex(m);
+}
+
+static SvtAv1AllocSizeClass get_size_class(size_t size) {
+    if (size < ((size_t)4 << 10))
+        return SVT_AV1_ALLOC_SIZE_SMALL;
+    if (size < ((size_t)2 << 20))
+        return SVT_AV1_ALLOC_SIZE_MEDIUM;
+    return SVT_AV1_ALLOC_SIZE_LARGE;
+}
+
+static void* ext_alloc(const SvtAv1Allocator* allocator, SvtAv1AllocTag tag, size_t size, size_t alignment) {
+    const SvtAv1AllocSizeClass size_class = get_size_class(size);
+    ExtAllocEntry*             e          = malloc(sizeof(*e));
+    if (!e)
+        return NULL;
+    void* ptr = alignment ? allocator->aligned_alloc(allocator->opaque, size, alignment, size_class, tag)
+                          : allocator->alloc(allocator->opaque, size, size_class, tag);
+    if (!ptr || !g_ext_alloc_bucket) {
+        // no registry without a registered user, the block could not be given back
+        if (ptr)
+            allocator->free(allocator->opaque, ptr, tag);
+        free(e);
+        return NULL;
+    }
+    e->ptr       = ptr;
+    e->allocator = allocator;
+    e->size      = size;
+    e->tag       = tag;
+
+    EbHandle m = get_malloc_mutex();
+    svt_block_on_mutex(m);
+    ExtAllocEntry** bucket = EXT_ALLOC_BUCKET(ptr);
+    e->next                = *bucket;
+    *bucket                = e;
+    g_ext_alloc_count++;
+    svt_release_mutex(m);
+    return ptr;
+}
+
+// Finds the registry entry of ptr, and unlinks it when remove is set
+static ExtAllocEntry* ext_alloc_find(void* ptr, Bool remove, ExtAllocEntry* copy) {
+    if (!ptr || !svt_atomic_load_u32(&g_ext_alloc_users))
+        return NULL;
+    ExtAllocEntry* e = NULL;
+    EbHandle       m = get_malloc_mutex();
+    svt_block_on_mutex(m);
+    if (g_ext_alloc_bucket) {
+        ExtAllocEntry** link = EXT_ALLOC_BUCKET(ptr);
+        while (*link && (*link)->ptr != ptr) link = &(*link)->next;
+        e = *link;
+        if (e && copy)
+            *copy = *e;
+        if (e && remove) {
+            *link = e->next;
+            g_ext_alloc_count--;
+        }
+    }
+    svt_release_mutex(m);
+    return e;
+}
+
+// Gives ptr back to its host allocator, returns FALSE if it did not come from one
+static Bool ext_free(void* ptr) {
+    ExtAllocEntry* e = ext_alloc_find(ptr, TRUE, NULL);
+    if (!e)
+        return FALSE;
+    e->allocator->free(e->allocator->opaque, ptr, e->tag);
+    free(e);
+    return TRUE;
+}
+
+void* svt_mem_malloc(size_t size) {
+    if (g_alloc_scope)
+        return ext_alloc(g_alloc_scope, g_alloc_scope_tag, size, 0);
+    return malloc(size);
+}
+
+void* svt_mem_calloc(size_t count, size_t size) {
+    if (g_alloc_scope) {
+        void* ptr = ext_alloc(g_alloc_scope, g_alloc_scope_tag, count * size, 0);
+        if (ptr)
+            memset(ptr, 0, count * size);
+        return ptr;
+    }
+    return calloc(count, size);
+}
+
+void* svt_mem_realloc(void* ptr, size_t size) {
+    ExtAllocEntry entry;
+    if (ext_alloc_find(ptr, FALSE, &entry)) {
+        // keep the block with its owner, host allocators have no realloc
+        void* new_ptr = ext_alloc(entry.allocator, entry.tag, size, 0);
+        if (new_ptr) {
+            EB_MEMCPY(new_ptr, ptr, entry.size < size ? entry.size : size);
+            ext_free(ptr);
+        }
+        return new_ptr;
+    }
+    if (!ptr)
+        return svt_mem_malloc(size);
+    return realloc(ptr, size);
+}
+
+void svt_mem_free(void* ptr) {
+    if (!ext_free(ptr))
+        free(ptr);
+}
+
+void* svt_mem_aligned_malloc(size_t size) {
+    if (g_alloc_scope)
+        return ext_alloc(g_alloc_scope, g_alloc_scope_tag, size, ALVALUE);
+#ifdef _WIN32
+    return _aligned_malloc(size, ALVALUE);
+#else
+    void* ptr;
+    return posix_memalign(&ptr, ALVALUE, size) ? NULL : ptr;
+#endif
+}
+
+void svt_mem_aligned_free(void* ptr) {
+    if (ext_free(ptr))
+        return;
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+#ifdef DEBUG_MEMORY_USAGE
+
 typedef struct MemoryEntry {
     void*       ptr;
     size_t      count;
@@ -27,6 +27,34 @@
 #endif
 void svt_print_alloc_fail_impl(const char* file, int line);
 
+// Allocation entry points of the EB_* macros. Blocks allocated while an allocation scope is
+// set on the calling thread come from the host allocator of that scope, everything else from
+// the C runtime. Frees and reallocs find the owner of a block on their own.
+void* svt_mem_malloc(size_t size);
+void* svt_mem_calloc(size_t count, size_t size);
+void* svt_mem_realloc(void* ptr, size_t size);
+void  svt_mem_free(void* ptr);
+void* svt_mem_aligned_malloc(size_t size);
+void  svt_mem_aligned_free(void* ptr);
+
+// What was allocated under an allocation scope: bytes for heap blocks, handles for
+// mutexes, semaphores and threads. Only touched by the thread owning the scope.
+typedef struct EbMemUsage {
+    uint64_t by_type[EB_PTR_TYPE_TOTAL];
+    uint64_t heap_by_tag[SVT_AV1_ALLOC_TAG_COUNT];
+} EbMemUsage;
+
+// Routes the EB_* allocations of the calling thread to allocator with tag, NULL restores the C runtime,
+// and adds them to usage when not NULL.
+// allocator must stay valid until every block allocated through it has been freed.
+void svt_set_alloc_scope(const SvtAv1Allocator* allocator, SvtAv1AllocTag tag, EbMemUsage* usage);
+// Changes the tag of the current scope, returns the previous one
+SvtAv1AllocTag svt_set_alloc_tag(SvtAv1AllocTag tag);
+void           svt_account_mem(EbPtrType type, size_t count);
+// Encoder instances using a host allocator, frees only look blocks up while there is one
+void svt_register_alloc_user(void);
+void svt_unregister_alloc_user(void);
+
 #ifdef DEBUG_MEMORY_USAGE
 void svt_print_memory_usage(void);
 void svt_increase_component_count(void);
@@ -66,8 +94,10 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
     do {                                              \
         if (!p)                                       \
             svt_print_alloc_fail(__FILE__, __LINE__); \
-        else                                          \
+        else {                                        \
+            svt_account_mem(type, size);              \
             EB_ADD_MEM_ENTRY(p, type, size);          \
+        }                                             \
     } while (0)
 
 #define EB_CHECK_MEM(p)                           \
@@ -84,7 +114,7 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_NO_THROW_MALLOC(pointer, size)                \
     do {                                                 \
-        void* malloced_p = malloc(size);                 \
+        void* malloced_p = svt_mem_malloc(size);         \
         EB_NO_THROW_ADD_MEM(malloced_p, size, EB_N_PTR); \
         pointer = malloced_p;                            \
     } while (0)
@@ -97,7 +127,7 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_NO_THROW_CALLOC(pointer, count, size)             \
     do {                                                     \
-        pointer = calloc(count, size);                       \
+        pointer = svt_mem_calloc(count, size);               \
         EB_NO_THROW_ADD_MEM(pointer, count* size, EB_C_PTR); \
     } while (0)
 
@@ -110,22 +140,22 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 #define EB_FREE(pointer)                        \
     do {                                        \
         EB_REMOVE_MEM_ENTRY(pointer, EB_N_PTR); \
-        free(pointer);                          \
+        svt_mem_free(pointer);                  \
         pointer = NULL;                         \
     } while (0)
 
 #define EB_MALLOC_ARRAY(pa, count) \
     do { EB_MALLOC(pa, sizeof(*(pa)) * (count)); } while (0)
 
-#define EB_REALLOC_ARRAY(pa, count)            \
-    do {                                       \
-        size_t size = sizeof(*(pa)) * (count); \
-        void*  p    = realloc(pa, size);       \
-        if (p) {                               \
-            EB_REMOVE_MEM_ENTRY(pa, EB_N_PTR); \
-        }                                      \
-        EB_ADD_MEM(p, size, EB_N_PTR);         \
-        pa = p;                                \
+#define EB_REALLOC_ARRAY(pa, count)              \
+    do {                                         \
+        size_t size = sizeof(*(pa)) * (count);   \
+        void*  p    = svt_mem_realloc(pa, size); \
+        if (p) {                                 \
+            EB_REMOVE_MEM_ENTRY(pa, EB_N_PTR);   \
+        }                                        \
+        EB_ADD_MEM(p, size, EB_N_PTR);           \
+        pa = p;                                  \
     } while (0)
 
 #define EB_CALLOC_ARRAY(pa, count) \
@@ -165,34 +195,18 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
         EB_FREE_ARRAY(p2d);        \
     } while (0)
 
-#ifdef _WIN32
-#define EB_MALLOC_ALIGNED(pointer, size)          \
-    do {                                          \
-        pointer = _aligned_malloc(size, ALVALUE); \
-        EB_ADD_MEM(pointer, size, EB_A_PTR);      \
-    } while (0)
-
-#define EB_FREE_ALIGNED(pointer)                \
+#define EB_MALLOC_ALIGNED(pointer, size)        \
     do {                                        \
-        EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR); \
-        _aligned_free(pointer);                 \
-        pointer = NULL;                         \
-    } while (0)
-#else
-#define EB_MALLOC_ALIGNED(pointer, size)                            \
-    do {                                                            \
-        if (posix_memalign((void**)&(pointer), ALVALUE, size) != 0) \
-            return EB_ErrorInsufficientResources;                   \
-        EB_ADD_MEM(pointer, size, EB_A_PTR);                        \
+        pointer = svt_mem_aligned_malloc(size); \
+        EB_ADD_MEM(pointer, size, EB_A_PTR);    \
     } while (0)
 
 #define EB_FREE_ALIGNED(pointer)                \
     do {                                        \
         EB_REMOVE_MEM_ENTRY(pointer, EB_A_PTR); \
-        free(pointer);                          \
+        svt_mem_aligned_free(pointer);          \
         pointer = NULL;                         \
     } while (0)
-#endif
 
 #define EB_MALLOC_ALIGNED_ARRAY(pa, count) EB_MALLOC_ALIGNED(pa, sizeof(*(pa)) * (count))
 
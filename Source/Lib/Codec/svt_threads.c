@@ -48,6 +48,89 @@
 #ifdef __APPLE__
 #include <dispatch/dispatch.h>
 #endif
+
+// Worker pool channel the current thread belongs to, and whether it currently owns one of its slots
+static SVT_THREAD_LOCAL EbWorkerChannel *svt_thread_channel;
+static SVT_THREAD_LOCAL Bool             svt_thread_holds_slot;
+// Worker pool channel joined by the threads the current thread creates
+static SVT_THREAD_LOCAL EbWorkerChannel *svt_thread_creation_channel;
+
+static EbErrorType svt_semaphore_wait(EbHandle semaphore_handle);
+static Bool        svt_semaphore_try_wait(EbHandle semaphore_handle);
+
+/*
+    take a free slot if there is one, otherwise queue up on the channel and
+    sleep until svt_worker_pool_release_slot hands one over
+*/
+static void svt_worker_pool_acquire_slot(void) {
+    EbWorkerChannel *channel = svt_thread_channel;
+    if (channel == NULL || svt_thread_holds_slot)
+        return;
+    EbWorkerPool *pool = channel->pool;
+
+    svt_block_on_mutex(pool->lock);
+    if (pool->free_slots) {
+        pool->free_slots--;
+        channel->held_slots++;
+        svt_release_mutex(pool->lock);
+    } else {
+        channel->waiting_threads++;
+        svt_release_mutex(pool->lock);
+        svt_semaphore_wait(channel->grant_semaphore);
+    }
+    svt_thread_holds_slot = TRUE;
+}
+
+/*
+    give the slot back; when threads are queued, it goes to the waiting channel
+    holding the fewest slots, ties going to the channel served least recently
+*/
+static void svt_worker_pool_release_slot(void) {
+    if (!svt_thread_holds_slot)
+        return;
+    svt_thread_holds_slot    = FALSE;
+    EbWorkerChannel *channel = svt_thread_channel;
+    EbWorkerPool    *pool    = channel->pool;
+
+    svt_block_on_mutex(pool->lock);
+    channel->held_slots--;
+    EbWorkerChannel **best_link = NULL;
+    for (EbWorkerChannel **link = &pool->channel_list; *link; link = &(*link)->next) {
+        if ((*link)->waiting_threads && (best_link == NULL || (*link)->held_slots < (*best_link)->held_slots))
+            best_link = link;
+    }
+    if (best_link) {
+        EbWorkerChannel *grantee = *best_link;
+        grantee->waiting_threads--;
+        grantee->held_slots++;
+        // Move the grantee to the back of the list so equal channels take turns
+        *best_link = grantee->next;
+        grantee->next = NULL;
+        EbWorkerChannel **tail = &pool->channel_list;
+        while (*tail) tail = &(*tail)->next;
+        *tail = grantee;
+        svt_post_semaphore(grantee->grant_semaphore);
+    } else
+        pool->free_slots++;
+    svt_release_mutex(pool->lock);
+}
+
+typedef struct WorkerPoolThreadArgs {
+    void *(*thread_function)(void *);
+    void            *thread_context;
+    EbWorkerChannel *channel;
+} WorkerPoolThreadArgs;
+
+static void *svt_worker_pool_thread_entry(void *p) {
+    WorkerPoolThreadArgs args = *(WorkerPoolThreadArgs *)p;
+    free(p);
+
+    svt_thread_channel = args.channel;
+    svt_worker_pool_acquire_slot();
+    void *ret = args.thread_function(args.thread_context);
+    svt_worker_pool_release_slot();
+    return ret;
+}
 #if PRINTF_TIME
 #include <time.h>
 #ifdef _WIN32
@@ -120,6 +203,21 @@ end:
 EbHandle svt_create_thread(void *thread_function(void *), void *thread_context) {
     EbHandle thread_handle = NULL;
 
+    WorkerPoolThreadArgs *pool_args = NULL;
+    if (svt_thread_creation_channel) {
+        // Route the thread through svt_worker_pool_thread_entry so it runs under the pool
+        pool_args = (WorkerPoolThreadArgs *)malloc(sizeof(*pool_args));
+        if (pool_args == NULL) {
+            SVT_ERROR("Failed to allocate thread arguments\n");
+            return NULL;
+        }
+        pool_args->thread_function = thread_function;
+        pool_args->thread_context  = thread_context;
+        pool_args->channel         = svt_thread_creation_channel;
+        thread_function            = svt_worker_pool_thread_entry;
+        thread_context             = pool_args;
+    }
+
 #ifdef _WIN32
 
     thread_handle = (EbHandle)CreateThread(
@@ -129,16 +227,20 @@ EbHandle svt_create_thread(void *thread_function(void *), void *thread_context)
         thread_context, // context to be tied to the new thread
         0, // thread active when created
         NULL); // new thread ID
+    if (thread_handle == NULL)
+        free(pool_args);
 
 #else
     if (pthread_once(&checked_once, check_set_prio)) {
         SVT_ERROR("Failed to run pthread_once to check if we can set priority\n");
+        free(pool_args);
         return NULL;
     }
 
     pthread_attr_t attr;
     if (pthread_attr_init(&attr)) {
         SVT_ERROR("Failed to initalize thread attributes\n");
+        free(pool_args);
         return NULL;
     }
 
@@ -159,6 +261,7 @@ EbHandle svt_create_thread(void *thread_function(void *), void *thread_context)
     if (th == NULL) {
         SVT_ERROR("Failed to allocate thread handle\n");
         pthread_attr_destroy(&attr);
+        free(pool_args);
         return NULL;
     }
 
@@ -167,6 +270,7 @@ EbHandle svt_create_thread(void *thread_function(void *), void *thread_context)
         SVT_ERROR("Failed to create thread: %s\n", strerror(ret));
         free(th);
         pthread_attr_destroy(&attr);
+        free(pool_args);
         return NULL;
     }
 
@@ -291,12 +395,46 @@ EbErrorType svt_post_semaphore(EbHandle semaphore_handle) {
     return return_error;
 }
 
+/***************************************
+ * svt_semaphore_try_wait
+ ***************************************/
+static Bool svt_semaphore_try_wait(EbHandle semaphore_handle) {
+#ifdef _WIN32
+    return WaitForSingleObject((HANDLE)semaphore_handle, 0) == WAIT_OBJECT_0;
+#elif defined(__APPLE__)
+    return dispatch_semaphore_wait((dispatch_semaphore_t)semaphore_handle, DISPATCH_TIME_NOW) == 0;
+#else
+    int ret;
+    do { ret = sem_trywait((sem_t *)semaphore_handle); } while (ret == -1 && errno == EINTR);
+    return ret == 0;
+#endif
+}
+
 /***************************************
  * svt_block_on_semaphore
  ***************************************/
 EbErrorType svt_block_on_semaphore(EbHandle semaphore_handle) {
     EbErrorType return_error;
 
+    if (!svt_thread_holds_slot)
+        return svt_semaphore_wait(semaphore_handle);
+    if (svt_semaphore_try_wait(semaphore_handle))
+        return EB_ErrorNone;
+
+    // Give the worker pool slot to another thread while blocked
+    svt_worker_pool_release_slot();
+    return_error = svt_semaphore_wait(semaphore_handle);
+    svt_worker_pool_acquire_slot();
+
+    return return_error;
+}
+
+/***************************************
+ * svt_semaphore_wait
+ ***************************************/
+static EbErrorType svt_semaphore_wait(EbHandle semaphore_handle) {
+    EbErrorType return_error;
+
 #ifdef _WIN32
     return_error = WaitForSingleObject((HANDLE)semaphore_handle, INFINITE) ? EB_ErrorSemaphoreUnresponsive
                                                                            : EB_ErrorNone;
@@ -376,12 +514,29 @@ EbErrorType svt_release_mutex(EbHandle mutex_handle) {
 EbErrorType svt_block_on_mutex(EbHandle mutex_handle) {
     EbErrorType return_error;
 
+    Bool released_slot = FALSE;
+    if (svt_thread_holds_slot) {
+#ifdef _WIN32
+        const Bool locked = WaitForSingleObject((HANDLE)mutex_handle, 0) == WAIT_OBJECT_0;
+#else
+        const Bool locked = pthread_mutex_trylock((pthread_mutex_t *)mutex_handle) == 0;
+#endif
+        if (locked)
+            return EB_ErrorNone;
+        // Contended: the owner may itself be waiting for a worker pool slot
+        svt_worker_pool_release_slot();
+        released_slot = TRUE;
+    }
+
 #ifdef _WIN32
     return_error = WaitForSingleObject((HANDLE)mutex_handle, INFINITE) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
 #else
     return_error = pthread_mutex_lock((pthread_mutex_t *)mutex_handle) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
 #endif
 
+    if (released_slot)
+        svt_worker_pool_acquire_slot();
+
     return return_error;
 }
 
@@ -459,6 +614,9 @@ EbErrorType svt_set_cond_var(CondVar *cond_var, int32_t newval) {
 EbErrorType svt_wait_cond_var(CondVar *cond_var, int32_t input) {
     EbErrorType return_error;
 
+    const Bool released_slot = svt_thread_holds_slot;
+    svt_worker_pool_release_slot();
+
 #ifdef _WIN32
 
     EnterCriticalSection(&cond_var->cs);
@@ -470,5 +628,55 @@ EbErrorType svt_wait_cond_var(CondVar *cond_var, int32_t input) {
     while (cond_var->val == input) return_error = pthread_cond_wait(&cond_var->m_cond, &cond_var->m_mutex);
     return_error = pthread_mutex_unlock(&cond_var->m_mutex);
 #endif
+    if (released_slot)
+        svt_worker_pool_acquire_slot();
     return return_error;
 }
+
+static void svt_worker_pool_dctor(EbPtr p) {
+    EbWorkerPool *obj = (EbWorkerPool *)p;
+    EB_DESTROY_MUTEX(obj->lock);
+}
+
+/*
+    create a worker pool with slot_count execution slots
+*/
+EbErrorType svt_worker_pool_ctor(EbWorkerPool *pool, uint32_t slot_count) {
+    pool->dctor        = svt_worker_pool_dctor;
+    pool->slot_count   = slot_count;
+    pool->free_slots   = slot_count;
+    pool->channel_list = NULL;
+    EB_CREATE_MUTEX(pool->lock);
+    return EB_ErrorNone;
+}
+
+static void svt_worker_channel_dctor(EbPtr p) {
+    EbWorkerChannel *obj = (EbWorkerChannel *)p;
+    if (obj->pool && obj->pool->lock) {
+        svt_block_on_mutex(obj->pool->lock);
+        EbWorkerChannel **link = &obj->pool->channel_list;
+        while (*link && *link != obj) link = &(*link)->next;
+        if (*link)
+            *link = obj->next;
+        svt_release_mutex(obj->pool->lock);
+    }
+    EB_DESTROY_SEMAPHORE(obj->grant_semaphore);
+}
+
+/*
+    register a new channel (one encoder instance) on pool
+*/
+EbErrorType svt_worker_channel_ctor(EbWorkerChannel *channel, EbWorkerPool *pool) {
+    channel->dctor = svt_worker_channel_dctor;
+    // At most slot_count grants can be outstanding at any time
+    EB_CREATE_SEMAPHORE(channel->grant_semaphore, 0, pool->slot_count);
+    channel->pool = pool;
+
+    svt_block_on_mutex(pool->lock);
+    channel->next      = pool->channel_list;
+    pool->channel_list = channel;
+    svt_release_mutex(pool->lock);
+    return EB_ErrorNone;
+}
+
+void svt_set_thread_creation_channel(EbWorkerChannel *channel) { svt_thread_creation_channel = channel; }
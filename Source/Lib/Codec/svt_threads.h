@@ -13,6 +13,7 @@
 #define EbThreads_h
 
 #include "definitions.h"
+#include "object.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -21,6 +22,12 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#ifdef _MSC_VER
+#define SVT_THREAD_LOCAL __declspec(thread)
+#else
+#define SVT_THREAD_LOCAL __thread
+#endif
+
 // Create wrapper functions that hide thread calls,
 // semaphores, mutex, etc. These wrappers also hide
 // platform specific implementations of these objects.
@@ -120,6 +127,96 @@ extern EbErrorType svt_destroy_mutex(EbHandle mutex_handle);
 
 void svt_aom_atomic_set_u32(AtomicVarU32 *var, uint32_t in);
 
+/**************************************
+     * Lock-free atomics
+     *   Thin wrappers over the compiler intrinsics, used by the lock-free
+     *   fifo backend. All operations are sequentially consistent unless the
+     *   name says otherwise.
+     **************************************/
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static INLINE uint32_t svt_atomic_load_u32(volatile uint32_t *ptr) { return (uint32_t)_InterlockedOr((volatile long *)ptr, 0); }
+static INLINE uint64_t svt_atomic_load_u64(volatile uint64_t *ptr) {
+    return (uint64_t)_InterlockedOr64((volatile __int64 *)ptr, 0);
+}
+static INLINE void svt_atomic_store_u64(volatile uint64_t *ptr, uint64_t val) {
+    _InterlockedExchange64((volatile __int64 *)ptr, (__int64)val);
+}
+static INLINE uint32_t svt_atomic_fetch_add_u32(volatile uint32_t *ptr, uint32_t val) {
+    return (uint32_t)_InterlockedExchangeAdd((volatile long *)ptr, (long)val);
+}
+static INLINE uint32_t svt_atomic_fetch_sub_u32(volatile uint32_t *ptr, uint32_t val) {
+    return (uint32_t)_InterlockedExchangeAdd((volatile long *)ptr, -(long)val);
+}
+static INLINE uint64_t svt_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t val) {
+    return (uint64_t)_InterlockedExchangeAdd64((volatile __int64 *)ptr, (__int64)val);
+}
+// returns TRUE and stores desired if *ptr == *expected, otherwise updates *expected with the current value
+static INLINE Bool svt_atomic_cas_u64(volatile uint64_t *ptr, uint64_t *expected, uint64_t desired) {
+    const uint64_t prev = (uint64_t)_InterlockedCompareExchange64(
+        (volatile __int64 *)ptr, (__int64)desired, (__int64)*expected);
+    if (prev == *expected)
+        return TRUE;
+    *expected = prev;
+    return FALSE;
+}
+#else
+static INLINE uint32_t svt_atomic_load_u32(volatile uint32_t *ptr) { return __atomic_load_n(ptr, __ATOMIC_SEQ_CST); }
+static INLINE uint64_t svt_atomic_load_u64(volatile uint64_t *ptr) { return __atomic_load_n(ptr, __ATOMIC_SEQ_CST); }
+static INLINE void     svt_atomic_store_u64(volatile uint64_t *ptr, uint64_t val) {
+    __atomic_store_n(ptr, val, __ATOMIC_SEQ_CST);
+}
+static INLINE uint32_t svt_atomic_fetch_add_u32(volatile uint32_t *ptr, uint32_t val) {
+    return __atomic_fetch_add(ptr, val, __ATOMIC_SEQ_CST);
+}
+static INLINE uint32_t svt_atomic_fetch_sub_u32(volatile uint32_t *ptr, uint32_t val) {
+    return __atomic_fetch_sub(ptr, val, __ATOMIC_SEQ_CST);
+}
+static INLINE uint64_t svt_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t val) {
+    return __atomic_fetch_add(ptr, val, __ATOMIC_SEQ_CST);
+}
+// returns TRUE and stores desired if *ptr == *expected, otherwise updates *expected with the current value
+static INLINE Bool svt_atomic_cas_u64(volatile uint64_t *ptr, uint64_t *expected, uint64_t desired) {
+    return __atomic_compare_exchange_n(ptr, expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? TRUE
+                                                                                                     : FALSE;
+}
+#endif
+
+/**************************************
+     * Worker pool
+     *   Bounds the number of encoder threads that execute at the same time.
+     *   A pool may be shared by several encoder instances, each of which
+     *   registers an EbWorkerChannel. Threads created while a channel is
+     *   attached to the creating thread (see svt_set_thread_creation_channel)
+     *   join the pool: they hold one of its slots while running and hand it
+     *   back whenever they block on a semaphore, a contended mutex or a
+     *   condition variable, so idle stages never occupy a core and a blocked
+     *   thread never starves the ones it is waiting for. A slot freed while
+     *   threads are queued goes to the waiting channel that holds the fewest
+     *   slots, so busy channels cannot crowd out the others.
+     **************************************/
+typedef struct EbWorkerChannel {
+    EbDctor                 dctor;
+    struct EbWorkerPool    *pool;
+    struct EbWorkerChannel *next;
+    EbHandle                grant_semaphore; // posted when a slot is handed to a waiting thread
+    uint32_t                held_slots;
+    uint32_t                waiting_threads;
+} EbWorkerChannel;
+
+typedef struct EbWorkerPool {
+    EbDctor          dctor;
+    EbHandle         lock;
+    uint32_t         slot_count;
+    uint32_t         free_slots;
+    EbWorkerChannel *channel_list; // registered channels, least recently served first
+} EbWorkerPool;
+
+EbErrorType svt_worker_pool_ctor(EbWorkerPool *pool, uint32_t slot_count);
+EbErrorType svt_worker_channel_ctor(EbWorkerChannel *channel, EbWorkerPool *pool);
+// Threads created afterwards by the calling thread join channel (NULL: no pool)
+void svt_set_thread_creation_channel(EbWorkerChannel *channel);
+
 /*
  Condition variable
 */
@@ -0,0 +1,158 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "svt_trace.h"
+#include "svt_threads.h"
+#include "svt_malloc.h"
+#include "svt_time.h"
+#include "svt_log.h"
+
+static const char *const stage_names[SVT_AV1_STAGE_COUNT] = {
+    "ResourceCoordination",
+    "PictureAnalysis",
+    "PictureDecision",
+    "MotionEstimation",
+    "InitialRateControl",
+    "SourceBasedOperations",
+    "TplDispenser",
+    "PictureManager",
+    "RateControl",
+    "ModeDecisionConfiguration",
+    "EncDec",
+    "Dlf",
+    "Cdef",
+    "Restoration",
+    "EntropyCoding",
+    "Packetization",
+};
+
+// Ring of the calling thread, and the event of the task it is running
+static SVT_THREAD_LOCAL EbTraceRing  *trace_ring;
+static SVT_THREAD_LOCAL EbTraceEvent *trace_event;
+
+static void svt_tracer_dctor(EbPtr p) {
+    EbTracer    *obj  = (EbTracer *)p;
+    EbTraceRing *ring = obj->ring_list;
+    while (ring) {
+        EbTraceRing *next = ring->next;
+        EB_FREE(ring);
+        ring = next;
+    }
+    EB_FREE(obj->path);
+    EB_DESTROY_MUTEX(obj->lock);
+}
+
+EbErrorType svt_tracer_ctor(EbTracer *tracer, const char *path) {
+    tracer->dctor = svt_tracer_dctor;
+    EB_MALLOC(tracer->path, strlen(path) + 1);
+    strcpy(tracer->path, path);
+    tracer->origin_ns = svt_av1_get_time_ns();
+    EB_CREATE_MUTEX(tracer->lock);
+    return EB_ErrorNone;
+}
+
+static EbTraceRing *trace_ring_create(EbTracer *tracer) {
+    EbTraceRing *ring;
+    EB_NO_THROW_CALLOC(ring, 1, sizeof(*ring));
+    if (!ring)
+        return NULL;
+    ring->tracer = tracer;
+    svt_block_on_mutex(tracer->lock);
+    ring->thread_index = ++tracer->thread_count;
+    ring->next         = tracer->ring_list;
+    tracer->ring_list  = ring;
+    svt_release_mutex(tracer->lock);
+    return ring;
+}
+
+void svt_trace_task_begin(EbTracer *tracer, uint32_t stage, uint64_t now_ns) {
+    if (!trace_ring || trace_ring->tracer != tracer)
+        trace_ring = trace_ring_create(tracer);
+    if (!trace_ring)
+        return;
+    trace_event = &trace_ring->events[trace_ring->event_count % TRACE_RING_SIZE];
+    memset(trace_event, 0, sizeof(*trace_event));
+    trace_event->start_ns      = now_ns;
+    trace_event->segment_index = -1;
+    trace_event->stage         = (uint8_t)stage;
+}
+
+void svt_trace_task_end(uint64_t now_ns) {
+    if (!trace_event)
+        return;
+    trace_event->end_ns = now_ns;
+    trace_event         = NULL;
+    // Publish the event to svt_tracer_dump()
+    svt_atomic_fetch_add_u64(&trace_ring->event_count, 1);
+}
+
+void svt_trace_picture(uint64_t picture_number, int32_t segment_index) {
+    if (!trace_event)
+        return;
+    trace_event->picture_number = picture_number;
+    trace_event->segment_index  = segment_index;
+    trace_event->has_picture    = 1;
+}
+
+void svt_trace_sb_count(uint32_t sb_count) {
+    if (trace_event)
+        trace_event->sb_count = sb_count;
+}
+
+static void write_event(FILE *f, const EbTracer *tracer, const EbTraceRing *ring, const EbTraceEvent *event) {
+    // Chrome trace timestamps are in microseconds
+    fprintf(f,
+            ",\n{\"name\":\"%s\",\"cat\":\"kernel\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+            stage_names[event->stage],
+            ring->thread_index,
+            (double)(event->start_ns - tracer->origin_ns) / 1000,
+            (double)(event->end_ns - event->start_ns) / 1000);
+    if (event->has_picture) {
+        fprintf(f, ",\"args\":{\"picture\":%llu", (unsigned long long)event->picture_number);
+        if (event->segment_index >= 0)
+            fprintf(f, ",\"segment\":%d", event->segment_index);
+        if (event->sb_count)
+            fprintf(f, ",\"sb_count\":%u", event->sb_count);
+        fprintf(f, "}");
+    }
+    fprintf(f, "}");
+}
+
+EbErrorType svt_tracer_dump(EbTracer *tracer) {
+    FILE *f;
+    FOPEN(f, tracer->path, "w");
+    if (!f) {
+        SVT_ERROR("Could not open trace file %s\n", tracer->path);
+        return EB_ErrorBadParameter;
+    }
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"SvtAv1Enc\"}}");
+    svt_block_on_mutex(tracer->lock);
+    for (const EbTraceRing *ring = tracer->ring_list; ring; ring = ring->next) {
+        const uint64_t count = svt_atomic_load_u64(&((EbTraceRing *)ring)->event_count);
+        const uint64_t first = count > TRACE_RING_SIZE ? count - TRACE_RING_SIZE : 0;
+        if (!count)
+            continue;
+        // Threads are named after the stage of their first recorded task, a thread serves one stage
+        fprintf(f,
+                ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+                ring->thread_index,
+                stage_names[ring->events[first % TRACE_RING_SIZE].stage],
+                ring->thread_index);
+        for (uint64_t i = first; i < count; i++) write_event(f, tracer, ring, &ring->events[i % TRACE_RING_SIZE]);
+    }
+    svt_release_mutex(tracer->lock);
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    return EB_ErrorNone;
+}
@@ -0,0 +1,75 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbTrace_h
+#define EbTrace_h
+
+#include "definitions.h"
+#include "object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************
+     * Tracer
+     *   Records one event per task taken by a kernel thread (see
+     *   svt_get_full_object) and writes them to a Chrome trace JSON
+     *   file, which chrome://tracing and ui.perfetto.dev can open.
+     *   Every thread writes to its own ring buffer, allocated the first
+     *   time it takes a task, so recording takes no lock; once a ring is
+     *   full the oldest events of that thread are overwritten.
+     **************************************/
+#define TRACE_RING_SIZE (1 << 14)
+
+typedef struct EbTraceEvent {
+    uint64_t start_ns;
+    uint64_t end_ns;
+    uint64_t picture_number;
+    int32_t  segment_index; // -1 when the task covers the whole picture
+    uint32_t sb_count; // 0 when unknown
+    uint8_t  stage; // SvtAv1PipelineStage
+    uint8_t  has_picture;
+} EbTraceEvent;
+
+typedef struct EbTraceRing {
+    struct EbTraceRing *next;
+    struct EbTracer    *tracer;
+    uint32_t            thread_index;
+    volatile uint64_t   event_count; // events completed since the thread started
+    EbTraceEvent        events[TRACE_RING_SIZE];
+} EbTraceRing;
+
+typedef struct EbTracer {
+    EbDctor      dctor;
+    EbHandle     lock;
+    char        *path;
+    uint64_t     origin_ns;
+    uint32_t     thread_count;
+    EbTraceRing *ring_list;
+} EbTracer;
+
+EbErrorType svt_tracer_ctor(EbTracer *tracer, const char *path);
+// Writes the events recorded so far to the trace file, tasks still running are left out
+EbErrorType svt_tracer_dump(EbTracer *tracer);
+
+// Called by the resource manager when the calling thread takes / is done with a task of stage
+void svt_trace_task_begin(EbTracer *tracer, uint32_t stage, uint64_t now_ns);
+void svt_trace_task_end(uint64_t now_ns);
+
+// Describe the task the calling thread is running, no-ops when tracing is off
+void svt_trace_picture(uint64_t picture_number, int32_t segment_index);
+void svt_trace_sb_count(uint32_t sb_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbTrace_h
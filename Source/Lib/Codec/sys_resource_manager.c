@@ -15,6 +15,8 @@
 #include "sys_resource_manager.h"
 #include "definitions.h"
 #include "svt_threads.h"
+#include "svt_time.h"
+#include "svt_trace.h"
 #if SRM_REPORT
 #include "svt_log.h"
 #endif
@@ -98,6 +100,7 @@ static EbErrorType svt_fifo_shutdown(EbFifo *fifo_ptr) {
     return return_error;
 }
 
+#if !LOCKFREE_FIFO
 static void svt_circular_buffer_dctor(EbPtr p) {
     EbCircularBuffer *obj = (EbCircularBuffer *)p;
     EB_FREE(obj->array_ptr);
@@ -115,6 +118,7 @@ static EbErrorType svt_circular_buffer_ctor(EbCircularBuffer *bufferPtr, uint32_
 
     return EB_ErrorNone;
 }
+#endif
 
 /**************************************
  * svt_circular_buffer_empty_check
@@ -183,11 +187,129 @@ static EbErrorType svt_circular_buffer_push_front(EbCircularBuffer *bufferPtr, E
     return return_error;
 }
 
+#if LOCKFREE_FIFO
+static void svt_lockfree_ring_dctor(EbPtr p) {
+    EbLockFreeRing *obj = (EbLockFreeRing *)p;
+    EB_DESTROY_SEMAPHORE(obj->wakeup_semaphore);
+    EB_FREE_ARRAY(obj->cell_array);
+}
+
+/**************************************
+ * svt_lockfree_ring_ctor
+ **************************************/
+static EbErrorType svt_lockfree_ring_ctor(EbLockFreeRing *ring_ptr, uint32_t object_total_count,
+                                          uint32_t process_total_count) {
+    uint64_t capacity = 1;
+
+    ring_ptr->dctor = svt_lockfree_ring_dctor;
+
+    while (capacity < object_total_count) capacity <<= 1;
+    ring_ptr->mask = capacity - 1;
+
+    EB_MALLOC_ARRAY(ring_ptr->cell_array, capacity);
+    for (uint64_t i = 0; i < capacity; ++i) {
+        ring_ptr->cell_array[i].sequence    = i;
+        ring_ptr->cell_array[i].wrapper_ptr = NULL;
+    }
+    ring_ptr->enqueue_pos   = 0;
+    ring_ptr->dequeue_pos   = 0;
+    ring_ptr->sleeper_count = 0;
+
+    // Every post matches a registered sleeper (or a shutdown request), so the count stays bounded
+    EB_CREATE_SEMAPHORE(ring_ptr->wakeup_semaphore, 0, object_total_count + process_total_count);
+
+    return EB_ErrorNone;
+}
+#endif
+
+/**************************************
+ * svt_lockfree_ring_push
+ *   Never fails: the ring holds at least as many cells as there are
+ *   objects in the owning SystemResource.
+ **************************************/
+static void svt_lockfree_ring_push(EbLockFreeRing *ring_ptr, EbObjectWrapper *wrapper_ptr) {
+    EbLockFreeCell *cell;
+    uint64_t        pos = svt_atomic_load_u64(&ring_ptr->enqueue_pos);
+
+    for (;;) {
+        cell                 = &ring_ptr->cell_array[pos & ring_ptr->mask];
+        const uint64_t seq   = svt_atomic_load_u64(&cell->sequence);
+        const int64_t  delta = (int64_t)(seq - pos);
+        if (delta == 0) {
+            if (svt_atomic_cas_u64(&ring_ptr->enqueue_pos, &pos, pos + 1))
+                break;
+        } else {
+            svt_aom_assert_err(delta > 0, "lock-free ring overflow");
+            pos = svt_atomic_load_u64(&ring_ptr->enqueue_pos);
+        }
+    }
+    cell->wrapper_ptr = wrapper_ptr;
+    svt_atomic_store_u64(&cell->sequence, pos + 1);
+
+    // Only pay for a semaphore post when a consumer went to sleep on an empty ring
+    if (svt_atomic_load_u32(&ring_ptr->sleeper_count))
+        svt_post_semaphore(ring_ptr->wakeup_semaphore);
+}
+
+/**************************************
+ * svt_lockfree_ring_try_pop
+ **************************************/
+static Bool svt_lockfree_ring_try_pop(EbLockFreeRing *ring_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
+    EbLockFreeCell *cell;
+    uint64_t        pos = svt_atomic_load_u64(&ring_ptr->dequeue_pos);
+
+    for (;;) {
+        cell                 = &ring_ptr->cell_array[pos & ring_ptr->mask];
+        const uint64_t seq   = svt_atomic_load_u64(&cell->sequence);
+        const int64_t  delta = (int64_t)(seq - (pos + 1));
+        if (delta == 0) {
+            if (svt_atomic_cas_u64(&ring_ptr->dequeue_pos, &pos, pos + 1))
+                break;
+        } else if (delta < 0) {
+            // empty
+            return FALSE;
+        } else
+            pos = svt_atomic_load_u64(&ring_ptr->dequeue_pos);
+    }
+    *wrapper_dbl_ptr = cell->wrapper_ptr;
+    svt_atomic_store_u64(&cell->sequence, pos + ring_ptr->mask + 1);
+
+    return TRUE;
+}
+
+/**************************************
+ * svt_lockfree_ring_pop
+ *   Blocks until an object is available or the requesting fifo is shut
+ *   down. Returns EB_NoErrorFifoShutdown in the latter case.
+ **************************************/
+static EbErrorType svt_lockfree_ring_pop(EbLockFreeRing *ring_ptr, EbFifo *fifo_ptr,
+                                         EbObjectWrapper **wrapper_dbl_ptr) {
+    for (;;) {
+        if (*(volatile Bool *)&fifo_ptr->quit_signal)
+            break;
+        if (svt_lockfree_ring_try_pop(ring_ptr, wrapper_dbl_ptr))
+            return EB_ErrorNone;
+
+        // Register as sleeper, then check again so that a push racing with the
+        // registration is either seen here or sees the registration and posts.
+        svt_atomic_fetch_add_u32(&ring_ptr->sleeper_count, 1);
+        if (!*(volatile Bool *)&fifo_ptr->quit_signal && svt_lockfree_ring_try_pop(ring_ptr, wrapper_dbl_ptr)) {
+            svt_atomic_fetch_sub_u32(&ring_ptr->sleeper_count, 1);
+            return EB_ErrorNone;
+        }
+        svt_block_on_semaphore(ring_ptr->wakeup_semaphore);
+        svt_atomic_fetch_sub_u32(&ring_ptr->sleeper_count, 1);
+    }
+    *wrapper_dbl_ptr = NULL;
+    return EB_NoErrorFifoShutdown;
+}
+
 void svt_muxing_queue_dctor(EbPtr p) {
     EbMuxingQueue *obj = (EbMuxingQueue *)p;
     EB_DELETE_PTR_ARRAY(obj->process_fifo_ptr_array, obj->process_total_count);
     EB_DELETE(obj->object_queue);
     EB_DELETE(obj->process_queue);
+    EB_DELETE(obj->ring);
     EB_DESTROY_MUTEX(obj->lockout_mutex);
 }
 
@@ -205,10 +327,15 @@ static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t obje
     // Lockout Mutex
     EB_CREATE_MUTEX(queue_ptr->lockout_mutex);
 
+#if LOCKFREE_FIFO
+    // Construct the shared lock-free ring
+    EB_NEW(queue_ptr->ring, svt_lockfree_ring_ctor, object_total_count, queue_ptr->process_total_count);
+#else
     // Construct Object Circular Buffer
     EB_NEW(queue_ptr->object_queue, svt_circular_buffer_ctor, object_total_count);
     // Construct Process Circular Buffer
     EB_NEW(queue_ptr->process_queue, svt_circular_buffer_ctor, queue_ptr->process_total_count);
+#endif
     // Construct the Process Fifos
     EB_ALLOC_PTR_ARRAY(queue_ptr->process_fifo_ptr_array, queue_ptr->process_total_count);
 
@@ -264,6 +391,11 @@ static EbErrorType svt_muxing_queue_assignation(EbMuxingQueue *queue_ptr) {
 static EbErrorType svt_muxing_queue_object_push_back(EbMuxingQueue *queue_ptr, EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (queue_ptr->ring) {
+        svt_lockfree_ring_push(queue_ptr->ring, object_ptr);
+        return return_error;
+    }
+
     svt_circular_buffer_push_back(queue_ptr->object_queue, object_ptr);
 
     svt_muxing_queue_assignation(queue_ptr);
@@ -277,6 +409,12 @@ static EbErrorType svt_muxing_queue_object_push_back(EbMuxingQueue *queue_ptr, E
 static EbErrorType svt_muxing_queue_object_push_front(EbMuxingQueue *queue_ptr, EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (queue_ptr->ring) {
+        // the ring has no front; released objects simply queue behind the others
+        svt_lockfree_ring_push(queue_ptr->ring, object_ptr);
+        return return_error;
+    }
+
     svt_circular_buffer_push_front(queue_ptr->object_queue, object_ptr);
 
     svt_muxing_queue_assignation(queue_ptr);
@@ -501,6 +639,15 @@ EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr) {
     if (!resource_ptr || !resource_ptr->full_queue)
         return EB_ErrorNone;
 
+    if (resource_ptr->full_queue->ring) {
+        // All consumers sleep on the same ring semaphore, so raise every quit flag
+        // before waking anybody; otherwise a consumer could swallow a post meant for another one.
+        for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++)
+            svt_system_resource_get_consumer_fifo(resource_ptr, i)->quit_signal = TRUE;
+        for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++)
+            svt_post_semaphore(resource_ptr->full_queue->ring->wakeup_semaphore);
+        return EB_ErrorNone;
+    }
     //notify all consumers we are shutting down
     for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++) {
         EbFifo *fifo_ptr = svt_system_resource_get_consumer_fifo(resource_ptr, i);
@@ -526,6 +673,75 @@ static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
     return return_error;
 }
 
+/*********************************************************************
+ * Stage telemetry
+ *********************************************************************/
+// Stage whose object the calling thread is working on, and since when
+static SVT_THREAD_LOCAL EbStageStats *svt_thread_stage;
+static SVT_THREAD_LOCAL uint64_t      svt_thread_stage_start_ns;
+
+void svt_latency_histogram_add(volatile uint64_t *histogram, uint64_t duration_ns) {
+    uint64_t us  = duration_ns / 1000;
+    uint32_t bin = 0;
+    while (us > 1 && bin < SVT_AV1_LATENCY_HISTOGRAM_BINS - 1) {
+        us >>= 1;
+        bin++;
+    }
+    svt_atomic_fetch_add_u64(&histogram[bin], 1);
+}
+
+void svt_stage_stats_read(EbStageStats *stats, SvtAv1StageTelemetry *telemetry) {
+    telemetry->task_count      = svt_atomic_load_u64(&stats->task_count);
+    telemetry->total_wait_us   = svt_atomic_load_u64(&stats->wait_time_ns) / 1000;
+    telemetry->total_busy_us   = svt_atomic_load_u64(&stats->busy_time_ns) / 1000;
+    telemetry->queue_depth     = (uint32_t)svt_atomic_load_u64(&stats->queue_depth);
+    telemetry->max_queue_depth = (uint32_t)svt_atomic_load_u64(&stats->max_queue_depth);
+    for (int bin = 0; bin < SVT_AV1_LATENCY_HISTOGRAM_BINS; bin++) {
+        telemetry->wait_histogram[bin] = svt_atomic_load_u64(&stats->wait_histogram[bin]);
+        telemetry->busy_histogram[bin] = svt_atomic_load_u64(&stats->busy_histogram[bin]);
+    }
+}
+
+static void stage_stats_post(EbObjectWrapper *object_ptr) {
+    EbStageStats *stats = object_ptr->system_resource_ptr->stage_stats;
+    if (!stats)
+        return;
+    object_ptr->post_time_ns = svt_av1_get_time_ns();
+    const uint64_t depth     = svt_atomic_fetch_add_u64(&stats->queue_depth, 1) + 1;
+    uint64_t       max_depth = svt_atomic_load_u64(&stats->max_queue_depth);
+    while (depth > max_depth && !svt_atomic_cas_u64(&stats->max_queue_depth, &max_depth, depth))
+        ;
+}
+
+// The calling thread is done with its previous object when it comes back for the next one
+static void stage_stats_task_done(void) {
+    EbStageStats *stats = svt_thread_stage;
+    if (!stats)
+        return;
+    const uint64_t busy_ns = svt_av1_get_time_ns() - svt_thread_stage_start_ns;
+    svt_atomic_fetch_add_u64(&stats->busy_time_ns, busy_ns);
+    svt_latency_histogram_add(stats->busy_histogram, busy_ns);
+    if (stats->tracer)
+        svt_trace_task_end(svt_thread_stage_start_ns + busy_ns);
+    svt_thread_stage = NULL;
+}
+
+static void stage_stats_task_taken(const EbObjectWrapper *object_ptr) {
+    EbStageStats *stats = object_ptr ? object_ptr->system_resource_ptr->stage_stats : NULL;
+    if (!stats)
+        return;
+    const uint64_t now_ns  = svt_av1_get_time_ns();
+    const uint64_t wait_ns = now_ns - object_ptr->post_time_ns;
+    svt_atomic_fetch_add_u64(&stats->queue_depth, (uint64_t)-1);
+    svt_atomic_fetch_add_u64(&stats->task_count, 1);
+    svt_atomic_fetch_add_u64(&stats->wait_time_ns, wait_ns);
+    svt_latency_histogram_add(stats->wait_histogram, wait_ns);
+    svt_thread_stage          = stats;
+    svt_thread_stage_start_ns = now_ns;
+    if (stats->tracer)
+        svt_trace_task_begin(stats->tracer, stats->stage, now_ns);
+}
+
 /*********************************************************************
  * EbSystemResourcePostObject
  *   Queues a full EbObjectWrapper to the SystemResource. This
@@ -543,6 +759,12 @@ static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
 EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    stage_stats_post(object_ptr);
+    if (object_ptr->system_resource_ptr->full_queue->ring) {
+        svt_lockfree_ring_push(object_ptr->system_resource_ptr->full_queue->ring, object_ptr);
+        return return_error;
+    }
+
     svt_block_on_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
 
     svt_muxing_queue_object_push_back(object_ptr->system_resource_ptr->full_queue, object_ptr);
@@ -563,7 +785,9 @@ EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr) {
  *      pointer to EbObjectWrapper to be released.
  *********************************************************************/
 EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
+    EbErrorType       return_error = EB_ErrorNone;
+    EbSystemResource *resource_ptr = object_ptr->system_resource_ptr;
+    Bool              returned     = FALSE;
 
     svt_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
@@ -577,7 +801,10 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
+        if (resource_ptr->recycle_callback)
+            resource_ptr->recycle_callback(resource_ptr->release_callback_data, object_ptr);
         svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
+        returned = TRUE;
 #if SRM_REPORT
         object_ptr->pic_number = 99999999;
         //increment the fullness
@@ -589,7 +816,11 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
 #endif
     }
 
-    svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+    svt_release_mutex(resource_ptr->empty_queue->lockout_mutex);
+
+    // object_ptr may already be reused by another thread here, only touch the resource
+    if (returned && resource_ptr->release_callback)
+        resource_ptr->release_callback(resource_ptr->release_callback_data);
 
     return return_error;
 }
@@ -661,6 +892,20 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log) {
 EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (empty_fifo_ptr->queue_ptr->ring) {
+        // Empty fifos are never shut down
+        svt_lockfree_ring_pop(empty_fifo_ptr->queue_ptr->ring, empty_fifo_ptr, wrapper_dbl_ptr);
+
+        svt_aom_assert_err(
+            (*wrapper_dbl_ptr)->live_count == 0 || (*wrapper_dbl_ptr)->live_count == EB_ObjectWrapperReleasedValue,
+            "live_count should be 0 or EB_ObjectWrapperReleasedValue when get");
+
+        // The wrapper is exclusively owned once popped
+        (*wrapper_dbl_ptr)->live_count     = 0;
+        (*wrapper_dbl_ptr)->release_enable = TRUE;
+        return return_error;
+    }
+
     // Queue the Fifo requesting the empty fifo
     svt_release_process(empty_fifo_ptr);
 
@@ -716,6 +961,13 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
 EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    stage_stats_task_done();
+    if (full_fifo_ptr->queue_ptr->ring) {
+        return_error = svt_lockfree_ring_pop(full_fifo_ptr->queue_ptr->ring, full_fifo_ptr, wrapper_dbl_ptr);
+        stage_stats_task_taken(*wrapper_dbl_ptr);
+        return return_error;
+    }
+
     // Queue the Fifo requesting the full fifo
     svt_release_process(full_fifo_ptr);
 
@@ -735,6 +987,7 @@ EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper
     // Release Mutex
     svt_release_mutex(full_fifo_ptr->lockout_mutex);
 
+    stage_stats_task_taken(*wrapper_dbl_ptr);
     return return_error;
 }
 
@@ -752,6 +1005,14 @@ static Bool svt_fifo_peak_front(EbFifo *fifoPtr) {
 EbErrorType svt_get_full_object_non_blocking(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
     Bool        fifo_empty;
+    if (full_fifo_ptr->queue_ptr->ring) {
+        //if the fifo is shutting down, we will not give any buffer to caller
+        if (*(volatile Bool *)&full_fifo_ptr->quit_signal ||
+            !svt_lockfree_ring_try_pop(full_fifo_ptr->queue_ptr->ring, wrapper_dbl_ptr))
+            *wrapper_dbl_ptr = (EbObjectWrapper *)NULL;
+        return return_error;
+    }
+
     // Queue the Fifo requesting the full fifo
     svt_release_process(full_fifo_ptr);
 
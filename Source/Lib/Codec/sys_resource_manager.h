@@ -22,6 +22,13 @@ extern "C" {
      *********************************/
 #define EB_ObjectWrapperReleasedValue ~0u
 
+// LOCKFREE_FIFO - when set (cmake -DLOCKFREE_FIFO=ON), every EbMuxingQueue is
+//   constructed with a bounded lock-free ring that replaces the mutex protected
+//   object/process circular buffers and per-process fifos.
+#ifndef LOCKFREE_FIFO
+#define LOCKFREE_FIFO 0
+#endif
+
 /*********************************************************************
       * Object Wrapper
       *   Provides state information for each type of object in the
@@ -52,11 +59,36 @@ typedef struct EbObjectWrapper {
     // next_ptr - a pointer to a different EbObjectWrapper.  Used
     //   only in the implemenation of a single-linked Fifo.
     struct EbObjectWrapper *next_ptr;
+
+    // post_time_ns - when the object was posted to the full queue, only
+    //   set when the SystemResource has stage_stats.
+    uint64_t post_time_ns;
 #if SRM_REPORT
     uint64_t pic_number;
 #endif
 } EbObjectWrapper;
 
+/*********************************************************************
+     * StageStats
+     *   Telemetry of the pipeline stage consuming the full queue of a
+     *   SystemResource: how long objects wait in the queue, how long the
+     *   consuming threads work on them (until they come back for the next
+     *   one) and how deep the queue gets. Updated with atomics by the
+     *   producing and consuming threads, see SVT_AV1_STREAM_INFO_PIPELINE_TELEMETRY.
+     *********************************************************************/
+typedef struct EbStageStats {
+    volatile uint64_t task_count;
+    volatile uint64_t wait_time_ns;
+    volatile uint64_t busy_time_ns;
+    volatile uint64_t queue_depth;
+    volatile uint64_t max_queue_depth;
+    volatile uint64_t wait_histogram[SVT_AV1_LATENCY_HISTOGRAM_BINS];
+    volatile uint64_t busy_histogram[SVT_AV1_LATENCY_HISTOGRAM_BINS];
+    // stage - SvtAv1PipelineStage, tracer - when set, records every task (see svt_trace.h)
+    uint32_t         stage;
+    struct EbTracer *tracer;
+} EbStageStats;
+
 /*********************************************************************
      * Fifo
      *   Defines a static (i.e. no dynamic memory allocation) single
@@ -102,6 +134,39 @@ typedef struct EbCircularBuffer {
     uint32_t current_count;
 } EbCircularBuffer;
 
+/*********************************************************************
+     * LockFreeRing
+     *   Bounded multi-producer multi-consumer ring of EbObjectWrapper
+     *   pointers. Each cell carries a sequence number that tells producers
+     *   and consumers whether the cell is free for their current position,
+     *   so push and pop only need one compare-and-swap on the shared
+     *   position. The capacity is rounded up to a power of two that is at
+     *   least the number of objects of the owning SystemResource, so a push
+     *   can never find the ring full.
+     *
+     *   Consumers that find the ring empty register in sleeper_count and
+     *   block on the semaphore; producers only post the semaphore when a
+     *   consumer is registered.
+     *********************************************************************/
+typedef struct EbLockFreeCell {
+    volatile uint64_t sequence;
+    EbObjectWrapper  *wrapper_ptr;
+} EbLockFreeCell;
+
+typedef struct EbLockFreeRing {
+    EbDctor         dctor;
+    EbLockFreeCell *cell_array;
+    uint64_t        mask;
+    // keep the producer and consumer positions on separate cache lines
+    uint8_t           pad0[64];
+    volatile uint64_t enqueue_pos;
+    uint8_t           pad1[64 - sizeof(uint64_t)];
+    volatile uint64_t dequeue_pos;
+    uint8_t           pad2[64 - sizeof(uint64_t)];
+    volatile uint32_t sleeper_count;
+    EbHandle          wakeup_semaphore;
+} EbLockFreeRing;
+
 /*********************************************************************
      * MuxingQueue
      *********************************************************************/
@@ -112,6 +177,9 @@ typedef struct EbMuxingQueue {
     EbCircularBuffer *process_queue;
     uint32_t          process_total_count;
     EbFifo          **process_fifo_ptr_array;
+    // ring - when not NULL, shared by all process fifos instead of the
+    //   object_queue / process_queue assignation (see LOCKFREE_FIFO).
+    EbLockFreeRing *ring;
 #if SRM_REPORT
     uint32_t curr_count; //run time fullness
     uint8_t  log; //if set monitor out the queue size
@@ -142,6 +210,17 @@ typedef struct EbSystemResource {
 
     // The full FIFO contains a queue of completed buffers
     EbMuxingQueue *full_queue;
+
+    // release_callback - Optional hook called, outside of any lock, each time
+    //   an object returns to the empty queue.
+    void (*release_callback)(void *release_callback_data);
+    // recycle_callback - Optional hook called with the object, under the empty
+    //   queue lock, right before it returns to the empty queue.
+    void (*recycle_callback)(void *release_callback_data, EbObjectWrapper *wrapper_ptr);
+    void *release_callback_data;
+
+    // stage_stats - Optional telemetry of the stage consuming the full queue.
+    EbStageStats *stage_stats;
 } EbSystemResource;
 
 /*********************************************************************
@@ -326,6 +405,16 @@ extern EbErrorType svt_release_object(EbObjectWrapper *object_ptr);
      *********************************************************************/
 extern EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr);
 
+/*********************************************************************
+     * svt_stage_stats_read
+     *   Copies the counters of a StageStats to the public telemetry struct.
+     *
+     * svt_latency_histogram_add
+     *   Counts a duration in a SVT_AV1_LATENCY_HISTOGRAM_BINS histogram.
+     *********************************************************************/
+void svt_stage_stats_read(EbStageStats *stats, SvtAv1StageTelemetry *telemetry);
+void svt_latency_histogram_add(volatile uint64_t *histogram, uint64_t duration_ns);
+
 #define EB_GET_FULL_OBJECT(full_fifo_ptr, wrapper_dbl_ptr)                     \
     do {                                                                       \
         EbErrorType err = svt_get_full_object(full_fifo_ptr, wrapper_dbl_ptr); \
@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 #include <assert.h>
 #include "temporal_filtering.h"
 #include "compute_sad.h"
@@ -670,6 +671,50 @@ int32_t svt_aom_noise_log1p_fp16(int32_t noise_level_fp16) {
     }
 }
 
+// Inverse of svt_aom_noise_log1p_fp16(), the largest noise level mapped to at most log1p_fp16
+static int32_t tf_noise_level_from_log1p_fp16(int32_t log1p_fp16) {
+    int32_t lo = 0, hi = 255 << 16;
+    if (svt_aom_noise_log1p_fp16(lo) > log1p_fp16)
+        return 0;
+    while (lo < hi) {
+        const int32_t mid = lo + ((hi - lo + 1) >> 1);
+        if (svt_aom_noise_log1p_fp16(mid) <= log1p_fp16)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+/*
+ * TF block early exit: return 1 if the zero-motion luma SSE of the 64x64 block is under
+ * sse_th, i.e. the block does not move (within the noise level) and needs no motion search.
+ * Uses the 8bit padded pictures of the PA references, as the ME does.
+ */
+static uint8_t tf_zz_within_noise(PictureParentControlSet *centre_pcs,
+                                  PictureParentControlSet *ref_pcs, uint32_t blk_col,
+                                  uint32_t blk_row, uint64_t sse_th) {
+    EbPictureBufferDesc *src =
+        ((EbPaReferenceObject *)centre_pcs->pa_ref_pic_wrapper->object_ptr)->input_padded_pic;
+    EbPictureBufferDesc *ref =
+        ((EbPaReferenceObject *)ref_pcs->pa_ref_pic_wrapper->object_ptr)->input_padded_pic;
+    const uint32_t src_offset = (src->org_y + blk_row * BH) * src->stride_y + src->org_x +
+        blk_col * BW;
+    const uint32_t ref_offset = (ref->org_y + blk_row * BH) * ref->stride_y + ref->org_x +
+        blk_col * BW;
+    unsigned int   sse;
+    svt_aom_mefn_ptr[BLOCK_64X64].vf(
+        src->buffer_y + src_offset, src->stride_y, ref->buffer_y + ref_offset, ref->stride_y, &sse);
+    return sse < sse_th;
+}
+
+// Scale a 1/8-pel TF MV found at seed_dist frames to a full-pel MV at dist frames
+static INLINE int16_t tf_scale_seed_mv(int16_t mv, int dist, int seed_dist) {
+    const int num = mv * dist;
+    const int den = seed_dist << 3;
+    return (int16_t)(num >= 0 ? DIVIDE_AND_ROUND(num, den) : -DIVIDE_AND_ROUND(-num, den));
+}
+
 // T[X] =  exp(-(X)/16)  for x in [0..7], step 1/16 values in Fixed Points shift 16
 static const int32_t expf_tab_fp16[] = {
     65536, 61565, 57835, 54331, 51039, 47947, 45042, 42313, 39749, 37341, 35078, 32953, 30957,
@@ -2926,6 +2971,14 @@ static EbErrorType produce_temporally_filtered_pic(
             ctx->tf_decay_factor_fp16[C_V] = (uint32_t)(
                 (((((int64_t)n_decay_fp10) * ((int64_t)n_decay_fp10))) * q_decay_fp8) >> 11);
         }
+    // Block early exit: zero-motion SSE under which a 64x64 block is not searched
+    // (zz_skip_th % of the luma noise variance, at least 1 per pixel)
+    uint64_t zz_skip_sse_th = 0;
+    if (ctx->tf_ctrls.zz_skip_th) {
+        const int64_t noise_fp16     = tf_noise_level_from_log1p_fp16(noise_levels_log1p_fp16[C_Y]);
+        const int64_t noise_var_fp8  = MAX((noise_fp16 * noise_fp16) >> 24, 1 << 8);
+        zz_skip_sse_th = (uint64_t)((noise_var_fp8 * BW * BH * ctx->tf_ctrls.zz_skip_th) / (100 << 8));
+    }
     for (uint32_t blk_row = y_b64_start_idx; blk_row < y_b64_end_idx; blk_row++) {
         for (uint32_t blk_col = x_b64_start_idx; blk_col < x_b64_end_idx; blk_col++) {
             int blk_y_src_offset  = (blk_col * BW) + (blk_row * BH) * stride[C_Y];
@@ -2992,7 +3045,11 @@ static EbErrorType produce_temporally_filtered_pic(
               centre_pcs->past_altref_nframes ,
               centre_pcs->past_altref_nframes + centre_pcs->future_altref_nframes };
 
-            for (int segment_idx = 0; segment_idx < 3; segment_idx++)
+            for (int segment_idx = 0; segment_idx < 3; segment_idx++) {
+                // 64x64 MV of the last reference frame searched on this side, seeds the next one
+                int16_t seed_mv_x = 0;
+                int16_t seed_mv_y = 0;
+                int     seed_dist = 0;
                 for (int frame_index = start_frame_index[segment_idx]; frame_index <= end_frame_index[segment_idx]; frame_index = frame_index+ me_context_ptr->me_ctx->tf_ctrls.ref_frame_factor) {
                 // Use ahd-error to central/avg to identify/skip outlier ref-frame(s)
                 if (frame_index != index_center) {
@@ -3062,19 +3119,56 @@ static EbErrorType produce_temporally_filtered_pic(
                         centre_pcs->tf_ctrls.use_pred_64x64_only_th;
                     ctx->tf_subpel_early_exit_th =
                         centre_pcs->tf_ctrls.subpel_early_exit_th;
-                    // Perform ME - context_ptr will store the outputs (MVs, buffers, etc)
-                    // Block-based MC using open-loop HME + refinement
-                    // set default hme search params
-                    set_hme_search_params_mctf(ctx,0);
-                    svt_aom_motion_estimation_b64(centre_pcs,
-                        (uint32_t)blk_row * blk_cols + blk_col,
-                        (uint32_t)blk_col * BW, // x block
-                        (uint32_t)blk_row * BH, // y block
-                        ctx,
-                        input_picture_ptr_central); // source picture
-
+                    // Block early exit: no motion search if the block does not move
+                    const int     dist    = ABS(frame_index - index_center);
+                    const uint8_t zz_skip = zz_skip_sse_th &&
+                        tf_zz_within_noise(centre_pcs, pcs_list[frame_index], blk_col, blk_row, zz_skip_sse_th);
+                    ctx->tf_tot_blks++;
+                    if (!zz_skip) {
+                        // Start the search from the MV of the last reference frame on this side
+                        ctx->tf_seed_valid = ctx->tf_ctrls.seed_me && seed_dist;
+                        if (ctx->tf_seed_valid) {
+                            ctx->tf_seed_mv_x = tf_scale_seed_mv(seed_mv_x, dist, seed_dist);
+                            ctx->tf_seed_mv_y = tf_scale_seed_mv(seed_mv_y, dist, seed_dist);
+                            ctx->tf_seed_blks++;
+                        }
+                        // Perform ME - context_ptr will store the outputs (MVs, buffers, etc)
+                        // Block-based MC using open-loop HME + refinement
+                        // set default hme search params
+                        set_hme_search_params_mctf(ctx,0);
+                        svt_aom_motion_estimation_b64(centre_pcs,
+                            (uint32_t)blk_row * blk_cols + blk_col,
+                            (uint32_t)blk_col * BW, // x block
+                            (uint32_t)blk_row * BH, // y block
+                            ctx,
+                            input_picture_ptr_central); // source picture
+                        ctx->tf_seed_valid = 0;
+                    }
 
-                    if (ctx->tf_use_pred_64x64_only_th &&
+                    if (zz_skip) {
+                        ctx->tf_skip_blks++;
+                        ctx->tf_64x64_mv_x = 0;
+                        ctx->tf_64x64_mv_y = 0;
+                        tf_64x64_inter_prediction(centre_pcs,
+                                                  ctx,
+                                                  pcs_list[frame_index],
+                                                  list_input_picture_ptr[frame_index],
+                                                  pred,
+                                                  pred_16bit,
+                                                  (uint32_t)blk_col * BW,
+                                                  (uint32_t)blk_row * BH,
+                                                  ss_x,
+                                                  encoder_bit_depth);
+                        convert_64x64_info_to_32x32_info(centre_pcs, ctx,
+                            pred,
+                            pred_16bit,
+                            stride_pred,
+                            src_center_ptr,
+                            altref_buffer_highbd_ptr,
+                            stride,
+                            is_highbd);
+                    }
+                    else if (ctx->tf_use_pred_64x64_only_th &&
                         (ctx->tf_use_pred_64x64_only_th == (uint8_t)~0 ||
                          tf_use_64x64_pred(ctx))) {
                         tf_64x64_sub_pel_search(
@@ -3273,6 +3367,10 @@ static EbErrorType produce_temporally_filtered_pic(
                                                              encoder_bit_depth);
                         }
                     }
+                    seed_mv_x = ctx->tf_64x64_mv_x;
+                    seed_mv_y = ctx->tf_64x64_mv_y;
+                    seed_dist = dist;
+                }
                 }
             }
 
@@ -3768,6 +3866,7 @@ void pad_and_decimate_filtered_pic(PictureParentControlSet *centre_pcs) {
                                        input_pic,
                                        src_object->quarter_downsampled_picture_ptr,
                                        src_object->sixteenth_downsampled_picture_ptr);
+    src_object->content_version++;
 }
 
 // save original enchanced_picture_ptr buffer in a separate buffer (to be replaced by the temporally filtered pic)
@@ -3953,6 +4052,8 @@ EbErrorType svt_av1_init_temporal_filtering(
 
     me_context_ptr->me_ctx->tf_tot_horz_blks =
         me_context_ptr->me_ctx->tf_tot_vert_blks = 0;
+    me_context_ptr->me_ctx->tf_tot_blks = me_context_ptr->me_ctx->tf_skip_blks =
+        me_context_ptr->me_ctx->tf_seed_blks = 0;
     // index of the central source frame
     index_center = centre_pcs->past_altref_nframes;
 
@@ -4061,9 +4162,24 @@ EbErrorType svt_av1_init_temporal_filtering(
         me_context_ptr->me_ctx->tf_tot_horz_blks;
     centre_pcs->tf_tot_vert_blks +=
         me_context_ptr->me_ctx->tf_tot_vert_blks;
+    centre_pcs->tf_tot_blks += me_context_ptr->me_ctx->tf_tot_blks;
+    centre_pcs->tf_skip_blks += me_context_ptr->me_ctx->tf_skip_blks;
+    centre_pcs->tf_seed_blks += me_context_ptr->me_ctx->tf_seed_blks;
 
     if (centre_pcs->temp_filt_seg_acc ==
         centre_pcs->tf_segments_total_count) {
+        // Block early exit stats (the low delay path has no motion search to skip)
+        if (centre_pcs->tf_tot_blks && (centre_pcs->tf_ctrls.zz_skip_th || centre_pcs->tf_ctrls.seed_me)) {
+            EncodeContext *enc_ctx = centre_pcs->scs->enc_ctx;
+            svt_atomic_fetch_add_u64(&enc_ctx->tf_tot_blks, centre_pcs->tf_tot_blks);
+            svt_atomic_fetch_add_u64(&enc_ctx->tf_skip_blks, centre_pcs->tf_skip_blks);
+            svt_atomic_fetch_add_u64(&enc_ctx->tf_seed_blks, centre_pcs->tf_seed_blks);
+            SVT_DEBUG("TF POC %" PRIu64 ": %u blocks, %u%% skipped, %u%% seeded\n",
+                      centre_pcs->picture_number,
+                      centre_pcs->tf_tot_blks,
+                      centre_pcs->tf_skip_blks * 100 / centre_pcs->tf_tot_blks,
+                      centre_pcs->tf_seed_blks * 100 / centre_pcs->tf_tot_blks);
+        }
 #if DEBUG_TF
         if (!is_highbd)
             save_YUV_to_file("filtered_picture.yuv",
@@ -1192,6 +1192,26 @@ static EbErrorType load_default_buffer_configuration_settings(
     }
 #endif
 
+    if (scs->static_config.worker_pool_size) {
+        // With a worker pool only slot holders run, so idle threads are cheap: let every
+        // parallel stage spread over the whole pool when it is the bottleneck
+        const int32_t pool = (int32_t)scs->static_config.worker_pool_size;
+        scs->picture_analysis_process_init_count = MAX(scs->picture_analysis_process_init_count, (uint32_t)clamp(pool, 1, max_pa_proc));
+        scs->motion_estimation_process_init_count = MAX(scs->motion_estimation_process_init_count, (uint32_t)clamp(pool, 1, max_me_proc));
+        scs->tpl_disp_process_init_count = MAX(scs->tpl_disp_process_init_count, (uint32_t)clamp(pool, 1, max_tpl_proc));
+        scs->mode_decision_configuration_process_init_count = MAX(scs->mode_decision_configuration_process_init_count, (uint32_t)clamp(pool, 1, max_mdc_proc));
+        scs->enc_dec_process_init_count = MAX(scs->enc_dec_process_init_count, (uint32_t)clamp(pool, 1, max_md_proc));
+        scs->entropy_coding_process_init_count = MAX(scs->entropy_coding_process_init_count, (uint32_t)clamp(pool, 1, max_ec_proc));
+        scs->dlf_process_init_count = MAX(scs->dlf_process_init_count, (uint32_t)clamp(pool, 1, max_dlf_proc));
+        scs->cdef_process_init_count = MAX(scs->cdef_process_init_count, (uint32_t)clamp(pool, 1, max_cdef_proc));
+        scs->rest_process_init_count = MAX(scs->rest_process_init_count, (uint32_t)clamp(pool, 1, max_rest_proc));
+        scs->total_process_init_count = scs->source_based_operations_process_init_count +
+            scs->picture_analysis_process_init_count + scs->motion_estimation_process_init_count +
+            scs->tpl_disp_process_init_count + scs->mode_decision_configuration_process_init_count +
+            scs->enc_dec_process_init_count + scs->entropy_coding_process_init_count + scs->dlf_process_init_count +
+            scs->cdef_process_init_count + scs->rest_process_init_count;
+    }
+
     scs->total_process_init_count += 6; // single processes count
 #if CLN_LP_LVLS
     if (scs->static_config.pass == 0 || scs->static_config.pass == 2) {
@@ -1393,10 +1413,59 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 /**********************************
 * Encoder Library Handle Deonstructor
 **********************************/
+/**************************************
+* Zero-copy input: a caller frame referenced by the y8b and the regular input
+* descriptors of a picture, handed back once both are recycled
+**************************************/
+typedef struct EbInputFrameRef {
+    EbExtFrameBuf     frame;
+    volatile uint32_t live_count;
+    // buffers allocated with the descriptors, restored on recycle
+    EbByte own_buffer_y;
+    EbByte own_buffer_cb;
+    EbByte own_buffer_cr;
+} EbInputFrameRef;
+
+static void release_input_frame(EbEncHandle *enc_handle_ptr, EbExtFrameBuf *frame) {
+    enc_handle_ptr->event_callbacks.release_input_frame(frame, enc_handle_ptr->event_callbacks.user_data);
+}
+
+static void input_frame_ref_release(EbEncHandle *enc_handle_ptr, EbInputFrameRef *ref) {
+    if (svt_atomic_fetch_sub_u32(&ref->live_count, 1) == 1) {
+        release_input_frame(enc_handle_ptr, &ref->frame);
+        free(ref);
+    }
+}
+
+static void input_y8b_recycle(void *p, EbObjectWrapper *wrapper_ptr) {
+    EbPictureBufferDesc *desc = (EbPictureBufferDesc *)((EbBufferHeaderType *)wrapper_ptr->object_ptr)->p_buffer;
+    EbInputFrameRef     *ref  = desc->ext_frame_ref;
+    if (ref) {
+        desc->buffer_y      = ref->own_buffer_y;
+        desc->ext_frame_ref = NULL;
+        input_frame_ref_release((EbEncHandle *)p, ref);
+    }
+}
+
+static void input_buffer_recycle(void *p, EbObjectWrapper *wrapper_ptr) {
+    EbPictureBufferDesc *desc = (EbPictureBufferDesc *)((EbBufferHeaderType *)wrapper_ptr->object_ptr)->p_buffer;
+    EbInputFrameRef     *ref  = desc->ext_frame_ref;
+    if (ref) {
+        desc->buffer_cb     = ref->own_buffer_cb;
+        desc->buffer_cr     = ref->own_buffer_cr;
+        desc->ext_frame_ref = NULL;
+        input_frame_ref_release((EbEncHandle *)p, ref);
+    }
+}
+
 static void svt_enc_handle_dctor(EbPtr p)
 {
     EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
     svt_enc_handle_stop_threads(enc_handle_ptr);
+    EB_DELETE(enc_handle_ptr->tracer);
+    EB_DELETE(enc_handle_ptr->worker_channel);
+    EB_DELETE(enc_handle_ptr->worker_pool);
+    EB_DESTROY_SEMAPHORE(enc_handle_ptr->eos_delivered_semaphore);
     EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -1409,6 +1478,13 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->tpl_reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->overlay_input_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->input_cmd_resource_ptr);
+    // hand back caller frames still referenced so their planes are not freed with the pools
+    if (enc_handle_ptr->input_y8b_buffer_resource_ptr && enc_handle_ptr->input_buffer_resource_ptr) {
+        for (uint32_t w_i = 0; w_i < enc_handle_ptr->input_y8b_buffer_resource_ptr->object_total_count; ++w_i)
+            input_y8b_recycle(enc_handle_ptr, enc_handle_ptr->input_y8b_buffer_resource_ptr->wrapper_ptr_pool[w_i]);
+        for (uint32_t w_i = 0; w_i < enc_handle_ptr->input_buffer_resource_ptr->object_total_count; ++w_i)
+            input_buffer_recycle(enc_handle_ptr, enc_handle_ptr->input_buffer_resource_ptr->wrapper_ptr_pool[w_i]);
+    }
     EB_DELETE(enc_handle_ptr->input_y8b_buffer_resource_ptr);
 
     //all buffer_y have been redirected to y8b location that just got released.
@@ -1458,7 +1534,8 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->rate_control_context_ptr);
     EB_DELETE(enc_handle_ptr->packetization_context_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
-
+    if (enc_handle_ptr->use_allocator)
+        svt_unregister_alloc_user();
 }
 
 /**********************************
@@ -1482,7 +1559,8 @@ static EbErrorType svt_enc_handle_ctor(
 
     // Config Set Count
     enc_handle_ptr->scs_pool_total_count = EB_SequenceControlSetPoolInitCount;
-    // Initialize Sequence Control Set Instance Array
+    // Initialize Sequence Control Set Instance Array, svt_av1_enc_init_handle() leaves the scope
+    svt_set_alloc_scope(NULL, SVT_AV1_ALLOC_TAG_SEQUENCE_CONTROL_SET, &enc_handle_ptr->mem_usage);
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->scs_instance_array, enc_handle_ptr->encode_instance_total_count);
     EB_NEW(enc_handle_ptr->scs_instance_array[0], svt_sequence_control_set_instance_ctor);
 
@@ -1844,10 +1922,37 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
 
 void init_fn_ptr(void);
 void svt_av1_init_wedge_masks(void);
-/**********************************
-* Initialize Encoder Library
-**********************************/
-EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
+/*
+    count the input buffer coming back and signal input_slot_available when it
+    completes a free (y8b, regular) pair
+*/
+static void input_slot_released(EbEncHandle *enc_handle_ptr, volatile uint32_t *released_count,
+                                volatile uint32_t *other_count) {
+    const uint32_t free_count = svt_atomic_fetch_add_u32(released_count, 1) + 1;
+    if (free_count <= svt_atomic_load_u32(other_count))
+        enc_handle_ptr->event_callbacks.input_slot_available(enc_handle_ptr->event_callbacks.user_data);
+}
+
+static void input_y8b_released(void *p) {
+    EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
+    input_slot_released(enc_handle_ptr, &enc_handle_ptr->free_input_y8b_count, &enc_handle_ptr->free_input_buffer_count);
+}
+
+static void input_buffer_released(void *p) {
+    EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
+    input_slot_released(enc_handle_ptr, &enc_handle_ptr->free_input_buffer_count, &enc_handle_ptr->free_input_y8b_count);
+}
+
+// Accounts the allocations of the current init section to the handle, and routes
+// them to the host allocator if there is one
+static void set_alloc_scope(EbEncHandle *enc_handle_ptr, SvtAv1AllocTag tag)
+{
+    svt_set_alloc_scope(enc_handle_ptr->use_allocator ? &enc_handle_ptr->allocator : NULL,
+                        tag,
+                        &enc_handle_ptr->mem_usage);
+}
+
+static EbErrorType init_encoder(EbComponentType *svt_enc_component)
 {
     if(svt_enc_component == NULL)
         return EB_ErrorBadParameter;
@@ -1879,6 +1984,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     /************************************
      * Sequence Control Set
      ************************************/
+    set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_SEQUENCE_CONTROL_SET);
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->scs_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
         EB_NEW(
@@ -1959,6 +2065,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         input_data.variance_octile = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.variance_octile;
         input_data.static_config = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config;
 
+        set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_PCS);
         EB_NEW(
             enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
             svt_system_resource_ctor,
@@ -1971,6 +2078,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 #if SRM_REPORT
         enc_handle_ptr->picture_parent_control_set_pool_ptr_array[0]->empty_queue->log = 0;
 #endif
+        set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_ME_RESULTS);
         EB_NEW(
             enc_handle_ptr->me_pool_ptr_array[instance_index],
             svt_system_resource_ctor,
@@ -1988,6 +2096,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
 
 
+        set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_ENC_DEC);
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->enc_dec_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
         for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
@@ -2048,6 +2157,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         /************************************
         * Picture Control Set: Child
         ************************************/
+        set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_PCS);
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
         for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
@@ -2109,6 +2219,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     * Picture Buffers
     ************************************/
 
+    set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_REFERENCE_PICTURE);
     // Allocate Resource Arrays
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->tpl_reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -2136,15 +2247,26 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         PictureControlSet *pcs = (PictureControlSet *)enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr;
         enc_handle_ptr->scs_instance_array[instance_index]->scs->rest_units_per_tile = pcs->rst_info[0/*Y-plane*/].units_per_tile;
         enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_total_count = pcs->b64_total_count;
+        set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_ME_RESULTS);
+        EB_NEW(enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->hme_cache,
+               svt_aom_hme_cache_ctor,
+               enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_total_count);
+        set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_ENC_DEC);
+        EB_NEW(enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->mv_rate_cache,
+               svt_aom_mv_rate_cache_ctor);
+        set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_REFERENCE_PICTURE);
         create_ref_buf_descs(enc_handle_ptr, instance_index);
+        set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_TPL);
 #if FTR_STILL_PICTURE
         if(enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl)
 #endif
         create_tpl_ref_buf_descs(enc_handle_ptr, instance_index);
 
+        set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_PA_REFERENCE);
         create_pa_ref_buf_descs(enc_handle_ptr, instance_index);
 
         if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.enable_overlays) {
+            set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_INPUT_PICTURE);
             // Overlay Input Picture Buffers
             EB_NEW(
                 enc_handle_ptr->overlay_input_picture_pool_ptr_array[instance_index],
@@ -2164,6 +2286,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     * System Resource Managers & Fifos
     ************************************/
 
+    set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_INPUT_PICTURE);
     //SRM to link App to Ress-Coordination via Input commands. an Input Command holds 2 picture buffers: y8bit and rest(uv8b + yuv2b)
     EB_NEW(
         enc_handle_ptr->input_cmd_resource_ptr,
@@ -2204,6 +2327,23 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 #endif
     enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_y8b_buffer_resource_ptr, 0);
 
+    // A picture can be sent once both its y8b and its regular input buffer are free
+    enc_handle_ptr->free_input_y8b_count = enc_handle_ptr->input_y8b_buffer_resource_ptr->object_total_count;
+    enc_handle_ptr->free_input_buffer_count = enc_handle_ptr->input_buffer_resource_ptr->object_total_count;
+    enc_handle_ptr->input_y8b_buffer_resource_ptr->release_callback_data = enc_handle_ptr;
+    enc_handle_ptr->input_buffer_resource_ptr->release_callback_data = enc_handle_ptr;
+    if (enc_handle_ptr->event_callbacks.input_slot_available) {
+        enc_handle_ptr->input_y8b_buffer_resource_ptr->release_callback = input_y8b_released;
+        enc_handle_ptr->input_buffer_resource_ptr->release_callback = input_buffer_released;
+    }
+    // Caller frames referenced by the input pictures go back when the pictures are recycled
+    if (enc_handle_ptr->event_callbacks.release_input_frame) {
+        enc_handle_ptr->input_y8b_buffer_resource_ptr->recycle_callback = input_y8b_recycle;
+        enc_handle_ptr->input_buffer_resource_ptr->recycle_callback = input_buffer_recycle;
+    }
+    EB_CREATE_SEMAPHORE(enc_handle_ptr->eos_delivered_semaphore, 0, 1);
+
+    set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_OUTPUT_BUFFER);
     // EbBufferHeaderType Output Stream
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
@@ -2237,6 +2377,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         enc_handle_ptr->output_recon_buffer_consumer_fifo_ptr = svt_system_resource_get_consumer_fifo(enc_handle_ptr->output_recon_buffer_resource_ptr_array[0], 0);
     }
 
+    set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_RESULTS);
     // Resource Coordination Results
     {
         ResourceCoordinationResultInitData resource_coordination_result_init_data;
@@ -2414,13 +2555,15 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     //DLF results
     {
         EntropyCodingResultsInitData delf_result_init_data;
+        SequenceControlSet          *scs = enc_handle_ptr->scs_instance_array[0]->scs;
 
+        // CDEF also posts its strength search tasks back to itself
         EB_NEW(
             enc_handle_ptr->dlf_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->dlf_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count,
+            scs->dlf_fifo_init_count,
+            scs->dlf_process_init_count + scs->cdef_process_init_count,
+            scs->cdef_process_init_count,
             dlf_results_creator,
             &delf_result_init_data,
             NULL);
@@ -2442,13 +2585,15 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     //REST results
     {
         EntropyCodingResultsInitData rest_result_init_data;
+        SequenceControlSet          *scs = enc_handle_ptr->scs_instance_array[0]->scs;
 
+        // With sub-frame output EncDec also hands its tiles straight to entropy coding
         EB_NEW(
             enc_handle_ptr->rest_results_resource_ptr,
             svt_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[0]->scs->rest_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count,
+            scs->rest_fifo_init_count,
+            scs->rest_process_init_count + (scs->static_config.sub_frame_output ? scs->enc_dec_process_init_count : 0),
+            scs->entropy_coding_process_init_count,
             rest_results_creator,
             &rest_result_init_data,
             NULL);
@@ -2470,6 +2615,35 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     }
 
 
+    // Pipeline telemetry, each stage accounts the full queue it consumes
+    {
+        EbStageStats *stage_stats = enc_handle_ptr->scs_instance_array[0]->enc_ctx->stage_stats;
+        enc_handle_ptr->input_cmd_resource_ptr->stage_stats                    = &stage_stats[SVT_AV1_STAGE_RESOURCE_COORDINATION];
+        enc_handle_ptr->resource_coordination_results_resource_ptr->stage_stats = &stage_stats[SVT_AV1_STAGE_PICTURE_ANALYSIS];
+        enc_handle_ptr->picture_analysis_results_resource_ptr->stage_stats      = &stage_stats[SVT_AV1_STAGE_PICTURE_DECISION];
+        enc_handle_ptr->picture_decision_results_resource_ptr->stage_stats      = &stage_stats[SVT_AV1_STAGE_MOTION_ESTIMATION];
+        enc_handle_ptr->motion_estimation_results_resource_ptr->stage_stats     = &stage_stats[SVT_AV1_STAGE_INITIAL_RATE_CONTROL];
+        enc_handle_ptr->initial_rate_control_results_resource_ptr->stage_stats  = &stage_stats[SVT_AV1_STAGE_SOURCE_BASED_OPERATIONS];
+        enc_handle_ptr->tpl_disp_res_srm->stage_stats                           = &stage_stats[SVT_AV1_STAGE_TPL_DISPENSER];
+        enc_handle_ptr->picture_demux_results_resource_ptr->stage_stats         = &stage_stats[SVT_AV1_STAGE_PICTURE_MANAGER];
+        enc_handle_ptr->rate_control_tasks_resource_ptr->stage_stats            = &stage_stats[SVT_AV1_STAGE_RATE_CONTROL];
+        enc_handle_ptr->rate_control_results_resource_ptr->stage_stats          = &stage_stats[SVT_AV1_STAGE_MODE_DECISION_CONFIGURATION];
+        enc_handle_ptr->enc_dec_tasks_resource_ptr->stage_stats                 = &stage_stats[SVT_AV1_STAGE_ENC_DEC];
+        enc_handle_ptr->enc_dec_results_resource_ptr->stage_stats               = &stage_stats[SVT_AV1_STAGE_DLF];
+        enc_handle_ptr->dlf_results_resource_ptr->stage_stats                   = &stage_stats[SVT_AV1_STAGE_CDEF];
+        enc_handle_ptr->cdef_results_resource_ptr->stage_stats                  = &stage_stats[SVT_AV1_STAGE_RESTORATION];
+        enc_handle_ptr->rest_results_resource_ptr->stage_stats                  = &stage_stats[SVT_AV1_STAGE_ENTROPY_CODING];
+        enc_handle_ptr->entropy_coding_results_resource_ptr->stage_stats        = &stage_stats[SVT_AV1_STAGE_PACKETIZATION];
+
+        const char *trace_file = enc_handle_ptr->scs_instance_array[0]->scs->static_config.trace_file;
+        if (trace_file)
+            EB_NEW(enc_handle_ptr->tracer, svt_tracer_ctor, trace_file);
+        for (uint32_t stage = 0; stage < SVT_AV1_STAGE_COUNT; stage++) {
+            stage_stats[stage].stage  = stage;
+            stage_stats[stage].tracer = enc_handle_ptr->tracer;
+        }
+    }
+
     /************************************
     * App Callbacks
     ************************************/
@@ -2485,6 +2659,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     /************************************
     * Contexts
     ************************************/
+    set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_CONTEXT);
 
     // Resource Coordination Context
     EB_NEW(
@@ -2653,6 +2828,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     /************************************
     * Thread Handles
     ************************************/
+    set_alloc_scope(enc_handle_ptr, SVT_AV1_ALLOC_TAG_OTHER);
     EbSvtAv1EncConfiguration   *config_ptr = &enc_handle_ptr->scs_instance_array[0]->scs->static_config;
 #if CLN_LP_LVLS
     if (config_ptr->pin_threads || config_ptr->target_socket != -1)
@@ -2663,6 +2839,22 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs;
 
+    // Worker pool shared by all kernel threads, either private or shared with other encoders
+    if (config_ptr->shared_worker_pool || config_ptr->worker_pool_size) {
+        EbWorkerPool *pool = config_ptr->shared_worker_pool;
+        if (pool == NULL) {
+            EB_NEW(enc_handle_ptr->worker_pool, svt_worker_pool_ctor, config_ptr->worker_pool_size);
+            pool = enc_handle_ptr->worker_pool;
+        }
+        EB_NEW(enc_handle_ptr->worker_channel, svt_worker_channel_ctor, pool);
+        SVT_INFO("Channel %u: %u threads on a worker pool of %u slots%s\n",
+                 config_ptr->channel_id + 1,
+                 control_set_ptr->total_process_init_count,
+                 pool->slot_count,
+                 config_ptr->shared_worker_pool ? " (shared)" : "");
+    }
+    svt_set_thread_creation_channel(enc_handle_ptr->worker_channel);
+
     // Resource Coordination
     EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, svt_aom_resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
     EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
@@ -2727,13 +2919,29 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     // Packetization
     EB_CREATE_THREAD(enc_handle_ptr->packetization_thread_handle, svt_aom_packetization_kernel, enc_handle_ptr->packetization_context_ptr);
+    svt_set_thread_creation_channel(NULL);
 
     svt_print_memory_usage();
 
     return return_error;
 }
 
+/**********************************
+* Initialize Encoder Library
+**********************************/
+EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
+{
+    EbErrorType return_error = init_encoder(svt_enc_component);
+    // init can bail out from any section, never leave the application thread in a scope
+    svt_set_alloc_scope(NULL, SVT_AV1_ALLOC_TAG_OTHER, NULL);
+    return return_error;
+}
+
 static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
+    EbEncHandle *handle = svt_enc_component->p_component_private;
+    // Packets go to the packet_ready callback, only wait for the last one to be handed over
+    if (handle->event_callbacks.packet_ready)
+        return svt_block_on_semaphore(handle->eos_delivered_semaphore);
     bool eos = false;
     do {
         EbBufferHeaderType *receive_buffer = NULL;
@@ -2752,6 +2960,56 @@ static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
     return EB_ErrorNone;
 }
 
+/**********************************
+* Register event callbacks
+**********************************/
+EB_API EbErrorType svt_av1_enc_set_callbacks(
+    EbComponentType          *svt_enc_component,
+    const SvtAv1EncCallbacks *callbacks)
+{
+    if (!svt_enc_component || !svt_enc_component->p_component_private)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = svt_enc_component->p_component_private;
+    // The kernels pick the callbacks up when they are created
+    if (enc_handle_ptr->packetization_thread_handle) {
+        SVT_ERROR("Callbacks must be set before svt_av1_enc_init\n");
+        return EB_ErrorBadParameter;
+    }
+    if (callbacks)
+        enc_handle_ptr->event_callbacks = *callbacks;
+    else
+        memset(&enc_handle_ptr->event_callbacks, 0, sizeof(enc_handle_ptr->event_callbacks));
+    return EB_ErrorNone;
+}
+
+EB_API EbErrorType svt_av1_enc_set_allocator(
+    EbComponentType       *svt_enc_component,
+    const SvtAv1Allocator *allocator)
+{
+    if (!svt_enc_component || !svt_enc_component->p_component_private)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = svt_enc_component->p_component_private;
+    // Blocks already allocated remember the allocator they came from
+    if (enc_handle_ptr->scs_pool_ptr_array) {
+        SVT_ERROR("The allocator must be set before svt_av1_enc_init\n");
+        return EB_ErrorBadParameter;
+    }
+    if (allocator && (!allocator->alloc || !allocator->aligned_alloc || !allocator->free)) {
+        SVT_ERROR("The allocator needs alloc, aligned_alloc and free functions\n");
+        return EB_ErrorBadParameter;
+    }
+    if (allocator && !enc_handle_ptr->use_allocator)
+        svt_register_alloc_user();
+    else if (!allocator && enc_handle_ptr->use_allocator)
+        svt_unregister_alloc_user();
+    if (allocator)
+        enc_handle_ptr->allocator = *allocator;
+    else
+        memset(&enc_handle_ptr->allocator, 0, sizeof(enc_handle_ptr->allocator));
+    enc_handle_ptr->use_allocator = allocator != NULL;
+    return EB_ErrorNone;
+}
+
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
@@ -2792,6 +3050,8 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
     svt_shutdown_process(handle->cdef_results_resource_ptr);
     svt_shutdown_process(handle->rest_results_resource_ptr);
 
+    if (handle->tracer)
+        return svt_tracer_dump(handle->tracer);
     return EB_ErrorNone;
 }
 
@@ -2824,6 +3084,7 @@ EB_API EbErrorType svt_av1_enc_init_handle(
     // Init Component OS objects (threads, semaphores, etc.)
     // also links the various Component control functions
     EbErrorType return_error = init_svt_av1_encoder_handle(*p_handle);
+    svt_set_alloc_scope(NULL, SVT_AV1_ALLOC_TAG_OTHER, NULL);
 
     if (return_error == EB_ErrorNone) {
         ((EbComponentType*)(*p_handle))->p_application_private = p_app_data;
@@ -2875,6 +3136,39 @@ EB_API EbErrorType svt_av1_enc_deinit_handle(
     return EB_ErrorInvalidComponent;
 }
 
+/**********************************
+* Worker pool shared between encoder handles
+**********************************/
+EB_API EbErrorType svt_av1_enc_create_worker_pool(
+    EbSvtAv1WorkerPool **p_pool,
+    uint32_t             slot_count)
+{
+    if (p_pool == NULL)
+        return EB_ErrorBadParameter;
+    *p_pool = NULL;
+    if (slot_count == 0 || slot_count > MAX_WORKER_POOL_SIZE) {
+        SVT_ERROR("Invalid worker pool size %u, must be [1 - %d]\n", slot_count, MAX_WORKER_POOL_SIZE);
+        return EB_ErrorBadParameter;
+    }
+    EbWorkerPool *pool;
+    EB_NEW(pool, svt_worker_pool_ctor, slot_count);
+    *p_pool = pool;
+    return EB_ErrorNone;
+}
+
+EB_API EbErrorType svt_av1_enc_destroy_worker_pool(
+    EbSvtAv1WorkerPool *pool)
+{
+    if (pool == NULL)
+        return EB_ErrorBadParameter;
+    if (pool->channel_list) {
+        SVT_ERROR("Worker pool is still used by an encoder handle\n");
+        return EB_ErrorBadParameter;
+    }
+    EB_DELETE(pool);
+    return EB_ErrorNone;
+}
+
 // Sets the default intra period the closest possible to 1 second without breaking the minigop
 static int32_t compute_default_intra_period(
     SequenceControlSet       *scs){
@@ -3735,6 +4029,17 @@ static void derive_tf_params(SequenceControlSet *scs) {
      }
     tf_controls(scs, tf_level);
 }
+/*
+ * Set the TF block early exit Params (applies to all frame types)
+ */
+static void set_tf_early_exit_ctrls(SequenceControlSet *scs, Bool tf_early_exit) {
+    for (int type = 0; type < 3; type++) {
+        TfControls *tf_ctrls = &scs->tf_params_per_type[type];
+        // Static noise gives a zero-motion MSE of twice the noise variance
+        tf_ctrls->zz_skip_th = tf_early_exit ? 250 : 0;
+        tf_ctrls->seed_me    = tf_early_exit ? 1 : 0;
+    }
+}
 
 
 /*
@@ -4155,8 +4460,9 @@ void set_multi_pass_params(SequenceControlSet *scs)
 
     if (scs->static_config.recode_loop > 0 &&
         ((scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_CQP_OR_CRF && scs->static_config.max_bit_rate == 0) ||
-        (scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_CBR))) {
-        // Only allow re-encoding for VBR or capped CRF, otherwise force recode_loop to DISALLOW_RECODE or 0
+        (scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_CBR) || scs->static_config.sub_frame_output)) {
+        // Only allow re-encoding for VBR or capped CRF, otherwise force recode_loop to DISALLOW_RECODE or 0.
+        // Sub-frame output sends tile rows while the frame is being coded, so it can't be re-encoded
         scs->static_config.recode_loop = DISALLOW_RECODE;
     }
     else if (scs->static_config.recode_loop == ALLOW_RECODE_DEFAULT) {
@@ -4259,6 +4565,16 @@ static void set_param_based_on_input(SequenceControlSet *scs)
                 "This mode retains a significant amount of memory, much more than other modes!\n");
         }
     }
+    if (scs->static_config.sub_frame_output) {
+        // The frame header goes out with the first tile row, so the filters whose parameters
+        // are searched on the whole frame are off. Frames are split at tile rows
+        scs->static_config.cdef_level = 0;
+        scs->static_config.enable_restoration_filtering = 0;
+        if (scs->static_config.tile_rows == 0) {
+            SVT_WARN("Sub-frame output splits frames at tile rows, tile rows set to 2 (log2)\n");
+            scs->static_config.tile_rows = 2;
+        }
+    }
     // Set initial qp for vbr and middle pass
     if ((scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_VBR) || (scs->static_config.pass == ENC_FIRST_PASS)) {
         if (scs->static_config.qp != DEFAULT_QP) {
@@ -4292,6 +4608,7 @@ static void set_param_based_on_input(SequenceControlSet *scs)
 
     // Set TF level
     derive_tf_params(scs);
+    set_tf_early_exit_ctrls(scs, scs->static_config.tf_early_exit);
 
     //Future frames window in Scene Change Detection (SCD) / TemporalFiltering
     scs->scd_delay = 0;
@@ -4351,6 +4668,19 @@ static void set_param_based_on_input(SequenceControlSet *scs)
             // update the look ahead size
             update_look_ahead(scs);
     }
+    // Incremental TPL reuses the results of the overlapping mini-gop of consecutive TPL groups,
+    // and keeps TPL reconstructions that would not match a frame coded at another resolution
+    if (scs->static_config.incremental_tpl &&
+        (scs->static_config.superres_mode > SUPERRES_NONE || scs->static_config.resize_mode > RESIZE_NONE)) {
+        SVT_WARN("Incremental TPL is not supported with super resolution or resize, disabled\n");
+        scs->static_config.incremental_tpl = FALSE;
+    }
+    // The downsampled pictures are built from the unscaled source
+    if (scs->static_config.tpl_downscale &&
+        (scs->static_config.superres_mode > SUPERRES_NONE || scs->static_config.resize_mode > RESIZE_NONE)) {
+        SVT_WARN("Downscaled TPL is not supported with super resolution or resize, disabled\n");
+        scs->static_config.tpl_downscale = 0;
+    }
     // when resize mode is used, use sb 64 because of a r2r when 128 is used
     // In low delay mode, sb size is set to 64
     // in 240P resolution, sb size is set to 64
@@ -4967,6 +5297,16 @@ static void copy_api_from_app(
 #endif
     scs->static_config.pin_threads = ((EbSvtAv1EncConfiguration*)config_struct)->pin_threads;
     scs->static_config.target_socket = ((EbSvtAv1EncConfiguration*)config_struct)->target_socket;
+    scs->static_config.worker_pool_size = ((EbSvtAv1EncConfiguration*)config_struct)->worker_pool_size;
+    scs->static_config.shared_worker_pool = ((EbSvtAv1EncConfiguration*)config_struct)->shared_worker_pool;
+    scs->static_config.trace_file = ((EbSvtAv1EncConfiguration*)config_struct)->trace_file;
+    scs->static_config.sub_frame_output = ((EbSvtAv1EncConfiguration*)config_struct)->sub_frame_output;
+    scs->static_config.incremental_tpl = ((EbSvtAv1EncConfiguration*)config_struct)->incremental_tpl;
+    scs->static_config.tpl_downscale = ((EbSvtAv1EncConfiguration*)config_struct)->tpl_downscale;
+    scs->static_config.tf_early_exit = ((EbSvtAv1EncConfiguration*)config_struct)->tf_early_exit;
+    // A shared pool dictates the slot count the stages are sized for
+    if (scs->static_config.shared_worker_pool)
+        scs->static_config.worker_pool_size = scs->static_config.shared_worker_pool->slot_count;
 #if !CLN_LP_LVLS
     if ((scs->static_config.pin_threads == 0) && (scs->static_config.target_socket != -1)){
         SVT_WARN("threads pinning 0 and ss %d is not a valid combination: unpin will be set to 0\n", scs->static_config.target_socket);
@@ -5729,6 +6069,70 @@ static void copy_input_buffer(SequenceControlSet* scs, EbBufferHeaderType* dst,
     else
         dst->p_app_private = NULL;
 }
+/*
+ Check whether the caller's planes follow the layout the library buffers use,
+so that they can be referenced instead of copied
+*/
+static Bool can_reference_input_buffer(SequenceControlSet* scs, EbBufferHeaderType* dst,
+                                       EbBufferHeaderType* dst_y8b, EbBufferHeaderType* src, int pass) {
+    const EbSvtAv1EncConfiguration* config = &scs->static_config;
+    if (src->p_buffer == NULL || pass == ENCODE_FIRST_PASS || scs->first_pass_ctrls.ds ||
+        config->encoder_bit_depth != EB_EIGHT_BIT || config->encoder_color_format != EB_YUV420)
+        return FALSE;
+    const EbSvtIOFormat*       input_ptr = (EbSvtIOFormat*)src->p_buffer;
+    const EbPictureBufferDesc* y8b_pic   = (EbPictureBufferDesc*)dst_y8b->p_buffer;
+    const EbPictureBufferDesc* input_pic = (EbPictureBufferDesc*)dst->p_buffer;
+    return input_ptr->y_stride == y8b_pic->stride_y && input_ptr->cb_stride == input_pic->stride_cb &&
+        input_ptr->cr_stride == input_pic->stride_cr;
+}
+
+/*
+ Point the library buffers to the planes of the sample application (zero-copy input),
+the caller frame is handed back once both buffers are recycled
+*/
+static EbErrorType reference_input_buffer(EbBufferHeaderType* dst, EbBufferHeaderType* dst_y8b,
+                                          EbBufferHeaderType* src) {
+    EbPictureBufferDesc* y8b_pic   = (EbPictureBufferDesc*)dst_y8b->p_buffer;
+    EbPictureBufferDesc* input_pic = (EbPictureBufferDesc*)dst->p_buffer;
+    EbSvtIOFormat*       input_ptr = (EbSvtIOFormat*)src->p_buffer;
+
+    EbInputFrameRef* ref = (EbInputFrameRef*)malloc(sizeof(*ref));
+    if (ref == NULL)
+        return EB_ErrorInsufficientResources;
+    ref->frame.buffer       = input_ptr->luma;
+    ref->frame.buffer_size  = src->n_filled_len;
+    ref->frame.private_data = input_ptr;
+    ref->live_count         = 2;
+    ref->own_buffer_y       = y8b_pic->buffer_y;
+    ref->own_buffer_cb      = input_pic->buffer_cb;
+    ref->own_buffer_cr      = input_pic->buffer_cr;
+
+    y8b_pic->buffer_y = input_ptr->luma - (y8b_pic->stride_y * y8b_pic->org_y + y8b_pic->org_x);
+    input_pic->buffer_cb = input_ptr->cb - (input_pic->stride_cb * (input_pic->org_y >> 1) + (input_pic->org_x >> 1));
+    input_pic->buffer_cr = input_ptr->cr - (input_pic->stride_cr * (input_pic->org_y >> 1) + (input_pic->org_x >> 1));
+    y8b_pic->ext_frame_ref   = ref;
+    input_pic->ext_frame_ref = ref;
+
+    // Copy the higher level structure
+    dst->n_alloc_len  = src->n_alloc_len;
+    dst->n_filled_len = src->n_filled_len;
+    dst->flags        = src->flags;
+    dst->pts          = src->pts;
+    dst->n_tick_count = src->n_tick_count;
+    dst->size         = src->size;
+    dst->qp           = src->qp;
+    dst->pic_type     = src->pic_type;
+    // Copy the metadata array
+    if (svt_aom_copy_metadata_buffer(dst, src->metadata) != EB_ErrorNone)
+        dst->metadata = NULL;
+    // Copy the private data list
+    if (src->p_app_private)
+        copy_private_data_list(dst, src);
+    else
+        dst->p_app_private = NULL;
+    return EB_ErrorNone;
+}
+
 // Update the input picture definitions: resolution of the sequence
 static EbErrorType validate_on_the_fly_settings(EbBufferHeaderType *input_ptr, SequenceControlSet *scs, EbHandle config_mutex) {
     EbPrivDataNode     *node = (EbPrivDataNode *)input_ptr->p_app_private;
@@ -5893,6 +6297,8 @@ EB_API EbErrorType svt_av1_enc_send_picture(
         svt_input_y8b_update((EbBufferHeaderType*)y8b_wrapper->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs);
     //set live count to 1 to be decremented at the end of the encode in RC
     svt_object_inc_live_count(y8b_wrapper, 1);
+    if (enc_handle_ptr->event_callbacks.input_slot_available)
+        svt_atomic_fetch_sub_u32(&enc_handle_ptr->free_input_y8b_count, 1);
 
    // svt_object_inc_live_count(y8b_wrapper, 1);
 
@@ -5906,6 +6312,8 @@ EB_API EbErrorType svt_av1_enc_send_picture(
      //set live count to 1 to be decremented at the end of the encode in RC, and released
      //this would also allow low delay TF to retain pictures
      svt_object_inc_live_count(eb_wrapper_ptr, 1);
+    if (enc_handle_ptr->event_callbacks.input_slot_available)
+        svt_atomic_fetch_sub_u32(&enc_handle_ptr->free_input_buffer_count, 1);
 
     if (p_buffer != NULL) {
         enc_handle_ptr->eos_received += p_buffer->flags & EB_BUFFERFLAG_EOS;
@@ -5934,6 +6342,11 @@ EB_API EbErrorType svt_av1_enc_send_picture(
                 0);
             enc_handle_ptr->is_prev_valid = false;
         }
+        else if (enc_handle_ptr->event_callbacks.release_input_frame &&
+                 can_reference_input_buffer(scs, lib_reg_hdr, lib_y8b_hdr, app_hdr, 0) &&
+                 reference_input_buffer(lib_reg_hdr, lib_y8b_hdr, app_hdr) == EB_ErrorNone) {
+            // zero-copy: the frame goes back to the caller when the pictures are recycled
+        }
         else {
             copy_input_buffer(
                 enc_handle_ptr->scs_instance_array[0]->scs,
@@ -5942,6 +6355,12 @@ EB_API EbErrorType svt_av1_enc_send_picture(
                 app_hdr,
                 0);
         }
+        // copied frames are no longer needed by the library
+        if (enc_handle_ptr->event_callbacks.release_input_frame && app_hdr->p_buffer &&
+            !((EbPictureBufferDesc*)lib_y8b_hdr->p_buffer)->ext_frame_ref) {
+            EbExtFrameBuf frame = {((EbSvtIOFormat*)app_hdr->p_buffer)->luma, app_hdr->n_filled_len, app_hdr->p_buffer};
+            release_input_frame(enc_handle_ptr, &frame);
+        }
     }
 
     //Take a new App-RessCoord command
@@ -6007,7 +6426,8 @@ EB_API EbErrorType svt_av1_enc_get_packet(
 
     // if we have already sent out an EOS, then the user should not be calling
     // this function again, as it will just block inside svt_get_full_object()
-    if (enc_handle->eos_sent) {
+    // packets never reach the output fifo when they are delivered through packet_ready
+    if (enc_handle->eos_sent || enc_handle->event_callbacks.packet_ready) {
         *p_buffer = NULL;
         return EB_NoErrorEmptyQueue;
     }
@@ -6023,7 +6443,7 @@ EB_API EbErrorType svt_av1_enc_get_packet(
 
     if (eb_wrapper_ptr) {
         packet = (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr;
-        if ( packet->flags & 0xfffffff0 )
+        if (packet->flags & EB_BUFFERFLAG_ERROR_MASK)
             return_error = EB_ErrorMax;
         // return the output stream buffer
         *p_buffer = packet;
@@ -6471,6 +6891,64 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
         first_pass_stats->sz = context->stats_out.size * sizeof(FIRSTPASS_STATS);
         return EB_ErrorNone;
     }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_INPUT_FRAME_LAYOUT) {
+        // all the input buffers share the layout of the first ones
+        if (!enc_handle->input_y8b_buffer_resource_ptr || !enc_handle->input_buffer_resource_ptr)
+            return EB_ErrorBadParameter;
+        const EbPictureBufferDesc* y8b_pic = (EbPictureBufferDesc*)((EbBufferHeaderType*)
+            enc_handle->input_y8b_buffer_resource_ptr->wrapper_ptr_pool[0]->object_ptr)->p_buffer;
+        const EbPictureBufferDesc* input_pic = (EbPictureBufferDesc*)((EbBufferHeaderType*)
+            enc_handle->input_buffer_resource_ptr->wrapper_ptr_pool[0]->object_ptr)->p_buffer;
+        SvtAv1InputFrameLayout* layout = (SvtAv1InputFrameLayout*)info;
+        layout->luma_stride = y8b_pic->stride_y;
+        layout->chroma_stride = input_pic->stride_cb;
+        layout->luma_offset = y8b_pic->stride_y * y8b_pic->org_y + y8b_pic->org_x;
+        layout->chroma_offset = input_pic->stride_cb * (input_pic->org_y >> 1) + (input_pic->org_x >> 1);
+        layout->luma_size = y8b_pic->luma_size;
+        layout->chroma_size = input_pic->chroma_size;
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_MEMORY_USAGE) {
+        const EbMemUsage*  mem   = &enc_handle->mem_usage;
+        SvtAv1MemoryUsage* usage = (SvtAv1MemoryUsage*)info;
+        usage->malloc_bytes    = mem->by_type[EB_N_PTR];
+        usage->calloc_bytes    = mem->by_type[EB_C_PTR];
+        usage->aligned_bytes   = mem->by_type[EB_A_PTR];
+        usage->total_bytes     = usage->malloc_bytes + usage->calloc_bytes + usage->aligned_bytes;
+        usage->mutex_count     = (uint32_t)mem->by_type[EB_MUTEX];
+        usage->semaphore_count = (uint32_t)mem->by_type[EB_SEMAPHORE];
+        usage->thread_count    = (uint32_t)mem->by_type[EB_THREAD];
+        for (int tag = 0; tag < SVT_AV1_ALLOC_TAG_COUNT; tag++)
+            usage->bytes_by_tag[tag] = mem->heap_by_tag[tag];
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_PIPELINE_TELEMETRY) {
+        EncodeContext*           enc_ctx   = enc_handle->scs_instance_array[0]->enc_ctx;
+        SvtAv1PipelineTelemetry* telemetry = (SvtAv1PipelineTelemetry*)info;
+        for (int stage = 0; stage < SVT_AV1_STAGE_COUNT; stage++)
+            svt_stage_stats_read(&enc_ctx->stage_stats[stage], &telemetry->stage[stage]);
+        telemetry->picture_count = svt_atomic_load_u64(&enc_ctx->picture_count);
+        for (int bin = 0; bin < SVT_AV1_LATENCY_HISTOGRAM_BINS; bin++)
+            telemetry->picture_latency_histogram[bin] = svt_atomic_load_u64(&enc_ctx->picture_latency_histogram[bin]);
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_HME_CACHE_STATS) {
+        HmeCache*            hme_cache = enc_handle->scs_instance_array[0]->enc_ctx->hme_cache;
+        SvtAv1HmeCacheStats* stats    = (SvtAv1HmeCacheStats*)info;
+        if (!hme_cache)
+            return EB_ErrorBadParameter;
+        stats->hits   = svt_atomic_load_u64(&hme_cache->hits);
+        stats->misses = svt_atomic_load_u64(&hme_cache->misses);
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_TF_STATS) {
+        EncodeContext* enc_ctx = enc_handle->scs_instance_array[0]->enc_ctx;
+        SvtAv1TfStats* stats   = (SvtAv1TfStats*)info;
+        stats->blocks  = svt_atomic_load_u64(&enc_ctx->tf_tot_blks);
+        stats->skipped = svt_atomic_load_u64(&enc_ctx->tf_skip_blks);
+        stats->seeded  = svt_atomic_load_u64(&enc_ctx->tf_seed_blks);
+        return EB_ErrorNone;
+    }
     return EB_ErrorBadParameter;
 }
 // clang-format on
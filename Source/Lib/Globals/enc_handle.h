@@ -18,6 +18,7 @@
 #include "sys_resource_manager.h"
 #include "sequence_control_set.h"
 #include "object.h"
+#include "svt_trace.h"
 
 struct _EbThreadContext {
     EbDctor dctor;
@@ -76,6 +77,11 @@ struct _EbEncHandle {
 
     EbHandle packetization_thread_handle;
 
+    // Execution slots shared by all the threads above: worker_pool is only set when the
+    // pool is private to this handle, worker_channel whenever a pool is used
+    EbWorkerPool    *worker_pool;
+    EbWorkerChannel *worker_channel;
+
     // Contexts
     EbThreadContext  *resource_coordination_context_ptr;
     EbThreadContext **picture_analysis_context_ptr_array;
@@ -119,6 +125,20 @@ struct _EbEncHandle {
 
     // Callbacks
     EbCallback **app_callback_ptr_array;
+    // Event callbacks registered through svt_av1_enc_set_callbacks()
+    SvtAv1EncCallbacks event_callbacks;
+    // Posted by packetization once the EOS packet went through packet_ready
+    EbHandle eos_delivered_semaphore;
+    // Input pictures that can be sent without waiting, tracked for input_slot_available
+    volatile uint32_t free_input_y8b_count;
+    volatile uint32_t free_input_buffer_count;
+    // Host allocator registered through svt_av1_enc_set_allocator(), backs the pools built by svt_av1_enc_init()
+    SvtAv1Allocator allocator;
+    bool            use_allocator;
+    // What svt_av1_enc_init_handle() and svt_av1_enc_init() allocated, see SVT_AV1_STREAM_INFO_MEMORY_USAGE
+    EbMemUsage mem_usage;
+    // Records the tasks of every stage when static_config.trace_file is set
+    EbTracer *tracer;
 
     EbFifo *input_buffer_producer_fifo_ptr;
     EbFifo *input_cmd_producer_fifo_ptr;
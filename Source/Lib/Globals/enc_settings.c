@@ -480,6 +480,11 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->worker_pool_size > MAX_WORKER_POOL_SIZE) {
+        SVT_ERROR("Instance %u: Invalid worker_pool_size. worker_pool_size must be [0 - %d] \n", channel_number + 1, MAX_WORKER_POOL_SIZE);
+        return_error = EB_ErrorBadParameter;
+    }
+
     // HBD mode decision
     if (scs->enable_hbd_mode_decision < (int8_t)(-1) || scs->enable_hbd_mode_decision > 2) {
         SVT_ERROR("Instance %u: Invalid HBD mode decision flag [-1 - 2], your input: %d\n",
@@ -530,6 +535,14 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
             config->fast_decode);
         return_error = EB_ErrorBadParameter;
     }
+    if (config->tpl_downscale > 2) {
+        SVT_ERROR(
+            "Instance %u: Invalid TPL downscale [0 - 2, 0 for full resolution, 1 for 1/4 and 2 for 1/16], your "
+            "input: %d\n",
+            channel_number + 1,
+            config->tpl_downscale);
+        return_error = EB_ErrorBadParameter;
+    }
     if (config->tune > 2) {
         SVT_ERROR(
             "Instance %u: Invalid tune flag [0 - 2, 0 for VQ, 1 for PSNR and 2 for SSIM], your "
@@ -695,6 +708,27 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
             channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
+    if (config->sub_frame_output) {
+        if (config->pred_structure != SVT_AV1_PRED_LOW_DELAY_P && config->pred_structure != SVT_AV1_PRED_LOW_DELAY_B) {
+            SVT_ERROR("Instance %u: sub-frame output only supports low delay prediction structure\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->pass != ENC_SINGLE_PASS || config->rc_stats_buffer.sz) {
+            SVT_ERROR("Instance %u: sub-frame output only supports single pass encoding\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->superres_mode > SUPERRES_NONE || config->resize_mode > RESIZE_NONE) {
+            SVT_ERROR("Instance %u: sub-frame output does not support super resolution or resize\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->cdef_level > 0 || config->enable_restoration_filtering > 0) {
+            SVT_ERROR("Instance %u: CDEF and restoration filtering are not supported with sub-frame output\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
     if (config->sframe_dist > 0 && config->hierarchical_levels == 0) {
         SVT_ERROR("Error instance %u: switch frame feature does not support flat IPPP\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
@@ -965,6 +999,12 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
 #endif
     config_ptr->pin_threads          = 0;
     config_ptr->target_socket        = -1;
+    config_ptr->worker_pool_size     = 0;
+    config_ptr->trace_file           = NULL;
+    config_ptr->sub_frame_output     = FALSE;
+    config_ptr->incremental_tpl      = FALSE;
+    config_ptr->tpl_downscale        = 0;
+    config_ptr->tf_early_exit        = FALSE;
     config_ptr->channel_id           = 0;
     config_ptr->active_channel_count = 1;
 
@@ -1938,6 +1978,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"lp", &config_struct->logical_processors},
 #endif
         {"pin", &config_struct->pin_threads},
+        {"worker-pool", &config_struct->worker_pool_size},
         {"fps-num", &config_struct->frame_rate_numerator},
         {"fps-denom", &config_struct->frame_rate_denominator},
         {"lookahead", &config_struct->look_ahead_distance},
@@ -1993,6 +2034,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"variance-boost-strength", &config_struct->variance_boost_strength},
         {"variance-octile", &config_struct->variance_octile},
         {"fast-decode", &config_struct->fast_decode},
+        {"tpl-downscale", &config_struct->tpl_downscale},
 #if FTR_LOSSLESS_SUPPORT
         {"lossless", &config_struct->lossless},
 #endif
@@ -2101,6 +2143,9 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"enable-dg", &config_struct->enable_dg},
         {"gop-constraint-rc", &config_struct->gop_constraint_rc},
         {"enable-variance-boost", &config_struct->enable_variance_boost},
+        {"sub-frame-output", &config_struct->sub_frame_output},
+        {"incremental-tpl", &config_struct->incremental_tpl},
+        {"tf-early-exit", &config_struct->tf_early_exit},
     };
     const size_t bool_opts_size = sizeof(bool_opts) / sizeof(bool_opts[0]);
 
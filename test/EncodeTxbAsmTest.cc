@@ -13,7 +13,8 @@
 /******************************************************************************
  * @file EncodeTxbAsmTest.cc
  *
- * @brief Unit test for svt_av1_txb_init_levels_avx2:
+ * @brief Unit test for svt_av1_txb_init_levels_avx2,
+ * svt_av1_get_nz_map_contexts and svt_av1_cost_coeffs_txb_loop:
  *
  * @author Cidana-Wenyao
  *
@@ -34,6 +35,7 @@
 #include "random.h"
 #include "svt_time.h"
 #include "encode_txb_ref_c.h"
+#include "md_rate_estimation.h"
 
 using svt_av1_test_tool::SVTRandom;  // to generate the random
 namespace {
@@ -332,4 +334,192 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Combine(::testing::Values(&svt_av1_txb_init_levels_neon),
                        ::testing::Range(0, static_cast<int>(TX_SIZES_ALL), 1)));
 #endif  // ARCH_AARCH64
+
+// test assembly code of svt_av1_cost_coeffs_txb_loop
+using CostCoeffsTxbLoopFunc = int32_t (*)(
+    const TranLow *const qcoeff, const int16_t *const scan,
+    const int8_t *const coeff_contexts, const uint8_t *const levels,
+    const struct LvMapCoeffCost *const coeff_costs, const int32_t c_start,
+    const int32_t bwl, const TxClass tx_class);
+using CostCoeffsTxbLoopParam = std::tuple<CostCoeffsTxbLoopFunc, int>;
+/**
+ * @brief Unit test for svt_av1_cost_coeffs_txb_loop:
+ *
+ * Test strategy:
+ * Build the levels and the coefficient contexts of random quantized blocks
+ * with the reference c functions, then compare the coefficient rate returned
+ * by the optimized function with the one of the reference c function.
+ *
+ * Expect result:
+ * Rates are exactly the same.
+ *
+ * Test coverage:
+ * tx_size: all tx sizes
+ * tx_type: all tx types
+ * eob and c_start: random
+ * Coefficients: sparse small levels mixed with large (Golomb coded) levels
+ *
+ */
+class EncodeTxbCostCoeffsTest
+    : public ::testing::TestWithParam<CostCoeffsTxbLoopParam> {
+  public:
+    EncodeTxbCostCoeffsTest()
+        : level_rnd_(0, 99),
+          sign_rnd_(0, 1),
+          big_rnd_(15, INT16_MAX),
+          cost_rnd_(0, 4095),
+          ref_func_(&svt_av1_cost_coeffs_txb_loop_c) {
+    }
+
+    virtual ~EncodeTxbCostCoeffsTest() {
+        aom_clear_system_state();
+    }
+
+    void run_test(const CostCoeffsTxbLoopFunc test_func, const int tx_size,
+                  const bool is_speed) {
+        const int bwl = get_txb_bwl((TxSize)tx_size);
+        const int width = get_txb_wide((TxSize)tx_size);
+        const int height = get_txb_high((TxSize)tx_size);
+        const int num_tests = is_speed ? 1 : 100;
+        const uint64_t num_loop =
+            is_speed ? (100000000 / (width * height)) : 1;
+        const int num_tx_types = is_speed ? 1 : TX_TYPES;
+        double time_c = 0, time_o = 0;
+
+        init_costs();
+        for (int tx_type = 0; tx_type < num_tx_types; ++tx_type) {
+            const TxClass tx_class = tx_type_to_class[tx_type];
+            const int16_t *const scan = av1_scan_orders[tx_size][tx_type].scan;
+            for (int i = 0; i < num_tests; ++i) {
+                const int eob =
+                    is_speed ? width * height / 2
+                             : 2 + rand() % (width * height - 1);
+                const int c_start = (i & 1) ? eob - 2 : rand() % (eob - 1);
+                prepare_data(scan, (TxSize)tx_size, tx_class, eob);
+
+                uint64_t start_time_seconds, start_time_useconds;
+                uint64_t middle_time_seconds, middle_time_useconds;
+                uint64_t finish_time_seconds, finish_time_useconds;
+                int32_t cost_ref = 0, cost_test = 0;
+
+                svt_av1_get_time(&start_time_seconds, &start_time_useconds);
+                for (uint64_t j = 0; j < num_loop; j++)
+                    cost_ref = ref_func_(qcoeff_,
+                                         scan,
+                                         coeff_contexts_,
+                                         levels_,
+                                         &coeff_costs_,
+                                         c_start,
+                                         bwl,
+                                         tx_class);
+                svt_av1_get_time(&middle_time_seconds, &middle_time_useconds);
+                for (uint64_t j = 0; j < num_loop; j++)
+                    cost_test = test_func(qcoeff_,
+                                          scan,
+                                          coeff_contexts_,
+                                          levels_,
+                                          &coeff_costs_,
+                                          c_start,
+                                          bwl,
+                                          tx_class);
+                svt_av1_get_time(&finish_time_seconds, &finish_time_useconds);
+
+                ASSERT_EQ(cost_ref, cost_test)
+                    << "tx_size " << tx_size << " tx_type " << tx_type
+                    << " eob " << eob << " c_start " << c_start;
+
+                time_c += svt_av1_compute_overall_elapsed_time_ms(
+                    start_time_seconds,
+                    start_time_useconds,
+                    middle_time_seconds,
+                    middle_time_useconds);
+                time_o += svt_av1_compute_overall_elapsed_time_ms(
+                    middle_time_seconds,
+                    middle_time_useconds,
+                    finish_time_seconds,
+                    finish_time_useconds);
+            }
+        }
+
+        if (is_speed) {
+            printf("svt_av1_cost_coeffs_txb_loop(%2dx%2d): %6.2f\n",
+                   width,
+                   height,
+                   time_c / time_o);
+        }
+    }
+
+  private:
+    void init_costs() {
+        int32_t *const costs = reinterpret_cast<int32_t *>(&coeff_costs_);
+        for (size_t i = 0; i < sizeof(coeff_costs_) / sizeof(*costs); i++)
+            costs[i] = cost_rnd_.random();
+    }
+
+    void prepare_data(const int16_t *const scan, const TxSize tx_size,
+                      const TxClass tx_class, const int eob) {
+        const int width = get_txb_wide(tx_size);
+        const int height = get_txb_high(tx_size);
+
+        memset(qcoeff_, 0, sizeof(qcoeff_));
+        for (int c = 0; c < eob; ++c) {
+            // mostly 0, 1 and 2, with some base range and Golomb levels
+            const int r = level_rnd_.random();
+            const int level = r < 50 ? 0
+                              : r < 80 ? 1
+                              : r < 90 ? 2
+                              : r < 98 ? 3 + r - 90
+                                       : big_rnd_.random();
+            qcoeff_[scan[c]] = sign_rnd_.random() ? -level : level;
+        }
+        if (!qcoeff_[scan[eob - 1]])
+            qcoeff_[scan[eob - 1]] = 1;
+
+        memset(levels_buf_, 0, sizeof(levels_buf_));
+        levels_ = set_levels(levels_buf_, width);
+        svt_av1_txb_init_levels_c(qcoeff_, width, height, levels_);
+        svt_av1_get_nz_map_contexts_c(
+            levels_, scan, eob, tx_size, tx_class, coeff_contexts_);
+    }
+
+    SVTRandom level_rnd_;
+    SVTRandom sign_rnd_;
+    SVTRandom big_rnd_;
+    SVTRandom cost_rnd_;
+    LvMapCoeffCost coeff_costs_;
+    TranLow qcoeff_[MAX_TX_SQUARE];
+    uint8_t levels_buf_[TX_PAD_2D];
+    uint8_t *levels_;
+    DECLARE_ALIGNED(16, int8_t, coeff_contexts_[MAX_TX_SQUARE]);
+    const CostCoeffsTxbLoopFunc ref_func_;
+};
+
+TEST_P(EncodeTxbCostCoeffsTest, cost_coeffs_txb_loop_match) {
+    run_test(TEST_GET_PARAM(0), TEST_GET_PARAM(1), false);
+}
+
+TEST_P(EncodeTxbCostCoeffsTest, DISABLED_cost_coeffs_txb_loop_speed) {
+    run_test(TEST_GET_PARAM(0), TEST_GET_PARAM(1), true);
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, EncodeTxbCostCoeffsTest,
+    ::testing::Combine(::testing::Values(&svt_av1_cost_coeffs_txb_loop_avx2),
+                       ::testing::Range(0, static_cast<int>(TX_SIZES_ALL), 1)));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, EncodeTxbCostCoeffsTest,
+    ::testing::Combine(::testing::Values(&svt_av1_cost_coeffs_txb_loop_avx512),
+                       ::testing::Range(0, static_cast<int>(TX_SIZES_ALL), 1)));
+#endif
+#endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(
+    NEON, EncodeTxbCostCoeffsTest,
+    ::testing::Combine(::testing::Values(&svt_av1_cost_coeffs_txb_loop_neon),
+                       ::testing::Range(0, static_cast<int>(TX_SIZES_ALL), 1)));
+#endif  // ARCH_AARCH64
 }  // namespace
@@ -894,6 +894,164 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Values(svt_ext_all_sad_calculation_8x8_16x16_neon)));
 #endif  // ARCH_AARCH64
 
+typedef void (*svt_ext_all_sad_calculation_8x8_16x16_multi_fn)(
+    uint8_t *src, uint32_t src_stride, MeSadRef *refs, uint32_t ref_count,
+    Bool sub_sad);
+
+typedef std::tuple<TestPattern, svt_ext_all_sad_calculation_8x8_16x16_multi_fn>
+    sad8x8_MultiTestParam;
+
+/**
+ * @brief Unit test for svt_ext_all_sad_calculation_8x8_16x16_multi:
+ *
+ *
+ * Test strategy:
+ *  This test use different test pattern {REF_MAX, SRC_MAX, RANDOM, UNALIGN}
+ *  to generate test vector, and searches 1 to 8 references of different
+ *  offsets and MVs at once. Check the result by comparing results from
+ *  reference function and SIMD function.
+ *
+ *
+ * Expect result:
+ *  Results come from reference function and SIMD funtion are equal.
+ *
+ **/
+
+class Allsad8x8_MultiCalculationTest
+    : public ::testing::WithParamInterface<sad8x8_MultiTestParam>,
+      public SADTestBase {
+  public:
+    Allsad8x8_MultiCalculationTest()
+        : SADTestBase(TEST_GET_PARAM(0), BUF_MAX) {
+        src_stride_ = ref1_stride_ = ref2_stride_ = MAX_SB_SIZE;
+        test_func_ = TEST_GET_PARAM(1);
+    }
+
+  protected:
+    static const int max_refs = MAX_NUM_OF_REF_PIC_LIST * MAX_REF_IDX;
+
+    void check_sad() {
+        uint32_t best_sad8x8[2][max_refs][64];
+        uint32_t best_mv8x8[2][max_refs][64];
+        uint32_t best_sad16x16[2][max_refs][16];
+        uint32_t best_mv16x16[2][max_refs][16];
+        uint32_t eight_sad16x16[2][max_refs][16][8];
+        MeSadRef refs[2][max_refs];
+
+        prepare_data();
+
+        for (int sub_sad = 0; sub_sad < 2; sub_sad++) {
+            for (int ref_count = 1; ref_count <= max_refs; ref_count++) {
+                fill_buf_with_value(
+                    &best_sad8x8[0][0][0], 2 * max_refs * 64, BEST_SAD_MAX);
+                fill_buf_with_value(
+                    &best_sad16x16[0][0][0], 2 * max_refs * 16, UINT_MAX);
+                fill_buf_with_value(
+                    &best_mv8x8[0][0][0], 2 * max_refs * 64, 0);
+                fill_buf_with_value(
+                    &best_mv16x16[0][0][0], 2 * max_refs * 16, 0);
+                fill_buf_with_value(&eight_sad16x16[0][0][0][0],
+                                    2 * max_refs * 16 * 8,
+                                    UINT_MAX);
+                for (int i = 0; i < 2; i++) {
+                    for (int r = 0; r < ref_count; r++) {
+                        // Alternate the two reference buffers, shifted by a
+                        // few rows and columns, with negative and positive MVs
+                        const uint32_t stride =
+                            (r & 1) ? ref2_stride_ : ref1_stride_;
+                        const int16_t mv_x = (int16_t)(8 * r - 28);
+                        const int16_t mv_y = (int16_t)(13 - 5 * r);
+                        refs[i][r].ref = ((r & 1) ? ref2_aligned_
+                                                  : ref1_aligned_) +
+                                         (r >> 1) * stride + r;
+                        refs[i][r].ref_stride = stride;
+                        refs[i][r].mv =
+                            ((uint32_t)(uint16_t)mv_y << 16) | (uint16_t)mv_x;
+                        refs[i][r].p_best_sad_8x8 = best_sad8x8[i][r];
+                        refs[i][r].p_best_sad_16x16 = best_sad16x16[i][r];
+                        refs[i][r].p_best_mv8x8 = best_mv8x8[i][r];
+                        refs[i][r].p_best_mv16x16 = best_mv16x16[i][r];
+                        refs[i][r].p_eight_sad16x16 = eight_sad16x16[i][r];
+                    }
+                }
+
+                svt_ext_all_sad_calculation_8x8_16x16_multi_c(
+                    src_aligned_, src_stride_, refs[0], ref_count, sub_sad);
+                test_func_(
+                    src_aligned_, src_stride_, refs[1], ref_count, sub_sad);
+
+                EXPECT_EQ(0,
+                          memcmp(best_sad8x8[0],
+                                 best_sad8x8[1],
+                                 sizeof(best_sad8x8[0])))
+                    << "compare best_sad8x8 error sub_sad " << sub_sad
+                    << " ref_count " << ref_count;
+                EXPECT_EQ(0,
+                          memcmp(best_mv8x8[0],
+                                 best_mv8x8[1],
+                                 sizeof(best_mv8x8[0])))
+                    << "compare best_mv8x8 error sub_sad " << sub_sad
+                    << " ref_count " << ref_count;
+                EXPECT_EQ(0,
+                          memcmp(best_sad16x16[0],
+                                 best_sad16x16[1],
+                                 sizeof(best_sad16x16[0])))
+                    << "compare best_sad16x16 error sub_sad " << sub_sad
+                    << " ref_count " << ref_count;
+                EXPECT_EQ(0,
+                          memcmp(best_mv16x16[0],
+                                 best_mv16x16[1],
+                                 sizeof(best_mv16x16[0])))
+                    << "compare best_mv16x16 error sub_sad " << sub_sad
+                    << " ref_count " << ref_count;
+                EXPECT_EQ(0,
+                          memcmp(eight_sad16x16[0],
+                                 eight_sad16x16[1],
+                                 sizeof(eight_sad16x16[0])))
+                    << "compare eight_sad16x16 error sub_sad " << sub_sad
+                    << " ref_count " << ref_count;
+            }
+        }
+    }
+
+    void check_sad(int width, int height) {
+        printf("Usage not override a function, %i, %i\n", width, height);
+        ASSERT_TRUE(0);
+    }
+
+    svt_ext_all_sad_calculation_8x8_16x16_multi_fn test_func_;
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Allsad8x8_MultiCalculationTest);
+
+TEST_P(Allsad8x8_MultiCalculationTest, check_sad8x8_multi) {
+    check_sad();
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Allsad8x8_MultiCalculationTest,
+    ::testing::Combine(
+        ::testing::ValuesIn(TEST_PATTERNS),
+        ::testing::Values(svt_ext_all_sad_calculation_8x8_16x16_multi_avx2)));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, Allsad8x8_MultiCalculationTest,
+    ::testing::Combine(
+        ::testing::ValuesIn(TEST_PATTERNS),
+        ::testing::Values(
+            svt_ext_all_sad_calculation_8x8_16x16_multi_avx512)));
+#endif
+#endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Allsad8x8_MultiCalculationTest,
+    ::testing::Combine(
+        ::testing::ValuesIn(TEST_PATTERNS),
+        ::testing::Values(svt_ext_all_sad_calculation_8x8_16x16_multi_neon)));
+#endif  // ARCH_AARCH64
+
 typedef void (*svt_ext_eight_sad_calculation_32x32_64x64_fn)(
     uint32_t p_sad16x16[16][8], uint32_t *p_best_sad_32x32,
     uint32_t *p_best_sad_64x64, uint32_t *p_best_mv32x32,
@@ -15,9 +15,9 @@
  *
  * @brief Unit test of project-related test in selfguided filter:
  *
- * - av1_lowbd_pixel_proj_error_avx2
- * - av1_highbd_pixel_proj_error_avx2
- * - svt_get_proj_subspace_avx2
+ * - av1_lowbd_pixel_proj_error_{sse4_1,avx2,avx512,neon,sve}
+ * - av1_highbd_pixel_proj_error_{sse4_1,avx2,avx512,sve}
+ * - svt_get_proj_subspace_{avx2,avx512,sve}
  *
  * @author Cidana-Edmond, Cidana-Wenyao
  *
@@ -353,6 +353,13 @@ INSTANTIATE_TEST_SUITE_P(
     NEON, PixelProjErrorLbdTest,
     ::testing::Values(make_tuple(svt_av1_lowbd_pixel_proj_error_neon,
                                  svt_av1_lowbd_pixel_proj_error_c)));
+
+#if HAVE_SVE
+INSTANTIATE_TEST_SUITE_P(
+    SVE, PixelProjErrorLbdTest,
+    ::testing::Values(make_tuple(svt_av1_lowbd_pixel_proj_error_sve,
+                                 svt_av1_lowbd_pixel_proj_error_c)));
+#endif  // HAVE_SVE
 #endif  // ARCH_AARCH64
 
 class PixelProjErrorHbdTest : public PixelProjErrorTest<uint16_t> {
@@ -392,6 +399,11 @@ TEST_P(PixelProjErrorHbdTest, MatchTestWithRandomSizeAndValue) {
 TEST_P(PixelProjErrorHbdTest, MatchTestWithExtremeValue) {
     run_extreme_test();
 }
+TEST_P(PixelProjErrorHbdTest, DISABLED_SpeedTest) {
+    run_speed_test(256, 1, 1);
+    run_speed_test(256, 1, 0);
+    run_speed_test(256, 0, 0);
+}
 
 #if ARCH_X86_64
 INSTANTIATE_TEST_SUITE_P(
@@ -404,234 +416,295 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Values(make_tuple(svt_av1_highbd_pixel_proj_error_avx2,
                                  svt_av1_highbd_pixel_proj_error_c)));
 
-// test svt_get_proj_subspace
-TEST(SelfGuidedToolsTest, GetProjSubspaceMatchTest) {
-    const int32_t pu_width = RESTORATION_PROC_UNIT_SIZE;
-    const int32_t pu_height = RESTORATION_PROC_UNIT_SIZE;
-    const int32_t width = 270, height = 256, stride = 300, out_stride = 300;
-    const int NUM_ITERS = 2000;
-    int i, j, k;
-
-    uint8_t *input_ = (uint8_t *)svt_aom_memalign(
-        32, stride * (height + 32) * sizeof(uint8_t));
-    uint8_t *output_ = (uint8_t *)svt_aom_memalign(
-        32, out_stride * (height + 32) * sizeof(uint8_t));
-    int32_t *tmpbuf = (int32_t *)svt_aom_memalign(32, RESTORATION_TMPBUF_SIZE);
-    uint8_t *input = input_ + stride * 16 + 16;
-    uint8_t *output = output_ + out_stride * 16 + 16;
-    int32_t *flt0 = tmpbuf;
-    int32_t *flt1 = flt0 + RESTORATION_UNITPELS_MAX;
-    int32_t flt_stride = ((width + 7) & ~7) + 8;
-
-    // check all the sg params
-    SVTRandom rnd(8, false);
-    for (int iter = 0; iter < NUM_ITERS; ++iter) {
-        if (iter == 0) {
-            // prepare src data and recon data
-            for (i = -16; i < height + 16; ++i) {
-                for (j = -16; j < width + 16; ++j) {
-                    input[i * stride + j] = rnd.random();
-                    if (iter == 0)
-                        output[i * stride + j] = input[i * stride + j];
-                    else
-                        output[i * stride + j] = rnd.random();
-                }
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, PixelProjErrorHbdTest,
+    ::testing::Values(make_tuple(svt_av1_highbd_pixel_proj_error_avx512,
+                                 svt_av1_highbd_pixel_proj_error_c)));
+#endif
+#endif  // ARCH_X86_64
+
+#if ARCH_AARCH64 && HAVE_SVE
+INSTANTIATE_TEST_SUITE_P(
+    SVE, PixelProjErrorHbdTest,
+    ::testing::Values(make_tuple(svt_av1_highbd_pixel_proj_error_sve,
+                                 svt_av1_highbd_pixel_proj_error_c)));
+#endif  // ARCH_AARCH64 && HAVE_SVE
+
+typedef void (*GetProjSubspaceFunc)(
+    const uint8_t *src8, int width, int height, int src_stride,
+    const uint8_t *dat8, int dat_stride, int use_highbitdepth, int32_t *flt0,
+    int flt0_stride, int32_t *flt1, int flt1_stride, int *xq,
+    const SgrParamsType *params);
+
+// The filtered planes only feed the projection, so any optimized self-guided
+// filter will do; the C one is too slow for the number of iterations.
+#if ARCH_X86_64
+#define selfguided_restoration_for_test svt_av1_selfguided_restoration_avx2
+#elif ARCH_AARCH64
+#define selfguided_restoration_for_test svt_av1_selfguided_restoration_neon
+#endif
+
+/**
+ * @brief Unit test for svt_get_proj_subspace:
+ * - svt_get_proj_subspace_avx2
+ * - svt_get_proj_subspace_avx512
+ * - svt_get_proj_subspace_sve
+ *
+ * Test strategy:
+ * Filter the recon with every self-guided parameter set and check that the
+ * optimized function and the C function return the same projection.
+ *
+ * Expect result:
+ * xq of the optimized function equals xq of the C function.
+ *
+ * Test coverage:
+ * 270x256 area filtered by RESTORATION_PROC_UNIT_SIZE units, 8-bit and 16-bit
+ * storage, all SGRPROJ_PARAMS parameter sets.
+ */
+class GetProjSubspaceTest
+    : public ::testing::TestWithParam<GetProjSubspaceFunc> {
+  public:
+    GetProjSubspaceTest() : tst_func_(GetParam()) {
+    }
+
+  protected:
+    static const int32_t width = 270, height = 256, stride = 300;
+
+    template <typename Sample>
+    static void filter_recon(Sample *output, int32_t *flt0, int32_t *flt1,
+                             int32_t flt_stride, int32_t ep) {
+        const int32_t pu_width = RESTORATION_PROC_UNIT_SIZE;
+        const int32_t pu_height = RESTORATION_PROC_UNIT_SIZE;
+        // apply selfguided filter to get A and b
+        for (int32_t k = 0; k < height; k += pu_height) {
+            for (int32_t j = 0; j < width; j += pu_width) {
+                int32_t w = AOMMIN(pu_width, width - j);
+                int32_t h = AOMMIN(pu_height, height - k);
+                Sample *output_p = output + k * stride + j;
+                int32_t *flt0_p = flt0 + k * flt_stride + j;
+                int32_t *flt1_p = flt1 + k * flt_stride + j;
+                assert(w * h <= RESTORATION_UNITPELS_MAX);
+
+                selfguided_restoration_for_test((uint8_t *)output_p,
+                                                w,
+                                                h,
+                                                stride,
+                                                flt0_p,
+                                                flt1_p,
+                                                flt_stride,
+                                                ep,
+                                                8,
+                                                0);
             }
-        } else {
+        }
+    }
+
+    template <typename Sample>
+    void run_match_test(const int use_highbitdepth) {
+        const int NUM_ITERS = 2000;
+        int i, j;
+
+        Sample *input_ = (Sample *)svt_aom_memalign(
+            32, stride * (height + 32) * sizeof(Sample));
+        Sample *output_ = (Sample *)svt_aom_memalign(
+            32, stride * (height + 32) * sizeof(Sample));
+        int32_t *tmpbuf =
+            (int32_t *)svt_aom_memalign(32, RESTORATION_TMPBUF_SIZE);
+        Sample *input = input_ + stride * 16 + 16;
+        Sample *output = output_ + stride * 16 + 16;
+        int32_t *flt0 = tmpbuf;
+        int32_t *flt1 = flt0 + RESTORATION_UNITPELS_MAX;
+        int32_t flt_stride = ((width + 7) & ~7) + 8;
+        uint8_t *src8 = use_highbitdepth ? CONVERT_TO_BYTEPTR(input)
+                                         : (uint8_t *)input;
+        uint8_t *dat8 = use_highbitdepth ? CONVERT_TO_BYTEPTR(output)
+                                         : (uint8_t *)output;
+
+        // check all the sg params
+        SVTRandom rnd(8, false);
+        for (int iter = 0; iter < NUM_ITERS; ++iter) {
             // prepare src data and recon data
             for (i = -16; i < height + 16; ++i) {
                 for (j = -16; j < width + 16; ++j) {
-                    input[i * stride + j] = 0;
-                    if (iter == 0)
-                        output[i * stride + j] = input[i * stride + j];
-                    else
-                        output[i * stride + j] = 0;
+                    input[i * stride + j] = iter == 0 ? rnd.random() : 0;
+                    output[i * stride + j] = input[i * stride + j];
                 }
             }
-        }
 
-        for (int32_t ep = 0; ep < SGRPROJ_PARAMS; ++ep) {
-            // apply selfguided filter to get A and b
-            for (k = 0; k < height; k += pu_height) {
-                for (j = 0; j < width; j += pu_width) {
-                    int32_t w = AOMMIN(pu_width, width - j);
-                    int32_t h = AOMMIN(pu_height, height - k);
-                    uint8_t *output_p = output + k * out_stride + j;
-                    int32_t *flt0_p = flt0 + k * flt_stride + j;
-                    int32_t *flt1_p = flt1 + k * flt_stride + j;
-                    assert(w * h <= RESTORATION_UNITPELS_MAX);
-
-                    svt_av1_selfguided_restoration_avx2(output_p,
-                                                        w,
-                                                        h,
-                                                        out_stride,
-                                                        flt0_p,
-                                                        flt1_p,
-                                                        flt_stride,
-                                                        ep,
-                                                        8,
-                                                        0);
-                }
+            for (int32_t ep = 0; ep < SGRPROJ_PARAMS; ++ep) {
+                filter_recon(output, flt0, flt1, flt_stride, ep);
+
+                aom_clear_system_state();
+                int32_t xqd_c[2] = {0};
+                int32_t xqd_asm[2] = {0};
+                const SgrParamsType *const params =
+                    &svt_aom_eb_sgr_params[ep];
+                svt_get_proj_subspace_c(src8,
+                                        width,
+                                        height,
+                                        stride,
+                                        dat8,
+                                        stride,
+                                        use_highbitdepth,
+                                        flt0,
+                                        flt_stride,
+                                        flt1,
+                                        flt_stride,
+                                        xqd_c,
+                                        params);
+                tst_func_(src8,
+                          width,
+                          height,
+                          stride,
+                          dat8,
+                          stride,
+                          use_highbitdepth,
+                          flt0,
+                          flt_stride,
+                          flt1,
+                          flt_stride,
+                          xqd_asm,
+                          params);
+                ASSERT_EQ(xqd_c[0], xqd_asm[0])
+                    << "xqd_asm[0] does not match with xqd_c[0] with iter "
+                    << iter << " ep " << ep;
+                ASSERT_EQ(xqd_c[1], xqd_asm[1])
+                    << "xqd_asm[1] does not match with xqd_c[1] with iter "
+                    << iter << " ep " << ep;
             }
-
-            aom_clear_system_state();
-            int32_t xqd_c[2] = {0};
-            int32_t xqd_asm[2] = {0};
-            const SgrParamsType *const params = &svt_aom_eb_sgr_params[ep];
-            svt_get_proj_subspace_c(input,
-                                    width,
-                                    height,
-                                    stride,
-                                    output,
-                                    out_stride,
-                                    0,
-                                    flt0,
-                                    flt_stride,
-                                    flt1,
-                                    flt_stride,
-                                    xqd_c,
-                                    params);
-            svt_get_proj_subspace_avx2(input,
-                                       width,
-                                       height,
-                                       stride,
-                                       output,
-                                       out_stride,
-                                       0,
-                                       flt0,
-                                       flt_stride,
-                                       flt1,
-                                       flt_stride,
-                                       xqd_asm,
-                                       params);
-            ASSERT_EQ(xqd_c[0], xqd_asm[0])
-                << "xqd_asm[0] does not match with xqd_asm[0] with iter "
-                << iter << " ep " << ep;
-            ASSERT_EQ(xqd_c[1], xqd_asm[1])
-                << "xqd_asm[1] does not match with xqd_asm[1] with iter "
-                << iter << " ep " << ep;
         }
+
+        svt_aom_free(input_);
+        svt_aom_free(output_);
+        svt_aom_free(tmpbuf);
     }
 
-    svt_aom_free(input_);
-    svt_aom_free(output_);
-    svt_aom_free(tmpbuf);
-}
+    template <typename Sample>
+    void run_speed_test(const int use_highbitdepth) {
+        const int num_loop = 100;
+        double time_c = 0, time_o = 0;
+        uint64_t start_time_seconds, start_time_useconds;
+        uint64_t middle_time_seconds, middle_time_useconds;
+        uint64_t finish_time_seconds, finish_time_useconds;
 
-// test svt_get_proj_subspace
-TEST(SelfGuidedToolsTest, GetProjSubspaceMatchTestHbd) {
-    const int32_t pu_width = RESTORATION_PROC_UNIT_SIZE;
-    const int32_t pu_height = RESTORATION_PROC_UNIT_SIZE;
-    const int32_t width = 270, height = 256, stride = 300, out_stride = 300;
-    const int NUM_ITERS = 2000;
-    int i, j, k;
-
-    uint16_t *input_ = (uint16_t *)svt_aom_memalign(
-        32, stride * (height + 32) * sizeof(uint16_t));
-    uint16_t *output_ = (uint16_t *)svt_aom_memalign(
-        32, out_stride * (height + 32) * sizeof(uint16_t));
-    int32_t *tmpbuf = (int32_t *)svt_aom_memalign(32, RESTORATION_TMPBUF_SIZE);
-    uint16_t *input = input_ + stride * 16 + 16;
-    uint16_t *output = output_ + out_stride * 16 + 16;
-    int32_t *flt0 = tmpbuf;
-    int32_t *flt1 = flt0 + RESTORATION_UNITPELS_MAX;
-    int32_t flt_stride = ((width + 7) & ~7) + 8;
-
-    // check all the sg params
-    SVTRandom rnd(8, false);
-    for (int iter = 0; iter < NUM_ITERS; ++iter) {
-        if (iter == 0) {
-            // prepare src data and recon data
-            for (i = -16; i < height + 16; ++i) {
-                for (j = -16; j < width + 16; ++j) {
-                    input[i * stride + j] = rnd.random();
-                    if (iter == 0)
-                        output[i * stride + j] = input[i * stride + j];
-                    else
-                        output[i * stride + j] = rnd.random();
-                }
-            }
-        } else {
-            // prepare src data and recon data
-            for (i = -16; i < height + 16; ++i) {
-                for (j = -16; j < width + 16; ++j) {
-                    input[i * stride + j] = 0;
-                    if (iter == 0)
-                        output[i * stride + j] = input[i * stride + j];
-                    else
-                        output[i * stride + j] = 0;
-                }
-            }
+        Sample *input = (Sample *)svt_aom_memalign(
+            32, stride * height * sizeof(Sample));
+        Sample *output = (Sample *)svt_aom_memalign(
+            32, stride * height * sizeof(Sample));
+        int32_t *tmpbuf =
+            (int32_t *)svt_aom_memalign(32, RESTORATION_TMPBUF_SIZE);
+        int32_t *flt0 = tmpbuf;
+        int32_t *flt1 = flt0 + RESTORATION_UNITPELS_MAX;
+        int32_t flt_stride = ((width + 7) & ~7) + 8;
+        uint8_t *src8 = use_highbitdepth ? CONVERT_TO_BYTEPTR(input)
+                                         : (uint8_t *)input;
+        uint8_t *dat8 = use_highbitdepth ? CONVERT_TO_BYTEPTR(output)
+                                         : (uint8_t *)output;
+
+        SVTRandom rnd(8, false);
+        for (int i = 0; i < stride * height; ++i) {
+            input[i] = rnd.random();
+            output[i] = rnd.random();
         }
 
         for (int32_t ep = 0; ep < SGRPROJ_PARAMS; ++ep) {
-            // apply selfguided filter to get A and b
-            for (k = 0; k < height; k += pu_height) {
-                for (j = 0; j < width; j += pu_width) {
-                    int32_t w = AOMMIN(pu_width, width - j);
-                    int32_t h = AOMMIN(pu_height, height - k);
-                    uint16_t *output_p = output + k * out_stride + j;
-                    int32_t *flt0_p = flt0 + k * flt_stride + j;
-                    int32_t *flt1_p = flt1 + k * flt_stride + j;
-                    assert(w * h <= RESTORATION_UNITPELS_MAX);
-
-                    svt_av1_selfguided_restoration_avx2((uint8_t *)output_p,
-                                                        w,
-                                                        h,
-                                                        out_stride,
-                                                        flt0_p,
-                                                        flt1_p,
-                                                        flt_stride,
-                                                        ep,
-                                                        8,
-                                                        0);
-                }
-            }
-
-            aom_clear_system_state();
+            const SgrParamsType *const params = &svt_aom_eb_sgr_params[ep];
             int32_t xqd_c[2] = {0};
             int32_t xqd_asm[2] = {0};
-            const SgrParamsType *const params = &svt_aom_eb_sgr_params[ep];
-            svt_get_proj_subspace_c(CONVERT_TO_BYTEPTR(input),
-                                    width,
-                                    height,
-                                    stride,
-                                    CONVERT_TO_BYTEPTR(output),
-                                    out_stride,
-                                    1,
-                                    flt0,
-                                    flt_stride,
-                                    flt1,
-                                    flt_stride,
-                                    xqd_c,
-                                    params);
-            svt_get_proj_subspace_avx2(CONVERT_TO_BYTEPTR(input),
-                                       width,
-                                       height,
-                                       stride,
-                                       CONVERT_TO_BYTEPTR(output),
-                                       out_stride,
-                                       1,
-                                       flt0,
-                                       flt_stride,
-                                       flt1,
-                                       flt_stride,
-                                       xqd_asm,
-                                       params);
-
-            ASSERT_EQ(xqd_c[0], xqd_asm[0])
-                << "xqd_asm[0] does not match with xqd_asm[0] with iter "
-                << iter << " ep " << ep;
-            ASSERT_EQ(xqd_c[1], xqd_asm[1])
-                << "xqd_asm[1] does not match with xqd_asm[1] with iter "
-                << iter << " ep " << ep;
+            filter_recon(output, flt0, flt1, flt_stride, ep);
+
+            svt_av1_get_time(&start_time_seconds, &start_time_useconds);
+            for (int i = 0; i < num_loop; i++)
+                svt_get_proj_subspace_c(src8,
+                                        width,
+                                        height,
+                                        stride,
+                                        dat8,
+                                        stride,
+                                        use_highbitdepth,
+                                        flt0,
+                                        flt_stride,
+                                        flt1,
+                                        flt_stride,
+                                        xqd_c,
+                                        params);
+            svt_av1_get_time(&middle_time_seconds, &middle_time_useconds);
+            for (int i = 0; i < num_loop; i++)
+                tst_func_(src8,
+                          width,
+                          height,
+                          stride,
+                          dat8,
+                          stride,
+                          use_highbitdepth,
+                          flt0,
+                          flt_stride,
+                          flt1,
+                          flt_stride,
+                          xqd_asm,
+                          params);
+            svt_av1_get_time(&finish_time_seconds, &finish_time_useconds);
+
+            ASSERT_EQ(xqd_c[0], xqd_asm[0]);
+            ASSERT_EQ(xqd_c[1], xqd_asm[1]);
+
+            time_c += svt_av1_compute_overall_elapsed_time_ms(
+                start_time_seconds,
+                start_time_useconds,
+                middle_time_seconds,
+                middle_time_useconds);
+            time_o += svt_av1_compute_overall_elapsed_time_ms(
+                middle_time_seconds,
+                middle_time_useconds,
+                finish_time_seconds,
+                finish_time_useconds);
         }
+
+        printf("Average Nanoseconds per Function Call\n");
+        printf("   svt_get_proj_subspace_c(highbd: %d)   : %6.2f\n",
+               use_highbitdepth,
+               1000000 * time_c / (num_loop * SGRPROJ_PARAMS));
+        printf(
+            "   svt_get_proj_subspace_opt(highbd: %d) : %6.2f   "
+            "(Comparison: %5.2fx)\n",
+            use_highbitdepth,
+            1000000 * time_o / (num_loop * SGRPROJ_PARAMS),
+            time_c / time_o);
+
+        svt_aom_free(input);
+        svt_aom_free(output);
+        svt_aom_free(tmpbuf);
     }
 
-    svt_aom_free(input_);
-    svt_aom_free(output_);
-    svt_aom_free(tmpbuf);
+    GetProjSubspaceFunc tst_func_;
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(GetProjSubspaceTest);
+
+TEST_P(GetProjSubspaceTest, MatchTest) {
+    run_match_test<uint8_t>(0);
+}
+TEST_P(GetProjSubspaceTest, MatchTestHbd) {
+    run_match_test<uint16_t>(1);
 }
+TEST_P(GetProjSubspaceTest, DISABLED_SpeedTest) {
+    run_speed_test<uint8_t>(0);
+    run_speed_test<uint16_t>(1);
+}
+
+#if ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(AVX2, GetProjSubspaceTest,
+                         ::testing::Values(svt_get_proj_subspace_avx2));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(AVX512, GetProjSubspaceTest,
+                         ::testing::Values(svt_get_proj_subspace_avx512));
+#endif
 #endif  // ARCH_X86_64
 
+#if ARCH_AARCH64 && HAVE_SVE
+INSTANTIATE_TEST_SUITE_P(SVE, GetProjSubspaceTest,
+                         ::testing::Values(svt_get_proj_subspace_sve));
+#endif  // ARCH_AARCH64 && HAVE_SVE
+
 }  // namespace
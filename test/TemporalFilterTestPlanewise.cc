@@ -451,6 +451,12 @@ INSTANTIATE_TEST_SUITE_P(
     AVX2, TemporalFilterTestPlanewiseMedium,
     ::testing::Values(svt_av1_apply_temporal_filter_planewise_medium_avx2));
 
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, TemporalFilterTestPlanewiseMedium,
+    ::testing::Values(svt_av1_apply_temporal_filter_planewise_medium_avx512));
+#endif
+
 #endif  // ARCH_X86_64
 
 #ifdef ARCH_AARCH64
@@ -957,6 +963,13 @@ INSTANTIATE_TEST_SUITE_P(
     AVX2, TemporalFilterTestPlanewiseMediumHbd,
     ::testing::Values(svt_av1_apply_temporal_filter_planewise_medium_hbd_avx2));
 
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, TemporalFilterTestPlanewiseMediumHbd,
+    ::testing::Values(
+        svt_av1_apply_temporal_filter_planewise_medium_hbd_avx512));
+#endif
+
 #endif  // ARCH_X86_64
 
 #ifdef ARCH_AARCH64
@@ -967,6 +980,267 @@ INSTANTIATE_TEST_SUITE_P(
 
 #endif  // ARCH_AARCH64
 
+typedef void (*ZzTemporalFilterFunc)(
+    struct MeContext *me_ctx, const uint8_t *y_pre, int y_pre_stride,
+    const uint8_t *u_pre, const uint8_t *v_pre, int uv_pre_stride,
+    unsigned int block_width, unsigned int block_height, int ss_x, int ss_y,
+    uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum,
+    uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count);
+
+typedef void (*ZzTemporalFilterFuncHbd)(
+    struct MeContext *me_ctx, const uint16_t *y_pre, int y_pre_stride,
+    const uint16_t *u_pre, const uint16_t *v_pre, int uv_pre_stride,
+    unsigned int block_width, unsigned int block_height, int ss_x, int ss_y,
+    uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum,
+    uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count,
+    uint32_t encoder_bit_depth);
+
+template <typename PixelType, typename FuncType>
+class TemporalFilterTestZzBased : public ::testing::TestWithParam<FuncType> {
+  public:
+    TemporalFilterTestZzBased() : rnd_(0, (1 << 16) - 1) {
+    }
+
+    void SetUp() {
+        setup_test_env();
+        for (int c = 0; c < COLOR_CHANNELS; c++) {
+            pred_ptr_[c] = reinterpret_cast<PixelType *>(svt_aom_memalign(
+                8, MAX_STRIDE * MAX_STRIDE * sizeof(PixelType)));
+            accum_ref_[c] = reinterpret_cast<uint32_t *>(svt_aom_memalign(
+                8, MAX_STRIDE * MAX_STRIDE * sizeof(uint32_t)));
+            count_ref_[c] = reinterpret_cast<uint16_t *>(svt_aom_memalign(
+                8, MAX_STRIDE * MAX_STRIDE * sizeof(uint16_t)));
+            accum_tst_[c] = reinterpret_cast<uint32_t *>(svt_aom_memalign(
+                8, MAX_STRIDE * MAX_STRIDE * sizeof(uint32_t)));
+            count_tst_[c] = reinterpret_cast<uint16_t *>(svt_aom_memalign(
+                8, MAX_STRIDE * MAX_STRIDE * sizeof(uint16_t)));
+        }
+    }
+
+    void TearDown() {
+        for (int c = 0; c < COLOR_CHANNELS; c++) {
+            svt_aom_free(pred_ptr_[c]);
+            svt_aom_free(accum_ref_[c]);
+            svt_aom_free(count_ref_[c]);
+            svt_aom_free(accum_tst_[c]);
+            svt_aom_free(count_tst_[c]);
+        }
+    }
+
+    // Randomize the block errors, split flags and decay factors so that
+    // every weight bucket of the zero-motion path is exercised, then
+    // accumulate on top of random (but identical) accum/count planes.
+    void GenRandomData(MeContext *me_ctx, int bd) {
+        for (int i = 0; i < 4; i++) {
+            me_ctx->tf_32x32_block_error[i] =
+                rnd_.random() % (1 << (rnd_.random() % 24 + 1));
+            me_ctx->tf_32x32_block_split_flag[i] = rnd_.random() & 1;
+        }
+        for (int i = 0; i < 16; i++)
+            me_ctx->tf_16x16_block_error[i] =
+                rnd_.random() % (1 << (rnd_.random() % 24 + 1));
+        for (int c = 0; c < COLOR_CHANNELS; c++)
+            me_ctx->tf_decay_factor_fp16[c] =
+                FLOAT2FP((float)fclamp(rnd_.random_float() * 100000.0f,
+                                       1.0,
+                                       32760),
+                         16,
+                         uint32_t);
+        me_ctx->tf_block_col = rnd_.random() & 1;
+        me_ctx->tf_block_row = rnd_.random() & 1;
+        me_ctx->tf_chroma = 1;
+
+        for (int c = 0; c < COLOR_CHANNELS; c++) {
+            for (int i = 0; i < MAX_STRIDE * MAX_STRIDE; i++) {
+                pred_ptr_[c][i] = rnd_.random() & ((1 << bd) - 1);
+                accum_ref_[c][i] = accum_tst_[c][i] = rnd_.random();
+                count_ref_[c][i] = count_tst_[c][i] = rnd_.random() & 0x3FFF;
+            }
+        }
+    }
+
+    void CheckOutput() {
+        for (int c = 0; c < COLOR_CHANNELS; c++) {
+            EXPECT_EQ(memcmp(accum_ref_[c],
+                             accum_tst_[c],
+                             MAX_STRIDE * MAX_STRIDE * sizeof(uint32_t)),
+                      0);
+            EXPECT_EQ(memcmp(count_ref_[c],
+                             count_tst_[c],
+                             MAX_STRIDE * MAX_STRIDE * sizeof(uint16_t)),
+                      0);
+        }
+    }
+
+  protected:
+    SVTRandom rnd_;
+    PixelType *pred_ptr_[COLOR_CHANNELS];
+    uint32_t *accum_ref_[COLOR_CHANNELS];
+    uint16_t *count_ref_[COLOR_CHANNELS];
+    uint32_t *accum_tst_[COLOR_CHANNELS];
+    uint16_t *count_tst_[COLOR_CHANNELS];
+};
+
+class TemporalFilterTestZzBasedLbd
+    : public TemporalFilterTestZzBased<uint8_t, ZzTemporalFilterFunc> {
+  public:
+    void RunTest() {
+        MeContext me_ctx;
+        memset(&me_ctx, 0, sizeof(me_ctx));
+        ZzTemporalFilterFunc tst_func = GetParam();
+        for (int ss = 0; ss <= 1; ss++) {
+            GenRandomData(&me_ctx, 8);
+            svt_av1_apply_zz_based_temporal_filter_planewise_medium_c(
+                &me_ctx,
+                pred_ptr_[C_Y],
+                MAX_STRIDE,
+                pred_ptr_[C_U],
+                pred_ptr_[C_V],
+                MAX_STRIDE,
+                32,
+                32,
+                ss,
+                ss,
+                accum_ref_[C_Y],
+                count_ref_[C_Y],
+                accum_ref_[C_U],
+                count_ref_[C_U],
+                accum_ref_[C_V],
+                count_ref_[C_V]);
+            tst_func(&me_ctx,
+                     pred_ptr_[C_Y],
+                     MAX_STRIDE,
+                     pred_ptr_[C_U],
+                     pred_ptr_[C_V],
+                     MAX_STRIDE,
+                     32,
+                     32,
+                     ss,
+                     ss,
+                     accum_tst_[C_Y],
+                     count_tst_[C_Y],
+                     accum_tst_[C_U],
+                     count_tst_[C_U],
+                     accum_tst_[C_V],
+                     count_tst_[C_V]);
+            CheckOutput();
+        }
+    }
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(TemporalFilterTestZzBasedLbd);
+
+TEST_P(TemporalFilterTestZzBasedLbd, OperationCheck) {
+    for (int i = 0; i < 50; i++)
+        RunTest();
+}
+
+class TemporalFilterTestZzBasedHbd
+    : public TemporalFilterTestZzBased<uint16_t, ZzTemporalFilterFuncHbd> {
+  public:
+    void RunTest() {
+        MeContext me_ctx;
+        memset(&me_ctx, 0, sizeof(me_ctx));
+        ZzTemporalFilterFuncHbd tst_func = GetParam();
+        for (int ss = 0; ss <= 1; ss++) {
+            for (uint32_t bd = 10; bd <= 12; bd += 2) {
+                GenRandomData(&me_ctx, bd);
+                svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_c(
+                    &me_ctx,
+                    pred_ptr_[C_Y],
+                    MAX_STRIDE,
+                    pred_ptr_[C_U],
+                    pred_ptr_[C_V],
+                    MAX_STRIDE,
+                    32,
+                    32,
+                    ss,
+                    ss,
+                    accum_ref_[C_Y],
+                    count_ref_[C_Y],
+                    accum_ref_[C_U],
+                    count_ref_[C_U],
+                    accum_ref_[C_V],
+                    count_ref_[C_V],
+                    bd);
+                tst_func(&me_ctx,
+                         pred_ptr_[C_Y],
+                         MAX_STRIDE,
+                         pred_ptr_[C_U],
+                         pred_ptr_[C_V],
+                         MAX_STRIDE,
+                         32,
+                         32,
+                         ss,
+                         ss,
+                         accum_tst_[C_Y],
+                         count_tst_[C_Y],
+                         accum_tst_[C_U],
+                         count_tst_[C_U],
+                         accum_tst_[C_V],
+                         count_tst_[C_V],
+                         bd);
+                CheckOutput();
+            }
+        }
+    }
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(TemporalFilterTestZzBasedHbd);
+
+TEST_P(TemporalFilterTestZzBasedHbd, OperationCheck) {
+    for (int i = 0; i < 50; i++)
+        RunTest();
+}
+
+#ifdef ARCH_X86_64
+
+INSTANTIATE_TEST_SUITE_P(
+    SSE4_1, TemporalFilterTestZzBasedLbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_sse4_1));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, TemporalFilterTestZzBasedLbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_avx2));
+
+INSTANTIATE_TEST_SUITE_P(
+    SSE4_1, TemporalFilterTestZzBasedHbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_sse4_1));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, TemporalFilterTestZzBasedHbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_avx2));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, TemporalFilterTestZzBasedLbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_avx512));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, TemporalFilterTestZzBasedHbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_avx512));
+#endif
+
+#endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+
+INSTANTIATE_TEST_SUITE_P(
+    NEON, TemporalFilterTestZzBasedLbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_neon));
+
+INSTANTIATE_TEST_SUITE_P(
+    NEON, TemporalFilterTestZzBasedHbd,
+    ::testing::Values(
+        svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_neon));
+
+#endif  // ARCH_AARCH64
+
 typedef void (*get_final_filtered_pixels_fn)(
     struct MeContext *me_ctx, EbByte *src_center_ptr_start,
     uint16_t **altref_buffer_highbd_start, uint32_t **accum, uint16_t **count,
@@ -1122,6 +1396,12 @@ INSTANTIATE_TEST_SUITE_P(
 INSTANTIATE_TEST_SUITE_P(
     AVX2, TemporalFilterTestGetFinalFilteredPixels,
     ::testing::Values(svt_aom_get_final_filtered_pixels_avx2));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, TemporalFilterTestGetFinalFilteredPixels,
+    ::testing::Values(svt_aom_get_final_filtered_pixels_avx512));
+#endif
 #endif  // ARCH_X86_64
 
 #ifdef ARCH_AARCH64
@@ -1267,6 +1547,12 @@ INSTANTIATE_TEST_SUITE_P(
 INSTANTIATE_TEST_SUITE_P(
     AVX2, TemporalFilterTestApplyFilteringCentralLbd,
     ::testing::Values(svt_aom_apply_filtering_central_avx2));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, TemporalFilterTestApplyFilteringCentralLbd,
+    ::testing::Values(svt_aom_apply_filtering_central_avx512));
+#endif
 #endif  // ARCH_X86_64
 
 #ifdef ARCH_AARCH64
@@ -1304,6 +1590,12 @@ INSTANTIATE_TEST_SUITE_P(
 INSTANTIATE_TEST_SUITE_P(
     AVX2, TemporalFilterTestApplyFilteringCentralHbd,
     ::testing::Values(svt_aom_apply_filtering_central_highbd_avx2));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, TemporalFilterTestApplyFilteringCentralHbd,
+    ::testing::Values(svt_aom_apply_filtering_central_highbd_avx512));
+#endif
 #endif  // ARCH_X86_64
 
 #ifdef ARCH_AARCH64
@@ -1435,6 +1727,16 @@ INSTANTIATE_TEST_SUITE_P(
                        ::testing::Values(2160, 1080, 720, 600, 480, 240),
                        ::testing::Values(10, 12)));
 
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, EstimateNoiseTestFPHbd,
+    ::testing::Combine(::testing::Values(svt_estimate_noise_highbd_fp16_c),
+                       ::testing::Values(svt_estimate_noise_highbd_fp16_avx512),
+                       ::testing::Values(3840, 1920, 1280, 800, 640, 360),
+                       ::testing::Values(2160, 1080, 720, 600, 480, 240),
+                       ::testing::Values(10, 12)));
+#endif
+
 #endif
 
 #ifdef ARCH_AARCH64
@@ -1447,6 +1749,14 @@ INSTANTIATE_TEST_SUITE_P(
                        ::testing::Values(2160, 1080, 720, 600, 480, 240),
                        ::testing::Values(8)));
 
+INSTANTIATE_TEST_SUITE_P(
+    NEON, EstimateNoiseTestFPHbd,
+    ::testing::Combine(::testing::Values(svt_estimate_noise_highbd_fp16_c),
+                       ::testing::Values(svt_estimate_noise_highbd_fp16_neon),
+                       ::testing::Values(3840, 1920, 1280, 800, 640, 360),
+                       ::testing::Values(2160, 1080, 720, 600, 480, 240),
+                       ::testing::Values(10, 12)));
+
 #endif
 
 typedef double (*EstimateNoiseFuncDbl)(const uint16_t *src, int width,
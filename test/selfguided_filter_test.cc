@@ -262,6 +262,12 @@ INSTANTIATE_TEST_SUITE_P(
     AVX2, AV1SelfguidedFilterTest,
     ::testing::Values(make_tuple(svt_apply_selfguided_restoration_avx2)));
 
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, AV1SelfguidedFilterTest,
+    ::testing::Values(make_tuple(svt_apply_selfguided_restoration_avx512)));
+#endif
+
 #endif /* ARCH_X86_64 */
 
 #ifdef ARCH_AARCH64
@@ -513,6 +519,14 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Combine(::testing::Values(svt_apply_selfguided_restoration_avx2),
                        ::testing::ValuesIn(highbd_params_avx2)));
 
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, AV1HighbdSelfguidedFilterTest,
+    ::testing::Combine(
+        ::testing::Values(svt_apply_selfguided_restoration_avx512),
+        ::testing::ValuesIn(highbd_params_avx2)));
+#endif
+
 #endif /* ARCH_X86_64 */
 
 }  // namespace